@@ -14,11 +14,24 @@ public class TouchEngineAPI : ModuleRules
             PrivateIncludePathModuleNames.AddRange(new string[] { "MessageLog" });
         }
 
-        if (Target.Platform == UnrealTargetPlatform.Win64)
+        PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "include"));
+
+        // The TouchEngine library only exists for Win64. The automation tests can instead run against an in-memory stub of the API compiled in the TouchEngine
+        // module (see Private/Stub/TouchEngineStub.h), e.g. on Linux under -nullrhi. The stub is never compiled in Shipping and Test configurations, nor in builds
+        // without automation tests, and stays disabled until a test enables it. The TouchEngine module is only allowed on Win64 in TouchEngine.uplugin, so
+        // running the tests on another platform requires adding it to the PlatformAllowList of the module in the test environment.
+        bool bUseStub = Target.Platform != UnrealTargetPlatform.Win64
+            && Target.Configuration != UnrealTargetConfiguration.Shipping
+            && Target.Configuration != UnrealTargetConfiguration.Test
+            && !Target.bForceDisableAutomationTests;
+        PublicDefinitions.Add("WITH_TOUCHENGINE_STUB=" + (bUseStub ? "1" : "0"));
+        if (bUseStub)
         {
-			// Add the import library
-            PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "include"));
+            PublicDefinitions.Add("TE_EXPORT=TOUCHENGINE_API");
+        }
 
+        if (Target.Platform == UnrealTargetPlatform.Win64)
+        {
 			// Delay-load the DLL, so we can load it from the right place first
 			PublicDelayLoadDLLs.Add("TouchEngine.dll");
 
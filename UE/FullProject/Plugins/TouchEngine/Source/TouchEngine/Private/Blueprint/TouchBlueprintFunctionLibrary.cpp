@@ -25,6 +25,7 @@
 #include "Engine/Texture2D.h"
 #include "GameFramework/Actor.h"
 #include "Rendering/Texture2DResource.h"
+#include "Util/TouchEngineStatsGroup.h"
 
 // pin names copied over from EdGraphSchema_K2.h
 namespace FTouchEngineType
@@ -426,9 +427,9 @@ UFunction* UTouchBlueprintFunctionLibrary::FindInputGetterByType(const FName InT
 }
 
 
-bool UTouchBlueprintFunctionLibrary::SetFloatByName(UTouchEngineComponentBase* Target, const FString VarName, const float Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetFloatByName(UTouchEngineComponentBase* Target, const FString VarName, const float Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Float)
@@ -449,9 +450,9 @@ bool UTouchBlueprintFunctionLibrary::SetFloatByName(UTouchEngineComponentBase* T
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetFloatArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<float> Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetFloatArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<float> Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Float || DynVar->VarType == EVarType::Double)
@@ -475,9 +476,9 @@ bool UTouchBlueprintFunctionLibrary::SetFloatArrayByName(UTouchEngineComponentBa
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetIntByName(UTouchEngineComponentBase* Target, const FString VarName, const int32 Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetIntByName(UTouchEngineComponentBase* Target, const FString VarName, const int32 Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Int)
@@ -492,9 +493,9 @@ bool UTouchBlueprintFunctionLibrary::SetIntByName(UTouchEngineComponentBase* Tar
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetInt64ByName(UTouchEngineComponentBase* Target, const FString VarName, const int64 Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetInt64ByName(UTouchEngineComponentBase* Target, const FString VarName, const int64 Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Int)
@@ -509,9 +510,9 @@ bool UTouchBlueprintFunctionLibrary::SetInt64ByName(UTouchEngineComponentBase* T
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetIntArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<int> Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetIntArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<int> Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Int && DynVar->bIsArray)
@@ -526,9 +527,9 @@ bool UTouchBlueprintFunctionLibrary::SetIntArrayByName(UTouchEngineComponentBase
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetBoolByName(UTouchEngineComponentBase* Target, const FString VarName, const bool Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetBoolByName(UTouchEngineComponentBase* Target, const FString VarName, const bool Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Bool)
@@ -543,14 +544,14 @@ bool UTouchBlueprintFunctionLibrary::SetBoolByName(UTouchEngineComponentBase* Ta
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetNameByName(UTouchEngineComponentBase* Target, const FString VarName, const FName Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetNameByName(UTouchEngineComponentBase* Target, const FString VarName, const FName Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	return SetStringByName(Target, VarName, Value.ToString(), Prefix);
+	return SetStringByName(Target, VarName, Value.ToString(), Prefix, Handle);
 }
 
-bool UTouchBlueprintFunctionLibrary::SetTextureByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture* Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetTextureByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture* Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Texture)
@@ -565,21 +566,21 @@ bool UTouchBlueprintFunctionLibrary::SetTextureByName(UTouchEngineComponentBase*
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetClassByName(UTouchEngineComponentBase* Target, const FString VarName, UClass* Value, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetClassByName(UTouchEngineComponentBase* Target, const FString VarName, UClass* Value, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
 		GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetClassByName), TEXT("Unsupported dynamic variable type."));
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetByteByName(UTouchEngineComponentBase* Target, const FString VarName, const uint8 Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetByteByName(UTouchEngineComponentBase* Target, const FString VarName, const uint8 Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	return SetIntByName(Target, VarName, static_cast<int>(Value), Prefix);
+	return SetIntByName(Target, VarName, static_cast<int>(Value), Prefix, Handle);
 }
 
-bool UTouchBlueprintFunctionLibrary::SetStringByName(UTouchEngineComponentBase* Target, const FString VarName, const FString Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetStringByName(UTouchEngineComponentBase* Target, const FString VarName, const FString Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String)
@@ -594,9 +595,9 @@ bool UTouchBlueprintFunctionLibrary::SetStringByName(UTouchEngineComponentBase*
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetStringArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<FString> Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetStringArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<FString> Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String || DynVar->VarType == EVarType::CHOP) //todo: double check if CHOP is acceptable
@@ -611,14 +612,14 @@ bool UTouchBlueprintFunctionLibrary::SetStringArrayByName(UTouchEngineComponentB
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetTextByName(UTouchEngineComponentBase* Target, const FString VarName, const FText Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetTextByName(UTouchEngineComponentBase* Target, const FString VarName, const FText Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	return SetStringByName(Target, VarName, Value.ToString(), Prefix);
+	return SetStringByName(Target, VarName, Value.ToString(), Prefix, Handle);
 }
 
-bool UTouchBlueprintFunctionLibrary::SetColorByName(UTouchEngineComponentBase* Target, const FString VarName, const FColor Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetColorByName(UTouchEngineComponentBase* Target, const FString VarName, const FColor Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if ((DynVar->VarType == EVarType::Double || DynVar->VarType == EVarType::Float) && DynVar->bIsArray)
@@ -637,9 +638,9 @@ bool UTouchBlueprintFunctionLibrary::SetColorByName(UTouchEngineComponentBase* T
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetLinearColorByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor Value, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetLinearColorByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor Value, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if ((DynVar->VarType == EVarType::Double || DynVar->VarType == EVarType::Float) && DynVar->bIsArray)
@@ -658,9 +659,9 @@ bool UTouchBlueprintFunctionLibrary::SetLinearColorByName(UTouchEngineComponentB
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetVectorByName(UTouchEngineComponentBase* Target, const FString VarName, const FVector Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetVectorByName(UTouchEngineComponentBase* Target, const FString VarName, const FVector Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray)
@@ -680,9 +681,9 @@ bool UTouchBlueprintFunctionLibrary::SetVectorByName(UTouchEngineComponentBase*
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetVector2DByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D Value, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetVector2DByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D Value, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray)
@@ -698,9 +699,9 @@ bool UTouchBlueprintFunctionLibrary::SetVector2DByName(UTouchEngineComponentBase
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetVector4ByName(UTouchEngineComponentBase* Target, const FString VarName, const FVector4 Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetVector4ByName(UTouchEngineComponentBase* Target, const FString VarName, const FVector4 Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray)
@@ -716,14 +717,14 @@ bool UTouchBlueprintFunctionLibrary::SetVector4ByName(UTouchEngineComponentBase*
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetEnumByName(UTouchEngineComponentBase* Target, const FString VarName, const uint8 Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetEnumByName(UTouchEngineComponentBase* Target, const FString VarName, const uint8 Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	return SetIntByName(Target, VarName, static_cast<int>(Value), Prefix);
+	return SetIntByName(Target, VarName, static_cast<int>(Value), Prefix, Handle);
 }
 
-bool UTouchBlueprintFunctionLibrary::SetChopByName(UTouchEngineComponentBase* Target, const FString VarName, const FTouchEngineCHOP& Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetChopByName(UTouchEngineComponentBase* Target, const FString VarName, const FTouchEngineCHOP& Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::CHOP)
@@ -744,27 +745,27 @@ bool UTouchBlueprintFunctionLibrary::SetChopByName(UTouchEngineComponentBase* Ta
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::SetChopChannelByName(UTouchEngineComponentBase* Target, const FString VarName, const FTouchEngineCHOPChannel& Value, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::SetChopChannelByName(UTouchEngineComponentBase* Target, const FString VarName, const FTouchEngineCHOPChannel& Value, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	FTouchEngineCHOP Chop;
 	Chop.Channels.Emplace(Value);
-	return SetChopByName(Target, VarName, Chop, Prefix);
+	return SetChopByName(Target, VarName, Chop, Prefix, Handle);
 }
 
 
 
-bool UTouchBlueprintFunctionLibrary::GetTextureByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture*& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetTextureByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture*& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = nullptr;
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Texture)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsTexture();
 				return IsValid(Value);
@@ -779,10 +780,10 @@ bool UTouchBlueprintFunctionLibrary::GetTextureByName(UTouchEngineComponentBase*
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetTexture2DByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture2D*& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetTexture2DByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture2D*& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	UTexture* Texture;
-	if (GetTextureByName(Target, VarName, Texture, FrameLastUpdated, Prefix))
+	if (GetTextureByName(Target, VarName, Texture, FrameLastUpdated, Prefix, Handle))
 	{
 		Value = Cast<UTexture2D>(Texture);
 		return IsValid(Value);
@@ -792,18 +793,18 @@ bool UTouchBlueprintFunctionLibrary::GetTexture2DByName(UTouchEngineComponentBas
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetStringArrayByName(UTouchEngineComponentBase* Target, const FString VarName, UTouchEngineDAT*& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetStringArrayByName(UTouchEngineComponentBase* Target, const FString VarName, UTouchEngineDAT*& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = nullptr;
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsDAT();
 				return IsValid(Value);
@@ -818,18 +819,18 @@ bool UTouchBlueprintFunctionLibrary::GetStringArrayByName(UTouchEngineComponentB
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetFloatArrayByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<float>& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetFloatArrayByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<float>& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray) //todo: should this accept float and CHOP?
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				const TArray<double> DoubleArray = DynVar->GetValueAsDoubleTArray();
 				if (DoubleArray.Num() != 0)
@@ -848,18 +849,18 @@ bool UTouchBlueprintFunctionLibrary::GetFloatArrayByName(UTouchEngineComponentBa
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetStringByName(UTouchEngineComponentBase* Target, const FString VarName, FString& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetStringByName(UTouchEngineComponentBase* Target, const FString VarName, FString& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String && !DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsString();
 				return true;
@@ -874,10 +875,10 @@ bool UTouchBlueprintFunctionLibrary::GetStringByName(UTouchEngineComponentBase*
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetFloatByName(UTouchEngineComponentBase* Target, const FString VarName, float& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetFloatByName(UTouchEngineComponentBase* Target, const FString VarName, float& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	TArray<float> FloatArray;
-	if (GetFloatArrayByName(Target, VarName, FloatArray, FrameLastUpdated, Prefix)) //todo If the current variable is not an array, this would return false. Is that what we want?
+	if (GetFloatArrayByName(Target, VarName, FloatArray, FrameLastUpdated, Prefix, Handle)) //todo If the current variable is not an array, this would return false. Is that what we want?
 	{
 		if (FloatArray.IsValidIndex(0))
 		{
@@ -890,18 +891,18 @@ bool UTouchBlueprintFunctionLibrary::GetFloatByName(UTouchEngineComponentBase* T
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetCHOPByName(UTouchEngineComponentBase* Target, const FString VarName, FTouchEngineCHOP& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetCHOPByName(UTouchEngineComponentBase* Target, const FString VarName, FTouchEngineCHOP& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::CHOP && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = Target->EngineInfo ? DynVar->GetValueAsCHOP(Target->EngineInfo) : DynVar->GetValueAsCHOP(); // todo: why do we need the EngineInfo here?
 				return Value.IsValid();
@@ -916,19 +917,65 @@ bool UTouchBlueprintFunctionLibrary::GetCHOPByName(UTouchEngineComponentBase* Ta
 	return false;
 }
 
+bool UTouchBlueprintFunctionLibrary::GetCHOPOutputSample(const UTouchEngineComponentBase* Target, const FString VarName, const int32 ChannelIndex, const int32 SampleIndex, float& Value, const FString Prefix)
+{
+	Value = 0.f;
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutput(Target, VarName, Prefix, EVarType::CHOP, GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, GetCHOPOutputSample));
+	return DynVar && DynVar->GetCHOPSample(ChannelIndex, SampleIndex, Value);
+}
+
+bool UTouchBlueprintFunctionLibrary::GetDATOutputSize(const UTouchEngineComponentBase* Target, const FString VarName, int32& NumRows, int32& NumColumns, const FString Prefix)
+{
+	NumRows = 0;
+	NumColumns = 0;
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutput(Target, VarName, Prefix, EVarType::String, GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, GetDATOutputSize));
+	if (!DynVar || !DynVar->bIsArray)
+	{
+		return false;
+	}
+	NumRows = DynVar->GetDATNumRows();
+	NumColumns = DynVar->GetDATNumColumns();
+	return true;
+}
+
+bool UTouchBlueprintFunctionLibrary::GetDATOutputCell(const UTouchEngineComponentBase* Target, const FString VarName, const int32 Row, const int32 Column, FString& Value, const FString Prefix)
+{
+	Value.Reset();
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutput(Target, VarName, Prefix, EVarType::String, GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, GetDATOutputCell));
+	if (!DynVar || Row < 0 || Row >= DynVar->GetDATNumRows() || Column < 0 || Column >= DynVar->GetDATNumColumns())
+	{
+		return false;
+	}
+	Value = FString(DynVar->GetDATCell(Row, Column));
+	return true;
+}
+
+bool UTouchBlueprintFunctionLibrary::GetDATOutputRow(const UTouchEngineComponentBase* Target, const FString VarName, const int32 Row, TArray<FString>& Values, const FString Prefix)
+{
+	Values.Reset();
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutput(Target, VarName, Prefix, EVarType::String, GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, GetDATOutputRow));
+	if (!DynVar || Row < 0 || Row >= DynVar->GetDATNumRows())
+	{
+		return false;
+	}
+	// The row is cached by the variable, so reading it again from several nodes only converts its cells once
+	Values = DynVar->GetDATRow(Row);
+	return true;
+}
+
 
-bool UTouchBlueprintFunctionLibrary::GetFloatInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, float& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetFloatInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, float& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Float || DynVar->VarType == EVarType::Double)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->VarType == EVarType::Float ? DynVar->GetValueAsFloat() : static_cast<float>(DynVar->GetValueAsDouble()); //todo: possible overflow issue?
 				return true;
@@ -943,18 +990,18 @@ bool UTouchBlueprintFunctionLibrary::GetFloatInputLatestByName(UTouchEngineCompo
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetFloatArrayInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<float>& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetFloatArrayInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<float>& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if ((DynVar->VarType == EVarType::Float || DynVar->VarType == EVarType::Double) && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				const TArray<double> BufferDoubleArray = DynVar->GetValueAsDoubleTArray();
 				Value.Append(BufferDoubleArray); //todo: possible overflow issue?
@@ -964,7 +1011,7 @@ bool UTouchBlueprintFunctionLibrary::GetFloatArrayInputLatestByName(UTouchEngine
 		else if (DynVar->VarType == EVarType::CHOP)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				const FTouchEngineCHOP Chop = DynVar->GetValueAsCHOP();
 				return Chop.GetCombinedValues(Value); //todo: check when this is called and what value should be returned
@@ -979,18 +1026,18 @@ bool UTouchBlueprintFunctionLibrary::GetFloatArrayInputLatestByName(UTouchEngine
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetDoubleArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<double>& Value, int64& FrameLastUpdated, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetDoubleArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<double>& Value, int64& FrameLastUpdated, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsDoubleTArray();
 				return true;
@@ -1005,18 +1052,18 @@ bool UTouchBlueprintFunctionLibrary::GetDoubleArrayInputLatestByName(UTouchEngin
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetIntInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, int32& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetIntInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, int32& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Int)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsInt();
 				return true;
@@ -1031,10 +1078,10 @@ bool UTouchBlueprintFunctionLibrary::GetIntInputLatestByName(UTouchEngineCompone
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetInt64InputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, int64& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetInt64InputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, int64& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	int32 Int;
-	if (GetIntInputLatestByName(Target, VarName, Int, FrameLastUpdated, Prefix))
+	if (GetIntInputLatestByName(Target, VarName, Int, FrameLastUpdated, Prefix, Handle))
 	{
 		Value = static_cast<int64>(Int);
 		return true;
@@ -1044,18 +1091,18 @@ bool UTouchBlueprintFunctionLibrary::GetInt64InputLatestByName(UTouchEngineCompo
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetIntArrayInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<int>& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetIntArrayInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<int>& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Int && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsIntTArray();
 				return true;
@@ -1070,18 +1117,18 @@ bool UTouchBlueprintFunctionLibrary::GetIntArrayInputLatestByName(UTouchEngineCo
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetBoolInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, bool& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetBoolInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, bool& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Bool)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsBool();
 				return true;
@@ -1096,10 +1143,10 @@ bool UTouchBlueprintFunctionLibrary::GetBoolInputLatestByName(UTouchEngineCompon
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetNameInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FName& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetNameInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FName& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	FString Str;
-	if (GetStringInputLatestByName(Target, VarName, Str, FrameLastUpdated, Prefix))
+	if (GetStringInputLatestByName(Target, VarName, Str, FrameLastUpdated, Prefix, Handle))
 	{
 		Value = FName(Str);
 		return true;
@@ -1109,18 +1156,18 @@ bool UTouchBlueprintFunctionLibrary::GetNameInputLatestByName(UTouchEngineCompon
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetTextureInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture*& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetTextureInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture*& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = nullptr;
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Bool)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsTexture();
 				return true;
@@ -1135,10 +1182,10 @@ bool UTouchBlueprintFunctionLibrary::GetTextureInputLatestByName(UTouchEngineCom
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetTexture2DInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture2D*& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetTexture2DInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, UTexture2D*& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	UTexture* Texture;
-	if (GetTextureInputLatestByName(Target, VarName, Texture, FrameLastUpdated, Prefix))
+	if (GetTextureInputLatestByName(Target, VarName, Texture, FrameLastUpdated, Prefix, Handle))
 	{
 		Value = Cast<UTexture2D>(Texture);
 		return IsValid(Value);
@@ -1148,17 +1195,17 @@ bool UTouchBlueprintFunctionLibrary::GetTexture2DInputLatestByName(UTouchEngineC
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetClassInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, class UClass*& Value, int64& FrameLastUpdated, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetClassInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, class UClass*& Value, int64& FrameLastUpdated, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
 		GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, GetClassInputLatestByName), TEXT("Input type is not supported."));
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetByteInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, uint8& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetByteInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, uint8& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	int32 Int;
-	if (GetIntInputLatestByName(Target, VarName, Int, FrameLastUpdated, Prefix))
+	if (GetIntInputLatestByName(Target, VarName, Int, FrameLastUpdated, Prefix, Handle))
 	{
 		Value = static_cast<uint8>(Int);//todo: possible overflow issue?
 		return true;
@@ -1168,18 +1215,18 @@ bool UTouchBlueprintFunctionLibrary::GetByteInputLatestByName(UTouchEngineCompon
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetStringInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FString& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetStringInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FString& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsString();
 				return true;
@@ -1194,18 +1241,18 @@ bool UTouchBlueprintFunctionLibrary::GetStringInputLatestByName(UTouchEngineComp
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetStringArrayInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<FString>& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetStringArrayInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, TArray<FString>& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String || DynVar->VarType == EVarType::CHOP)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsStringArray();
 				return true;
@@ -1220,10 +1267,10 @@ bool UTouchBlueprintFunctionLibrary::GetStringArrayInputLatestByName(UTouchEngin
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetTextInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FText& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetTextInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FText& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	FString Str;
-	if (GetStringInputLatestByName(Target, VarName, Str, FrameLastUpdated, Prefix))
+	if (GetStringInputLatestByName(Target, VarName, Str, FrameLastUpdated, Prefix, Handle))
 	{
 		Value = FText::FromString(Str);
 		return true;
@@ -1233,18 +1280,18 @@ bool UTouchBlueprintFunctionLibrary::GetTextInputLatestByName(UTouchEngineCompon
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetColorInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FColor& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetColorInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FColor& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if ((DynVar->VarType == EVarType::Float || DynVar->VarType == EVarType::Double) && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsColor();
 				return true;
@@ -1259,18 +1306,18 @@ bool UTouchBlueprintFunctionLibrary::GetColorInputLatestByName(UTouchEngineCompo
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetLinearColorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor& Value, int64& FrameLastUpdated, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetLinearColorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor& Value, int64& FrameLastUpdated, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix, Handle);
 	if (DynVar)
 	{
 		if ((DynVar->VarType == EVarType::Float || DynVar->VarType == EVarType::Double) && DynVar->bIsArray)
 		{
 			FrameLastUpdated = DynVar->FrameLastUpdated;
-			if (FrameLastUpdated > 0 && DynVar->Value)
+			if (FrameLastUpdated > 0 && DynVar->HasValue())
 			{
 				Value = DynVar->GetValueAsLinearColor();
 				return true;
@@ -1285,10 +1332,10 @@ bool UTouchBlueprintFunctionLibrary::GetLinearColorInputLatestByName(UTouchEngin
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetVectorInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FVector& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetVectorInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FVector& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	TArray<double> DoubleArray;
-	if (GetDoubleArrayInputLatestByName(Target, VarName, DoubleArray, FrameLastUpdated, Prefix))
+	if (GetDoubleArrayInputLatestByName(Target, VarName, DoubleArray, FrameLastUpdated, Prefix, Handle))
 	{
 		if (DoubleArray.Num() == 3)
 		{
@@ -1303,10 +1350,10 @@ bool UTouchBlueprintFunctionLibrary::GetVectorInputLatestByName(UTouchEngineComp
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetVector4InputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FVector4& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetVector4InputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, FVector4& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	TArray<double> DoubleArray;
-	if (GetDoubleArrayInputLatestByName(Target, VarName, DoubleArray, FrameLastUpdated, Prefix))
+	if (GetDoubleArrayInputLatestByName(Target, VarName, DoubleArray, FrameLastUpdated, Prefix, Handle))
 	{
 		if (DoubleArray.Num() == 4)
 		{
@@ -1321,10 +1368,10 @@ bool UTouchBlueprintFunctionLibrary::GetVector4InputLatestByName(UTouchEngineCom
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetVector2DInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D& Value, int64& FrameLastUpdated, FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetVector2DInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D& Value, int64& FrameLastUpdated, FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
 	TArray<double> DoubleArray;
-	if (GetDoubleArrayInputLatestByName(Target, VarName, DoubleArray, FrameLastUpdated, Prefix))
+	if (GetDoubleArrayInputLatestByName(Target, VarName, DoubleArray, FrameLastUpdated, Prefix, Handle))
 	{
 		if (DoubleArray.Num() == 2)
 		{
@@ -1339,9 +1386,9 @@ bool UTouchBlueprintFunctionLibrary::GetVector2DInputLatestByName(UTouchEngineCo
 	return false;
 }
 
-bool UTouchBlueprintFunctionLibrary::GetEnumInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, uint8& Value, int64& FrameLastUpdated, const FString Prefix)
+bool UTouchBlueprintFunctionLibrary::GetEnumInputLatestByName(UTouchEngineComponentBase* Target, const FString VarName, uint8& Value, int64& FrameLastUpdated, const FString Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	return GetByteInputLatestByName(Target, VarName, Value, FrameLastUpdated, Prefix);
+	return GetByteInputLatestByName(Target, VarName, Value, FrameLastUpdated, Prefix, Handle);
 }
 
 
@@ -1450,8 +1497,9 @@ bool UTouchBlueprintFunctionLibrary::GetChannelByName(FTouchEngineCHOP& InChop,
 }
 
 
-FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix)
+FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("BlueprintLibrary - TryGetDynamicVariable"), STAT_TE_BlueprintLibraryTryGetDynamicVariable, STATGROUP_TouchEngine);
 	if (!Target)
 	{
 		return nullptr;
@@ -1463,31 +1511,36 @@ FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetDynamic
 		return nullptr;
 	}
 
-	FString VarNameWithPrefix = VarName;
-	if (VarName.StartsWith("p/") || VarName.StartsWith("i/") || VarName.StartsWith("o/"))
+	// The handle is cached by the calling node, so the name only needs to be resolved on the first call, after the variables are reloaded and when the name changes.
+	// If the node is called with another Target, the handle does not match its container and the name is resolved again.
+	FTouchEngineDynamicVariableStruct* DynVar = Target->DynamicVariables.FindDynamicVariable(VarName, Prefix, Handle);
+	if (!DynVar)
 	{
-		// Legacy names. The user was previously required to explicitly supply the prefix in Blueprint
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::VariableNameNotFound, FTouchEngineDynamicVariableContainer::GetNameWithPrefix(VarName, Prefix),
+			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, TryGetDynamicVariable));
 	}
-	else
+	return DynVar;
+}
+
+const FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetOutput(const UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix, EVarType VarType, const FName& FunctionName)
+{
+	if (!Target || !Target->IsLoaded())
 	{
-		VarNameWithPrefix = Prefix + VarName;
+		return nullptr;
 	}
 
-	// try to find by name
-	FTouchEngineDynamicVariableStruct* DynVar = Target->DynamicVariables.GetDynamicVariableByIdentifier(VarNameWithPrefix);
-
+	const FTouchEngineDynamicVariableStruct* DynVar = Target->DynamicVariables.FindOutput(VarName, Prefix);
 	if (!DynVar)
 	{
-		// failed to find by name, try to find by visible name
-		DynVar = Target->DynamicVariables.GetDynamicVariableByName(VarNameWithPrefix);
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::VariableNameNotFound, FTouchEngineDynamicVariableContainer::GetNameWithPrefix(VarName, Prefix), FunctionName);
+		return nullptr;
 	}
-	
-	if (!DynVar)
+	if (DynVar->VarType != VarType)
 	{
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::VariableNameNotFound, VarNameWithPrefix,
-			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, TryGetDynamicVariable));
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkGetValueError, Prefix + VarName, FunctionName,
+			FString::Printf(TEXT("Output is not a %s property."), VarType == EVarType::CHOP ? TEXT("CHOP") : TEXT("DAT")));
+		return nullptr;
 	}
-
 	return DynVar;
 }
 
@@ -22,6 +22,7 @@
 #include "Engine/TouchEngineInfo.h"
 #include "Engine/TouchEngineSubsystem.h"
 #include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchCookReplayer.h"
 
 #include "Engine/Engine.h"
 #include "Misc/CoreDelegates.h"
@@ -29,6 +30,7 @@
 #include "Misc/Paths.h"
 #include "Tasks/Task.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 #include "RenderingThread.h"
 #include "Engine/TEDebug.h"
@@ -335,6 +337,106 @@ bool UTouchEngineComponentBase::KeepFrameTexture(UTexture2D* FrameTexture, UText
 	return false;
 }
 
+bool UTouchEngineComponentBase::GetTouchEngineStatistics(FTouchEngineStatistics& Statistics)
+{
+	Statistics = EngineInfo ? EngineInfo->Engine->GetStatistics_GameThread() : FTouchEngineStatistics();
+	return Statistics.bIsValid;
+}
+
+static FTouchEngineLatencyPercentiles GetLatencyPercentiles(const UE::TouchEngine::FTouchRollingHistogram& Histogram, double UnitsPerValue)
+{
+	FTouchEngineLatencyPercentiles Percentiles;
+	Percentiles.P50 = Histogram.GetPercentile(50.0) * UnitsPerValue;
+	Percentiles.P95 = Histogram.GetPercentile(95.0) * UnitsPerValue;
+	Percentiles.P99 = Histogram.GetPercentile(99.0) * UnitsPerValue;
+	Percentiles.Max = Histogram.GetMax() * UnitsPerValue;
+	return Percentiles;
+}
+
+bool UTouchEngineComponentBase::GetLatencyReport(FTouchEngineLatencyReport& Report) const
+{
+	Report = FTouchEngineLatencyReport();
+	Report.NumFrames = LatencyHistogram.Num();
+	Report.Latency = GetLatencyPercentiles(LatencyHistogram, 1.0 / 1000000.0);
+	Report.TickLatency = GetLatencyPercentiles(TickLatencyHistogram, 1.0);
+	Report.CookDuration = GetLatencyPercentiles(CookDurationHistogram, 1.0 / 1000000.0);
+	Report.DroppedFrameRate = DroppedFrameHistogram.GetMean();
+	return Report.NumFrames > 0;
+}
+
+void UTouchEngineComponentBase::ResetLatencyReport()
+{
+	LatencyHistogram.Reset();
+	TickLatencyHistogram.Reset();
+	CookDurationHistogram.Reset();
+	DroppedFrameHistogram.Reset();
+}
+
+void UTouchEngineComponentBase::RecordLatency(const FTouchEngineOutputFrameData& OutputFrameData, bool bWasCookSuccessful)
+{
+	const int32 WindowSize = FMath::Max(1, LatencyReportWindowSize);
+	if (LatencyHistogram.GetWindowSize() != WindowSize)
+	{
+		LatencyHistogram.SetWindowSize(WindowSize);
+		TickLatencyHistogram.SetWindowSize(WindowSize);
+		CookDurationHistogram.SetWindowSize(WindowSize);
+		DroppedFrameHistogram.SetWindowSize(WindowSize);
+	}
+
+	LatencyHistogram.Record(FMath::RoundToInt64(OutputFrameData.Latency * 1000000.0));
+	TickLatencyHistogram.Record(OutputFrameData.TickLatency);
+	DroppedFrameHistogram.Record(OutputFrameData.bWasFrameDropped ? 1 : 0);
+	if (bWasCookSuccessful && !OutputFrameData.bWasFrameDropped)
+	{
+		CookDurationHistogram.Record(FMath::RoundToInt64((OutputFrameData.CookEndTime - OutputFrameData.CookStartTime) * 1000000.0));
+	}
+}
+
+bool UTouchEngineComponentBase::StartCookRecording(const FString& FilePath)
+{
+	if (!EngineInfo)
+	{
+		UE_LOG(LogTouchEngineComponent, Warning, TEXT("Unable to start a cook recording as TouchEngine is not running"))
+		return false;
+	}
+	return EngineInfo->Engine->StartCookRecording_GameThread(FilePath);
+}
+
+bool UTouchEngineComponentBase::StopCookRecording()
+{
+	return EngineInfo && EngineInfo->Engine->StopCookRecording_GameThread();
+}
+
+bool UTouchEngineComponentBase::ReplayCookRecording(const FString& FilePath)
+{
+	using namespace UE::TouchEngine;
+	if (!EngineInfo || !EngineInfo->Engine->IsReadyToCookFrame() || bIsReplayingCooks)
+	{
+		UE_LOG(LogTouchEngineComponent, Warning, TEXT("Unable to replay a cook recording as a tox file is not loaded or a replay is already running"))
+		return false;
+	}
+
+	TOptional<FTouchCookRecording> Recording = FTouchCookRecording::LoadFromFile(FilePath);
+	if (!Recording)
+	{
+		return false;
+	}
+
+	// The cooks already requested by the component would be mixed with the replayed ones
+	EngineInfo->Engine->CancelCurrentAndNextCooks_GameThread(ECookFrameResult::Cancelled);
+	bIsReplayingCooks = true;
+	FTouchCookReplayer::Replay_GameThread(EngineInfo->Engine, MoveTemp(Recording.GetValue()))
+		.Next([WeakTEComponent = MakeWeakObjectPtr(this)](const FTouchCookReplayReport&)
+		{
+			// The report is logged by the replayer, and the future is fulfilled on the GameThread
+			if (UTouchEngineComponentBase* ThisPinned = WeakTEComponent.Get())
+			{
+				ThisPinned->bIsReplayingCooks = false;
+			}
+		});
+	return true;
+}
+
 void UTouchEngineComponentBase::BeginDestroy()
 {
 	ReleaseResources(EReleaseTouchResources::KillProcess);
@@ -360,6 +462,7 @@ void UTouchEngineComponentBase::PreEditChange(FProperty* PropertyThatWillChange)
 void UTouchEngineComponentBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	DynamicVariables.InvalidateLookup(); // the details panel can modify the variables in place
 
 	const FName PropertyName = (PropertyChangedEvent.Property != nullptr) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UTouchEngineComponentBase, ToxAsset))
@@ -394,6 +497,7 @@ void UTouchEngineComponentBase::PreEditUndo()
 void UTouchEngineComponentBase::PostEditUndo()
 {
 	Super::PostEditUndo();
+	DynamicVariables.InvalidateLookup(); // the transaction restores the variables in place
 	
 	EngineInfo = PreUndoValues.EngineInfo; //not supposed to be directly affected by Undo/Redo
 	
@@ -455,7 +559,7 @@ void UTouchEngineComponentBase::PostReinitProperties()
 	LoadToxInternal(false,true, true); // this ensures the defaults are set
 	for(FTouchEngineDynamicVariableStruct& DynVarInput : DynamicVariables.DynVars_Input)
 	{
-		if (DynVarInput.Value != nullptr)
+		if (DynVarInput.HasValue())
 		{
 			continue;
 		}
@@ -468,7 +572,7 @@ void UTouchEngineComponentBase::PostReinitProperties()
 			}
 		}
 
-		if (DynVarInput.Value == nullptr)
+		if (!DynVarInput.HasValue())
 		{
 			DynVarInput.ResetToDefault();
 		}
@@ -511,7 +615,7 @@ void UTouchEngineComponentBase::Serialize(FArchive& Ar)
 		DynamicVariables.Reset();
 	}
 	
-	Super::Serialize(Ar);
+	Super::Serialize(Ar); // DynamicVariables invalidates its lookup in PostSerialize
 	
 	if (Ar.IsLoading() && !IsValid(ToxAsset))
 	{
@@ -615,7 +719,10 @@ void UTouchEngineComponentBase::TickComponent(float DeltaTime, ELevelTick TickTy
 	const double Now = FPlatformTime::Seconds();
 	UE_LOG(LogTouchEngineComponent, Log, TEXT("  ====== ====== ====== ====== ------ ------ ====== ====== TickComponent ====== ====== ------ ------ ====== ====== ====== ======  %f"), Now - StartTime)
 	StartTime = Now;
-	StartNewCook(WorldTimeSeconds);
+	if (!bIsReplayingCooks)
+	{
+		StartNewCook(WorldTimeSeconds);
+	}
 }
 
 void UTouchEngineComponentBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -826,7 +933,8 @@ void UTouchEngineComponentBase::StartNewCook(double TimeInSeconds)
 	const int64 TimeScale = EngineInfo ? EngineInfo->Engine->GetFrameRate() * 1000 : 1000; // The TimeScale should be a multiplier of the frame rate for best results. Decided on TDUE-189
 	FCookFrameRequest CookFrameRequest{
 		TimeInSeconds, TimeScale, InputFrameData,
-		DynamicVariables.CopyInputsForCook(InputFrameData.FrameID)
+		DynamicVariables.CopyInputsForCook(InputFrameData.FrameID),
+		CookTimeout // The FrameCooker arms a deadline for this cook and cancels it when reached, no need to poll for the timeout
 	};
 
 	// 2b. If the user put a breakpoint in OnStartFrame and decided to turn off AllowRunningInEditor, we could arrive here with an invalid engine.
@@ -838,8 +946,10 @@ void UTouchEngineComponentBase::StartNewCook(double TimeInSeconds)
 		return;
 	}
 
-	// 3. We actually send the cook to the frame cooker. It will be enqueued until it can be processed
-	const TFuture<void> PendingCookFrame = EngineInfo->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit)
+	// 3. We actually send the cook to the frame cooker. It will be enqueued until it can be processed.
+	// In Synchronized mode, the next cook must not overwrite the outputs of this one before OnCookFinished reads them, so they are never overlapped
+	const int32 CooksInFlight = CookMode == ETouchEngineCookMode::Synchronized ? 1 : MaxCooksInFlight;
+	const TFuture<void> PendingCookFrame = EngineInfo->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit, CooksInFlight)
          .Next([WeakTEComponent = MakeWeakObjectPtr(this)](FCookFrameResult CookFrameResult)
          {
              // When done, we will need to be on GameThread to call BroadcastOnEndFrame, so better going there right away
@@ -861,18 +971,13 @@ void UTouchEngineComponentBase::StartNewCook(double TimeInSeconds)
 	// 4. In Synchronised mode, we do stall the GameThread. This is the only difference between Synchronised and Independent/Delayed Synchronised modes (apart from the TETimeMode)
 	if (CookMode == ETouchEngineCookMode::Synchronized)
 	{
-		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("II. [GT] Synchronized Wait"), STAT_TE_II, STATGROUP_TouchEngine);
+		SCOPE_CYCLE_COUNTER(STAT_TE_II); // The time the GameThread is stalled in Synchronized mode
 		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] About to wait for PendingCookFrame for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID)
 		FlushRenderingCommands(); //We need to ensure the RHI Thread starts the copies before we wait or we would end in a deadlock
-		const bool bDidCookTimeout = !PendingCookFrame.WaitFor(FTimespan::FromSeconds(CookTimeout));
+		// The deadline armed by the FrameCooker cancels the cook from a GameThread task, which cannot run while we are stalling, so the cook is cancelled right after the wait if it timed out
+		const bool bDidCookTimeout = !EngineInfo->Engine->WaitForCook_GameThread(PendingCookFrame, CookTimeout);
 		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] Done waiting for PendingCookFrame for frame %lld. Cook timeout? %s"), *GetCurrentThreadStr(), InputFrameData.FrameID, bDidCookTimeout ? TEXT("TRUE") : TEXT("false"))
 	}
-	
-	// 6. We check if the cook timed out
-	if (EngineInfo)
-	{
-		EngineInfo->CheckIfCookTimedOut_GameThread(CookTimeout);
-	}
 }
 
 void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrameResult& CookFrameResult)
@@ -908,12 +1013,18 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		OutputFrameData.FrameLastUpdated = CookFrameResult.FrameLastUpdated;
 		OutputFrameData.CookStartTime = CookFrameResult.TECookStartTime;
 		OutputFrameData.CookEndTime = CookFrameResult.TECookEndTime;
+		OutputFrameData.TouchEngineStatistics = EngineInfo->Engine->GetStatistics_GameThread();
+		RecordLatency(OutputFrameData, CookFrameResult.Result == ECookFrameResult::Success);
 
 		UE_LOG(LogTouchEngineComponent, Log, TEXT("[PendingCookFrame.Next[%s]] Calling `BroadcastOnEndFrame` for frame %lld"), *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID)
 
 		if (CookFrameResult.Result == ECookFrameResult::Success && !OutputFrameData.bWasFrameDropped) // if the cook was skipped by TE or not successful, we know that the outputs have not changed, so no need to update them 
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    IV.B.1 [GT] Post Cook - DynVar Get Outputs"), STAT_TE_IV_B_1, STATGROUP_TouchEngine);
+			if (CookMode == ETouchEngineCookMode::Synchronized) // The TOP outputs of this cook must be linked before they are read
+			{
+				EngineInfo->Engine->FlushPendingTextureImports_GameThread();
+			}
 			DynamicVariables.GetOutputs(EngineInfo);
 		}
 
@@ -936,6 +1047,8 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		BroadcastOnEndFrame(CookFrameResult.Result == ECookFrameResult::Success ? ECookFrameResult::Cancelled : CookFrameResult.Result, OutputFrameData);
 	}
 
+	UE_TRACE_TOUCHENGINE_COOK_EVENT(CookFinished, CookFrameResult.FrameData.FrameID);
+
 	// 3. We let the FrameCooker know that we can accept a next cook job. Does not actually start a new cook.
 	if (CookFrameResult.OnReadyToStartNextCook)
 	{
@@ -1092,6 +1205,15 @@ void UTouchEngineComponentBase::CreateEngineInfo()
 	{
 		// Create TouchEngine instance if we don't have one already
 		EngineInfo = NewObject<UTouchEngineInfo>(this);
+
+		// Take an instance which has already been started by the subsystem if there is one, to not pay for starting TouchEngine
+		if (UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr)
+		{
+			if (TSharedPtr<UE::TouchEngine::FTouchEngine> PooledEngine = TESubsystem->AcquirePooledEngine(TEFrameRate))
+			{
+				EngineInfo->Engine = PooledEngine.ToSharedRef();
+			}
+		}
 	}
 
 	const TSharedPtr<UE::TouchEngine::FTouchEngine> Engine = EngineInfo->Engine;
@@ -1102,6 +1224,11 @@ void UTouchEngineComponentBase::CreateEngineInfo()
 		Engine->SetCookMode(CookMode == ETouchEngineCookMode::Independent);
 		Engine->SetFrameRate(TEFrameRate);
 	}
+	else if (!Engine->IsLoading() && !Engine->IsReadyToCookFrame())
+	{
+		// The cook mode is only given to TouchEngine when a tox file is loaded, so it can still be applied to an instance coming from the pool
+		Engine->SetCookMode(CookMode == ETouchEngineCookMode::Independent);
+	}
 }
 
 FString UTouchEngineComponentBase::GetAbsoluteToxPath() const
@@ -1133,13 +1260,16 @@ bool UTouchEngineComponentBase::ShouldUseLocalTouchEngine() const
 void UTouchEngineComponentBase::ReleaseResources(EReleaseTouchResources ReleaseMode)
 {
 	UE_LOG(LogTouchEngineComponent, Log, TEXT("[UTouchEngineComponentBase::ReleaseResources] Requesting the %s of TouchEngine..."), ReleaseMode == EReleaseTouchResources::KillProcess ? TEXT("CLOSING") : TEXT("UNLOADING"))
+	ResetLatencyReport();
 	if (EngineInfo)
 	{
+		// The engine might be recycled for another component, which should not end up in the recording
+		EngineInfo->Engine->StopCookRecording_GameThread();
 		const bool bHadValidEngine = EngineInfo->Engine->IsLoading() || EngineInfo->Engine->IsReadyToCookFrame();
 		switch (ReleaseMode)
 		{
 		case EReleaseTouchResources::KillProcess:
-			EngineInfo->Destroy();
+			EngineInfo->Recycle();
 			EngineInfo = nullptr;
 			break;
 		case EReleaseTouchResources::Unload:
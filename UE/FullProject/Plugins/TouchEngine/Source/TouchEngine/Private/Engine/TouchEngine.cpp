@@ -25,8 +25,12 @@
 #include "Algo/Transform.h"
 #include "Async/Async.h"
 #include "Engine/TEDebug.h"
+#include "Util/TouchCookRecorder.h"
+#include "Util/TouchDeadlineTimer.h"
 #include "Util/TouchFrameCooker.h"
+#include "Util/TouchEngineStatsGroup.h"
 #include "Util/TouchHelpers.h"
+#include "Util/ToxParameterCache.h"
 #include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "FTouchEngine"
@@ -35,7 +39,7 @@ namespace UE::TouchEngine
 {
 	void FTouchEngineHazardPointer::TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale, void* Info)
 	{
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceEventCallback(TEInstance: '%p', event: '%s', result: '%hs', start_time_value: '%lld', start_time_scale: '%d', end_time_value: '%lld', end_time_scale: '%d', info: '%p') [Thread: '%s']"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceEventCallback(TEInstance: '%p', event: '%s', result: '%hs', start_time_value: '%lld', start_time_scale: '%d', end_time_value: '%lld', end_time_scale: '%d', info: '%p') [Thread: '%s']"),
 			Instance,
 			*TEEventToString(Event),
 			TEResultGetDescription(Result),
@@ -59,7 +63,7 @@ namespace UE::TouchEngine
 
 	void FTouchEngineHazardPointer::LinkValueCallback_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier, void* Info)
 	{
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkCallback(TEInstance: '%p', event: '%s', identifier '%hs', info: '%p') [Thread: '%s']"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkCallback(TEInstance: '%p', event: '%s', identifier '%hs', info: '%p') [Thread: '%s']"),
 			Instance,
 			*TELinkEventToString(Event),
 			Identifier,
@@ -77,6 +81,19 @@ namespace UE::TouchEngine
 		}
 	}
 
+	void FTouchEngineHazardPointer::StatisticsCallback_AnyThread(TEInstance* Instance, const TEInstanceStatistics* Statistics, void* Info)
+	{
+		// Not logged in LogTouchEngineTECalls as it is called continuously while the instance runs
+		const FTouchEngineHazardPointer* HazardPointer = static_cast<FTouchEngineHazardPointer*>(Info);
+		if (Statistics && HazardPointer && HazardPointer->TouchEngine.IsValid())
+		{
+			if (const TSharedPtr<FTouchEngine> TouchEnginePin = HazardPointer->TouchEngine.Pin())
+			{
+				TouchEnginePin->Statistics_AnyThread(*Statistics);
+			}
+		}
+	}
+
 	FTouchEngine::~FTouchEngine()
 	{
 		check(IsInGameThread());
@@ -98,6 +115,11 @@ namespace UE::TouchEngine
 		{
 			TouchResources.ErrorLog = MakeShared<FTouchErrorLog>(TWeakObjectPtr<UTouchEngineComponentBase>(Component));
 		}
+		else if (IsValid(Component))
+		{
+			// The engine might have been started by the subsystem instance pool or used by another component before
+			TouchResources.ErrorLog->SetComponent(Component);
+		}
 		if (InToxPath.IsEmpty())
 		{
 			const FString ErrMessage(TEXT("Invalid .tox file path. The path is empty"));
@@ -131,6 +153,21 @@ namespace UE::TouchEngine
 		return LoadTouchEngine(InToxPath, LastLoadTimeoutInSeconds);
 	}
 
+	bool FTouchEngine::Prewarm_GameThread()
+	{
+		check(IsInGameThread());
+		if (TouchResources.TouchEngineInstance)
+		{
+			return true;
+		}
+		
+		if (!TouchResources.ErrorLog)
+		{
+			TouchResources.ErrorLog = MakeShared<FTouchErrorLog>(nullptr);
+		}
+		return CreateTouchEngineInstance_GameThread();
+	}
+
 	void FTouchEngine::Unload_GameThread()
 	{
 		SharedCleanUp();
@@ -164,7 +201,7 @@ namespace UE::TouchEngine
 		return LoadState_GameThread == ELoadState::Ready && TouchResources.FrameCooker ? TouchResources.FrameCooker->GetNextFrameID() : -1;
 	}
 
-	TFuture<FCookFrameResult> FTouchEngine::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
+	TFuture<FCookFrameResult> FTouchEngine::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 MaxCooksInFlight)
 	{
 		check(IsInGameThread());
 
@@ -175,7 +212,10 @@ namespace UE::TouchEngine
 			return MakeFulfilledPromise<FCookFrameResult>(FCookFrameResult::FromCookFrameRequest(CookFrameRequest, ECookFrameResult::BadRequest, FrameLastUpdated)).GetFuture();
 		}
 		
-		TFuture<FCookFrameResult> CookFrame = TouchResources.FrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit)
+		// TouchEngine only keeps the latest value of each output, and the outputs are read from it once the result of a cook is processed. With more than one cook
+		// in flight, they could come from a more recent cook, so the cooks stay serialized until the outputs are captured for each frame when it finishes.
+		MaxCooksInFlight = 1;
+		TFuture<FCookFrameResult> CookFrame = TouchResources.FrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit, MaxCooksInFlight)
            .Next([this](FCookFrameResult Value)
            {
                UE_LOG(LogTouchEngine, Verbose, TEXT("[CookFrame_GameThread->Next[%s]] Finished cooking frame (code: %d)"), *GetCurrentThreadStr(), static_cast<int32>(Value.Result));
@@ -219,6 +259,42 @@ namespace UE::TouchEngine
 		return TouchResources.FrameCooker->ExecuteNextPendingCookFrame_GameThread();
 	}
 
+	bool FTouchEngine::StartCookRecording_GameThread(const FString& FilePath)
+	{
+		check(IsInGameThread());
+		StopCookRecording_GameThread();
+
+		const TSharedPtr<FTouchCookRecorder> NewCookRecorder = MakeShared<FTouchCookRecorder>(FilePath, LastToxPathAttemptedToLoad);
+		if (!NewCookRecorder->IsRecording())
+		{
+			return false;
+		}
+
+		CookRecorder = NewCookRecorder;
+		if (TouchResources.FrameCooker)
+		{
+			TouchResources.FrameCooker->SetCookRecorder(CookRecorder);
+		}
+		return true;
+	}
+
+	bool FTouchEngine::StopCookRecording_GameThread()
+	{
+		check(IsInGameThread());
+		if (!CookRecorder)
+		{
+			return false;
+		}
+
+		if (TouchResources.FrameCooker)
+		{
+			TouchResources.FrameCooker->SetCookRecorder(nullptr);
+		}
+		const bool bWasWritten = CookRecorder->Stop();
+		CookRecorder.Reset();
+		return bWasWritten;
+	}
+
 
 	void FTouchEngine::CancelCurrentAndNextCooks_GameThread(ECookFrameResult CookFrameResult)
 	{
@@ -246,6 +322,15 @@ namespace UE::TouchEngine
 		return false;
 	}
 
+	bool FTouchEngine::WaitForCook_GameThread(const TFuture<void>& CookFuture, double CookTimeoutInSeconds)
+	{
+		if (LoadState_GameThread == ELoadState::Ready && TouchResources.FrameCooker)
+		{
+			return TouchResources.FrameCooker->WaitForCook_GameThread(CookFuture, CookTimeoutInSeconds);
+		}
+		return CookFuture.WaitFor(FTimespan::FromSeconds(CookTimeoutInSeconds));
+	}
+
 	void FTouchEngine::HandleTouchEngineInternalError(const TEResult CookResult)
 	{
 		const FString Message = TEResultGetDescription(CookResult);
@@ -275,7 +360,9 @@ namespace UE::TouchEngine
 
 	void FTouchEngine::SetCookMode(bool bIsIndependent)
 	{
-		if (ensureMsgf(!TouchResources.TouchEngineInstance, TEXT("TimeMode can only be set before the engine is started.")))
+		// The TimeMode is only given to TouchEngine when configuring the instance for a tox file, so it can be changed as long as no tox file is loading or loaded
+		if (ensureMsgf(!TouchResources.TouchEngineInstance || (LoadState_GameThread != ELoadState::Loading && LoadState_GameThread != ELoadState::Ready),
+			TEXT("TimeMode can only be set before a tox file is loaded.")))
 		{
 			TimeMode = bIsIndependent
 				? TETimeInternal
@@ -306,7 +393,7 @@ namespace UE::TouchEngine
 	{
 		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("ImportedTexturePoolSize can only be set after the engine is started.")))
 		{
-			TouchResources.ResourceProvider->SetExportedTexturePoolSize(ImportedTexturePoolSize);
+			TouchResources.ResourceProvider->SetImportedTexturePoolSize(ImportedTexturePoolSize);
 			return true;
 		}
 		return false;
@@ -327,6 +414,56 @@ namespace UE::TouchEngine
 		return false;
 	}
 
+	FTouchEngineStatistics FTouchEngine::GetStatistics_GameThread()
+	{
+		check(IsInGameThread());
+		FTouchEngineStatistics ReportedSnapshot;
+		if (ReportedStatistics.Read(ReportedSnapshot))
+		{
+			LatestStatistics_GameThread = ReportedSnapshot;
+			SET_MEMORY_STAT(STAT_TE_Instance_MemoryUsedGPU, ReportedSnapshot.MemoryUsedGPU);
+			SET_MEMORY_STAT(STAT_TE_Instance_MemoryUsedCPU, ReportedSnapshot.MemoryUsedCPU);
+			SET_CYCLE_COUNTER(STAT_TE_Instance_FrameTimeCPU, SecondsToStatCycles(ReportedSnapshot.FrameTimeCPU));
+			SET_CYCLE_COUNTER(STAT_TE_Instance_FrameTimeGPU, SecondsToStatCycles(ReportedSnapshot.FrameTimeGPU));
+		}
+		LatestStatistics_GameThread.FramesProcessed = StatisticsFramesProcessed.load(std::memory_order_relaxed);
+		LatestStatistics_GameThread.FramesDropped = StatisticsFramesDropped.load(std::memory_order_relaxed);
+		SET_DWORD_STAT(STAT_TE_Instance_NbFramesDropped, FMath::Max<int64>(LatestStatistics_GameThread.FramesDropped, 0));
+		return LatestStatistics_GameThread;
+	}
+
+	void FTouchEngine::Statistics_AnyThread(const TEInstanceStatistics& Statistics)
+	{
+		// The times reported cover all the frames processed since the last report
+		const double NumFrames = static_cast<double>(FMath::Max<int64>(Statistics.frames, 1));
+		FTouchEngineStatistics Snapshot;
+		Snapshot.bIsValid = true;
+		Snapshot.MemoryUsedGPU = Statistics.memUsedGPU;
+		Snapshot.MemoryUsedCPU = Statistics.memUsedCPU;
+		Snapshot.FrameTimeCPU = Statistics.frameTimeCPU * 1e-9 / NumFrames;
+		Snapshot.FrameTimeGPU = Statistics.frameTimeGPU < 0 ? -1.0 : Statistics.frameTimeGPU * 1e-9 / NumFrames;
+		ReportedStatistics.Write(Snapshot);
+
+		StatisticsFramesProcessed.fetch_add(FMath::Max<int64>(Statistics.frames, 0), std::memory_order_relaxed);
+		if (Statistics.framesDropped >= 0)
+		{
+			int64 FramesDropped = StatisticsFramesDropped.load(std::memory_order_relaxed);
+			while (!StatisticsFramesDropped.compare_exchange_weak(FramesDropped, FMath::Max<int64>(FramesDropped, 0) + Statistics.framesDropped, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+
+	void FTouchEngine::ResetStatistics_GameThread()
+	{
+		check(IsInGameThread());
+		FTouchEngineStatistics Discarded;
+		ReportedStatistics.Read(Discarded);
+		StatisticsFramesProcessed = 0;
+		StatisticsFramesDropped = -1;
+		LatestStatistics_GameThread = FTouchEngineStatistics();
+	}
+
 	TFuture<FTouchLoadResult> FTouchEngine::LoadTouchEngine(const FString& InToxPath, double TimeoutInSeconds)
 	{
 		if (!InstantiateEngineWithToxFile(InToxPath))
@@ -351,42 +488,111 @@ namespace UE::TouchEngine
 
 		{
 			FScopeLock Lock(&LoadTimeoutTaskLock);
-			// Here we will check if the task passed its timeout, and if yes we unload it. Using the OnBeginFrame delegate to have a consistent implementation for Editor and Game
-			LoadTimeoutTaskHandle = FCoreDelegates::OnBeginFrame.AddLambda([EndTime = FPlatformTime::Seconds() + TimeoutInSeconds, TimeoutInSeconds = TimeoutInSeconds, InToxPath = InToxPath, WeakThis = SharedThis(this)->AsWeak()]()
+			// The timer calls us back on GameThread at the deadline, which works the same in Editor and Game and does not depend on the tick rate
+			if (FTouchDeadlineTimer* Timer = FTouchDeadlineTimer::Get())
 			{
-				if (FPlatformTime::Seconds() < EndTime)
+				LoadTimeoutTaskHandle = Timer->ArmIn(TimeoutInSeconds, [TimeoutInSeconds = TimeoutInSeconds, InToxPath = InToxPath, WeakThis = SharedThis(this)->AsWeak()](FTouchDeadlineTimer::FHandle Handle)
 				{
-					return;
-				}
-				
-				if (const TSharedPtr<FTouchEngine> SharedThis = WeakThis.Pin())
-				{
-					FScopeLock Lock(&SharedThis->LoadTimeoutTaskLock);
-					if (SharedThis->LoadTimeoutTaskHandle)
+					check(IsInGameThread());
+					if (const TSharedPtr<FTouchEngine> SharedThis = WeakThis.Pin())
 					{
-						if (SharedThis->TouchResources.ErrorLog)
-						{
-							SharedThis->TouchResources.ErrorLog->AddError(FTouchErrorLog::EErrorType::TELoadToxTimeout,FString(),
-								GET_FUNCTION_NAME_CHECKED(FTouchEngine, LoadTouchEngine), FString::Printf(TEXT("Tox file '%s' timed-out after %f s"), *InToxPath, TimeoutInSeconds));
-						}
-						else
+						FScopeLock Lock(&SharedThis->LoadTimeoutTaskLock);
+						if (SharedThis->LoadTimeoutTaskHandle.Get(FTouchDeadlineTimer::INVALID_HANDLE) == Handle) // Reset if the tox loaded or the instance was cleaned up after the deadline was reached, or re-armed by a new load
 						{
-							UE_LOG(LogTouchEngine, Error, TEXT("Loading of the Tox '%s' timed-out after %f s"), *InToxPath, TimeoutInSeconds);
-						}
-						FCoreDelegates::OnBeginFrame.Remove(SharedThis->LoadTimeoutTaskHandle.GetValue());
-						SharedThis->LoadTimeoutTaskHandle.Reset();
+							if (SharedThis->TouchResources.ErrorLog)
+							{
+								SharedThis->TouchResources.ErrorLog->AddError(FTouchErrorLog::EErrorType::TELoadToxTimeout,FString(),
+									GET_FUNCTION_NAME_CHECKED(FTouchEngine, LoadTouchEngine), FString::Printf(TEXT("Tox file '%s' timed-out after %f s"), *InToxPath, TimeoutInSeconds));
+							}
+							else
+							{
+								UE_LOG(LogTouchEngine, Error, TEXT("Loading of the Tox '%s' timed-out after %f s"), *InToxPath, TimeoutInSeconds);
+							}
+							SharedThis->LoadTimeoutTaskHandle.Reset();
 						
-						Lock.Unlock();
-						// if TEInstanceUnload is successful, TouchEventCallback_AnyThread will end up being called with event TEEventInstanceDidLoad and result TEResultCancelled
-						const TEResult UnloadResult = TEInstanceUnload(SharedThis->TouchResources.TouchEngineInstance);
+							Lock.Unlock();
+							// if TEInstanceUnload is successful, TouchEventCallback_AnyThread will end up being called with event TEEventInstanceDidLoad and result TEResultCancelled
+							if (SharedThis->TouchResources.TouchEngineInstance)
+							{
+								TEInstanceUnload(SharedThis->TouchResources.TouchEngineInstance);
+							}
+						}
 					}
-				}
-			});
+				});
+			}
 		}
 
 		return LoadPromise->GetFuture();
 	}
 	
+	bool FTouchEngine::CreateTouchEngineInstance_GameThread()
+	{
+		checkf(!TouchResources.ResourceProvider, TEXT("ResourceProvider was expected to be null if there is no running instance!"));
+		TouchResources.ResourceProvider = ITouchEngineModule::Get().CreateResourceProvider();
+		if (!OutputResultAndCheckForError_GameThread(TouchResources.ResourceProvider ? TEResultSuccess : TEResultFeatureNotSupportedBySystem,
+			FString::Printf(TEXT("Impossible to create a ressource provider for the current RHI `%s` which is not supported."), GDynamicRHI->GetName())))
+		{
+			return false;
+		}
+		
+		// The TE instance may get destroyed latently after the owning FTouchEngine is!
+		// HazardPointer's job is to avoid TE from keep on to garbage memory; the HazardPointer is destroyed after the TE instance is destroyed.
+		TouchResources.HazardPointer = MakeShared<FTouchEngineHazardPointer>(SharedThis(this));
+		ResetStatistics_GameThread();
+		const TEResult TouchEngineInstanceResult = TEInstanceCreate(FTouchEngineHazardPointer::TouchEventCallback_AnyThread, FTouchEngineHazardPointer::LinkValueCallback_AnyThread, TouchResources.HazardPointer.Get(), TouchResources.TouchEngineInstance.take());
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceCreate(event_callback: '%p', link_callback: '%p', callback_info: '%p', instance: '%p') [Thread: '%s'] => Returned:  '%s'"),
+			FTouchEngineHazardPointer::TouchEventCallback_AnyThread,
+			FTouchEngineHazardPointer::LinkValueCallback_AnyThread,
+			TouchResources.HazardPointer.Get(),
+			TouchResources.TouchEngineInstance.get(),
+			*UE::TouchEngine::GetCurrentThreadStr(),
+			*TEResultToString(TouchEngineInstanceResult)
+		);
+		
+		if (!OutputResultAndCheckForError_GameThread(TouchEngineInstanceResult, TEXT("Unable to create TouchEngine Instance")))
+		{
+			return false;
+		}
+
+		// The statistics are optional, so we do not fail if they cannot be delivered
+		const TEResult StatisticsCallbackResult = TEInstanceSetStatisticsCallback(TouchResources.TouchEngineInstance, FTouchEngineHazardPointer::StatisticsCallback_AnyThread);
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceSetStatisticsCallback(TEInstance: '%p', callback: '%p') [Thread: '%s'] => Returned:  '%s'"),
+			TouchResources.TouchEngineInstance.get(),
+			FTouchEngineHazardPointer::StatisticsCallback_AnyThread,
+			*UE::TouchEngine::GetCurrentThreadStr(),
+			*TEResultToString(StatisticsCallbackResult)
+		);
+
+		const TEResult SetFrameResult = TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, TargetFrameRate, 1);
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceSetFrameRate(TEInstance: '%p', numerator: '%lld', denominator: '1') [Thread: '%s'] => Returned:  '%s'"),
+			TouchResources.TouchEngineInstance.get(),
+			FMath::RoundToInt64(TargetFrameRate),
+			*UE::TouchEngine::GetCurrentThreadStr(),
+			*TEResultToString(SetFrameResult)
+		);
+
+		if (!OutputResultAndCheckForError_GameThread(SetFrameResult, TEXT("Unable to set frame rate")))
+		{
+			return false;
+		}
+		
+		const TEResult GraphicsContextResult = TEInstanceAssociateGraphicsContext(TouchResources.TouchEngineInstance, TouchResources.ResourceProvider->GetContext());
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceAssociateGraphicsContext(TEInstance: '%p', context: '%p') [Thread: '%s'] => Returned:  '%s'"),
+			TouchResources.TouchEngineInstance.get(),
+			TouchResources.ResourceProvider->GetContext(),
+			*UE::TouchEngine::GetCurrentThreadStr(),
+			*TEResultToString(GraphicsContextResult)
+		);
+
+		if (!OutputResultAndCheckForError_GameThread(GraphicsContextResult, TEXT("Unable to associate graphics Context")))
+		{
+			return false;
+		}
+
+		TouchResources.ResourceProvider->ConfigureInstance(TouchResources.TouchEngineInstance);
+		return true;
+	}
+
 	bool FTouchEngine::InstantiateEngineWithToxFile(const FString& InToxPath)
 	{
 		if (!InToxPath.IsEmpty() && !InToxPath.EndsWith(".tox"))
@@ -398,58 +604,14 @@ namespace UE::TouchEngine
 		
 		if (!TouchResources.TouchEngineInstance)
 		{
-			checkf(!TouchResources.ResourceProvider, TEXT("ResourceProvider was expected to be null if there is no running instance!"));
-			TouchResources.ResourceProvider = ITouchEngineModule::Get().CreateResourceProvider();
-			if (!OutputResultAndCheckForError_GameThread(TouchResources.ResourceProvider ? TEResultSuccess : TEResultFeatureNotSupportedBySystem,
-				FString::Printf(TEXT("Impossible to create a ressource provider for the current RHI `%s` which is not supported."), GDynamicRHI->GetName())))
-			{
-				return false;
-			}
-			
-			// The TE instance may get destroyed latently after the owning FTouchEngine is!
-			// HazardPointer's job is to avoid TE from keep on to garbage memory; the HazardPointer is destroyed after the TE instance is destroyed.
-			TouchResources.HazardPointer = MakeShared<FTouchEngineHazardPointer>(SharedThis(this));
-			const TEResult TouchEngineInstanceResult = TEInstanceCreate(FTouchEngineHazardPointer::TouchEventCallback_AnyThread, FTouchEngineHazardPointer::LinkValueCallback_AnyThread, TouchResources.HazardPointer.Get(), TouchResources.TouchEngineInstance.take());
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceCreate(event_callback: '%p', link_callback: '%p', callback_info: '%p', instance: '%p') [Thread: '%s'] => Returned:  '%s'"),
-				FTouchEngineHazardPointer::TouchEventCallback_AnyThread,
-				FTouchEngineHazardPointer::LinkValueCallback_AnyThread,
-				TouchResources.HazardPointer.Get(),
-				TouchResources.TouchEngineInstance.get(),
-				*UE::TouchEngine::GetCurrentThreadStr(),
-				*TEResultToString(TouchEngineInstanceResult)
-			);
-			
-			if (!OutputResultAndCheckForError_GameThread(TouchEngineInstanceResult, TEXT("Unable to create TouchEngine Instance")))
-			{
-				return false;
-			}
-
-			const TEResult SetFrameResult = TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, TargetFrameRate, 1);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceSetFrameRate(TEInstance: '%p', numerator: '%lld', denominator: '1') [Thread: '%s'] => Returned:  '%s'"),
-				TouchResources.TouchEngineInstance.get(),
-				FMath::RoundToInt64(TargetFrameRate),
-				*UE::TouchEngine::GetCurrentThreadStr(),
-				*TEResultToString(SetFrameResult)
-			);
-
-			if (!OutputResultAndCheckForError_GameThread(SetFrameResult, TEXT("Unable to set frame rate")))
-			{
-				return false;
-			}
-			
-			const TEResult GraphicsContextResult = TEInstanceAssociateGraphicsContext(TouchResources.TouchEngineInstance, TouchResources.ResourceProvider->GetContext());
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceAssociateGraphicsContext(TEInstance: '%p', context: '%p') [Thread: '%s'] => Returned:  '%s'"),
-				TouchResources.TouchEngineInstance.get(),
-				TouchResources.ResourceProvider->GetContext(),
-				*UE::TouchEngine::GetCurrentThreadStr(),
-				*TEResultToString(GraphicsContextResult)
-			);
-
-			if (!OutputResultAndCheckForError_GameThread(GraphicsContextResult, TEXT("Unable to associate graphics Context")))
+			if (!CreateTouchEngineInstance_GameThread())
 			{
 				return false;
 			}
-
+		}
+		else if (TouchResources.ResourceProvider)
+		{
+			// The instance is being reused after Unload_GameThread, which clears the instance saved in the resource provider
 			TouchResources.ResourceProvider->ConfigureInstance(TouchResources.TouchEngineInstance);
 		}
 
@@ -462,7 +624,7 @@ namespace UE::TouchEngine
 			: TEXT("Unable to configure TouchEngine");
 		
 		const TEResult ConfigurationResult = TEInstanceConfigure(TouchResources.TouchEngineInstance, Path, TimeMode);
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceConfigure(TEInstance: '%p', path: '%hs', mode: '%s') [Thread: '%s'] => Returned:  '%s'"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceConfigure(TEInstance: '%p', path: '%hs', mode: '%s') [Thread: '%s'] => Returned:  '%s'"),
 			TouchResources.TouchEngineInstance.get(),
 			Path,
 			TimeMode == TETimeInternal ? TEXT("TimeInternal") : TEXT("TimeExternal"),
@@ -541,7 +703,10 @@ namespace UE::TouchEngine
 			FScopeLock Lock(&LoadTimeoutTaskLock);
 			if (LoadTimeoutTaskHandle) // If we reached that point and we still have a Timeout task handle, we destroy it as we got a result before the timeout
 			{
-				FCoreDelegates::OnBeginFrame.Remove(LoadTimeoutTaskHandle.GetValue());
+				if (FTouchDeadlineTimer* Timer = FTouchDeadlineTimer::Get())
+				{
+					Timer->Disarm(LoadTimeoutTaskHandle.GetValue());
+				}
 				LoadTimeoutTaskHandle.Reset();
 			}
 		}
@@ -592,6 +757,13 @@ namespace UE::TouchEngine
 			OnLoadError_AnyThread(ValidationResult.Error.GetValue());
 			return;
 		}
+
+		// The tox parameter cache discards the parameters parsed with another TouchDesigner installation
+		TouchObject<TEString> EnginePath;
+		if (TEInstanceGetConfiguredEnginePath(Instance, EnginePath.take()) == TEResultSuccess && EnginePath)
+		{
+			FToxParameterCache::SetTouchDesignerPath(UTF8_TO_TCHAR(EnginePath->string));
+		}
 		
 		TPair<TEResult, TArray<FTouchEngineDynamicVariableStruct>> VariablesIn = ProcessTouchVariables(Instance, TEScopeInput);
 		TPair<TEResult, TArray<FTouchEngineDynamicVariableStruct>> VariablesOut = ProcessTouchVariables(Instance, TEScopeOutput);
@@ -620,10 +792,14 @@ namespace UE::TouchEngine
 					return;
 				}
 				SharedThis->TouchResources.VariableManager = MakeShared<FTouchVariableManager>(SharedThis->TouchResources.TouchEngineInstance, SharedThis->TouchResources.ResourceProvider, SharedThis->TouchResources.ErrorLog);
+				// The link infos only change when the tox is loaded or its links are modified, so we cache them now instead of querying them on every Get/Set
+				SharedThis->TouchResources.VariableManager->CacheLinkInfos(VariablesIn.Value);
+				SharedThis->TouchResources.VariableManager->CacheLinkInfos(VariablesOut.Value);
 
 				check(SharedThis->TouchResources.ResourceProvider); //TouchResources.ResourceProvider is supposed to be valid at this point as it has been created in InstantiateEngineWithToxFile
 				SharedThis->TouchResources.FrameCooker = MakeShared<FTouchFrameCooker>(SharedThis->TouchResources.TouchEngineInstance, *SharedThis->TouchResources.VariableManager, *SharedThis->TouchResources.ResourceProvider);
 				SharedThis->TouchResources.FrameCooker->SetTimeMode(SharedThis->TimeMode);
+				SharedThis->TouchResources.FrameCooker->SetCookRecorder(SharedThis->CookRecorder);
 			
 				SharedThis->LoadState_GameThread = ELoadState::Ready;
 				SharedThis->EmplaceLoadPromiseIfSet_GameThread(FTouchLoadResult::MakeSuccess(MoveTemp(VariablesIn.Value), MoveTemp(VariablesOut.Value)));
@@ -721,6 +897,24 @@ namespace UE::TouchEngine
 			return;
 		}
 
+		if (TouchResources.VariableManager)
+		{
+			switch (Event)
+			{
+			case TELinkEventAdded:
+			case TELinkEventRemoved:
+			case TELinkEventModified:
+			case TELinkEventMoved:
+				TouchResources.VariableManager->InvalidateLinkInfo_AnyThread(Identifier);
+				break;
+			case TELinkEventChildChange: // The children are not identified, so we invalidate every link
+				TouchResources.VariableManager->InvalidateAllLinkInfos_AnyThread();
+				break;
+			default:
+				break;
+			}
+		}
+
 		TouchObject<TELinkInfo> Info;
 		const TEResult Result = TEInstanceLinkGetInfo(Instance, Identifier, Info.take());
 
@@ -749,7 +943,10 @@ namespace UE::TouchEngine
 			FScopeLock Lock(&LoadTimeoutTaskLock);
 			if (LoadTimeoutTaskHandle) // We might be loading a tox file while we are trying to destroy
 			{
-				FCoreDelegates::OnBeginFrame.Remove(LoadTimeoutTaskHandle.GetValue());
+				if (FTouchDeadlineTimer* Timer = FTouchDeadlineTimer::Get())
+				{
+					Timer->Disarm(LoadTimeoutTaskHandle.GetValue());
+				}
 				LoadTimeoutTaskHandle.Reset();
 			}
 		}
@@ -16,6 +16,7 @@
 
 #include "Logging.h"
 #include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineSubsystem.h"
 #include "Engine/Util/CookFrameData.h"
 
 #include "Misc/Paths.h"
@@ -67,12 +68,32 @@ void UTouchEngineInfo::Destroy()
 	Engine->DestroyTouchEngine_GameThread();
 }
 
+void UTouchEngineInfo::Recycle()
+{
+	UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+	if (!TESubsystem)
+	{
+		Destroy();
+		return;
+	}
+
+	// This object might still be referenced by latent tasks, so it must not keep using the engine once it is in the pool
+	TESubsystem->ReleaseEngineToPool(Engine);
+	Engine = MakeShared<UE::TouchEngine::FTouchEngine>();
+}
+
 FTouchEngineCHOP UTouchEngineInfo::GetCHOPOutput(const FString& Identifier) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_StatsVarGet);
 	return Engine->GetCHOPOutput(Identifier);
 }
 
+FTouchEngineCHOPView UTouchEngineInfo::GetCHOPOutputView(const FString& Identifier) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_StatsVarGet);
+	return Engine->GetCHOPOutputView(Identifier);
+}
+
 UTexture2D* UTouchEngineInfo::GetTOPOutput(const FString& Identifier) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_StatsVarGet);
@@ -114,10 +135,10 @@ FTouchDATFull UTouchEngineInfo::GetTableOutput(const FString& Identifier) const
 	return Engine->GetTableOutput(Identifier);
 }
 
-TFuture<UE::TouchEngine::FCookFrameResult> UTouchEngineInfo::CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
+TFuture<UE::TouchEngine::FCookFrameResult> UTouchEngineInfo::CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 MaxCooksInFlight)
 {
 	check(IsInGameThread());
-	return Engine->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit);
+	return Engine->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit, MaxCooksInFlight);
 }
 
 bool UTouchEngineInfo::ExecuteNextPendingCookFrame_GameThread() const
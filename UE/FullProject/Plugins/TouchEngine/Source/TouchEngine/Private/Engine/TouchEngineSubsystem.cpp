@@ -18,13 +18,37 @@
 // #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/TouchEngineInfo.h"
 #include "Engine/TouchEngine.h"
+#include "Engine/Util/ToxParameterCache.h"
+#include "Logging.h"
+#include "Util/TouchEngineStatsGroup.h"
 
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/Paths.h"
 
 // class FAssetRegistryModule;
 
 namespace UE::TouchEngine::Private
 {
+	static TAutoConsoleVariable<int32> CVarMaxConcurrentToxLoads(
+		TEXT("TouchEngine.Subsystem.MaxConcurrentToxLoads"),
+		4,
+		TEXT("Maximum number of tox files the TouchEngine subsystem loads at the same time. Each concurrent load starts its own TouchEngine instance."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<int32> CVarInstancePoolSize(
+		TEXT("TouchEngine.Subsystem.InstancePoolSize"),
+		0,
+		TEXT("Number of TouchEngine instances the subsystem keeps started ahead of time, so components do not pay for starting TouchEngine when they load their tox file.\n")
+		TEXT("Instances released by components are unloaded and kept in the pool up to this number. 0 disables the pool."),
+		ECVF_Default);
+
+	static TAutoConsoleVariable<int32> CVarInstancePoolFrameRate(
+		TEXT("TouchEngine.Subsystem.InstancePoolFrameRate"),
+		60,
+		TEXT("Frame rate of the TouchEngine instances started by the instance pool. Only components with the same TEFrameRate can use them."),
+		ECVF_Default);
+
 	static TOptional<FString> GetAbsoluteToxPathIfExists(const UToxAsset* ToxAsset)
 	{
 		if (IsValid(ToxAsset))
@@ -41,7 +65,7 @@ namespace UE::TouchEngine::Private
 
 void UTouchEngineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
-	EngineForLoading = NewObject<UTouchEngineInfo>();
+	ScheduleEnginePoolRefill();
 	//
 	// FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	// TArray<FAssetData> AssetData;
@@ -61,17 +85,26 @@ void UTouchEngineSubsystem::Deinitialize()
 {
 	static const FString FailureReason = TEXT("TouchEngine Subsystem shutting down.");
 
-	if (ActiveTask.IsSet())
+	for (FActiveLoad& ActiveLoad : ActiveLoads)
 	{
-		ActiveTask->Promise.SetValue(UE::TouchEngine::FCachedToxFileInfo::MakeFailure(FailureReason));
-		ActiveTask.Reset();
+		for (FLoadTask& Task : ActiveLoad.Tasks)
+		{
+			Task.Promise.SetValue(UE::TouchEngine::FCachedToxFileInfo::MakeFailure(FailureReason));
+		}
 	}
+	ActiveLoads.Empty();
 
 	for (FLoadTask& Task : TaskQueue)
 	{
 		Task.Promise.SetValue(UE::TouchEngine::FCachedToxFileInfo::MakeFailure(FailureReason));
 	}
 	TaskQueue.Empty();
+
+	for (const TSharedRef<UE::TouchEngine::FTouchEngine>& Engine : EnginePool)
+	{
+		Engine->DestroyTouchEngine_GameThread();
+	}
+	EnginePool.Empty();
 }
 
 TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::GetOrLoadParamsFromTox(UToxAsset* ToxAsset, double LoadTimeoutInSeconds, bool bForceReload)
@@ -119,7 +152,7 @@ TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::GetOrLoadPar
 	}
 
 	ToxAssetToStartLoading.Reset();
-	return EnqueueOrExecuteLoadTask(ToxAsset, LoadTimeoutInSeconds);
+	return EnqueueOrExecuteLoadTask(ToxAsset, LoadTimeoutInSeconds, !bForceReload);
 	
 }
 
@@ -177,9 +210,15 @@ bool UTouchEngineSubsystem::IsLoading(const UToxAsset* ToxAsset) const
 	const TOptional<FString> AbsolutePath = Private::GetAbsoluteToxPathIfExists(ToxAsset);
 	if (AbsolutePath.IsSet())
 	{
-		if (ActiveTask && ActiveTask->ToxAsset == ToxAsset)
+		for (const FActiveLoad& ActiveLoad : ActiveLoads)
 		{
-			return true;
+			for (const FLoadTask& Task : ActiveLoad.Tasks)
+			{
+				if (Task.ToxAsset == ToxAsset)
+				{
+					return true;
+				}
+			}
 		}
 		for (const FLoadTask& Task :TaskQueue)
 		{
@@ -219,6 +258,14 @@ void UTouchEngineSubsystem::CacheLoadedDataFromComponent(UToxAsset* ToxAsset, co
 	if (IsValid(ToxAsset))
 	{
 		CachedFileData.Add(ToxAsset->GetAbsoluteFilePath(), LoadResult);
+		if (LoadResult.IsSuccess())
+		{
+			Async(EAsyncExecution::ThreadPool, [AbsolutePath = ToxAsset->GetAbsoluteFilePath(), LoadResult]()
+			{
+				using namespace UE::TouchEngine;
+				FToxParameterCache::Save(FToxParameterCache::MakeKey(AbsolutePath), LoadResult);
+			});
+		}
 	}
 }
 
@@ -236,60 +283,254 @@ void UTouchEngineSubsystem::LoadPixelFormats(const UTouchEngineInfo* ComponentEn
 	}
 }
 
-TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds)
+TSharedPtr<UE::TouchEngine::FTouchEngine> UTouchEngineSubsystem::AcquirePooledEngine(int64 FrameRate)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Instance Pool - Acquire"), STAT_TE_InstancePool_Acquire, STATGROUP_TouchEngine);
+	check(IsInGameThread());
+	
+	const int32 Index = EnginePool.IndexOfByPredicate([FrameRate](const TSharedRef<UE::TouchEngine::FTouchEngine>& Engine)
+	{
+		return FMath::RoundToInt64(Engine->GetFrameRate()) == FrameRate;
+	});
+	if (Index == INDEX_NONE)
+	{
+		// The pool might not have been filled yet, e.g. if TouchEngine.Subsystem.InstancePoolSize was raised after the subsystem was initialized
+		ScheduleEnginePoolRefill();
+		return nullptr;
+	}
+
+	TSharedRef<UE::TouchEngine::FTouchEngine> Engine = EnginePool[Index];
+	EnginePool.RemoveAt(Index);
+	ScheduleEnginePoolRefill();
+	return Engine;
+}
+
+void UTouchEngineSubsystem::ReleaseEngineToPool(const TSharedRef<UE::TouchEngine::FTouchEngine>& Engine)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Instance Pool - Release"), STAT_TE_InstancePool_Release, STATGROUP_TouchEngine);
+	check(IsInGameThread());
+	
+	const int32 PoolSize = UE::TouchEngine::Private::CVarInstancePoolSize.GetValueOnGameThread();
+	if (EnginePool.Num() >= PoolSize || !Engine->HasCreatedTouchInstance() || EnginePool.Contains(Engine))
+	{
+		Engine->DestroyTouchEngine_GameThread();
+		return;
+	}
+
+	// Unloading keeps the TouchEngine process alive, and LoadTox_GameThread waits for the unload to be done if the engine is acquired before it finished
+	Engine->Unload_GameThread();
+	EnginePool.Add(Engine);
+}
+
+void UTouchEngineSubsystem::ScheduleEnginePoolRefill()
+{
+	if (bIsEnginePoolRefillScheduled || EnginePool.Num() >= UE::TouchEngine::Private::CVarInstancePoolSize.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	bIsEnginePoolRefillScheduled = true;
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UTouchEngineSubsystem>(this)]()
+	{
+		if (UTouchEngineSubsystem* StrongThis = WeakThis.Get())
+		{
+			StrongThis->bIsEnginePoolRefillScheduled = false;
+			StrongThis->RefillEnginePool();
+		}
+	});
+}
+
+void UTouchEngineSubsystem::RefillEnginePool()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Instance Pool - Prewarm"), STAT_TE_InstancePool_Prewarm, STATGROUP_TouchEngine);
+	using namespace UE::TouchEngine;
+	check(IsInGameThread());
+
+	if (GIsCookerLoadingPackage || IsRunningCommandlet() || EnginePool.Num() >= Private::CVarInstancePoolSize.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	const TSharedRef<FTouchEngine> Engine = MakeShared<FTouchEngine>();
+	Engine->SetFrameRate(Private::CVarInstancePoolFrameRate.GetValueOnGameThread());
+	if (!Engine->Prewarm_GameThread())
+	{
+		// Do not try again, the next attempt would most likely fail the same way
+		UE_LOG(LogTouchEngine, Warning, TEXT("Unable to start a TouchEngine instance for the instance pool. The pool will not be refilled until an instance is acquired."));
+		Engine->DestroyTouchEngine_GameThread();
+		return;
+	}
+	
+	EnginePool.Add(Engine);
+	ScheduleEnginePoolRefill();
+}
+
+TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds, bool bUseParameterCache)
 {
 	using namespace UE::TouchEngine;
 	
 	TPromise<FCachedToxFileInfo> Promise;
 	TFuture<FCachedToxFileInfo> Future = Promise.GetFuture();
-	if (ActiveTask)
+	FLoadTask LoadTask{ToxAsset, MoveTemp(Promise), LoadTimeoutInSeconds, bUseParameterCache};
+
+	// If the file is already loading, there is no need to load it a second time
+	const FString AbsolutePath = ToxAsset->GetAbsoluteFilePath();
+	if (FActiveLoad* ActiveLoad = ActiveLoads.FindByPredicate([&AbsolutePath](const FActiveLoad& Load) { return Load.AbsolutePath == AbsolutePath; }))
+	{
+		ActiveLoad->Tasks.Emplace(MoveTemp(LoadTask));
+		return Future;
+	}
+	
+	if (UTouchEngineInfo* LoaderEngine = FindOrCreateIdleLoaderEngine())
 	{
-		TaskQueue.Emplace(FLoadTask{ToxAsset, MoveTemp(Promise), LoadTimeoutInSeconds});
+		ExecuteLoadTask(MoveTemp(LoadTask), LoaderEngine);
 	}
 	else
 	{
-		ExecuteLoadTask(FLoadTask{ToxAsset, MoveTemp(Promise), LoadTimeoutInSeconds});
+		TaskQueue.Emplace(MoveTemp(LoadTask));
 	}
 
 	return Future;
 }
 
-void UTouchEngineSubsystem::ExecuteLoadTask(FLoadTask&& LoadTask)
+void UTouchEngineSubsystem::ExecuteLoadTask(FLoadTask&& LoadTask, UTouchEngineInfo* LoaderEngine)
 {
 	using namespace UE::TouchEngine;
-	ActiveTask = MoveTemp(LoadTask);
-	EngineForLoading->LoadTox(*ActiveTask->ToxAsset->GetAbsoluteFilePath(), nullptr, ActiveTask->LoadTimeoutInSeconds)
-		.Next([this](const FTouchLoadResult& LoadResult)
+	check(LoaderEngine);
+
+	const bool bUseParameterCache = LoadTask.bUseParameterCache;
+	FActiveLoad& ActiveLoad = ActiveLoads.Emplace_GetRef(FActiveLoad{LoadTask.ToxAsset->GetAbsoluteFilePath(), LoaderEngine, {}, nullptr});
+	ActiveLoad.Tasks.Emplace(MoveTemp(LoadTask));
+
+	// Requests for the same file which were queued behind other files are served by this load as well
+	for (int32 Index = 0; Index < TaskQueue.Num(); ++Index)
+	{
+		if (TaskQueue[Index].ToxAsset->GetAbsoluteFilePath() == ActiveLoad.AbsolutePath)
 		{
-			check(IsInGameThread());
+			ActiveLoad.Tasks.Emplace(MoveTemp(TaskQueue[Index]));
+			TaskQueue.RemoveAt(Index--);
+		}
+	}
 
-			// We do not expect this to fire because the only Reset points should be in this if and in Deinitialize()
-			if (ensure(ActiveTask.IsSet()))
-			{
-				const FCachedToxFileInfo FinalResult { LoadResult, false };
-				CachedFileData.Add(ActiveTask->ToxAsset->GetAbsoluteFilePath(), LoadResult);
-				
-				// This is only safe to call after TE has sent the load success event - which has if it has told us the file is loaded.
-				EngineForLoading->GetSupportedPixelFormats(CachedSupportedPixelFormats);
-				
-				ActiveTask->Promise.EmplaceValue(FinalResult);
-#if WITH_EDITOR
-				ActiveTask->ToxAsset->GetOnToxLoadedThroughSubsystem().Broadcast(ActiveTask->ToxAsset, FinalResult);
-#endif
-				ActiveTask.Reset();
-			}
-			
-			if (TaskQueue.Num() > 0)
-			{
-				FLoadTask Task = MoveTemp(TaskQueue[0]);
-				TaskQueue.RemoveAt(0);
-				ExecuteLoadTask(MoveTemp(Task));
-			}
-			else
+	// Hashing the file reads all of it, which can take a while for big files, so it is never done on the GameThread
+	Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<UTouchEngineSubsystem>(this), LoaderEngine, AbsolutePath = ActiveLoad.AbsolutePath, bUseParameterCache]()
+	{
+		TSharedRef<FToxParameterCacheKey> Key = MakeShared<FToxParameterCacheKey>(FToxParameterCache::MakeKey(AbsolutePath));
+		TOptional<FTouchLoadResult> CachedResult = bUseParameterCache ? FToxParameterCache::Load(*Key) : TOptional<FTouchLoadResult>();
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, LoaderEngine, Key = MoveTemp(Key), CachedResult = MoveTemp(CachedResult)]() mutable
+		{
+			if (UTouchEngineSubsystem* StrongThis = WeakThis.Get())
 			{
-				// If there are no more tasks, prevent the engine locking up rendering resources.
-				// Some .tox files when loaded lock shared hardware resources which we'd block.
-				EngineForLoading->Destroy();
+				StrongThis->OnParameterCacheLookupCompleted(LoaderEngine, MoveTemp(Key), MoveTemp(CachedResult));
 			}
 		});
+	});
+}
+
+void UTouchEngineSubsystem::OnParameterCacheLookupCompleted(UTouchEngineInfo* LoaderEngine, TSharedRef<UE::TouchEngine::FToxParameterCacheKey> Key, TOptional<UE::TouchEngine::FTouchLoadResult> CachedResult)
+{
+	using namespace UE::TouchEngine;
+	check(IsInGameThread());
+
+	// The load can only be missing if the subsystem was deinitialized in the meantime
+	FActiveLoad* ActiveLoad = ActiveLoads.FindByPredicate([LoaderEngine](const FActiveLoad& Load) { return Load.LoaderEngine == LoaderEngine; });
+	if (!ActiveLoad)
+	{
+		return;
+	}
+
+	if (CachedResult.IsSet())
+	{
+		// The parameters were saved by a previous session for this exact file content, so there is no need to load the file in TouchEngine
+		OnLoadCompleted(LoaderEngine, CachedResult.GetValue(), true);
+		return;
+	}
+
+	ActiveLoad->ParameterCacheKey = MoveTemp(Key);
+	// ActiveLoad is not used past this point as LoadTox might complete immediately and reallocate ActiveLoads
+	LoaderEngine->LoadTox(ActiveLoad->AbsolutePath, nullptr, ActiveLoad->Tasks[0].LoadTimeoutInSeconds)
+		.Next([this, LoaderEngine](const FTouchLoadResult& LoadResult)
+		{
+			OnLoadCompleted(LoaderEngine, LoadResult);
+		});
+}
+
+void UTouchEngineSubsystem::OnLoadCompleted(UTouchEngineInfo* LoaderEngine, const UE::TouchEngine::FTouchLoadResult& LoadResult, bool bIsFromParameterCache)
+{
+	using namespace UE::TouchEngine;
+	check(IsInGameThread());
+
+	// The load can only be missing if the subsystem was deinitialized in the meantime
+	const int32 LoadIndex = ActiveLoads.IndexOfByPredicate([LoaderEngine](const FActiveLoad& Load) { return Load.LoaderEngine == LoaderEngine; });
+	if (LoadIndex == INDEX_NONE)
+	{
+		return;
+	}
+	FActiveLoad CompletedLoad = MoveTemp(ActiveLoads[LoadIndex]);
+	ActiveLoads.RemoveAtSwap(LoadIndex);
+
+	// A result read from the parameter cache is reported as a new load (bWasCached is false) as the components have never received these parameters
+	const FCachedToxFileInfo FinalResult { LoadResult, false };
+	CachedFileData.Add(CompletedLoad.AbsolutePath, LoadResult);
+	if (CompletedLoad.ParameterCacheKey && LoadResult.IsSuccess())
+	{
+		Async(EAsyncExecution::ThreadPool, [Key = CompletedLoad.ParameterCacheKey.ToSharedRef(), LoadResult]()
+		{
+			FToxParameterCache::Save(*Key, LoadResult);
+		});
+	}
+	
+	if (!bIsFromParameterCache)
+	{
+		// This is only safe to call after TE has sent the load success event - which has if it has told us the file is loaded.
+		LoaderEngine->GetSupportedPixelFormats(CachedSupportedPixelFormats);
+	}
+
+#if WITH_EDITOR
+	TSet<UToxAsset*> BroadcastAssets;
+#endif
+	for (FLoadTask& Task : CompletedLoad.Tasks)
+	{
+		Task.Promise.EmplaceValue(FinalResult);
+#if WITH_EDITOR
+		bool bAlreadyBroadcast = false;
+		BroadcastAssets.Add(Task.ToxAsset, &bAlreadyBroadcast);
+		if (!bAlreadyBroadcast)
+		{
+			Task.ToxAsset->GetOnToxLoadedThroughSubsystem().Broadcast(Task.ToxAsset, FinalResult);
+		}
+#endif
+	}
+	
+	if (TaskQueue.Num() > 0)
+	{
+		FLoadTask Task = MoveTemp(TaskQueue[0]);
+		TaskQueue.RemoveAt(0);
+		ExecuteLoadTask(MoveTemp(Task), LoaderEngine);
+	}
+	else
+	{
+		// If there are no more tasks, prevent the engine locking up rendering resources.
+		// Some .tox files when loaded lock shared hardware resources which we'd block.
+		LoaderEngine->Destroy();
+	}
+}
+
+UTouchEngineInfo* UTouchEngineSubsystem::FindOrCreateIdleLoaderEngine()
+{
+	const int32 MaxConcurrentLoads = FMath::Max(1, UE::TouchEngine::Private::CVarMaxConcurrentToxLoads.GetValueOnGameThread());
+	if (ActiveLoads.Num() >= MaxConcurrentLoads)
+	{
+		return nullptr;
+	}
+	
+	for (UTouchEngineInfo* LoaderEngine : LoaderEngines)
+	{
+		if (!ActiveLoads.ContainsByPredicate([LoaderEngine](const FActiveLoad& Load) { return Load.LoaderEngine == LoaderEngine; }))
+		{
+			return LoaderEngine;
+		}
+	}
+
+	return LoaderEngines.Add_GetRef(NewObject<UTouchEngineInfo>());
 }
@@ -188,6 +188,100 @@ bool FTouchEngineCHOP::Serialize(FArchive& Ar)
 }
 
 
+FTouchEngineCHOPView::FTouchEngineCHOPView(TouchObject<TEFloatBuffer> InBuffer)
+	: Buffer(MoveTemp(InBuffer))
+{
+}
+
+bool FTouchEngineCHOPView::IsTimeDependent() const
+{
+	return IsValid() && TEFloatBufferIsTimeDependent(Buffer);
+}
+
+int32 FTouchEngineCHOPView::GetNumChannels() const
+{
+	return IsValid() ? TEFloatBufferGetChannelCount(Buffer) : 0;
+}
+
+int32 FTouchEngineCHOPView::GetNumSamples() const
+{
+	return IsValid() ? static_cast<int32>(TEFloatBufferGetValueCount(Buffer)) : 0;
+}
+
+TConstArrayView<float> FTouchEngineCHOPView::GetChannel(int32 ChannelIndex) const
+{
+	if (ChannelIndex < 0 || ChannelIndex >= GetNumChannels())
+	{
+		return {};
+	}
+	const float* const* Channels = TEFloatBufferGetValues(Buffer);
+	return Channels ? TConstArrayView<float>(Channels[ChannelIndex], GetNumSamples()) : TConstArrayView<float>();
+}
+
+TConstArrayView<float> FTouchEngineCHOPView::GetChannelSamples(int32 ChannelIndex, int32 StartSample, int32 NumSamples) const
+{
+	const TConstArrayView<float> Channel = GetChannel(ChannelIndex);
+	StartSample = FMath::Clamp(StartSample, 0, Channel.Num());
+	NumSamples = FMath::Clamp(NumSamples, 0, Channel.Num() - StartSample);
+	return Channel.Slice(StartSample, NumSamples);
+}
+
+bool FTouchEngineCHOPView::GetSample(int32 ChannelIndex, int32 SampleIndex, float& OutValue) const
+{
+	const TConstArrayView<float> Channel = GetChannel(ChannelIndex);
+	if (SampleIndex == INDEX_NONE)
+	{
+		SampleIndex = Channel.Num() - 1;
+	}
+	if (!Channel.IsValidIndex(SampleIndex))
+	{
+		return false;
+	}
+	OutValue = Channel[SampleIndex];
+	return true;
+}
+
+const char* FTouchEngineCHOPView::GetChannelNameAsCStr(int32 ChannelIndex) const
+{
+	if (ChannelIndex < 0 || ChannelIndex >= GetNumChannels())
+	{
+		return nullptr;
+	}
+	const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buffer);
+	return ChannelNames ? ChannelNames[ChannelIndex] : nullptr;
+}
+
+FString FTouchEngineCHOPView::GetChannelName(int32 ChannelIndex) const
+{
+	const char* ChannelName = GetChannelNameAsCStr(ChannelIndex);
+	return ChannelName ? FString(UTF8_TO_TCHAR(ChannelName)) : FString();
+}
+
+TArray<FString> FTouchEngineCHOPView::GetChannelNames() const
+{
+	TArray<FString> ChannelNames;
+	const int32 NumChannels = GetNumChannels();
+	ChannelNames.Reserve(NumChannels);
+	for (int32 i = 0; i < NumChannels; i++)
+	{
+		ChannelNames.Add(GetChannelName(i));
+	}
+	return ChannelNames;
+}
+
+FTouchEngineCHOP FTouchEngineCHOPView::ToCHOP(int32 StartSample, int32 NumSamples) const
+{
+	FTouchEngineCHOP Chop;
+	const int32 NumChannels = GetNumChannels();
+	Chop.Channels.Reserve(NumChannels);
+	for (int32 i = 0; i < NumChannels; i++)
+	{
+		Chop.Channels.Add(FTouchEngineCHOPChannel{TArray<float>(GetChannelSamples(i, StartSample, NumSamples)), GetChannelName(i)});
+	}
+	return Chop;
+}
+
+
 FString FTouchEngineDATLine::ToString() const
 {
 	const FString StringData = FString::JoinBy(LineData,TEXT(","), [](const FString& Value)
@@ -327,3 +421,29 @@ bool FTouchEngineDATData::operator!=(const FTouchEngineDATData& Other) const
 {
 	return !(*this == Other);
 }
+
+
+FTouchDATView::FTouchDATView(TouchObject<TETable> InTable)
+	: Table(MoveTemp(InTable))
+{
+	if (IsValid())
+	{
+		NumRows = TETableGetRowCount(Table);
+		NumColumns = TETableGetColumnCount(Table);
+	}
+}
+
+FUtf8StringView FTouchDATView::GetCell(int32 Row, int32 Column) const
+{
+	if (Row < 0 || Row >= GetNumRows() || Column < 0 || Column >= GetNumColumns())
+	{
+		return {};
+	}
+	const char* Cell = TETableGetStringValue(Table, Row, Column);
+	return Cell ? FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Cell)) : FUtf8StringView();
+}
+
+FString FTouchDATView::GetCellAsString(int32 Row, int32 Column) const
+{
+	return FString(GetCell(Row, Column));
+}
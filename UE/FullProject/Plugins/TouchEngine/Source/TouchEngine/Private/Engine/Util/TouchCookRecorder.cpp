@@ -0,0 +1,262 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "TouchCookRecorder.h"
+
+#include "Logging.h"
+#include "TouchEngineDynamicVariableStructVersion.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static constexpr uint32 CookRecordingMagic = 0x54434B52; // 'TCKR'
+		/** Must be increased every time the layout written by FTouchCookRecorder changes */
+		static constexpr int32 CookRecordingFormatVersion = 1;
+
+		enum class ECookRecordingEntry : uint8
+		{
+			Request,
+			Result
+		};
+
+		/** Serializes everything but the variables, which are serialized one by one right after */
+		static void SerializeRequestHeader(FArchive& Ar, FTouchRecordedCookRequest& Request, int32& NumVariables)
+		{
+			Ar << Request.RecordingTime;
+			Ar << Request.FrameID;
+			Ar << Request.FrameTimeInSeconds;
+			Ar << Request.TimeScale;
+			Ar << Request.CookTimeoutInSeconds;
+			Ar << Request.InputBufferLimit;
+			Ar << Request.MaxCooksInFlight;
+			Ar << NumVariables;
+		}
+
+		static void SerializeVariable(FArchive& Ar, FString& Identifier, FTouchEngineDynamicVariableStruct& Variable)
+		{
+			Ar << Identifier;
+			Variable.Serialize(Ar);
+		}
+
+		static void SerializeResult(FArchive& Ar, FTouchRecordedCookResult& Result)
+		{
+			uint8 CookResult = static_cast<uint8>(Result.Result);
+			int32 TouchEngineInternalResult = static_cast<int32>(Result.TouchEngineInternalResult);
+			Ar << Result.RecordingTime;
+			Ar << Result.FrameID;
+			Ar << CookResult;
+			Ar << TouchEngineInternalResult;
+			Ar << Result.bWasFrameDropped;
+			Ar << Result.FrameLastUpdated;
+			Ar << Result.TECookStartTime;
+			Ar << Result.TECookEndTime;
+			Result.Result = static_cast<ECookFrameResult>(CookResult);
+			Result.TouchEngineInternalResult = static_cast<TEResult>(TouchEngineInternalResult);
+		}
+	}
+
+	TOptional<FTouchCookRecording> FTouchCookRecording::LoadFromFile(const FString& FilePath)
+	{
+		const FString AbsoluteFilePath = GetAbsoluteFilePath(FilePath);
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *AbsoluteFilePath))
+		{
+			UE_LOG(LogTouchEngine, Error, TEXT("Unable to read the cook recording '%s'"), *AbsoluteFilePath);
+			return {};
+		}
+
+		FMemoryReader Reader(Bytes, true);
+		FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+
+		uint32 Magic = 0;
+		int32 FormatVersion = INDEX_NONE;
+		int32 DynamicVariableVersion = INDEX_NONE;
+		Ar << Magic;
+		Ar << FormatVersion;
+		Ar << DynamicVariableVersion;
+		if (Ar.IsError() || Magic != Private::CookRecordingMagic || FormatVersion != Private::CookRecordingFormatVersion
+			|| DynamicVariableVersion < 0 || DynamicVariableVersion > FTouchEngineDynamicVariableStructVersion::LatestVersion)
+		{
+			UE_LOG(LogTouchEngine, Error, TEXT("'%s' is not a cook recording or was written by an incompatible version of the plugin"), *AbsoluteFilePath);
+			return {};
+		}
+		Ar.SetCustomVersion(FTouchEngineDynamicVariableStructVersion::GUID, DynamicVariableVersion, TEXT("TouchEngineDynamicVariableStructVer"));
+
+		FTouchCookRecording Recording;
+		Ar << Recording.ToxPath;
+		while (!Ar.AtEnd() && !Ar.IsError())
+		{
+			uint8 EntryType = 0;
+			Ar << EntryType;
+			switch (static_cast<Private::ECookRecordingEntry>(EntryType))
+			{
+			case Private::ECookRecordingEntry::Request:
+				{
+					FTouchRecordedCookRequest& Request = Recording.Requests.AddDefaulted_GetRef();
+					Request.NumResultsBefore = Recording.Results.Num();
+					int32 NumVariables = 0;
+					Private::SerializeRequestHeader(Ar, Request, NumVariables);
+					for (int32 Index = 0; Index < NumVariables && !Ar.IsError(); ++Index)
+					{
+						FString Identifier;
+						FTouchEngineDynamicVariableStruct Variable;
+						Private::SerializeVariable(Ar, Identifier, Variable);
+						Request.VariablesToSend.Add(MoveTemp(Identifier), MoveTemp(Variable));
+					}
+					break;
+				}
+			case Private::ECookRecordingEntry::Result:
+				Private::SerializeResult(Ar, Recording.Results.AddDefaulted_GetRef());
+				break;
+			default:
+				Ar.SetError();
+				break;
+			}
+		}
+
+		if (Ar.IsError())
+		{
+			UE_LOG(LogTouchEngine, Error, TEXT("The cook recording '%s' is corrupted"), *AbsoluteFilePath);
+			return {};
+		}
+		return Recording;
+	}
+
+	FString FTouchCookRecording::GetRecordingDirectory()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TouchEngine"), TEXT("CookRecordings"));
+	}
+
+	FString FTouchCookRecording::GetAbsoluteFilePath(const FString& FilePath)
+	{
+		return FPaths::IsRelative(FilePath) ? FPaths::ConvertRelativePathToFull(GetRecordingDirectory(), FilePath) : FilePath;
+	}
+
+	FTouchCookRecorder::FTouchCookRecorder(const FString& InFilePath, const FString& ToxPath)
+		: FilePath(FTouchCookRecording::GetAbsoluteFilePath(InFilePath))
+		, TempFilePath(FilePath + TEXT(".tmp"))
+		, StartTime(FPlatformTime::Seconds())
+	{
+		FileWriter.Reset(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!FileWriter)
+		{
+			UE_LOG(LogTouchEngine, Error, TEXT("Unable to create the cook recording '%s'"), *FilePath);
+			return;
+		}
+		Archive = MakeUnique<FObjectAndNameAsStringProxyArchive>(*FileWriter, false);
+
+		uint32 Magic = Private::CookRecordingMagic;
+		int32 FormatVersion = Private::CookRecordingFormatVersion;
+		int32 DynamicVariableVersion = FTouchEngineDynamicVariableStructVersion::LatestVersion;
+		FString RecordedToxPath = ToxPath;
+		*Archive << Magic;
+		*Archive << FormatVersion;
+		*Archive << DynamicVariableVersion;
+		*Archive << RecordedToxPath;
+		UE_LOG(LogTouchEngine, Log, TEXT("Started recording the cooks of '%s' to '%s'"), *ToxPath, *FilePath);
+	}
+
+	FTouchCookRecorder::~FTouchCookRecorder()
+	{
+		Stop();
+	}
+
+	bool FTouchCookRecorder::IsRecording() const
+	{
+		FScopeLock Lock(&RecordingLock);
+		return Archive.IsValid();
+	}
+
+	void FTouchCookRecorder::RecordRequest(FCookFrameRequest& Request, int32 InputBufferLimit, int32 MaxCooksInFlight)
+	{
+		FScopeLock Lock(&RecordingLock);
+		if (!Archive)
+		{
+			return;
+		}
+
+		FTouchRecordedCookRequest RecordedRequest;
+		RecordedRequest.RecordingTime = FPlatformTime::Seconds() - StartTime;
+		RecordedRequest.FrameID = Request.FrameData.FrameID;
+		RecordedRequest.FrameTimeInSeconds = Request.FrameTimeInSeconds;
+		RecordedRequest.TimeScale = Request.TimeScale;
+		RecordedRequest.CookTimeoutInSeconds = Request.CookTimeoutInSeconds;
+		RecordedRequest.InputBufferLimit = InputBufferLimit;
+		RecordedRequest.MaxCooksInFlight = MaxCooksInFlight;
+		int32 NumVariables = Request.VariablesToSend.Num();
+
+		uint8 EntryType = static_cast<uint8>(Private::ECookRecordingEntry::Request);
+		*Archive << EntryType;
+		Private::SerializeRequestHeader(*Archive, RecordedRequest, NumVariables);
+		// The variables are written straight from the request to not copy their values
+		for (TPair<FString, FTouchEngineDynamicVariableStruct>& Variable : Request.VariablesToSend)
+		{
+			Private::SerializeVariable(*Archive, Variable.Key, Variable.Value);
+		}
+	}
+
+	void FTouchCookRecorder::RecordResult(const FCookFrameResult& Result)
+	{
+		FScopeLock Lock(&RecordingLock);
+		if (!Archive)
+		{
+			return;
+		}
+
+		FTouchRecordedCookResult RecordedResult;
+		RecordedResult.RecordingTime = FPlatformTime::Seconds() - StartTime;
+		RecordedResult.FrameID = Result.FrameData.FrameID;
+		RecordedResult.Result = Result.Result;
+		RecordedResult.TouchEngineInternalResult = Result.TouchEngineInternalResult;
+		RecordedResult.bWasFrameDropped = Result.bWasFrameDropped;
+		RecordedResult.FrameLastUpdated = Result.FrameLastUpdated;
+		RecordedResult.TECookStartTime = Result.TECookStartTime;
+		RecordedResult.TECookEndTime = Result.TECookEndTime;
+
+		uint8 EntryType = static_cast<uint8>(Private::ECookRecordingEntry::Result);
+		*Archive << EntryType;
+		Private::SerializeResult(*Archive, RecordedResult);
+	}
+
+	bool FTouchCookRecorder::Stop()
+	{
+		FScopeLock Lock(&RecordingLock);
+		if (!Archive)
+		{
+			return false;
+		}
+
+		Archive.Reset();
+		const bool bWasWritten = FileWriter->Close() && !FileWriter->IsError();
+		FileWriter.Reset();
+
+		if (!bWasWritten || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+		{
+			UE_LOG(LogTouchEngine, Error, TEXT("Unable to write the cook recording '%s'"), *FilePath);
+			IFileManager::Get().Delete(*TempFilePath, false, false, true);
+			return false;
+		}
+
+		UE_LOG(LogTouchEngine, Log, TEXT("Saved the cook recording '%s'"), *FilePath);
+		return true;
+	}
+}
@@ -0,0 +1,112 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Util/CookFrameData.h"
+#include "TouchEngineDynamicVariableStruct.h"
+
+class FObjectAndNameAsStringProxyArchive;
+
+namespace UE::TouchEngine
+{
+	/** A cook request as it was received by FTouchFrameCooker, with the settings of the queue it was requested with */
+	struct FTouchRecordedCookRequest
+	{
+		/** The number of seconds since the start of the recording when the request was received */
+		double RecordingTime = 0.0;
+		/** The number of results recorded before this request. The replay waits for the same number of results before sending it, to keep the same interleaving of requests and results */
+		int32 NumResultsBefore = 0;
+
+		int64 FrameID = -1;
+		double FrameTimeInSeconds = 0.0;
+		int64 TimeScale = 0;
+		double CookTimeoutInSeconds = -1.0;
+		int32 InputBufferLimit = 1;
+		int32 MaxCooksInFlight = 1;
+		TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend;
+	};
+
+	/** The result given by FTouchFrameCooker to a recorded cook request */
+	struct FTouchRecordedCookResult
+	{
+		/** The number of seconds since the start of the recording when the result was given */
+		double RecordingTime = 0.0;
+
+		int64 FrameID = -1;
+		ECookFrameResult Result = ECookFrameResult::Count;
+		TEResult TouchEngineInternalResult = TEResultSuccess;
+		bool bWasFrameDropped = false;
+		int64 FrameLastUpdated = -1;
+		double TECookStartTime = 0.0;
+		double TECookEndTime = 0.0;
+	};
+
+	/** The cook requests and results of a FTouchFrameCooker, as written by FTouchCookRecorder */
+	struct FTouchCookRecording
+	{
+		/** The tox file which was loaded when the recording started */
+		FString ToxPath;
+		/** The requests, in the order they were received */
+		TArray<FTouchRecordedCookRequest> Requests;
+		/** The results, in the order they were given */
+		TArray<FTouchRecordedCookResult> Results;
+
+		/** Returns the recording saved in the given file, or an unset optional if the file could not be read or was written with a different format */
+		static TOptional<FTouchCookRecording> LoadFromFile(const FString& FilePath);
+
+		/** The folder in which the recordings given with a relative path are saved */
+		static FString GetRecordingDirectory();
+		/** Returns the given path if absolute, or the path relative to GetRecordingDirectory() otherwise */
+		static FString GetAbsoluteFilePath(const FString& FilePath);
+	};
+
+	/**
+	 * Writes the cook requests and results of a FTouchFrameCooker to a compact binary file, to reproduce queueing and cancellation patterns offline with FTouchCookReplayer.
+	 * The entries are streamed to a temporary file which is moved to the requested path when the recording is stopped, so a crash never leaves a truncated recording behind.
+	 * Texture inputs are recorded by object path, so only the ones which are assets can be replayed.
+	 * This class is thread-safe.
+	 */
+	class FTouchCookRecorder
+	{
+	public:
+		FTouchCookRecorder(const FString& InFilePath, const FString& ToxPath);
+		/** Stops the recording if it was not already */
+		~FTouchCookRecorder();
+
+		/** False if the file could not be created or if the recording was stopped */
+		bool IsRecording() const;
+		const FString& GetFilePath() const { return FilePath; }
+
+		/** Records the request before it is enqueued. The request is taken by non-const reference as FTouchEngineDynamicVariableStruct::Serialize is non-const, but it is not modified */
+		void RecordRequest(FCookFrameRequest& Request, int32 InputBufferLimit, int32 MaxCooksInFlight);
+		/** Records the result given to a request */
+		void RecordResult(const FCookFrameResult& Result);
+
+		/** Finalizes the file. Nothing is recorded after this is called. Returns true if the recording was written successfully */
+		bool Stop();
+
+	private:
+		/** Must be obtained to write to the file */
+		mutable FCriticalSection RecordingLock;
+		FString FilePath;
+		FString TempFilePath;
+		TUniquePtr<FArchive> FileWriter;
+		TUniquePtr<FObjectAndNameAsStringProxyArchive> Archive;
+		/** The FPlatformTime::Seconds() at which the recording started */
+		double StartTime = 0.0;
+	};
+}
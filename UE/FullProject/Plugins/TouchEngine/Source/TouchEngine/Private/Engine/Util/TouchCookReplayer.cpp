@@ -0,0 +1,178 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "TouchCookReplayer.h"
+
+#include "Logging.h"
+#include "Async/Async.h"
+#include "Engine/TouchEngine.h"
+#include "Engine/Util/TouchFrameCooker.h"
+#include "Util/TouchHelpers.h"
+
+namespace UE::TouchEngine
+{
+	FString FTouchCookReplayReport::ToString() const
+	{
+		FString Result = FString::Printf(TEXT("%d requests replayed in %.3fs (recorded over %.3fs). %d results differ from the recording. Dropped frames: %d recorded, %d replayed."),
+			NumRequests, ReplayDurationInSeconds, RecordedDurationInSeconds, NumMismatchedResults, NumRecordedDroppedFrames, NumReplayedDroppedFrames);
+		for (int32 Index = 0; Index < static_cast<int32>(ECookFrameResult::Count); ++Index)
+		{
+			if (NumRecordedResults[Index] > 0 || NumReplayedResults[Index] > 0)
+			{
+				Result += FString::Printf(TEXT("\n  %s: %d recorded, %d replayed"), *UEnum::GetValueAsString(static_cast<ECookFrameResult>(Index)), NumRecordedResults[Index], NumReplayedResults[Index]);
+			}
+		}
+		return Result;
+	}
+
+	TFuture<FTouchCookReplayReport> FTouchCookReplayer::Replay_GameThread(const TSharedRef<FTouchEngine>& Engine, FTouchCookRecording&& Recording, FOnCookReplayed OnCookReplayed)
+	{
+		check(IsInGameThread());
+		if (!Engine->IsReadyToCookFrame() || !Engine->TouchResources.FrameCooker)
+		{
+			UE_LOG(LogTouchEngine, Warning, TEXT("Unable to replay the cook recording made with '%s' as no tox file is loaded"), *Recording.ToxPath);
+			FTouchCookReplayReport Report;
+			Report.NumRequests = Recording.Requests.Num();
+			return MakeFulfilledPromise<FTouchCookReplayReport>(Report).GetFuture();
+		}
+
+		UE_CLOG(Recording.ToxPath != Engine->GetToxPath(), LogTouchEngine, Warning, TEXT("The cook recording was made with '%s' but is replayed with '%s'"), *Recording.ToxPath, *Engine->GetToxPath());
+		return Replay_GameThread(Engine->TouchResources.FrameCooker.ToSharedRef(), MoveTemp(Recording), MoveTemp(OnCookReplayed));
+	}
+
+	TFuture<FTouchCookReplayReport> FTouchCookReplayer::Replay_GameThread(const TSharedRef<FTouchFrameCooker>& FrameCooker, FTouchCookRecording&& Recording, FOnCookReplayed OnCookReplayed)
+	{
+		check(IsInGameThread());
+		const TSharedRef<FTouchCookReplayer> Replayer = MakeShared<FTouchCookReplayer>(FrameCooker, MoveTemp(Recording), MoveTemp(OnCookReplayed));
+		TFuture<FTouchCookReplayReport> Future = Replayer->ReportPromise.GetFuture();
+		
+		UE_LOG(LogTouchEngine, Log, TEXT("Replaying %d cook requests recorded with '%s'"), Replayer->Recording.Requests.Num(), *Replayer->Recording.ToxPath);
+		if (Replayer->Recording.Requests.IsEmpty())
+		{
+			Replayer->FinishReplay_GameThread();
+		}
+		else
+		{
+			Replayer->SendReadyRequests_GameThread();
+		}
+		return Future;
+	}
+
+	FTouchCookReplayer::FTouchCookReplayer(const TSharedRef<FTouchFrameCooker>& InFrameCooker, FTouchCookRecording&& InRecording, FOnCookReplayed InOnCookReplayed)
+		: FrameCooker(InFrameCooker)
+		, OnCookReplayed(MoveTemp(InOnCookReplayed))
+		, Recording(MoveTemp(InRecording))
+		, ReplayStartTime(FPlatformTime::Seconds())
+	{
+		Report.NumRequests = Recording.Requests.Num();
+		for (const FTouchRecordedCookResult& Result : Recording.Results)
+		{
+			RecordedResultsByFrameID.Add(Result.FrameID, Result.Result);
+			if (Result.Result < ECookFrameResult::Count)
+			{
+				++Report.NumRecordedResults[static_cast<int32>(Result.Result)];
+			}
+			Report.NumRecordedDroppedFrames += Result.bWasFrameDropped ? 1 : 0;
+		}
+		if (!Recording.Requests.IsEmpty() && !Recording.Results.IsEmpty())
+		{
+			Report.RecordedDurationInSeconds = Recording.Results.Last().RecordingTime - Recording.Requests[0].RecordingTime;
+		}
+	}
+
+	void FTouchCookReplayer::SendReadyRequests_GameThread()
+	{
+		const TSharedPtr<FTouchFrameCooker> PinnedFrameCooker = FrameCooker.Pin();
+		while (NextRequestIndex < Recording.Requests.Num() && Recording.Requests[NextRequestIndex].NumResultsBefore <= NumResultsReceived)
+		{
+			if (!PinnedFrameCooker)
+			{
+				UE_LOG(LogTouchEngine, Warning, TEXT("The tox file was unloaded during the replay, only %d of the %d requests were replayed"), NextRequestIndex, Recording.Requests.Num());
+				FinishReplay_GameThread();
+				return;
+			}
+
+			const int32 RequestIndex = NextRequestIndex++;
+			FTouchRecordedCookRequest& RecordedRequest = Recording.Requests[RequestIndex];
+			FTouchEngineInputFrameData FrameData{PinnedFrameCooker->GetNextFrameID()};
+			FrameData.StartTime = FPlatformTime::Seconds() - GStartTime;
+			FCookFrameRequest CookFrameRequest{
+				RecordedRequest.FrameTimeInSeconds, RecordedRequest.TimeScale, FrameData,
+				MoveTemp(RecordedRequest.VariablesToSend),
+				RecordedRequest.CookTimeoutInSeconds
+			};
+
+			PinnedFrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), RecordedRequest.InputBufferLimit, RecordedRequest.MaxCooksInFlight)
+				.Next([This = AsShared(), RequestIndex](FCookFrameResult CookFrameResult)
+				{
+					// Always deferred, as some results are given while the FrameCooker is enqueuing, and we would otherwise send the next requests from there
+					AsyncTask(ENamedThreads::GameThread, [This, RequestIndex, CookFrameResult = MoveTemp(CookFrameResult)]()
+					{
+						This->OnCookFinished_GameThread(RequestIndex, CookFrameResult);
+					});
+				});
+		}
+	}
+
+	void FTouchCookReplayer::OnCookFinished_GameThread(int32 RequestIndex, const FCookFrameResult& CookFrameResult)
+	{
+		++NumResultsReceived;
+		if (CookFrameResult.Result < ECookFrameResult::Count)
+		{
+			++Report.NumReplayedResults[static_cast<int32>(CookFrameResult.Result)];
+		}
+		Report.NumReplayedDroppedFrames += CookFrameResult.bWasFrameDropped ? 1 : 0;
+		const ECookFrameResult* RecordedResult = RecordedResultsByFrameID.Find(Recording.Requests[RequestIndex].FrameID);
+		if (RecordedResult && *RecordedResult != CookFrameResult.Result)
+		{
+			++Report.NumMismatchedResults;
+		}
+
+		// Once the outputs have been read, the next cook can start right away
+		if (OnCookReplayed)
+		{
+			OnCookReplayed(RequestIndex, CookFrameResult);
+		}
+		if (CookFrameResult.OnReadyToStartNextCook)
+		{
+			CookFrameResult.OnReadyToStartNextCook->SetValue();
+		}
+		if (const TSharedPtr<FTouchFrameCooker> PinnedFrameCooker = FrameCooker.Pin())
+		{
+			PinnedFrameCooker->ExecuteNextPendingCookFrame_GameThread();
+		}
+
+		if (NumResultsReceived >= Recording.Requests.Num())
+		{
+			FinishReplay_GameThread();
+		}
+		else
+		{
+			SendReadyRequests_GameThread();
+		}
+	}
+
+	void FTouchCookReplayer::FinishReplay_GameThread()
+	{
+		if (bIsFinished)
+		{
+			return;
+		}
+		bIsFinished = true;
+		Report.ReplayDurationInSeconds = FPlatformTime::Seconds() - ReplayStartTime;
+		UE_LOG(LogTouchEngine, Log, TEXT("Cook replay done. %s"), *Report.ToString());
+		ReportPromise.SetValue(Report);
+	}
+}
@@ -0,0 +1,89 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Engine/Util/TouchCookRecorder.h"
+
+namespace UE::TouchEngine
+{
+	class FTouchEngine;
+	class FTouchFrameCooker;
+
+	/** Compares the results of a replay with the ones of the recording */
+	struct FTouchCookReplayReport
+	{
+		int32 NumRequests = 0;
+		/** The number of results for each ECookFrameResult */
+		int32 NumRecordedResults[static_cast<int32>(ECookFrameResult::Count)] = {};
+		int32 NumReplayedResults[static_cast<int32>(ECookFrameResult::Count)] = {};
+		int32 NumRecordedDroppedFrames = 0;
+		int32 NumReplayedDroppedFrames = 0;
+		/** The number of requests which did not get the same ECookFrameResult as in the recording */
+		int32 NumMismatchedResults = 0;
+
+		/** The time between the first request and the last result of the recording */
+		double RecordedDurationInSeconds = 0.0;
+		double ReplayDurationInSeconds = 0.0;
+
+		FString ToString() const;
+	};
+
+	/**
+	 * Sends the requests of a FTouchCookRecording through the cook pipeline of a FTouchEngine as fast as possible, to reproduce queueing and cancellation patterns offline.
+	 * The requests are not sent at their recorded time, but each one is sent once as many results have been received as when it was recorded,
+	 * so the requests and results interleave the same way they did in the recording, independently of the speed of the machine.
+	 * The results are released as soon as they are received, after being given to the optional FOnCookReplayed so the outputs can be read.
+	 */
+	class FTouchCookReplayer : public TSharedFromThis<FTouchCookReplayer>
+	{
+	public:
+		/** Called on the GameThread with the index of the recorded request and its result, before the result is released */
+		using FOnCookReplayed = TFunction<void(int32 RequestIndex, const FCookFrameResult& CookFrameResult)>;
+
+		/**
+		 * Replays the recording with the given engine, which should have loaded the tox file the recording was made with.
+		 * The owner of the engine must not request cooks until the replay is done.
+		 * @return A future fulfilled on the GameThread once the results of all the requests have been received
+		 */
+		static TFuture<FTouchCookReplayReport> Replay_GameThread(const TSharedRef<FTouchEngine>& Engine, FTouchCookRecording&& Recording, FOnCookReplayed OnCookReplayed = {});
+		/** Replays the recording with the frame cooker of a loaded tox, which is what the overload above does with the frame cooker of the engine */
+		static TFuture<FTouchCookReplayReport> Replay_GameThread(const TSharedRef<FTouchFrameCooker>& FrameCooker, FTouchCookRecording&& Recording, FOnCookReplayed OnCookReplayed = {});
+
+		FTouchCookReplayer(const TSharedRef<FTouchFrameCooker>& InFrameCooker, FTouchCookRecording&& InRecording, FOnCookReplayed InOnCookReplayed);
+
+	private:
+		/** Only valid while the tox stays loaded */
+		TWeakPtr<FTouchFrameCooker> FrameCooker;
+		FOnCookReplayed OnCookReplayed;
+		FTouchCookRecording Recording;
+		/** The recorded result of each recorded FrameID */
+		TMap<int64, ECookFrameResult> RecordedResultsByFrameID;
+
+		int32 NextRequestIndex = 0;
+		int32 NumResultsReceived = 0;
+		double ReplayStartTime = 0.0;
+		FTouchCookReplayReport Report;
+		TPromise<FTouchCookReplayReport> ReportPromise;
+		bool bIsFinished = false;
+
+		/** Sends all the requests whose results recorded before them have been received */
+		void SendReadyRequests_GameThread();
+		void OnCookFinished_GameThread(int32 RequestIndex, const FCookFrameResult& CookFrameResult);
+		void FinishReplay_GameThread();
+	};
+}
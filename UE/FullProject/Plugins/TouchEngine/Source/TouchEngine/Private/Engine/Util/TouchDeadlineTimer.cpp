@@ -0,0 +1,158 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "TouchDeadlineTimer.h"
+
+#include "Logging.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static FCriticalSection SharedTimerLock;
+		static TUniquePtr<FTouchDeadlineTimer> SharedTimer;
+		static bool bIsSharedTimerShutDown = false;
+	}
+
+	FTouchDeadlineTimer* FTouchDeadlineTimer::Get()
+	{
+		FScopeLock Lock(&Private::SharedTimerLock);
+		if (!Private::SharedTimer && !Private::bIsSharedTimerShutDown)
+		{
+			Private::SharedTimer = MakeUnique<FTouchDeadlineTimer>();
+		}
+		return Private::SharedTimer.Get();
+	}
+
+	void FTouchDeadlineTimer::Shutdown()
+	{
+		FScopeLock Lock(&Private::SharedTimerLock);
+		Private::SharedTimer.Reset();
+		Private::bIsSharedTimerShutDown = true;
+	}
+
+	FTouchDeadlineTimer::FTouchDeadlineTimer(FClock InClock, bool bStartThread)
+		: Clock(MoveTemp(InClock))
+	{
+		check(Clock);
+		WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		if (bStartThread)
+		{
+			Thread = FRunnableThread::Create(this, TEXT("TouchEngineDeadlineTimer"), 0, TPri_AboveNormal);
+			UE_CLOG(!Thread, LogTouchEngine, Error, TEXT("FTouchDeadlineTimer: Unable to create the timer thread, cook and load timeouts will not fire."));
+		}
+	}
+
+	FTouchDeadlineTimer::~FTouchDeadlineTimer()
+	{
+		if (Thread)
+		{
+			Thread->Kill(true); // Calls Stop and waits for Run to return
+			delete Thread;
+			Thread = nullptr;
+		}
+		FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+		WakeUpEvent = nullptr;
+	}
+
+	FTouchDeadlineTimer::FHandle FTouchDeadlineTimer::Arm(double DeadlineInSeconds, FOnDeadline OnDeadline)
+	{
+		FHandle Handle;
+		{
+			FScopeLock Lock(&DeadlinesLock);
+			Handle = NextHandle++;
+			Deadlines.Add(FDeadline{Handle, DeadlineInSeconds, MoveTemp(OnDeadline)});
+		}
+		WakeUpEvent->Trigger();
+		return Handle;
+	}
+
+	void FTouchDeadlineTimer::Disarm(FHandle Handle)
+	{
+		if (Handle == INVALID_HANDLE)
+		{
+			return;
+		}
+
+		// The callback is moved out of the lock to not call any destructor while holding it
+		FOnDeadline DisarmedCallback;
+		{
+			FScopeLock Lock(&DeadlinesLock);
+			const int32 Index = Deadlines.IndexOfByPredicate([Handle](const FDeadline& Deadline) { return Deadline.Handle == Handle; });
+			if (Index != INDEX_NONE)
+			{
+				DisarmedCallback = MoveTemp(Deadlines[Index].OnDeadline);
+				Deadlines.RemoveAtSwap(Index);
+			}
+		}
+	}
+
+	double FTouchDeadlineTimer::FireExpiredDeadlines()
+	{
+		TArray<FDeadline> ExpiredDeadlines;
+		double SecondsToWait = -1.0;
+		{
+			FScopeLock Lock(&DeadlinesLock);
+			const double CurrentTime = Now();
+			for (int32 Index = Deadlines.Num() - 1; Index >= 0; --Index)
+			{
+				FDeadline& Deadline = Deadlines[Index];
+				if (Deadline.DeadlineInSeconds <= CurrentTime)
+				{
+					ExpiredDeadlines.Add(MoveTemp(Deadline));
+					Deadlines.RemoveAtSwap(Index);
+				}
+				else if (SecondsToWait < 0.0 || Deadline.DeadlineInSeconds - CurrentTime < SecondsToWait)
+				{
+					SecondsToWait = Deadline.DeadlineInSeconds - CurrentTime;
+				}
+			}
+		}
+
+		// The timer only watches the deadlines, the callbacks cancel cooks and unload instances which must happen on the GameThread
+		for (FDeadline& Deadline : ExpiredDeadlines)
+		{
+			AsyncTask(ENamedThreads::GameThread, [Handle = Deadline.Handle, OnDeadline = MoveTemp(Deadline.OnDeadline)]()
+			{
+				OnDeadline(Handle);
+			});
+		}
+		return SecondsToWait;
+	}
+
+	uint32 FTouchDeadlineTimer::Run()
+	{
+		while (!bIsStopping)
+		{
+			const double SecondsToWait = FireExpiredDeadlines();
+			if (!bIsStopping)
+			{
+				// Round up so we do not wake up right before the deadline and spin
+				const uint32 WaitTimeInMs = SecondsToWait < 0.0 ? MAX_uint32 : static_cast<uint32>(FMath::CeilToInt64(SecondsToWait * 1000.0));
+				WakeUpEvent->Wait(WaitTimeInMs);
+			}
+		}
+		return 0;
+	}
+
+	void FTouchDeadlineTimer::Stop()
+	{
+		bIsStopping = true;
+		WakeUpEvent->Trigger();
+	}
+}
@@ -0,0 +1,95 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+class FRunnableThread;
+class FEvent;
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Fires callbacks on the GameThread when their deadline is reached.
+	 * The deadlines are watched from a dedicated thread so they are not quantized to the game tick. Once a deadline is reached, its callback is only marshalled to the GameThread,
+	 * so it can safely use the GameThread-only parts of the plugin.
+	 * Deadlines are expressed in the time of the clock given at construction, FPlatformTime::Seconds() by default, which is monotonic.
+	 */
+	class FTouchDeadlineTimer : public FRunnable
+	{
+	public:
+		using FHandle = uint64;
+		using FClock = TFunction<double()>;
+		/** Called with the handle returned by Arm, so the callback can check it is still the one expected by its owner */
+		using FOnDeadline = TUniqueFunction<void(FHandle)>;
+		static constexpr FHandle INVALID_HANDLE = 0;
+
+		/** Returns the shared timer, starting it if needed. Returns nullptr once Shutdown has been called */
+		static FTouchDeadlineTimer* Get();
+		/** Stops the shared timer. Pending callbacks are discarded and Get returns nullptr from now on. Called when the module shuts down */
+		static void Shutdown();
+
+		/**
+		 * @param InClock The clock in which the deadlines are expressed
+		 * @param bStartThread If false, no thread is started and FireExpiredDeadlines needs to be called manually. Used to drive the timer with a fake clock
+		 */
+		explicit FTouchDeadlineTimer(FClock InClock = &FPlatformTime::Seconds, bool bStartThread = true);
+		virtual ~FTouchDeadlineTimer() override;
+
+		double Now() const { return Clock(); }
+
+		/**
+		 * Calls OnDeadline on the GameThread once Now() reaches DeadlineInSeconds.
+		 * @return A handle to pass to Disarm to cancel the callback
+		 */
+		FHandle Arm(double DeadlineInSeconds, FOnDeadline OnDeadline);
+		/** Arms a callback to be called in the given number of seconds */
+		FHandle ArmIn(double DelayInSeconds, FOnDeadline OnDeadline) { return Arm(Now() + DelayInSeconds, MoveTemp(OnDeadline)); }
+		/** Cancels the callback. The callback might still be called if its deadline was already reached when this is called, so it must check that it is still relevant */
+		void Disarm(FHandle Handle);
+
+		/**
+		 * Sends the callbacks of the deadlines reached to the GameThread. This is done by the timer thread, or manually when the timer was created without one.
+		 * @return The number of seconds until the next deadline, or a negative number if no deadline is armed
+		 */
+		double FireExpiredDeadlines();
+
+		//~ Begin FRunnable Interface
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+		//~ End FRunnable Interface
+
+	private:
+		struct FDeadline
+		{
+			FHandle Handle;
+			double DeadlineInSeconds;
+			FOnDeadline OnDeadline;
+		};
+
+		FClock Clock;
+
+		/** Must be obtained to read or write Deadlines and NextHandle */
+		FCriticalSection DeadlinesLock;
+		TArray<FDeadline> Deadlines;
+		FHandle NextHandle = INVALID_HANDLE + 1;
+
+		/** Triggered when a new deadline is armed or when the thread is stopping, so the thread can recompute how long to wait */
+		FEvent* WakeUpEvent = nullptr;
+		std::atomic_bool bIsStopping = false;
+		FRunnableThread* Thread = nullptr;
+	};
+}
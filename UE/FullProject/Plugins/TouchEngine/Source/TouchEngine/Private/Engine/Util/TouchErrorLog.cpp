@@ -32,6 +32,16 @@ namespace UE::TouchEngine
 	{
 	}
 
+	void FTouchErrorLog::SetComponent(TWeakObjectPtr<UTouchEngineComponentBase> InComponent)
+	{
+		check(IsInGameThread());
+		if (Component != InComponent)
+		{
+			Component = InComponent;
+			bWasLogOpened = false; // The new component gets its own page in the message log
+		}
+	}
+
 	void FTouchErrorLog::AddResult(const FString& ResultString, TEResult Result, const FString& VarName, const FName& FunctionName, const FString& AdditionalDescription)
 	{
 		const FString Message = ResultString + " " + TEResultGetDescription(Result);
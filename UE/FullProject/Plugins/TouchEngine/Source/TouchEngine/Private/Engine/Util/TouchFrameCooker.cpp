@@ -17,6 +17,7 @@
 #include "Logging.h"
 #include "Engine/TEDebug.h"
 #include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchCookRecorder.h"
 #include "Engine/Util/TouchErrorLog.h"
 #include "Engine/Util/TouchVariableManager.h"
 #include "Rendering/TouchResourceProvider.h"
@@ -24,6 +25,7 @@
 #include "TouchEngine/TEInstance.h"
 #include "TouchEngine/TEResult.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -46,7 +48,7 @@ namespace UE::TouchEngine
 		CancelCurrentAndNextCooks();
 	}
 
-	TFuture<FCookFrameResult> FTouchFrameCooker::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
+	TFuture<FCookFrameResult> FTouchFrameCooker::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 InMaxCooksInFlight)
 	{
 		check(IsInGameThread());
 
@@ -57,34 +59,16 @@ namespace UE::TouchEngine
 		}
 		
 		FPendingFrameCook PendingCook { MoveTemp(CookFrameRequest) };
-		TFuture<FCookFrameResult> Future = PendingCook.PendingCookPromise.GetFuture().Next([WeakThis = AsWeak()](FCookFrameResult Result)
-		{
-			// Here we mark each input texture as not being used by the current cook so they can be reused
-			if (TSharedPtr<FTouchFrameCooker> This = WeakThis.Pin())
-			{
-				FScopeLock Lock(&This->PendingFrameMutex);
-				if (This->InProgressFrameCook)
-				{
-					for (const TPair<FString, FTouchEngineDynamicVariableStruct>& Var : This->InProgressFrameCook->VariablesToSend)
-					{
-						const FTouchEngineDynamicVariableStruct& DynVar = Var.Value;
-						if (DynVar.VarType != EVarType::Texture)
-						{
-							continue;
-						}
-						if (TSharedPtr<FExportedTouchTexture> Texture = DynVar.GetExportedTexture())
-						{
-							Texture->bIsUsedInCurrentCook = false;
-						}
-					}
-					This->InProgressFrameCook->VariablesToSend.Reset();
-				}
-			}
-			return Result;
-		});
+		PendingCook.JobCreationTime = Clock();
+		TFuture<FCookFrameResult> Future = PendingCook.PendingCookPromise.GetFuture();
 
 		{
 			FScopeLock Lock(&PendingFrameMutex);
+			if (CookRecorder)
+			{
+				CookRecorder->RecordRequest(PendingCook, InputBufferLimit, InMaxCooksInFlight);
+			}
+			MaxCooksInFlight = FMath::Max(1, InMaxCooksInFlight);
 			EnqueueCookFrame(MoveTemp(PendingCook), InputBufferLimit);
 			++NextFrameID; // We increase the next cook number as soon as we have enqueued the previous set of inputs.
 			ExecuteNextPendingCookFrame_GameThread(Lock);
@@ -108,7 +92,12 @@ namespace UE::TouchEngine
 		FScopeLock Lock(&PendingFrameMutex);
 		if (ensure(InProgressCookResult))
 		{
+			UE_TRACE_TOUCHENGINE_COOK_EVENT(FrameFinishedInTouchEngine, InProgressCookResult->FrameData.FrameID);
 			InProgressCookResult->bWasFrameDropped = bInWasFrameDropped && FrameLastUpdated > -1; // if it is the first frame, we cannot consider it dropped
+			if (InProgressCookResult->bWasFrameDropped)
+			{
+				INC_TOUCHENGINE_STAT(STAT_TE_Cook_NbDroppedFrames, NbDroppedFrames);
+			}
 			if (CookResult == ECookFrameResult::Success && !InProgressCookResult->bWasFrameDropped) // if the cook was successful and the frame not dropped, we update the FrameLastUpdated
 			{
 				FrameLastUpdated = InProgressCookResult->FrameData.FrameID;
@@ -140,7 +129,8 @@ namespace UE::TouchEngine
 		while (!PendingCookQueue.IsEmpty())
 		{
 			FPendingFrameCook NextFrameCook = PendingCookQueue.Pop();
-			NextFrameCook.PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(NextFrameCook, ECookFrameResult::Cancelled, FrameLastUpdated));
+			INC_TOUCHENGINE_STAT(STAT_TE_Cook_NbCancelled, NbCancelledCooks);
+			SetCookResult(NextFrameCook, FCookFrameResult::FromCookFrameRequest(NextFrameCook, ECookFrameResult::Cancelled, FrameLastUpdated));
 		}
 	}
 
@@ -149,6 +139,7 @@ namespace UE::TouchEngine
 		FScopeLock Lock(&PendingFrameMutex);
 		if (InProgressFrameCook && (InProgressFrameCook->FrameData.FrameID == FrameID || FrameID < 0))
 		{
+			INC_TOUCHENGINE_STAT(STAT_TE_Cook_NbCancelled, NbCancelledCooks);
 			//if we still have a cook result, that means that we haven't set the promise yet, so we check if this is the frame we are supposed to cancel
 			if (InProgressCookResult)
 			{
@@ -157,7 +148,7 @@ namespace UE::TouchEngine
 
 			if (InProgressFrameCook->bWasJobSentToTouchEngine)
 			{
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceCancelFrame(TEInstance: '%p') [Thread: '%s', CookingFrame '%lld']"),
+				UE_LOG_TE_CALL(Log, TEXT("  TEInstanceCancelFrame(TEInstance: '%p') [Thread: '%s', CookingFrame '%lld']"),
 					TouchEngineInstance.get(),
 					*GetCurrentThreadStr(),
 					FrameID
@@ -182,7 +173,7 @@ namespace UE::TouchEngine
 	bool FTouchFrameCooker::CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds)
 	{
 		FScopeLock Lock(&PendingFrameMutex);
-		if (InProgressFrameCook && (FDateTime::Now() - InProgressFrameCook->JobCreationTime).GetTotalSeconds() >= CookTimeoutInSeconds) // we check if the frame Timed-out
+		if (InProgressFrameCook && Clock() - InProgressFrameCook->JobCreationTime >= CookTimeoutInSeconds) // we check if the frame Timed-out
 		{
 			const int64 FrameID = InProgressFrameCook->FrameData.FrameID;
 			CancelCurrentFrame_GameThread(FrameID, ECookFrameResult::TouchEngineCookTimeout);
@@ -211,6 +202,7 @@ namespace UE::TouchEngine
 		VariableManager.AllocateLinkedTop(ParamId); // Avoid system querying this param from generating an output error
 
 		const FTouchImportParameters LinkParams{ TouchEngineInstance, ParamId, Texture, InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameData : FTouchEngineInputFrameData() };
+		UE_TRACE_TOUCHENGINE_COOK_EVENT(ImportStarted, LinkParams.FrameData.FrameID, ParamId);
 		
 		// below calls FTouchTextureImporter::ImportTexture_AnyThread for DX12
 		const TSharedRef<FTouchFrameCooker> This = SharedThis(this);
@@ -225,6 +217,7 @@ namespace UE::TouchEngine
 					UE_LOG(LogTouchEngine, Verbose, TEXT("[ImportTextureToUnrealEngine_AnyThread.Next[%s]] Calling `UpdateLinkedTOP` for Identifier `%s` for frame %lld"),
 						*GetCurrentThreadStr(), *ParamId.ToString(), FrameID)
 					ExistingTextureToBePooled = VariableManager.UpdateLinkedTOP(ParamId, Texture);
+					UE_TRACE_TOUCHENGINE_COOK_EVENT(ImportLinked, FrameID, ParamId);
 				}
 				else if (TouchLinkResult.ResultType == EImportResultType::Failure && GDynamicRHI->GetInterfaceType() == ERHIInterfaceType::Vulkan
 					&& VariableManager.GetErrorLog()) // todo: For UE 5.6, Vulkan Textures are not supported
@@ -239,6 +232,12 @@ namespace UE::TouchEngine
 			});
 	}
 
+	void FTouchFrameCooker::SetCookRecorder(TSharedPtr<FTouchCookRecorder> InCookRecorder)
+	{
+		FScopeLock Lock(&PendingFrameMutex);
+		CookRecorder = MoveTemp(InCookRecorder);
+	}
+
 	void FTouchFrameCooker::ResetTouchEngineInstance()
 	{
 		TouchEngineInstance.reset();
@@ -247,28 +246,33 @@ namespace UE::TouchEngine
 	void FTouchFrameCooker::EnqueueCookFrame(FPendingFrameCook&& CookRequest, int32 InputBufferLimit)
 	{
 		InputBufferLimit = FMath::Max(1, InputBufferLimit);
+		UE_TRACE_TOUCHENGINE_COOK_EVENT(CookEnqueued, CookRequest.FrameData.FrameID);
 		UE_LOG(LogTouchEngine, Log, TEXT("[EnqueueCookFrame[%s]] Enqueuing Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
 			*GetCurrentThreadStr(), CookRequest.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit)
 		
+		// The capacity only grows, a lower InputBufferLimit is enforced by the loop below
+		PendingCookQueue.EnsureCapacity(InputBufferLimit);
+		
 		// here we remove one more item than the buffer limit as we are going to add the given CookRequest
 		while (!PendingCookQueue.IsEmpty() && PendingCookQueue.Num() >= InputBufferLimit)
 		{
 			FPendingFrameCook CookToCancel = PendingCookQueue.Pop();
+			INC_TOUCHENGINE_STAT(STAT_TE_Cook_NbMerged, NbMergedCooks);
 			UE_LOG(LogTouchEngine, Log, TEXT("[EnqueueCookFrame[%s]]   Cancelling Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
 				*GetCurrentThreadStr(), CookToCancel.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit)
 
 			// Before dropping the inputs, we are trying to merge them with the next set of inputs,
 			// which will end up sending them to TE unless they are being set by the next set of inputs
-			FPendingFrameCook& NextFutureCook = PendingCookQueue.IsEmpty() ? CookRequest : PendingCookQueue.Last();
+			FPendingFrameCook& NextFutureCook = PendingCookQueue.IsEmpty() ? CookRequest : PendingCookQueue.Peek();
 			for (TPair<FString, FTouchEngineDynamicVariableStruct>& Variable : CookToCancel.VariablesToSend)
 			{
 				NextFutureCook.VariablesToSend.FindOrAdd(Variable.Key, MoveTemp(Variable.Value));
 			}
 			
-			CookToCancel.PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(CookToCancel, ECookFrameResult::InputsDiscarded, FrameLastUpdated));
+			SetCookResult(CookToCancel, FCookFrameResult::FromCookFrameRequest(CookToCancel, ECookFrameResult::InputsDiscarded, FrameLastUpdated));
 		}
 		
-		PendingCookQueue.Insert(MoveTemp(CookRequest), 0); // We enqueue at the start so we can easily use Pop to get the last element
+		PendingCookQueue.Push(MoveTemp(CookRequest));
 	}
 
 	bool FTouchFrameCooker::ExecuteNextPendingCookFrame_GameThread()
@@ -279,13 +283,16 @@ namespace UE::TouchEngine
 
 	bool FTouchFrameCooker::ExecuteNextPendingCookFrame_GameThread(FScopeLock& PendingFrameMutexLock)
 	{
-		if (InProgressFrameCook || PendingCookQueue.IsEmpty())
+		// TouchEngine only cooks one frame at a time, but we can start the next one while previous results are still being processed by the user
+		if (InProgressFrameCook || PendingCookQueue.IsEmpty() || NumCooksAwaitingRelease >= MaxCooksInFlight)
 		{
 			return false;
 		}
 		
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.B [GT] Cook Frame"), STAT_TE_I_B, STATGROUP_TouchEngine);
 		FPendingFrameCook CookRequest = PendingCookQueue.Pop();
+		UE_TRACE_TOUCHENGINE_COOK_EVENT(CookStarted, CookRequest.FrameData.FrameID);
+		SET_TOUCHENGINE_CYCLE_STAT(STAT_TE_Cook_TimeQueued, LastCookTimeQueued, Clock() - CookRequest.JobCreationTime);
 
 		UE_LOG(LogTouchEngine, Log, TEXT("  --------- [FTouchFrameCooker::ExecuteCurrentCookFrame[%s]] Executing the cook for the frame %lld [Requested during frame %lld, Queue: %d cooks waiting] ---------"),
 		       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID, GetNextFrameID() - 1, PendingCookQueue.Num())
@@ -323,6 +330,7 @@ namespace UE::TouchEngine
 		InProgressCookResult->FrameData = CookRequest.FrameData;
 
 		InProgressFrameCook = MoveTemp(CookRequest);
+		ArmCookTimeout();
 
 		InputsSentFuture.Next([WeakThis = AsWeak(), FrameData = InProgressCookResult->FrameData](auto) mutable // This can execute on AnyThread
 		{
@@ -342,7 +350,7 @@ namespace UE::TouchEngine
 				{
 					return;
 				}
-				This->InProgressFrameCook->JobStartTime = FDateTime::Now();
+				This->InProgressFrameCook->JobStartTime = FPlatformTime::Seconds();
 				This->InProgressFrameCook->bWasJobSentToTouchEngine = true;
 
 				switch (This->TimeMode)
@@ -351,13 +359,14 @@ namespace UE::TouchEngine
 					{
 						Lock.Unlock(); // This is unlocked before calling TEInstanceStartFrameAtTime in case for whatever reason it finishes cooking the frame instantly. That would cause a deadlock.
 
-						UE_LOG(LogTouchEngineTECalls, Log, TEXT("==== Calling TEInstanceStartFrameAtTime(TEInstance: '%p', time_value: '%d',  time_scale '%d', discontinuity 'false') [Thread: '%s', TimeMode: 'TETimeInternal', CookingFrame '%lld']"),
+						UE_LOG_TE_CALL(Log, TEXT("==== Calling TEInstanceStartFrameAtTime(TEInstance: '%p', time_value: '%d',  time_scale '%d', discontinuity 'false') [Thread: '%s', TimeMode: 'TETimeInternal', CookingFrame '%lld']"),
 							This->TouchEngineInstance.get(),
 							0,
 							0,
 							*GetCurrentThreadStr(),
 							FrameData.FrameID
 						)
+						UE_TRACE_TOUCHENGINE_COOK_EVENT(FrameStartedInTouchEngine, FrameData.FrameID);
 						Result = TEInstanceStartFrameAtTime(This->TouchEngineInstance, 0, 0, false);
 						UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Error, TEXT("TEInstanceStartFrameAtTime[%s] (TETimeInternal) for frame `%lld`:  Time: %d  TimeScale: %d => %s (`%hs`)"), *GetCurrentThreadStr(), FrameData.FrameID, 0, 0, *TEResultToString(Result), TEResultGetDescription(Result));
 						break;
@@ -372,13 +381,14 @@ namespace UE::TouchEngine
 						int64 TimeScale = This->InProgressFrameCook->TimeScale;
 						Lock.Unlock(); // This is unlocked before calling TEInstanceStartFrameAtTime in case for whatever reason it finishes cooking the frame instantly. That would cause a deadlock.
 
-						UE_LOG(LogTouchEngineTECalls, Log, TEXT("==== Calling TEInstanceStartFrameAtTime(TEInstance: '%p', time_value: '%lld',  time_scale '%lld', discontinuity 'false') [Thread: '%s', TimeMode: 'TETimeExternal', CookingFrame '%lld']"),
+						UE_LOG_TE_CALL(Log, TEXT("==== Calling TEInstanceStartFrameAtTime(TEInstance: '%p', time_value: '%lld',  time_scale '%lld', discontinuity 'false') [Thread: '%s', TimeMode: 'TETimeExternal', CookingFrame '%lld']"),
 							This->TouchEngineInstance.get(),
 							EngineTime,
 							TimeScale,
 							*GetCurrentThreadStr(),
 							FrameData.FrameID
 						)
+						UE_TRACE_TOUCHENGINE_COOK_EVENT(FrameStartedInTouchEngine, FrameData.FrameID);
 						Result = TEInstanceStartFrameAtTime(This->TouchEngineInstance, EngineTime, TimeScale, false);
 						UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Error, TEXT("TEInstanceStartFrameAtTime[%s] (TETimeExternal) for frame `%lld`:  Time: %lld  TimeScale: %lld => %s (`%hs`)"), *GetCurrentThreadStr(), FrameData.FrameID, This->AccumulatedTime, TimeScale, *TEResultToString(Result), TEResultGetDescription(Result));
 						break;
@@ -405,26 +415,111 @@ namespace UE::TouchEngine
 		return true;
 	}
 
+	void FTouchFrameCooker::SetCookResult(FPendingFrameCook& PendingCook, FCookFrameResult&& CookResult)
+	{
+		if (CookRecorder)
+		{
+			CookRecorder->RecordResult(CookResult);
+		}
+		PendingCook.PendingCookPromise.SetValue(MoveTemp(CookResult));
+	}
+
+	void FTouchFrameCooker::ArmCookTimeout()
+	{
+		if (!InProgressFrameCook || InProgressFrameCook->CookTimeoutInSeconds <= 0.0)
+		{
+			return;
+		}
+
+		FTouchDeadlineTimer* Timer = FTouchDeadlineTimer::Get();
+		if (!Timer) // The module is shutting down
+		{
+			return;
+		}
+
+		// The deadline is watched by the timer thread and the cook is cancelled on the next GameThread task processing, without waiting for the component to tick
+		// The timer has its own clock, so only the time left is carried over
+		const double Deadline = Timer->Now() + InProgressFrameCook->JobCreationTime + InProgressFrameCook->CookTimeoutInSeconds - Clock();
+		InProgressFrameCook->TimeoutHandle = Timer->Arm(Deadline, [WeakThis = AsWeak(), FrameID = InProgressFrameCook->FrameData.FrameID](FTouchDeadlineTimer::FHandle)
+		{
+			if (const TSharedPtr<FTouchFrameCooker> SharedThis = WeakThis.Pin())
+			{
+				UE_LOG(LogTouchEngine, Log, TEXT("[FTouchFrameCooker::ArmCookTimeout[%s]] Cook for frame %lld reached its deadline"), *GetCurrentThreadStr(), FrameID)
+				SharedThis->CancelCurrentFrame_GameThread(FrameID, ECookFrameResult::TouchEngineCookTimeout);
+			}
+		});
+	}
+
+	void FTouchFrameCooker::StartNextPendingCookIfAllowed()
+	{
+		// Called with PendingFrameMutex locked from any thread, so the cook is started from GameThread like every other cook
+		if (!InProgressFrameCook && NumCooksAwaitingRelease < MaxCooksInFlight && !PendingCookQueue.IsEmpty())
+		{
+			AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]()
+			{
+				if (const TSharedPtr<FTouchFrameCooker> SharedThis = WeakThis.Pin())
+				{
+					SharedThis->ExecuteNextPendingCookFrame_GameThread();
+				}
+			});
+		}
+	}
+
 	void FTouchFrameCooker::FinishCurrentCookFrame_AnyThread()
 	{
 		FScopeLock Lock(&PendingFrameMutex);
 		if (InProgressFrameCook.IsSet())
 		{
 			UE_LOG(LogTouchEngine, Log, TEXT(" === FinishCurrentCookFrame_AnyThread[%s] : =>  %s"), *GetCurrentThreadStr(), *UEnum::GetValueAsString(InProgressCookResult->Result))
-			InProgressCookResult->OnReadyToStartNextCook = MakeShared<TPromise<void>>();
-			InProgressCookResult->OnReadyToStartNextCook->GetFuture().Next([WeakThis = AsWeak(), FrameData = InProgressCookResult->FrameData]()
+			FPendingFrameCook FinishedFrameCook = MoveTemp(InProgressFrameCook.GetValue());
+			if (FTouchDeadlineTimer* Timer = FTouchDeadlineTimer::Get())
+			{
+				Timer->Disarm(FinishedFrameCook.TimeoutHandle);
+			}
+			const double CookEndTime = FPlatformTime::Seconds();
+			SET_TOUCHENGINE_CYCLE_STAT(STAT_TE_Cook_Latency, LastCookLatency, Clock() - FinishedFrameCook.JobCreationTime);
+			if (FinishedFrameCook.JobStartTime >= 0.0)
+			{
+				SET_TOUCHENGINE_CYCLE_STAT(STAT_TE_Cook_TimeInTouchEngine, LastCookTimeInTouchEngine, CookEndTime - FinishedFrameCook.JobStartTime);
+			}
+			FCookFrameResult CookResult = MoveTemp(InProgressCookResult.GetValue());
+			// TouchEngine is done with this frame, so it does not count as cooking anymore. It is only awaiting release until the user has processed its results
+			InProgressFrameCook.Reset();
+			InProgressCookResult.Reset(); // to be sure not to try to set it again if we cancel
+			++NumCooksAwaitingRelease;
+
+			// Here we mark each input texture as not being used by the current cook so they can be reused
+			for (const TPair<FString, FTouchEngineDynamicVariableStruct>& Var : FinishedFrameCook.VariablesToSend)
+			{
+				const FTouchEngineDynamicVariableStruct& DynVar = Var.Value;
+				if (DynVar.VarType != EVarType::Texture)
+				{
+					continue;
+				}
+				if (TSharedPtr<FExportedTouchTexture> Texture = DynVar.GetExportedTexture())
+				{
+					Texture->bIsUsedInCurrentCook = false;
+				}
+			}
+			FinishedFrameCook.VariablesToSend.Reset();
+
+			CookResult.OnReadyToStartNextCook = MakeShared<TPromise<void>>();
+			CookResult.OnReadyToStartNextCook->GetFuture().Next([WeakThis = AsWeak(), FrameData = CookResult.FrameData]()
 			{
 				if (const TSharedPtr<FTouchFrameCooker> SharedThis = WeakThis.Pin())
 				{
 					FScopeLock Lock(&SharedThis->PendingFrameMutex);
-					SharedThis->InProgressFrameCook.Reset();
-					SharedThis->InProgressCookResult.Reset();
+					--SharedThis->NumCooksAwaitingRelease;
 					SharedThis->ResourceProvider.GetTextureImporter().TexturePoolMaintenance(FrameData);
+					// A cook queued because the limit of cooks in flight was reached can start now, without waiting for the next request
+					SharedThis->StartNextPendingCookIfAllowed();
 				}
 			});
-			FCookFrameResult CookResult = MoveTemp(InProgressCookResult.GetValue());
-			InProgressCookResult.Reset(); // to be sure not to try to set it again if we cancel
-			InProgressFrameCook->PendingCookPromise.SetValue(MoveTemp(CookResult));
+
+			// If we are allowed more cooks in flight, TouchEngine can start cooking the next frame while this one is being processed
+			StartNextPendingCookIfAllowed();
+			
+			SetCookResult(FinishedFrameCook, MoveTemp(CookResult));
 		}
 		else
 		{
@@ -433,4 +528,3 @@ namespace UE::TouchEngine
 		}
 	}
 }
-
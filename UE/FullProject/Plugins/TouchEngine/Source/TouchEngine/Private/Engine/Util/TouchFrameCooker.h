@@ -18,13 +18,16 @@
 #include "Async/Future.h"
 #include "Engine/Util/CookFrameData.h"
 #include "Engine/Util/TouchVariableManager.h"
+#include "Engine/Util/TouchDeadlineTimer.h"
 #include "TouchEngine/TEInstance.h"
 #include "TouchEngine/TouchObject.h"
+#include "Util/TouchRingBuffer.h"
 
 class FScopeLock;
 
 namespace UE::TouchEngine
 {
+	class FTouchCookRecorder;
 	class FTouchVariableManager;
 
 	/**
@@ -40,7 +43,11 @@ namespace UE::TouchEngine
 
 		void SetTimeMode(TETimeMode InTimeMode) { TimeMode = InTimeMode; }
 
-		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
+		/**
+		 * @param InputBufferLimit The maximum number of cooks to hold in the queue. The older ones will be cancelled if the queue reach this limit
+		 * @param InMaxCooksInFlight The maximum number of cooks which can have been started and not yet released through FCookFrameResult::OnReadyToStartNextCook
+		 */
+		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 InMaxCooksInFlight = 1);
 		bool ExecuteNextPendingCookFrame_GameThread();
 		/**
 		 * @brief 
@@ -56,7 +63,29 @@ namespace UE::TouchEngine
 		 * @return Returns true if the frame with the GivenID was cancelled
 		 */
 		bool CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameResult CookFrameResult = ECookFrameResult::Cancelled);
+		/**
+		 * Checks if the current cook has been running for longer than the given timeout, and cancels it if so.
+		 * Cooks requested with a CookTimeoutInSeconds are already cancelled automatically when their deadline is reached, without needing to call this function.
+		 */
 		bool CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds);
+		/**
+		 * Blocks the GameThread until the given cook is done or its timeout is reached, and cancels the cook in progress if it timed out.
+		 * The deadline armed for the cook cancels it from a GameThread task, which cannot run while the GameThread waits here, so the timeout is checked before returning.
+		 * @return True if the cook was done before its timeout
+		 */
+		template<typename ResultType>
+		bool WaitForCook_GameThread(const TFuture<ResultType>& CookFuture, double CookTimeoutInSeconds)
+		{
+			if (CookFuture.WaitFor(FTimespan::FromSeconds(CookTimeoutInSeconds)))
+			{
+				return true;
+			}
+			CheckIfCookTimedOut_GameThread(CookTimeoutInSeconds);
+			return false;
+		}
+
+		/** Sets the clock in which the cook timeouts are measured, FPlatformTime::Seconds() by default. Used to time out cooks with a fake clock */
+		void SetClock(FTouchDeadlineTimer::FClock InClock) { Clock = MoveTemp(InClock); }
 
 		/** Returns the FrameID to be used for the next cook. */
 		int64 GetNextFrameID() const { return NextFrameID; }
@@ -68,6 +97,9 @@ namespace UE::TouchEngine
 		/** returns the FrameID of the current cooking frame, or -1 if no frame is cooking */
 		int64 GetCookingFrameID() const { return InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameData.FrameID : -1; }
 
+		/** Records the next cook requests and their results with the given recorder. Pass nullptr to stop recording */
+		void SetCookRecorder(TSharedPtr<FTouchCookRecorder> InCookRecorder);
+
 		void ProcessLinkTextureValueChanged_AnyThread(const char* Identifier);
 		void ResetTouchEngineInstance();
 
@@ -78,10 +110,12 @@ namespace UE::TouchEngine
 		
 		struct FPendingFrameCook : FCookFrameRequest
 		{
-			/* The time at which the job was created */
-			FDateTime JobCreationTime = FDateTime::Now();
-			/* The time at which the job was started by calling TEInstanceStartFrameAtTime. Used to check the Timeout */
-			FDateTime JobStartTime = FDateTime::MinValue();
+			/* The time at which the job was created, in the time of Clock. The cook timeout is counted from this time */
+			double JobCreationTime = -1.0;
+			/* The time at which the job was started by calling TEInstanceStartFrameAtTime, in FPlatformTime::Seconds() */
+			double JobStartTime = -1.0;
+			/* The handle of the deadline armed in FTouchDeadlineTimer to cancel this cook if it times out */
+			FTouchDeadlineTimer::FHandle TimeoutHandle = FTouchDeadlineTimer::INVALID_HANDLE;
 			/* As we are waiting for textures to be available in RenderThread before sending the cook to TE, the cook might not have actually started yet */
 			bool bWasJobSentToTouchEngine = false;
 			TPromise<FCookFrameResult> PendingCookPromise;
@@ -92,6 +126,9 @@ namespace UE::TouchEngine
 		/** The Resource provider is used to handle Texture callbacks */
 		FTouchResourceProvider& ResourceProvider;
 		
+		/** The clock in which JobCreationTime and the cook timeouts are expressed */
+		FTouchDeadlineTimer::FClock Clock = &FPlatformTime::Seconds;
+
 		TETimeMode TimeMode = TETimeInternal;
 		int64 AccumulatedTime = 0;
 
@@ -104,19 +141,34 @@ namespace UE::TouchEngine
 		TOptional<FPendingFrameCook> InProgressFrameCook;
 		/** The cook frame result for the frame in progress, if any. */
 		TOptional<FCookFrameResult> InProgressCookResult;
+		/** The number of cooks finished by TouchEngine for which OnReadyToStartNextCook has not been called yet. */
+		int32 NumCooksAwaitingRelease = 0;
+		/** The maximum number of cooks allowed in flight, including the cook in progress and the ones awaiting release. 1 means the cooks are fully serialized. */
+		int32 MaxCooksInFlight = 1;
 		
-		/** The next frame cooks to execute after InProgressFrameCook is done. Implemented as Array to have access to size and keep FPendingFrameCook.Promise not shared*/
-		TArray<FPendingFrameCook> PendingCookQueue;
-		FCriticalSection PendingCookQueueMutex;
+		/**
+		 * The next frame cooks to execute after InProgressFrameCook is done, oldest first. Must be obtained with PendingFrameMutex.
+		 * Its capacity follows InputBufferLimit so enqueuing and dequeuing never shift or reallocate the pending cooks.
+		 */
+		TTouchRingBuffer<FPendingFrameCook> PendingCookQueue;
+
+		/** Records the requests and results if set. Must be obtained with PendingFrameMutex. */
+		TSharedPtr<FTouchCookRecorder> CookRecorder;
 
 		/**
-		 * Enqueue the given Cook Request to be processed. There should be a lock to PendingCookQueueMutex before calling this function.
+		 * Enqueue the given Cook Request to be processed. There should be a lock to PendingFrameMutex before calling this function.
 		 * @param CookRequest The Request to enqueue
 		 * @param InputBufferLimit The maximum number of cooks to hold in the queue. The older ones will be cancelled if the queue reach this limit
 		 */
 		void EnqueueCookFrame(FPendingFrameCook&& CookRequest, int32 InputBufferLimit);
 		bool ExecuteNextPendingCookFrame_GameThread(FScopeLock& PendingFrameMutexLock);
+		/** Starts the next pending cook on GameThread if no cook is in progress and the limit of cooks in flight allows it. Must be called with PendingFrameMutex locked */
+		void StartNextPendingCookIfAllowed();
+		/** Arms the deadline of the in progress cook if it was requested with a timeout. There should be a lock to PendingFrameMutex before calling this function. */
+		void ArmCookTimeout();
 		void FinishCurrentCookFrame_AnyThread();
+		/** Gives the result to the requester of the cook. There should be a lock to PendingFrameMutex before calling this function. */
+		void SetCookResult(FPendingFrameCook& PendingCook, FCookFrameResult&& CookResult);
 	};
 }
 
@@ -22,6 +22,7 @@
 #include "Rendering/Exporting/TouchExportParams.h"
 
 #include "Engine/TEDebug.h"
+#include "Util/TouchEngineStatsGroup.h"
 #include "Util/TouchHelpers.h"
 #include "Engine/Texture.h"
 
@@ -62,80 +63,21 @@ namespace UE::TouchEngine
 		return ExistingTextureToBePooled;
 	}
 	
-	FTouchEngineCHOP FTouchVariableManager::GetCHOPOutputSingleSample(const FString& Identifier)
+	FTouchEngineCHOPView FTouchVariableManager::GetCHOPOutputView(FTouchLinkHandle Handle)
 	{
-		FTouchEngineCHOP Chop;
-		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputSingleSample)))
+		if (!Handle.IsValid())
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
-			TouchObject<TEFloatBuffer> Buf;
-			const TEResult Result = TEInstanceLinkGetFloatBufferValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, Buf.take());
-			if (Result == TEResultSuccess && Buf != nullptr)
-			{
-				FTouchEngineCHOPChannel& Output = CHOPChannelOutputs.FindOrAdd(Identifier); //todo: to be reviewed, why a FTouchEngineCHOPChannel?
-
-				const int32 ChannelCount = TEFloatBufferGetChannelCount(Buf);
-				const int64 NumSamples = TEFloatBufferGetValueCount(Buf);
-				Chop.Channels.Reserve(ChannelCount);
-
-				double rate = TEFloatBufferGetRate(Buf);
-				if (!TEFloatBufferIsTimeDependent(Buf))
-				{
-					const float* const* Channels = TEFloatBufferGetValues(Buf);
-					const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buf);
-					
-					// Use the channel data here
-					if (NumSamples > 0 && ChannelCount > 0)
-					{
-						for (int i = 0; i < ChannelCount; i++)
-						{
-							Chop.Channels.Add(FTouchEngineCHOPChannel {{Channels[i], static_cast<int>(NumSamples)}, ChannelNames[i]});
-						}
-					}
-				}
-				else //todo: to be reviewed
-				{
-					//length /= rate / MyFrameRate;
-					const float* const* Channels = TEFloatBufferGetValues(Buf);
-					const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buf);
-
-					// Use the channel data here
-					if (NumSamples > 0 && ChannelCount > 0)
-					{
-						Output.Values.Reserve(ChannelCount);
-
-						for (int32 i = 0; i < ChannelCount; i++)
-						{
-							Output.Values.Add(Channels[i][NumSamples - 1]);
-						}
-						Output.Name = ChannelNames[0];
-					}
-					Chop.Channels.Add(Output);
-				}
-			}
-			else if (Result != TEResultSuccess)
-			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkGetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputSingleSample));
-			}
+			return FTouchEngineCHOPView{};
 		}
-
-		return FTouchEngineCHOP{};
-	}
-
-	FTouchEngineCHOP FTouchVariableManager::GetCHOPOutput(const FString& Identifier)
-	{
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputView)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			TouchObject<TEFloatBuffer> Buf = nullptr;
 			const TEResult Result = TEInstanceLinkGetFloatBufferValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, Buf.take());
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetFloatBufferValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkGetFloatBufferValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				Buf.get(),
@@ -145,36 +87,28 @@ namespace UE::TouchEngine
 			
 			if (Result == TEResultSuccess)
 			{
-				FTouchEngineCHOP& Output = CHOPOutputs.FindOrAdd(Identifier);
-
-				const int32_t ChannelCount = TEFloatBufferGetChannelCount(Buf);
-				const uint32_t NumSamples = TEFloatBufferGetValueCount(Buf);
-				const float* const* Channels = TEFloatBufferGetValues(Buf);
-				const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buf);
-				Output.Channels.Empty(ChannelCount);
-				
-				if (TEFloatBufferIsTimeDependent(Buf))
-				{
-				}
-
-				for (int i = 0; i < ChannelCount; i++)
-				{
-					Output.Channels.Add(FTouchEngineCHOPChannel{{Channels[i], static_cast<int>(NumSamples)},  ChannelNames[i]});
-				}
+				INC_TOUCHENGINE_STAT_BY(STAT_TE_CHOP_NbSamplesReceived, NbCHOPSamplesReceived, Buf ? TEFloatBufferGetChannelCount(Buf) * TEFloatBufferGetValueCount(Buf) : 0);
+				FTouchEngineCHOPView& Output = CHOPOutputs.FindOrAdd(Identifier);
+				Output = FTouchEngineCHOPView(MoveTemp(Buf));
 				return Output;
 			}
 			else
 			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkGetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutput));
+				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkGetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputView));
 			}
 		}
-		return FTouchEngineCHOP{};
+		return FTouchEngineCHOPView{};
 	}
 
-	UTexture2D* FTouchVariableManager::GetTOPOutput(const FString& Identifier)
+	UTexture2D* FTouchVariableManager::GetTOPOutput(FTouchLinkHandle Handle)
 	{
+		if (!Handle.IsValid())
+		{
+			return nullptr;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTOPOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTOPOutput)))
 		{
 			FScopeLock Lock(&TOPOutputsLock);
 
@@ -189,17 +123,21 @@ namespace UE::TouchEngine
 		return nullptr;
 	}
 
-	FTouchDATFull FTouchVariableManager::GetTableOutput(const FString& Identifier) const
+	FTouchDATFull FTouchVariableManager::GetTableOutput(FTouchLinkHandle Handle) const
 	{
+		if (!Handle.IsValid())
+		{
+			return FTouchDATFull{};
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		FTouchDATFull DATFull;
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeStringData, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTableOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeStringData, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTableOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			const TEResult Result = TEInstanceLinkGetTableValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, DATFull.TableData.take());
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetTableValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkGetTableValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				DATFull.TableData.get(),
@@ -218,31 +156,29 @@ namespace UE::TouchEngine
 
 	TArray<FString> FTouchVariableManager::GetCHOPChannelNames(const FString& Identifier) const
 	{
-		if (const FTouchEngineCHOP* FullChop = CHOPOutputs.Find(Identifier))
+		if (const FTouchEngineCHOPView* FullChop = CHOPOutputs.Find(Identifier))
 		{
-			TArray<FString> RetVal;
-			RetVal.Reserve(FullChop->Channels.Num());
-			for (int32 i = 0; i < FullChop->Channels.Num(); i++)
-			{
-				RetVal.Add(FullChop->Channels[i].Name);
-			}
-			return RetVal;
+			return FullChop->GetChannelNames();
 		}
 
 		return TArray<FString>();
 	}
 
-	bool FTouchVariableManager::GetBooleanOutput(const FString& Identifier)
+	bool FTouchVariableManager::GetBooleanOutput(FTouchLinkHandle Handle)
 	{
+		if (!Handle.IsValid())
+		{
+			return bool{};
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		bool c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetBooleanOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetBooleanOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			const TEResult Result = TEInstanceLinkGetBooleanValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, &c);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetBooleanValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkGetBooleanValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				&c,
@@ -259,17 +195,21 @@ namespace UE::TouchEngine
 		return c;
 	}
 
-	double FTouchVariableManager::GetDoubleOutput(const FString& Identifier)
+	double FTouchVariableManager::GetDoubleOutput(FTouchLinkHandle Handle)
 	{
+		if (!Handle.IsValid())
+		{
+			return double{};
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		double c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetDoubleOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetDoubleOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			const TEResult Result = TEInstanceLinkGetDoubleValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, &c, 1);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetDoubleValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p', count: '1') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkGetDoubleValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p', count: '1') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				&c,
@@ -286,17 +226,21 @@ namespace UE::TouchEngine
 		return c;
 	}
 
-	int32_t FTouchVariableManager::GetIntegerOutput(const FString& Identifier)
+	int32_t FTouchVariableManager::GetIntegerOutput(FTouchLinkHandle Handle)
 	{
+		if (!Handle.IsValid())
+		{
+			return int32_t{};
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		int32_t c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetIntegerOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetIntegerOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			const TEResult Result = TEInstanceLinkGetIntValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, &c, 1);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetIntValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p', count: '1') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkGetIntValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', value: '%p', count: '1') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				&c,
@@ -313,17 +257,21 @@ namespace UE::TouchEngine
 		return c;
 	}
 
-	TouchObject<TEString> FTouchVariableManager::GetStringOutput(const FString& Identifier)
+	TouchObject<TEString> FTouchVariableManager::GetStringOutput(FTouchLinkHandle Handle)
 	{
+		if (!Handle.IsValid())
+		{
+			return TouchObject<TEString>{};
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TEString> c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeString, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetStringOutput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeOutput, TELinkTypeString, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetStringOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			const TEResult Result = TEInstanceLinkGetStringValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, c.take());
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetStringValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', string: '%p') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkGetStringValue(TEInstance: '%p', identifier: '%hs', which: 'TELinkValueCurrent', string: '%p') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				c.get(),
@@ -341,161 +289,162 @@ namespace UE::TouchEngine
 	}
 	
 
-	void FTouchVariableManager::SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel)
+	void FTouchVariableManager::SetCHOPInputSingleSample(FTouchLinkHandle Handle, const FTouchEngineCHOPChannel& CHOPChannel)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
-			TArray<const float*> DataPointers {CHOPChannel.Values.GetData()};
-
-			TouchObject<TEFloatBuffer> Buf;
-			Buf.take(TEFloatBufferCreate(-1.f, CHOPChannel.Values.Num(), 1, nullptr));
-			const void* NullPointer = nullptr;
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEFloatBufferCreate(rate: '%f', channels: '%d', capacity: '%d', names: '%p') [Thread: '%s'] => Returned: '%p'"),
-				-1.f,
-				CHOPChannel.Values.Num(),
-				1,
-				NullPointer,
-				*GetCurrentThreadStr(),
-				Buf.get()
-			);
-
-			TEResult Result = TEFloatBufferSetValues(Buf, DataPointers.GetData(), 1);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEFloatBufferSetValues(TEFloatBuffer: '%p', values: '%p', count: '1') [Thread: '%s'] => Returned: '%s'"),
-				Buf.get(),
-				DataPointers.GetData(),
-				*GetCurrentThreadStr(),
-				*TEResultToString(Result)
-			);
-			
-			if (Result != TEResultSuccess)
+			// Each value is sent as its own channel holding a single sample
+			TArray<const float*, TInlineAllocator<64>> DataPointers;
+			DataPointers.Reserve(CHOPChannel.Values.Num());
+			for (const float& Value : CHOPChannel.Values)
 			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample));
-				return;
+				DataPointers.Add(&Value);
 			}
-			
-			Result = TEInstanceLinkAddFloatBuffer(TouchEngineInstance, IdentifierAsCStr, Buf);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkAddFloatBuffer(TEInstance: '%p', identifier: '%hs', TEFloatBuffer: '%p') [Thread: '%s'] => Returned: '%s'"),
-				TouchEngineInstance.get(),
-				IdentifierAsCStr,
-				Buf.get(),
-				*GetCurrentThreadStr(),
-				*TEResultToString(Result)
-			);
 
-			if (Result != TEResultSuccess)
-			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample),
-					TEXT("Unable to append buffer values"));
-			}
+			SendFloatBufferInput(Handle, DataPointers, 1, {}, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample));
 		}
-
 	}
 
-	void FTouchVariableManager::SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP)
+	void FTouchVariableManager::SetCHOPInput(FTouchLinkHandle Handle, const FTouchEngineCHOP& CHOP)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
-			int32 Capacity = CHOP.Channels.IsEmpty() ? 0 : CHOP.Channels[0].Values.Num();
+			const int32 Capacity = CHOP.Channels.IsEmpty() ? 0 : CHOP.Channels[0].Values.Num();
 
-			bool bAreAllChannelNamesEmpty = true;
-			TArray<std::string> ChannelNamesANSI; // Store as temporary string to keep a reference until the buffer is created
-			TArray<const char*> ChannelNames;
-			TArray<const float*> DataPointers;
-			ChannelNamesANSI.Reserve(CHOP.Channels.Num());
-			ChannelNames.Reserve(CHOP.Channels.Num());
+			TArray<const float*, TInlineAllocator<64>> DataPointers;
 			DataPointers.Reserve(CHOP.Channels.Num());
-			
-			for (int i = 0; i < CHOP.Channels.Num(); i++)
+			for (const FTouchEngineCHOPChannel& Channel : CHOP.Channels)
 			{
-				if (CHOP.Channels[i].Values.Num() != Capacity) //CHOP is not valid
+				if (Channel.Values.Num() != Capacity) //CHOP is not valid
 				{
-					Capacity = -1;
-					break;
+					ErrorLog->AddError(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput),
+						TEXT("The given CHOP is not valid."));
+					return;
 				}
-				const FString& ChannelName = CHOP.Channels[i].Name;
-				bAreAllChannelNamesEmpty &= ChannelName.IsEmpty();
-			
-				auto ChannelNameANSI = StringCast<ANSICHAR>(*ChannelName);
-				std::string ChannelNameString(ChannelNameANSI.Get());
+				DataPointers.Add(Channel.Values.GetData());
+			}
 
-				const int32 Index = ChannelNamesANSI.Emplace(ChannelNameString);
-				ChannelNames.Emplace(ChannelName.IsEmpty() ? nullptr : ChannelNamesANSI[Index].c_str());
+			SendFloatBufferInput(Handle, DataPointers, Capacity, CHOP.Channels, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput));
+		}
+	}
 
-				DataPointers.Add(CHOP.Channels[i].Values.GetData());
-			}
+	void FTouchVariableManager::SendFloatBufferInput(FTouchLinkHandle Handle, TArrayView<const float*> DataPointers, int32 Capacity, TConstArrayView<FTouchEngineCHOPChannel> NamedChannels, const FName& FunctionName)
+	{
+		check(IsInGameThread());
+		const FString& Identifier = GetLinkIdentifier(Handle);
+		const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
+		FCachedLinkInfo& CachedLink = CachedLinkInfos[Handle.Index];
+		const int32 ChannelCount = DataPointers.Num();
+
+		bool bHasSameLayout = CachedLink.InputFloatBuffer
+			&& TEFloatBufferGetChannelCount(CachedLink.InputFloatBuffer) == ChannelCount
+			&& TEFloatBufferGetCapacity(CachedLink.InputFloatBuffer) == static_cast<uint32>(Capacity)
+			&& CachedLink.InputChannelNames.Num() == NamedChannels.Num();
+		for (int32 Index = 0; bHasSameLayout && Index < NamedChannels.Num(); ++Index)
+		{
+			bHasSameLayout = CachedLink.InputChannelNames[Index].Equals(NamedChannels[Index].Name, ESearchCase::CaseSensitive);
+		}
 
-			if (Capacity == -1)
+		if (!bHasSameLayout)
+		{
+			bool bAreAllChannelNamesEmpty = true;
+			CachedLink.InputChannelNames.Reset(NamedChannels.Num());
+			TArray<std::string> ChannelNamesANSI; // Store as temporary string to keep a reference until the buffer is created
+			TArray<const char*> ChannelNames;
+			ChannelNamesANSI.Reserve(NamedChannels.Num());
+			ChannelNames.Reserve(NamedChannels.Num());
+			for (const FTouchEngineCHOPChannel& Channel : NamedChannels)
 			{
-				ErrorLog->AddError(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput),
-						TEXT("The given CHOP is not valid."));
-				return;
+				bAreAllChannelNamesEmpty &= Channel.Name.IsEmpty();
+				CachedLink.InputChannelNames.Add(Channel.Name);
+
+				const int32 Index = ChannelNamesANSI.Emplace(StringCast<ANSICHAR>(*Channel.Name).Get());
+				ChannelNames.Emplace(Channel.Name.IsEmpty() ? nullptr : ChannelNamesANSI[Index].c_str());
 			}
+			const char* const* Names = bAreAllChannelNamesEmpty ? nullptr : ChannelNames.GetData();
 
-			const TouchObject<TEFloatBuffer> Buffer = TouchObject<TEFloatBuffer>::make_take(TEFloatBufferCreate(-1.f, CHOP.Channels.Num(), Capacity, bAreAllChannelNamesEmpty ? nullptr : ChannelNames.GetData()));
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEFloatBufferCreate(rate: '%f', channels: '%d', capacity: '%d', names: '%p') [Thread: '%s'] => Returned: '%p'"),
+			CachedLink.InputFloatBuffer.take(TEFloatBufferCreate(-1.f, ChannelCount, Capacity, Names));
+			UE_LOG_TE_CALL(Log, TEXT("  TEFloatBufferCreate(rate: '%f', channels: '%d', capacity: '%d', names: '%p') [Thread: '%s'] => Returned: '%p'"),
 				-1.f,
-				CHOP.Channels.Num(),
-				Capacity,
-				bAreAllChannelNamesEmpty ? nullptr : ChannelNames.GetData(),
-				*GetCurrentThreadStr(),
-				Buffer.get()
-			);
-			TEResult Result = TEFloatBufferSetValues(Buffer, DataPointers.GetData(), Capacity);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEFloatBufferSetValues(TEFloatBuffer: '%p', values: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
-				Buffer.get(),
-				DataPointers.GetData(),
+				ChannelCount,
 				Capacity,
+				Names,
 				*GetCurrentThreadStr(),
-				*TEResultToString(Result)
+				CachedLink.InputFloatBuffer.get()
 			);
-
-			if (Result != TEResultSuccess)
+			if (!CachedLink.InputFloatBuffer)
 			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput));
+				CachedLink.InputChannelNames.Reset();
+				ErrorLog->AddError(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Identifier, FunctionName, TEXT("Unable to create the buffer"));
 				return;
 			}
-			
-			Result = TEInstanceLinkAddFloatBuffer(TouchEngineInstance, IdentifierAsCStr, Buffer);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkAddFloatBuffer(TEInstance: '%p', identifier: '%hs', TEFloatBuffer: '%p') [Thread: '%s'] => Returned: '%s'"),
-				TouchEngineInstance.get(),
-				IdentifierAsCStr,
-				Buffer.get(),
-				*GetCurrentThreadStr(),
-				*TEResultToString(Result)
-			);
+		}
 
-			if (Result != TEResultSuccess)
-			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput),
-					TEXT("Unable to append buffer values"));
-			}
+		TEResult Result = TEFloatBufferSetValues(CachedLink.InputFloatBuffer, DataPointers.GetData(), Capacity);
+		UE_LOG_TE_CALL(Log, TEXT("  TEFloatBufferSetValues(TEFloatBuffer: '%p', values: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
+			CachedLink.InputFloatBuffer.get(),
+			DataPointers.GetData(),
+			Capacity,
+			*GetCurrentThreadStr(),
+			*TEResultToString(Result)
+		);
+
+		if (Result != TEResultSuccess)
+		{
+			ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, FunctionName);
+			return;
 		}
+
+		// Required even though the same buffer is sent every frame, for TouchEngine to pick up the new values
+		Result = TEInstanceLinkSetFloatBufferValue(TouchEngineInstance, IdentifierAsCStr, CachedLink.InputFloatBuffer);
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetFloatBufferValue(TEInstance: '%p', identifier: '%hs', TEFloatBuffer: '%p') [Thread: '%s'] => Returned: '%s'"),
+			TouchEngineInstance.get(),
+			IdentifierAsCStr,
+			CachedLink.InputFloatBuffer.get(),
+			*GetCurrentThreadStr(),
+			*TEResultToString(Result)
+		);
+
+		if (Result != TEResultSuccess)
+		{
+			ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, FunctionName,
+				TEXT("Unable to set buffer values"));
+			return;
+		}
+		INC_TOUCHENGINE_STAT_BY(STAT_TE_CHOP_NbSamplesSent, NbCHOPSamplesSent, ChannelCount * Capacity);
 	}
 
-	TFuture<bool> FTouchVariableManager::SetTOPInput(const FString& Identifier, const TSharedPtr<FExportedTouchTexture>& Texture, const FTouchEngineInputFrameData& FrameData)
+	TFuture<bool> FTouchVariableManager::SetTOPInput(FTouchLinkHandle Handle, const TSharedPtr<FExportedTouchTexture>& Texture, const FTouchEngineInputFrameData& FrameData)
 	{
+		if (!Handle.IsValid())
+		{
+			return MakeFulfilledPromise<bool>(false).GetFuture();
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (!GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTOPInput)))
+		if (!GetLinkInfo(Handle, LinkInfo, TEScopeInput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTOPInput)))
 		{
 			return MakeFulfilledPromise<bool>(false).GetFuture();
 		}
 		
 		// Fast path
-		const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-		const char* IdentifierAsCStr = AnsiString.Get();
+		const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 		if (!Texture)
 		{
 			const void* NullPointer = nullptr;
 			const TEResult Result = TEInstanceLinkSetTextureValue(TouchEngineInstance, IdentifierAsCStr, nullptr, ResourceProvider->GetContext());
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetTextureValue(TEInstance: '%p', identifier: '%hs', texture: '%p' ['%s'], context: '%p') [Thread: '%s', Frame: '%lld']  =>  '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetTextureValue(TEInstance: '%p', identifier: '%hs', texture: '%p' ['%s'], context: '%p') [Thread: '%s', Frame: '%lld']  =>  '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				NullPointer,
@@ -529,7 +478,7 @@ namespace UE::TouchEngine
 				
 				{
 					// Logging before the call as the call will generate some texture callbacks and we want to keep the log consistent with the code
-					UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetTextureValue(TEInstance: '%p', identifier: '%hs', texture: '%p' ['%s'], context: '%p') [Thread: '%s', Frame: '%lld']"),
+					UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetTextureValue(TEInstance: '%p', identifier: '%hs', texture: '%p' ['%s'], context: '%p') [Thread: '%s', Frame: '%lld']"),
 						This->TouchEngineInstance.get(),
 						IdentifierAsCStr,
 						ExportedTexture.get(),
@@ -541,7 +490,7 @@ namespace UE::TouchEngine
 					const TEResult Result = TEInstanceLinkSetTextureValue(This->TouchEngineInstance, IdentifierAsCStr, ExportedTexture, This->ResourceProvider->GetContext());
 					
 					const TEResult SetInterestResult = TEInstanceLinkSetInterest(This->TouchEngineInstance, IdentifierAsCStr, TELinkInterestNoValues);
-					UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetInterest(TEInstance: '%p', identifier: '%hs', interest: 'TELinkInterestNoValues') [Thread: '%s', Frame: '%lld']  =>  '%s'"),
+					UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetInterest(TEInstance: '%p', identifier: '%hs', interest: 'TELinkInterestNoValues') [Thread: '%s', Frame: '%lld']  =>  '%s'"),
 						This->TouchEngineInstance.get(),
 						IdentifierAsCStr,
 						*GetCurrentThreadStr(),
@@ -589,16 +538,20 @@ namespace UE::TouchEngine
 		return Future;
 	}
 
-	void FTouchVariableManager::SetBooleanInput(const FString& Identifier, const bool& Op)
+	void FTouchVariableManager::SetBooleanInput(FTouchLinkHandle Handle, const bool& Op)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetBooleanInput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetBooleanInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 
 			const TEResult Result = TEInstanceLinkSetBooleanValue(TouchEngineInstance, IdentifierAsCStr, Op);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetBooleanValue(TEInstance: '%p', identifier: '%hs', value: '%s') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetBooleanValue(TEInstance: '%p', identifier: '%hs', value: '%s') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				Op ? TEXT("True") : TEXT("False"),
@@ -613,13 +566,17 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetDoubleInput(const FString& Identifier, const TArray<double>& Op)
+	void FTouchVariableManager::SetDoubleInput(FTouchLinkHandle Handle, const TArray<double>& Op)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetDoubleInput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetDoubleInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			
 			if (Op.Num() > LinkInfo->count)
 			{
@@ -632,7 +589,7 @@ namespace UE::TouchEngine
 			}
 			
 			const TEResult Result = TEInstanceLinkSetDoubleValue(TouchEngineInstance, IdentifierAsCStr, Op.GetData(), LinkInfo->count);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetDoubleValue(TEInstance: '%p', identifier: '%hs', value: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetDoubleValue(TEInstance: '%p', identifier: '%hs', value: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				Op.GetData(),
@@ -648,13 +605,17 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetIntegerInput(const FString& Identifier, const TArray<int32_t>& Op)
+	void FTouchVariableManager::SetIntegerInput(FTouchLinkHandle Handle, const TArray<int32_t>& Op)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetIntegerInput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetIntegerInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 
 			if (Op.Num() > LinkInfo->count)
 			{
@@ -667,7 +628,7 @@ namespace UE::TouchEngine
 			}
 
 			const TEResult Result = TEInstanceLinkSetIntValue(TouchEngineInstance, IdentifierAsCStr, Op.GetData(), LinkInfo->count);
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetIntValue(TEInstance: '%p', identifier: '%hs', value: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetIntValue(TEInstance: '%p', identifier: '%hs', value: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
 				TouchEngineInstance.get(),
 				IdentifierAsCStr,
 				Op.GetData(),
@@ -683,17 +644,21 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetStringInput(const FString& Identifier, const char*& Op)
+	void FTouchVariableManager::SetStringInput(FTouchLinkHandle Handle, const char*& Op)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetStringInput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetStringInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			if (LinkInfo->type == TELinkTypeString)
 			{
 				const TEResult Result = TEInstanceLinkSetStringValue(TouchEngineInstance, IdentifierAsCStr, Op);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetStringValue(TEInstance: '%p', identifier: '%hs', value: '%p') [Thread: '%s'] => Returned: '%s'"),
+				UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetStringValue(TEInstance: '%p', identifier: '%hs', value: '%p') [Thread: '%s'] => Returned: '%s'"),
 					TouchEngineInstance.get(),
 					IdentifierAsCStr,
 					Op,
@@ -711,12 +676,12 @@ namespace UE::TouchEngine
 			{
 				const TouchObject<TETable> Table = TouchObject<TETable>::make_take(TETableCreate());
 				TETableResize(Table, 1, 1);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TETableResize(TETable: '%p', rows: '1', columns: '1') [Thread: '%s']"),
+				UE_LOG_TE_CALL(Log, TEXT("  TETableResize(TETable: '%p', rows: '1', columns: '1') [Thread: '%s']"),
 					Table.get(),
 					*GetCurrentThreadStr()
 				);
 				TEResult Result = TETableSetStringValue(Table, 0, 0, Op);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TETableSetStringValue(TETable: '%p', row: '0', column: '0', value: '%p') [Thread: '%s'] => Returned: '%s'"),
+				UE_LOG_TE_CALL(Log, TEXT("  TETableSetStringValue(TETable: '%p', row: '0', column: '0', value: '%p') [Thread: '%s'] => Returned: '%s'"),
 					Table.get(),
 					Op,
 					*GetCurrentThreadStr(),
@@ -730,7 +695,7 @@ namespace UE::TouchEngine
 				}
 				
 				Result = TEInstanceLinkSetTableValue(TouchEngineInstance, IdentifierAsCStr, Table);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetTableValue(TEInstance: '%p', identifier: '%hs', TETable: '%p') [Thread: '%s'] => Returned: '%s'"),
+				UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetTableValue(TEInstance: '%p', identifier: '%hs', TETable: '%p') [Thread: '%s'] => Returned: '%s'"),
 					TouchEngineInstance.get(),
 					IdentifierAsCStr,
 					Table.get(),
@@ -751,23 +716,27 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetTableInput(const FString& Identifier, const FTouchDATFull& Op)
+	void FTouchVariableManager::SetTableInput(FTouchLinkHandle Handle, const FTouchDATFull& Op)
 	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+		const FString& Identifier = GetLinkIdentifier(Handle);
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTableInput)))
+		if (GetLinkInfo(Handle, LinkInfo, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTableInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
+			const char* IdentifierAsCStr = GetLinkIdentifierAsCStr(Handle);
 			if (LinkInfo->type == TELinkTypeString)
 			{
 				const char* String = TETableGetStringValue(Op.TableData, 0, 0);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TETableGetStringValue(TETable: '%p', row: '0', column: '0') [Thread: '%s'] => Returned: '%p'"),
+				UE_LOG_TE_CALL(Log, TEXT("  TETableGetStringValue(TETable: '%p', row: '0', column: '0') [Thread: '%s'] => Returned: '%p'"),
 					Op.TableData.get(),
 					*GetCurrentThreadStr(),
 					String
 				);
 				const TEResult Result = TEInstanceLinkSetStringValue(TouchEngineInstance, IdentifierAsCStr, String);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetStringValue(TEInstance: '%p', identifier: '%hs', value: '%p') [Thread: '%s'] => Returned: '%s'"),
+				UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetStringValue(TEInstance: '%p', identifier: '%hs', value: '%p') [Thread: '%s'] => Returned: '%s'"),
 					TouchEngineInstance.get(),
 					IdentifierAsCStr,
 					String,
@@ -784,7 +753,7 @@ namespace UE::TouchEngine
 			else if (LinkInfo->type == TELinkTypeStringData)
 			{
 				const TEResult Result = TEInstanceLinkSetTableValue(TouchEngineInstance, IdentifierAsCStr, Op.TableData);
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetTableValue(TEInstance: '%p', identifier: '%hs', TETable: '%p') [Thread: '%s'] => Returned: '%s'"),
+				UE_LOG_TE_CALL(Log, TEXT("  TEInstanceLinkSetTableValue(TEInstance: '%p', identifier: '%hs', TETable: '%p') [Thread: '%s'] => Returned: '%s'"),
 					TouchEngineInstance.get(),
 					IdentifierAsCStr,
 					Op.TableData.get(),
@@ -833,12 +802,88 @@ namespace UE::TouchEngine
 		}
 	}
 
-	bool FTouchVariableManager::GetLinkInfo(const FString& Identifier, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const
+	FTouchLinkHandle FTouchVariableManager::GetLinkHandle(const FString& Identifier) const
 	{
 		check(IsInGameThread());
+		FScopeLock Lock(&CachedLinkInfosLock);
+		if (const int32* Index = CachedLinkHandles.Find(Identifier))
+		{
+			return FTouchLinkHandle{*Index};
+		}
+
+		FCachedLinkInfo CachedLink{Identifier};
 		const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-		const char* IdentifierAsCStr = AnsiString.Get();
-		const TEResult Result = TEInstanceLinkGetInfo(TouchEngineInstance, IdentifierAsCStr, LinkInfo.take());
+		CachedLink.IdentifierAnsi.Append(AnsiString.Get(), AnsiString.Length() + 1); // including the null terminator
+
+		const int32 Index = CachedLinkInfos.Add(MoveTemp(CachedLink));
+		CachedLinkHandles.Add(Identifier, Index);
+		return FTouchLinkHandle{Index};
+	}
+
+	void FTouchVariableManager::CacheLinkInfos(const TArray<FTouchEngineDynamicVariableStruct>& Variables)
+	{
+		for (const FTouchEngineDynamicVariableStruct& Variable : Variables)
+		{
+			TouchObject<TELinkInfo> LinkInfo;
+			GetCachedLinkInfo(GetLinkHandle(Variable.VarIdentifier), LinkInfo);
+		}
+	}
+
+	void FTouchVariableManager::InvalidateLinkInfo_AnyThread(const char* Identifier)
+	{
+		const FString IdentifierStr(Identifier);
+		FScopeLock Lock(&CachedLinkInfosLock);
+		if (const int32* Index = CachedLinkHandles.Find(IdentifierStr))
+		{
+			CachedLinkInfos[*Index].LinkInfo.reset();
+			++CachedLinkInfos[*Index].Generation;
+		}
+	}
+
+	void FTouchVariableManager::InvalidateAllLinkInfos_AnyThread()
+	{
+		FScopeLock Lock(&CachedLinkInfosLock);
+		for (FCachedLinkInfo& CachedLink : CachedLinkInfos)
+		{
+			CachedLink.LinkInfo.reset();
+			++CachedLink.Generation;
+		}
+	}
+
+	TEResult FTouchVariableManager::GetCachedLinkInfo(FTouchLinkHandle Handle, TouchObject<TELinkInfo>& LinkInfo) const
+	{
+		check(IsInGameThread());
+		INC_TOUCHENGINE_STAT(STAT_TE_LinkInfo_NbLookups, NbLinkInfoLookups);
+		uint32 Generation;
+		{
+			FScopeLock Lock(&CachedLinkInfosLock);
+			LinkInfo = CachedLinkInfos[Handle.Index].LinkInfo;
+			Generation = CachedLinkInfos[Handle.Index].Generation;
+		}
+		if (LinkInfo)
+		{
+			return TEResultSuccess;
+		}
+
+		// The lock is not held while querying TouchEngine, so the link might be invalidated in the meantime
+		INC_TOUCHENGINE_STAT(STAT_TE_LinkInfo_NbCacheMisses, NbLinkInfoCacheMisses);
+		const TEResult Result = TEInstanceLinkGetInfo(TouchEngineInstance, GetLinkIdentifierAsCStr(Handle), LinkInfo.take());
+		if (Result == TEResultSuccess)
+		{
+			FScopeLock Lock(&CachedLinkInfosLock);
+			FCachedLinkInfo& CachedLink = CachedLinkInfos[Handle.Index];
+			if (CachedLink.Generation == Generation) // Otherwise the info we got might predate the invalidation, so it is queried again on next use
+			{
+				CachedLink.LinkInfo = LinkInfo;
+			}
+		}
+		return Result;
+	}
+
+	bool FTouchVariableManager::GetLinkInfo(FTouchLinkHandle Handle, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const
+	{
+		const FString& Identifier = GetLinkIdentifier(Handle);
+		const TEResult Result = GetCachedLinkInfo(Handle, LinkInfo);
 		if (Result == TEResultSuccess && LinkInfo->scope == ExpectedScope && LinkInfo->type == ExpectedType)
 		{
 			return true;
@@ -858,12 +903,10 @@ namespace UE::TouchEngine
 		return false;
 	}
 
-	bool FTouchVariableManager::GetLinkInfo(const FString& Identifier, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, const FName& FunctionName) const
+	bool FTouchVariableManager::GetLinkInfo(FTouchLinkHandle Handle, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, const FName& FunctionName) const
 	{
-		check(IsInGameThread());
-		const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-		const char* IdentifierAsCStr = AnsiString.Get();
-		const TEResult Result = TEInstanceLinkGetInfo(TouchEngineInstance, IdentifierAsCStr, LinkInfo.take());
+		const FString& Identifier = GetLinkIdentifier(Handle);
+		const TEResult Result = GetCachedLinkInfo(Handle, LinkInfo);
 		if (Result == TEResultSuccess && LinkInfo->scope == ExpectedScope)
 		{
 			return true;
@@ -0,0 +1,215 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "ToxParameterCache.h"
+
+#include "Logging.h"
+#include "TouchEngineDynamicVariableStruct.h"
+#include "TouchEngineDynamicVariableStructVersion.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static constexpr uint32 ToxParameterCacheMagic = 0x54584350; // 'TXCP'
+		/** Must be increased every time the layout of the header or the one written by SerializeVariables changes */
+		static constexpr int32 ToxParameterCacheFormatVersion = 2;
+
+		/** The engine versions captured by MakeKey, set from the GameThread and read by the workers loading and saving entries */
+		static FCriticalSection EngineVersionsLock;
+		static FString TouchEngineVersion;
+		static FString TouchDesignerPath;
+
+		static void SerializeVariables(FArchive& Ar, TArray<FTouchEngineDynamicVariableStruct>& Variables)
+		{
+			int32 NumVariables = Variables.Num();
+			Ar << NumVariables;
+			if (Ar.IsLoading())
+			{
+				if (NumVariables < 0 || Ar.IsError())
+				{
+					Ar.SetError();
+					return;
+				}
+				Variables.SetNum(NumVariables);
+			}
+
+			for (FTouchEngineDynamicVariableStruct& Variable : Variables)
+			{
+				// VarScope and ParentIdentifier are not part of Serialize as the component sets them when the tox file is loaded
+				uint8 VarScope = static_cast<uint8>(Variable.VarScope);
+				Ar << VarScope;
+				Variable.VarScope = static_cast<EVarScope>(VarScope);
+				Ar << Variable.ParentIdentifier;
+
+				Variable.Serialize(Ar);
+				Variable.SerializeMetadata(Ar);
+				if (Ar.IsError())
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	FToxParameterCacheKey FToxParameterCache::MakeKey(const FString& AbsoluteToxPath)
+	{
+		FToxParameterCacheKey Key;
+		Key.AbsoluteToxPath = AbsoluteToxPath;
+		Key.ToxHash = FMD5Hash::HashFile(*AbsoluteToxPath);
+
+		FScopeLock Lock(&Private::EngineVersionsLock);
+		Key.TouchEngineVersion = Private::TouchEngineVersion;
+		Key.TouchDesignerPath = Private::TouchDesignerPath;
+		return Key;
+	}
+
+	TOptional<FTouchLoadResult> FToxParameterCache::Load(const FToxParameterCacheKey& Key)
+	{
+		const FString CacheFilePath = GetCacheFilePath(Key);
+		TArray<uint8> Bytes;
+		if (CacheFilePath.IsEmpty() || !FFileHelper::LoadFileToArray(Bytes, *CacheFilePath, FILEREAD_Silent))
+		{
+			return {};
+		}
+
+		FMemoryReader Reader(Bytes, true);
+		FObjectAndNameAsStringProxyArchive Ar(Reader, false);
+
+		uint32 Magic = 0;
+		int32 FormatVersion = INDEX_NONE;
+		int32 DynamicVariableVersion = INDEX_NONE;
+		Ar << Magic;
+		Ar << FormatVersion;
+		if (Ar.IsError() || Magic != Private::ToxParameterCacheMagic || FormatVersion != Private::ToxParameterCacheFormatVersion)
+		{
+			UE_LOG(LogTouchEngine, Verbose, TEXT("Discarding outdated tox parameter cache '%s' for '%s'"), *CacheFilePath, *Key.AbsoluteToxPath);
+			return {};
+		}
+
+		FString SavedTouchEngineVersion;
+		FString SavedTouchDesignerPath;
+		Ar << DynamicVariableVersion;
+		Ar << SavedTouchEngineVersion;
+		Ar << SavedTouchDesignerPath;
+		// An entry saved before the TouchDesigner installation was known, or read before it is known, cannot be checked against it
+		const bool bIsSameTouchDesigner = Key.TouchDesignerPath.IsEmpty() || SavedTouchDesignerPath.IsEmpty() || Key.TouchDesignerPath == SavedTouchDesignerPath;
+		if (Ar.IsError() || DynamicVariableVersion != FTouchEngineDynamicVariableStructVersion::LatestVersion
+			|| SavedTouchEngineVersion != Key.TouchEngineVersion || !bIsSameTouchDesigner)
+		{
+			UE_LOG(LogTouchEngine, Verbose, TEXT("Discarding tox parameter cache '%s' for '%s' saved with TouchEngine '%s' and TouchDesigner '%s'"),
+				*CacheFilePath, *Key.AbsoluteToxPath, *SavedTouchEngineVersion, *SavedTouchDesignerPath);
+			return {};
+		}
+		Ar.SetCustomVersion(FTouchEngineDynamicVariableStructVersion::GUID, DynamicVariableVersion, TEXT("TouchEngineDynamicVariableStructVer"));
+
+		TArray<FTouchEngineDynamicVariableStruct> Inputs;
+		TArray<FTouchEngineDynamicVariableStruct> Outputs;
+		Private::SerializeVariables(Ar, Inputs);
+		Private::SerializeVariables(Ar, Outputs);
+		if (Ar.IsError())
+		{
+			UE_LOG(LogTouchEngine, Warning, TEXT("Unable to read the tox parameter cache '%s' for '%s'. The tox file will be loaded in TouchEngine."), *CacheFilePath, *Key.AbsoluteToxPath);
+			return {};
+		}
+
+		UE_LOG(LogTouchEngine, Log, TEXT("Loaded the parameters of '%s' from the tox parameter cache '%s'"), *Key.AbsoluteToxPath, *CacheFilePath);
+		return FTouchLoadResult::MakeSuccess(MoveTemp(Inputs), MoveTemp(Outputs));
+	}
+
+	void FToxParameterCache::Save(const FToxParameterCacheKey& Key, const FTouchLoadResult& LoadResult)
+	{
+		if (!LoadResult.IsSuccess())
+		{
+			return;
+		}
+
+		const FString CacheFilePath = GetCacheFilePath(Key);
+		if (CacheFilePath.IsEmpty())
+		{
+			return;
+		}
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes, true);
+		FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+
+		uint32 Magic = Private::ToxParameterCacheMagic;
+		int32 FormatVersion = Private::ToxParameterCacheFormatVersion;
+		int32 DynamicVariableVersion = FTouchEngineDynamicVariableStructVersion::LatestVersion;
+		FString SavedTouchEngineVersion = Key.TouchEngineVersion;
+		// The load which produced the result has configured an instance, so the installation is most likely known by now even if it was not when the key was made
+		FString SavedTouchDesignerPath = Key.TouchDesignerPath.IsEmpty() ? GetTouchDesignerPath() : Key.TouchDesignerPath;
+		Ar << Magic;
+		Ar << FormatVersion;
+		Ar << DynamicVariableVersion;
+		Ar << SavedTouchEngineVersion;
+		Ar << SavedTouchDesignerPath;
+
+		// Serialize takes non-const references even when saving
+		TArray<FTouchEngineDynamicVariableStruct> Inputs = LoadResult.SuccessResult->Inputs;
+		TArray<FTouchEngineDynamicVariableStruct> Outputs = LoadResult.SuccessResult->Outputs;
+		Private::SerializeVariables(Ar, Inputs);
+		Private::SerializeVariables(Ar, Outputs);
+
+		// Write to a temporary file first so a crash or a concurrent editor instance never leaves a truncated entry behind
+		const FString TempFilePath = CacheFilePath + FString::Printf(TEXT(".%u.tmp"), FPlatformTLS::GetCurrentThreadId());
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempFilePath) || !IFileManager::Get().Move(*CacheFilePath, *TempFilePath, true, true))
+		{
+			UE_LOG(LogTouchEngine, Warning, TEXT("Unable to write the tox parameter cache '%s' for '%s'"), *CacheFilePath, *Key.AbsoluteToxPath);
+			IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		}
+	}
+
+	void FToxParameterCache::SetTouchEngineVersion(const FString& Version)
+	{
+		FScopeLock Lock(&Private::EngineVersionsLock);
+		Private::TouchEngineVersion = Version;
+	}
+
+	void FToxParameterCache::SetTouchDesignerPath(const FString& Path)
+	{
+		FScopeLock Lock(&Private::EngineVersionsLock);
+		Private::TouchDesignerPath = Path;
+	}
+
+	FString FToxParameterCache::GetTouchDesignerPath()
+	{
+		FScopeLock Lock(&Private::EngineVersionsLock);
+		return Private::TouchDesignerPath;
+	}
+
+	FString FToxParameterCache::GetCacheDirectory()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TouchEngine"), TEXT("ToxParameterCache"));
+	}
+
+	FString FToxParameterCache::GetCacheFilePath(const FToxParameterCacheKey& Key)
+	{
+		if (!Key.IsValid())
+		{
+			return FString();
+		}
+		return FPaths::Combine(GetCacheDirectory(), LexToString(Key.ToxHash) + TEXT(".bin"));
+	}
+}
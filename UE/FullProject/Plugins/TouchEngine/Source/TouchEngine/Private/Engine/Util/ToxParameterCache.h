@@ -0,0 +1,70 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TouchLoadResults.h"
+#include "Misc/SecureHash.h"
+
+namespace UE::TouchEngine
+{
+	/** Identifies a cache entry: the content of a tox file, and the TouchEngine library and TouchDesigner installation it is parsed with */
+	struct FToxParameterCacheKey
+	{
+		/** Only used for logging */
+		FString AbsoluteToxPath;
+		FMD5Hash ToxHash;
+		/** See FToxParameterCache::SetTouchEngineVersion */
+		FString TouchEngineVersion;
+		/** See FToxParameterCache::SetTouchDesignerPath. Empty while no TouchEngine instance has been configured in this session */
+		FString TouchDesignerPath;
+
+		bool IsValid() const { return ToxHash.IsValid(); }
+	};
+
+	/**
+	 * Persists the parameters parsed from tox files under the project's Saved folder, so they can be retrieved without loading the file in TouchEngine again.
+	 * Entries are keyed by the hash of the content of the tox file, so a modified file is never matched with stale parameters, and are discarded when
+	 * the cache format, FTouchEngineDynamicVariableStructVersion, the TouchEngine library or the TouchDesigner installation changes.
+	 * Only successful load results are cached.
+	 *
+	 * MakeKey, Load and Save read or write whole files, so they are meant to be called from a worker thread. Everything else can be called from any thread.
+	 */
+	class FToxParameterCache
+	{
+	public:
+		/** Hashes the content of the given tox file and captures the current engine versions. The key is invalid if the file cannot be read */
+		static FToxParameterCacheKey MakeKey(const FString& AbsoluteToxPath);
+		/** Returns the cached parameters for the given key, or an unset optional if they are not cached or if the cache entry is outdated */
+		static TOptional<FTouchLoadResult> Load(const FToxParameterCacheKey& Key);
+		/** Saves the parameters for the given key. Does nothing if the key is invalid or if the LoadResult is a failure */
+		static void Save(const FToxParameterCacheKey& Key, const FTouchLoadResult& LoadResult);
+
+		/** Sets the version of the TouchEngine library the module loaded. Entries saved with another version are discarded */
+		static void SetTouchEngineVersion(const FString& Version);
+		/**
+		 * Sets the TouchDesigner installation TouchEngine selected, as returned by TEInstanceGetConfiguredEnginePath once an instance is configured.
+		 * Entries saved with another installation are discarded. Until it is known in a session, entries saved with any installation are used.
+		 */
+		static void SetTouchDesignerPath(const FString& Path);
+		static FString GetTouchDesignerPath();
+
+		/** The folder in which the cache entries are saved */
+		static FString GetCacheDirectory();
+
+	private:
+		static FString GetCacheFilePath(const FToxParameterCacheKey& Key);
+	};
+}
@@ -110,7 +110,7 @@ namespace UE::TouchEngine
 			// Here we can use a regular TEInstanceGetTextureTransfer even for Vulkan because the contents of the texture can be discarded
 			// as noted https://github.com/TouchDesigner/TouchEngine-Windows#vulkan
 			TETextureTransfer.Result = TEInstanceGetTextureTransfer(Instance, TouchTexture, TETextureTransfer.Semaphore.take(), &TETextureTransfer.WaitValue); // request an ownership transfer from TE to UE, will be processed below
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceGetTextureTransfer(TEInstance: '%p', texture: '%p' ['%s'], semaphore&: '%p', waitValue&: '%lld') [Thread: '%s']  =>  Returned '%s'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEInstanceGetTextureTransfer(TEInstance: '%p', texture: '%p' ['%s'], semaphore&: '%p', waitValue&: '%lld') [Thread: '%s']  =>  Returned '%s'"),
 				Instance.get(),
 				TouchTexture.get(),
 				*DebugName,
@@ -150,7 +150,7 @@ namespace UE::TouchEngine
 			return;
 		}
 
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEVulkanTextureCallback(textureHandle: '%p' [TE: '%p', UE: '%s'], event: '%s', info: '%p') [Thread: '%s']"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEVulkanTextureCallback(textureHandle: '%p' [TE: '%p', UE: '%s'], event: '%s', info: '%p') [Thread: '%s']"),
 			Handle,
 			TouchRepresentation_RenderThread.get(),
 			*DebugName,
@@ -22,6 +22,7 @@
 #include "Rendering/TouchResourceProvider.h"
 #include "Rendering/Exporting/TouchExportParams.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -35,6 +36,7 @@ namespace UE::TouchEngine
 		}
 
 		ParamsConst.TextureToBeExported->bIsUsedInCurrentCook = true;
+		UE_TRACE_TOUCHENGINE_COOK_EVENT(ExportStarted, ParamsConst.FrameData.FrameID, ParamsConst.ParameterName);
 
 		TPromise<TouchObject<TETexture>> Promise;
 		TFuture<TouchObject<TETexture>> Future = Promise.GetFuture();
@@ -80,9 +82,11 @@ namespace UE::TouchEngine
 					Promise.SetValue(nullptr);
 					return;
 				}
+				UE_TRACE_TOUCHENGINE_COOK_EVENT(ExportTransferAdded, Params.FrameData.FrameID, Params.ParameterName);
 			}
 
 			This->FinaliseExport_RenderThread(Params, ExportedTexture.ToSharedRef());
+			UE_TRACE_TOUCHENGINE_COOK_EVENT(ExportFinalised, Params.FrameData.FrameID, Params.ParameterName);
 
 			// Finally return the texture that will be passed to TEInstanceLinkSetTextureValue in FTouchVariableManager::SetTOPInput
 			Promise.SetValue(TouchTexture);
@@ -102,7 +106,7 @@ namespace UE::TouchEngine
 
 		TSharedPtr<FExportedTouchTexture> ExportedPlatformTexture;
 		UE_LOG(LogTouchEngine, Verbose, TEXT("[TExportedTouchTextureCache::GetOrCreateTexture] Overall Pool Size: %d   Pool: %d   Cached: %d   Future: %d"),
-			TexturePool.Num() + CachedInputTextures.Num() + FutureTexturesToPool.Num(), TexturePool.Num(), CachedInputTextures.Num(), FutureTexturesToPool.Num());
+			TexturePool.Num(), TexturePool.Num(EExportTextureState::Available), TexturePool.Num(EExportTextureState::InUse), TexturePool.Num(EExportTextureState::WaitingForTouchEngine));
 
 		bool bIsNewTexture = false;
 		// If we have an existing pool, try to get it from there
@@ -126,108 +130,34 @@ namespace UE::TouchEngine
 
 		UE_LOG(LogTouchEngine, Verbose, TEXT("[TExportedTouchTextureCache::GetOrCreateTexture] for texture `%s` returned %s pool texture '%s'"), *InTexture->GetFullName(), bIsNewTexture ? TEXT("NEW") : TEXT("EXISTING"), *ExportedPlatformTexture->DebugName);
 		ExportedPlatformTexture->EnqueueTextureCopy(InTexture);
+		INC_TOUCHENGINE_STAT(STAT_TE_Export_NbCopies, NbExportCopies);
 
 		return ExportedPlatformTexture;
 	}
 
 	void FTouchTextureExporter::TexturePoolMaintenance()
 	{
-		TArray<TSharedRef<FTextureData>> TexturesToPool;
-		TArray<TSharedRef<FTextureData>> TexturesToWait;
-		TArray<TSharedRef<FTextureData>> TexturesToRelease;
-
-		// 1.  we check the CachedInputTextureData which holds input textures
-		for (auto It = CachedInputTextures.CreateIterator(); It; ++It)
-		{
-			TSharedRef<FTextureData>& TextureData = *It;
-			if (TextureData->ExportedPlatformTexture->IsInUseByDynVars() || TextureData->ExportedPlatformTexture->IsUsedInCurrentCook())
-			{
-				continue;
-			}
-			
-			if (TextureData->ExportedPlatformTexture->WasEverUsedByTouchEngine())
-			{
-				if (const TSharedPtr<FTouchResourceProvider> Provider = WeakProvider.Pin())
-				{
-					TextureData->ExportedPlatformTexture->GetTextureBackFromTE(Provider->GetInstance());
-				}
-			}
-			
-			if (!TextureData->CanBeReused())
-			{
-				TexturesToWait.AddUnique(TextureData); // if it is still in use, we cannot reuse it right away.
-			}
-			else
-			{
-				TexturesToPool.AddUnique(TextureData); // otherwise we'll add it to the pool
-			}
-			It.RemoveCurrent();
-		}
-
-		// 2. Then we ensure our pool is healthy
-		for (auto It = TexturePool.CreateIterator(); It; ++It)
-		{
-			TSharedRef<FTextureData>& TextureData = *It;
-			if (!ensure(TextureData->CanBeReused()))
-			{
-				CachedInputTextures.AddUnique(TextureData);
-				It.RemoveCurrent();
-			}
-		}
-
-		// 3. Check if the textures are still in use by TouchEngine and add the new ones
-		for (auto It = FutureTexturesToPool.CreateIterator(); It; ++It)
-		{
-			TSharedRef<FTextureData>& TextureData = *It;
-			if (TextureData->CanBeReused()) // if freed up, we can add it to the Pool
-			{
-				TexturesToPool.AddUnique(TextureData);
-				It.RemoveCurrent();
-			}
-		}
-		FutureTexturesToPool.Append(TexturesToWait);
-
-		// 4. We add to the pool the ones that can be added and we ensure the pool is not too big
-		TexturePool.Append(TexturesToPool);
-		while (TexturePool.Num() > PoolSize)
-		{
-			TexturesToRelease.AddUnique(TexturePool[0]); // we remove from the front as they have been here the longest
-			TexturePool.RemoveAt(0);
-		}
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Export - Texture Pool Maintenance"), STAT_TE_ExportedTexturePool_Maintenance, STATGROUP_TouchEngine);
+		FScopeLock Lock(&PooledTextureMutex);
 
-		// 5. And finally we release the textures
-		for (const TSharedRef<FTextureData>& TextureData : TexturesToRelease)
+		FTexturePoolPolicy Policy{WeakProvider};
+		for (const TSharedRef<FTextureData>& TextureData : TexturePool.Maintenance(PoolSize, Policy))
 		{
 			ReleaseTexture(TextureData->ExportedPlatformTexture);
 		}
 
-		SET_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesPool, TexturePool.Num())
+		SET_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesPool, TexturePool.Num(EExportTextureState::Available))
 	}
 
 	TFuture<FTouchSuspendResult> FTouchTextureExporter::ReleaseTextures()
 	{
 		FScopeLock Lock(&PooledTextureMutex);
-			
-		for (TSharedRef<FTextureData>& TextureData : CachedInputTextures)
-		{
-			ReleaseTexture(TextureData->ExportedPlatformTexture);
-		}
-		CachedInputTextures.Empty();
-		check(CachedInputTextures.IsEmpty());
 
-		for (const TSharedRef<FTextureData>& TextureData : FutureTexturesToPool)
-		{
-			ReleaseTexture(TextureData->ExportedPlatformTexture);
-		}
-		FutureTexturesToPool.Empty();
-		check(FutureTexturesToPool.IsEmpty());
-			
-		for (const TSharedRef<FTextureData>& TextureData : TexturePool)
+		for (const TSharedRef<FTextureData>& TextureData : TexturePool.Empty())
 		{
 			ReleaseTexture(TextureData->ExportedPlatformTexture);
 		}
-		TexturePool.Empty();
-		check(TexturePool.IsEmpty());
+		check(TexturePool.Num() == 0);
 			
 		TPromise<FTouchSuspendResult> Promise;
 		TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
@@ -306,7 +236,7 @@ namespace UE::TouchEngine
 		TSharedRef<FTextureData> NewTextureData = MakeShared<FTextureData>(ExportedTexture.ToSharedRef());
 		NewTextureData->DebugName = ExportedTexture->DebugName;
 
-		CachedInputTextures.Add(NewTextureData);
+		TexturePool.AddInUse(NewTextureData);
 		INC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
 
 		return NewTextureData;
@@ -314,22 +244,25 @@ namespace UE::TouchEngine
 
 	TSharedPtr<FTouchTextureExporter::FTextureData> FTouchTextureExporter::FindSuitableTextureFromPool(UTexture* InTexture)
 	{
-		for (auto It = TexturePool.CreateIterator(); It; ++It)
+		const FTextureRHIRef TextureToFitRHI = FTouchResourceProvider::GetStableRHIFromTexture(InTexture);
+		const TOptional<FExportedTexturePoolKey> Key = FExportedTexturePoolKey::FromRHI(TextureToFitRHI);
+		if (!Key)
 		{
-			TSharedRef<FTextureData>& TextureData = *It;
-			if (ensure(TextureData->CanBeReused()) && TextureData->ExportedPlatformTexture->CanFitTexture(InTexture))
-			{
-				UE_LOG(LogTouchEngine, Verbose, TEXT("[TExportedTouchTextureCache::FindSuitableTextureFromPool] reusing pooled texture '%s' for UTexture `%s`"), *TextureData->ExportedPlatformTexture->DebugName, *InTexture->GetFullName());
-
-				TextureData->DebugName = TextureData->ExportedPlatformTexture->DebugName;
-				TSharedPtr<FTextureData> SuitableTextureFromPool = TextureData;
+			return nullptr;
+		}
 
-				CachedInputTextures.Add(TextureData);
-				It.RemoveCurrent();
-				return SuitableTextureFromPool;
-			}
+		const TOptional<TSharedRef<FTextureData>> TextureData = TexturePool.AcquireAvailable(*Key, [](const TSharedRef<FTextureData>& Candidate)
+		{
+			return ensure(Candidate->CanBeReused());
+		});
+		if (!TextureData)
+		{
+			return nullptr;
 		}
-		return nullptr;
+
+		UE_LOG(LogTouchEngine, Verbose, TEXT("[TExportedTouchTextureCache::FindSuitableTextureFromPool] reusing pooled texture '%s' for UTexture `%s`"), *(*TextureData)->ExportedPlatformTexture->DebugName, *InTexture->GetFullName());
+		(*TextureData)->DebugName = (*TextureData)->ExportedPlatformTexture->DebugName;
+		return *TextureData;
 	}
 
 	void FTouchTextureExporter::ReleaseTexture(TSharedRef<FExportedTouchTexture>& Texture)
@@ -342,4 +275,36 @@ namespace UE::TouchEngine
 				DEC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
 			});
 	}
+
+	TOptional<FTouchTextureExporter::FExportedTexturePoolKey> FTouchTextureExporter::FExportedTexturePoolKey::FromRHI(const FRHITexture* TextureRHI)
+	{
+		if (!TextureRHI)
+		{
+			return {};
+		}
+		const FRHITextureDesc& Desc = TextureRHI->GetDesc();
+		return FExportedTexturePoolKey{ Desc.Extent, Desc.Format, Desc.NumMips, Desc.NumSamples, EnumHasAnyFlags(Desc.Flags, ETextureCreateFlags::SRGB) };
+	}
+
+	bool FTouchTextureExporter::FTexturePoolPolicy::IsInUse(const TSharedRef<FTextureData>& TextureData) const
+	{
+		return TextureData->ExportedPlatformTexture->IsInUseByDynVars() || TextureData->ExportedPlatformTexture->IsUsedInCurrentCook();
+	}
+
+	void FTouchTextureExporter::FTexturePoolPolicy::OnNoLongerInUse(TSharedRef<FTextureData>& TextureData) const
+	{
+		if (TextureData->ExportedPlatformTexture->WasEverUsedByTouchEngine())
+		{
+			if (const TSharedPtr<FTouchResourceProvider> Provider = WeakProvider.Pin())
+			{
+				TextureData->ExportedPlatformTexture->GetTextureBackFromTE(Provider->GetInstance());
+			}
+		}
+	}
+
+	TOptional<FTouchTextureExporter::FExportedTexturePoolKey> FTouchTextureExporter::FTexturePoolPolicy::GetKey(const TSharedRef<FTextureData>& TextureData) const
+	{
+		// The key is computed from the shared RHI, which is what FExportedTouchTexture::CanFitTexture compares against
+		return FExportedTexturePoolKey::FromRHI(TextureData->ExportedPlatformTexture->GetSharedTextureRHI_RenderThread());
+	}
 }
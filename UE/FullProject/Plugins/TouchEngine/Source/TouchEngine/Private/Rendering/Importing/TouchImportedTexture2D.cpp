@@ -0,0 +1,65 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "Rendering/Importing/TouchImportedTexture2D.h"
+
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "Rendering/Importing/ITouchImportTexture.h"
+#include "Rendering/Importing/TouchImportedTextureResource.h"
+#include "UObject/Package.h"
+
+UTouchImportedTexture2D* UTouchImportedTexture2D::Create(const UE::TouchEngine::FTextureMetaData& Metadata, FTextureRHIRef ImportedTextureRHI, FName Name)
+{
+	UTouchImportedTexture2D* Texture = NewObject<UTouchImportedTexture2D>(GetTransientPackage(), Name, RF_Transient);
+
+	// Same description as UTexture2D::CreateTransient, but the content lives in ImportedTextureRHI so the mip has no bulk data
+	FTexturePlatformData* PlatformData = new FTexturePlatformData();
+	PlatformData->SizeX = Metadata.SizeX;
+	PlatformData->SizeY = Metadata.SizeY;
+	PlatformData->SetNumSlices(1);
+	PlatformData->PixelFormat = Metadata.PixelFormat;
+	PlatformData->Mips.Add(new FTexture2DMipMap(Metadata.SizeX, Metadata.SizeY, 1));
+	Texture->SetPlatformData(PlatformData);
+
+	Texture->NeverStream = true;
+	Texture->SRGB = Metadata.IsSRGB;
+	Texture->ImportedTextureRHI = MoveTemp(ImportedTextureRHI);
+	return Texture;
+}
+
+void UTouchImportedTexture2D::InitImportedResource_GameThread()
+{
+	check(IsInGameThread());
+	check(!GetResource());
+
+	// The texture reference is what FTouchImportedTextureResource::InitRHI points to our RHI, so it needs to be initialised before it
+	if (!TextureReference.IsInitialized_GameThread())
+	{
+		TextureReference.BeginInit_GameThread();
+	}
+	FTextureResource* Resource = CreateResource();
+	SetResource(Resource);
+	if (Resource)
+	{
+		BeginInitResource(Resource);
+	}
+}
+
+FTextureResource* UTouchImportedTexture2D::CreateResource()
+{
+	// Called by UpdateResource as well, which would otherwise allocate a new empty RHI and lose the imported content
+	return ImportedTextureRHI ? new UE::TouchEngine::FTouchImportedTextureResource(ImportedTextureRHI, TextureReference, SRGB) : nullptr;
+}
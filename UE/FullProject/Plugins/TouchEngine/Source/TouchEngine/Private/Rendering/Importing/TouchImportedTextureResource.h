@@ -0,0 +1,73 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIStaticStates.h"
+#include "TextureResource.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * The resource of the UTexture2D created for an imported texture.
+	 * It adopts an RHI texture which was created and filled on the render thread before the UTexture2D existed, so initialising it does not allocate anything.
+	 */
+	class FTouchImportedTextureResource : public FTextureResource
+	{
+	public:
+		FTouchImportedTextureResource(FTextureRHIRef InPreallocatedTextureRHI, FTextureReference& InOwnerTextureReference, bool bInSRGB)
+			: PreallocatedTextureRHI(MoveTemp(InPreallocatedTextureRHI))
+			, OwnerTextureReference(InOwnerTextureReference)
+		{
+			bSRGB = bInSRGB;
+		}
+
+		//~ Begin FTextureResource Interface
+		virtual uint32 GetSizeX() const override { return PreallocatedTextureRHI->GetSizeX(); }
+		virtual uint32 GetSizeY() const override { return PreallocatedTextureRHI->GetSizeY(); }
+		//~ End FTextureResource Interface
+
+		//~ Begin FRenderResource Interface
+		virtual void InitRHI(FRHICommandListBase& RHICmdList) override
+		{
+			TextureRHI = PreallocatedTextureRHI;
+			SamplerStateRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+			// The texture reference is initialised by a render command enqueued before this one, so it is valid by now.
+			// Pointing it to our RHI is what FTouchResourceProvider::GetStableRHIFromTexture relies on, as seen in FStreamableTextureResource::InitRHI()
+			TextureReferenceRHI = OwnerTextureReference.TextureReferenceRHI;
+			if (TextureReferenceRHI.IsValid())
+			{
+				RHICmdList.UpdateTextureReference(TextureReferenceRHI, TextureRHI);
+			}
+		}
+
+		virtual void ReleaseRHI() override
+		{
+			if (TextureReferenceRHI.IsValid())
+			{
+				FRHICommandListImmediate::Get().UpdateTextureReference(TextureReferenceRHI, nullptr);
+			}
+			FTextureResource::ReleaseRHI();
+		}
+		//~ End FRenderResource Interface
+
+	private:
+		/** Kept after ReleaseRHI so the resource can be initialised again */
+		FTextureRHIRef PreallocatedTextureRHI;
+		/** The TextureReference of the owning UTexture, which outlives its resource */
+		FTextureReference& OwnerTextureReference;
+	};
+}
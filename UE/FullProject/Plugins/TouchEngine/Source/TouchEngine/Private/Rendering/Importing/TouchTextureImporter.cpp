@@ -16,13 +16,16 @@
 #include "Logging.h"
 #include "RenderingThread.h"
 #include "Engine/TEDebug.h"
+#include "Engine/Texture2D.h"
 #include "Engine/Util/TouchFrameCooker.h"
 #include "Rendering/TouchResourceProvider.h"
 #include "Rendering/Importing/ITouchImportTexture.h"
+#include "Rendering/Importing/TouchImportedTexture2D.h"
 #include "Tasks/Task.h"
 #include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -31,6 +34,16 @@ namespace UE::TouchEngine
 	{
 		UE_LOG(LogTouchEngine, Verbose, TEXT("Shutting down ~FTouchTextureLinker"));
 
+		// The GameThread task creating the pending textures cannot run anymore, but their promises still need to be set
+		{
+			FScopeLock Lock(&PendingTextureWrappersMutex);
+			for (FPendingTextureWrapper& PendingTextureWrapper : PendingTextureWrappers)
+			{
+				PendingTextureWrapper.Promise.SetValue(FTouchTextureImportResult::MakeCancelled());
+			}
+			PendingTextureWrappers.Empty();
+		}
+
 		// We don't need to care about removing textures from root set in this situation (in fact scheduling a game thread task will not work)
 		if (IsEngineExitRequested())
 		{
@@ -47,10 +60,10 @@ namespace UE::TouchEngine
 		}
 		{
 			FScopeLock PoolLock(&TexturePoolMutex);
-			for (FImportedTexturePoolData& Data : TexturePool)
+			TexturePool.ForEach([&TexturesToCleanUp](const FImportedTexturePoolData& Data)
 			{
 				TexturesToCleanUp.Add(Data.UETexture);
-			}
+			});
 		}
 
 		ExecuteOnGameThread<void>([TexturesToCleanUp = MoveTemp(TexturesToCleanUp)]()
@@ -174,20 +187,21 @@ namespace UE::TouchEngine
 		FScopeLock PoolLock(&TexturePoolMutex);
 		while (TexturePool.Num() > PoolSize)
 		{
-			FImportedTexturePoolData& TextureData = TexturePool[0]; // we would remove from the front as they have been here the longest
+			const FImportedTexturePoolData& OldestTextureData = TexturePool.GetOldest(); // we would remove the oldest first as they have been here the longest
+			if (IsValid(OldestTextureData.UETexture) && OldestTextureData.PooledFrameID == FrameData.FrameID)
+			{
+				break; //if we reach a texture added this frame, we know the next textures will also have been added this frame so we stop removing from the pool
+			}
+
+			const FImportedTexturePoolData TextureData = TexturePool.RemoveOldest();
 			if (IsValid(TextureData.UETexture))
 			{
-				if (TextureData.PooledFrameID == FrameData.FrameID)
-				{
-					break; //if we reach a texture added this frame, we know the next textures will also have been added this frame so we stop removing from the pool
-				}
 				// as we might create a lot of textures and the GC might take some time to kick in, we expedite some of the cleaning
 				TextureData.UETexture->RemoveFromRoot();
 				TextureData.UETexture->TextureReference.TextureReferenceRHI.SafeRelease();
 				TextureData.UETexture->ReleaseResource(); 
 				TextureData.UETexture->ConditionalBeginDestroy();
 			}
-			TexturePool.RemoveAt(0);
 		}
 		SET_DWORD_STAT(STAT_TE_ImportedTexturePool_NbTexturesPool, TexturePool.Num())
 	}
@@ -216,7 +230,7 @@ namespace UE::TouchEngine
 	{
 		FTouchTextureTransfer Transfer;
 		Transfer.Result = TEInstanceGetTextureTransfer(ImportParams.Instance, ImportParams.TETexture, Transfer.Semaphore.take(), &Transfer.WaitValue);
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceGetTextureTransfer(TEInstance: '%p', texture: '%p', semaphore&: '%p', waitValue&: '%lld') [Thread: '%s', Identifier: '%s']  =>  Returned '%s'"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceGetTextureTransfer(TEInstance: '%p', texture: '%p', semaphore&: '%p', waitValue&: '%lld') [Thread: '%s', Identifier: '%s']  =>  Returned '%s'"),
 			ImportParams.Instance.get(),
 			ImportParams.TETexture.get(),
 			Transfer.Semaphore.get(),
@@ -244,27 +258,48 @@ namespace UE::TouchEngine
 
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1 [AT] Link Texture Import"), STAT_TE_III_A_1, STATGROUP_TouchEngine);
 		// At this point, we are neither on the GameThread nor on the RenderThread, we are on a parallel thread.
-		// A UTexture2D can be created on any thread but the call to UTexture2D::UpdateResource need to be on GameThread.
-		// As we are creating the texture here, we use an FTaskTagScope to allow us to call UTexture2D::UpdateResource from this thread.
-		// There should be no issues as the texture is not used anywhere else at this point.
+		// Creating a UTexture2D and initialising its resource would need the GameThread, so we never do it from here:
+		// either we reuse a pooled texture, or we copy into a new RHI created on the render thread and only wrap it in a UTexture2D later on GameThread.
 		
 		const FTextureMetaData TETextureMetadata = GetTextureMetaData(LinkParams.TETexture);
-		
-		// 1. Check if we already have a UTexture that could hold the data from TouchEngine, or create one
-		bool bAccessRHIViaReferenceTexture = false;
-		UTexture2D* UEDestinationTexture = GetOrCreateUTextureMatchingMetaData(TETextureMetadata, LinkParams, bAccessRHIViaReferenceTexture);
-		if (!ensure(IsValid(UEDestinationTexture)))
+		if (!ensure(TETextureMetadata.PixelFormat != PF_Unknown))
 		{
+			UE_LOG(LogTouchEngine, Error, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] The PlatformMetadata has an unknown Pixel format `%s` for parameter `%s` for frame `%lld`"),
+				   *GetCurrentThreadStr(), GetPixelFormatString(TETextureMetadata.PixelFormat), *LinkParams.Identifier.ToString(), LinkParams.FrameData.FrameID);
 			Promise.SetValue(FTouchTextureImportResult::MakeFailure());
 			return;
 		}
+		
+		// 1. Check if we already have a UTexture that could hold the data from TouchEngine. If the UTexture and the TE Texture matches size and format, copy straight into the UTexture resource
+		UTexture2D* PoolTexture = FindPoolTextureMatchingMetadata(TETextureMetadata, LinkParams.FrameData);
+		// Otherwise, the promise is only set once the UTexture2D has been created and bound to the RHI we are about to create, see CreatePendingTextureWrappers_GameThread
+		TOptional<TPromise<FTouchTextureImportResult>> PendingTextureWrapperPromise;
+		if (PoolTexture)
+		{
+			Promise.SetValue(FTouchTextureImportResult::MakeSuccessful(PoolTexture, MakePreviousTextureToBePooledPromise(LinkParams.FrameData.FrameID)));
+		}
+		else
+		{
+			UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] Need to create new UTexture for parameter `%s`: %dx%d [%s] for frame `%lld`"),
+				   *GetCurrentThreadStr(), *LinkParams.Identifier.ToString(), TETextureMetadata.SizeX, TETextureMetadata.SizeY, GetPixelFormatString(TETextureMetadata.PixelFormat), LinkParams.FrameData.FrameID);
+			PendingTextureWrapperPromise.Emplace(MoveTemp(Promise));
+			++NumNewTexturesBeingCopied; // Decremented by the render command below, once the texture is pending or has failed
+		}
 
 		// 2. Enqueue the copy of the Texture
-		ENQUEUE_RENDER_COMMAND(CopyRHI)([WeakThis = AsWeak(), LinkParams, UEDestinationTexture, bAccessRHIViaReferenceTexture](FRHICommandListImmediate& RHICmdList) mutable
+		ENQUEUE_RENDER_COMMAND(CopyRHI)([WeakThis = AsWeak(), LinkParams, PoolTexture, TETextureMetadata, PendingTextureWrapperPromise = MoveTemp(PendingTextureWrapperPromise)](FRHICommandListImmediate& RHICmdList) mutable
 		{
 			const TSharedPtr<FTouchTextureImporter> ThisPin = WeakThis.Pin();
 			if (!ThisPin || ThisPin->TaskSuspender.IsSuspended())
 			{
+				if (PendingTextureWrapperPromise)
+				{
+					PendingTextureWrapperPromise->SetValue(FTouchTextureImportResult::MakeCancelled());
+					if (ThisPin)
+					{
+						--ThisPin->NumNewTexturesBeingCopied;
+					}
+				}
 				return;
 			}
 			
@@ -275,34 +310,55 @@ namespace UE::TouchEngine
 			   PlatformTexture = ThisPin->CreatePlatformTexture_RenderThread(LinkParams.Instance, LinkParams.TETexture);
 			}
 
+			// 2. We create a destination RHI if we don't have a pooled texture to copy into
 			TRefCountPtr<FRHITexture> UEDestinationTextureRHI;
-			if (IsValid(UEDestinationTexture))
+			if (PendingTextureWrapperPromise)
+			{
+				UEDestinationTextureRHI = CreateDestinationTextureRHI_RenderThread(RHICmdList, TETextureMetadata, LinkParams.Identifier);
+			}
+			else if (IsValid(PoolTexture) && PoolTexture->TextureReference.TextureReferenceRHI)
 			{
-				UEDestinationTextureRHI = bAccessRHIViaReferenceTexture && UEDestinationTexture->TextureReference.TextureReferenceRHI ?
-					FTextureRHIRef{UEDestinationTexture->TextureReference.TextureReferenceRHI->GetReferencedTexture()} :
-					UEDestinationTexture->GetResource() ? UEDestinationTexture->GetResource()->TextureRHI : nullptr;
+				UEDestinationTextureRHI = PoolTexture->TextureReference.TextureReferenceRHI->GetReferencedTexture();
 			}
 
 			if (PlatformTexture && UEDestinationTextureRHI)
 			{
 				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.3 [RT] Link Texture Import - CopyRHI"), STAT_TE_III_A_3, STATGROUP_TouchEngine);
-				// 2. We create a destination UTexture RHI if we don't have one already
 				const FTouchCopyTextureArgs CopyArgs { LinkParams, RHICmdList, UEDestinationTextureRHI};
 				ThisPin->CopyNativeToUnreal_RenderThread(PlatformTexture, CopyArgs);
+				UE_TRACE_TOUCHENGINE_COOK_EVENT(ImportCopyEnqueued, LinkParams.FrameData.FrameID, LinkParams.Identifier);
 
+				if (!PendingTextureWrapperPromise) // For new textures, this is done once the UTexture2D exists
 				{
 					FScopeLock Lock(&ThisPin->LinkDataMutex);
 					FTouchTextureLinkData& TextureLinkData = ThisPin->LinkData.FindOrAdd(LinkParams.Identifier);
-					TextureLinkData.UnrealTexture = UEDestinationTexture;
+					TextureLinkData.UnrealTexture = PoolTexture;
 					TextureLinkData.bIsInProgress = false;
 				}
 			}
+
+			// 3. The UTexture2D wrapping the new RHI is created later on GameThread, together with the ones of the other imports of this frame
+			if (PendingTextureWrapperPromise)
+			{
+				if (UEDestinationTextureRHI)
+				{
+					ThisPin->EnqueuePendingTextureWrapper_RenderThread({ LinkParams.Identifier, LinkParams.FrameData, TETextureMetadata, MoveTemp(UEDestinationTextureRHI), MoveTemp(PendingTextureWrapperPromise.GetValue()) });
+				}
+				else
+				{
+					PendingTextureWrapperPromise->SetValue(FTouchTextureImportResult::MakeFailure());
+				}
+				--ThisPin->NumNewTexturesBeingCopied;
+			}
 		}); // ~ENQUEUE_RENDER_COMMAND(CopyRHI)
-		
-		//3. Here, we want to make sure the previous texture would be put back in the pool, so we create a promise to be filled
+	}
+
+	TSharedPtr<TPromise<UTexture2D*>> FTouchTextureImporter::MakePreviousTextureToBePooledPromise(int64 FrameID)
+	{
+		// Here, we want to make sure the previous texture would be put back in the pool, so we create a promise to be filled
 		TSharedPtr<TPromise<UTexture2D*>> PreviousTextureToBePooledPromise = MakeShared<TPromise<UTexture2D*>>();
 		TFuture<UTexture2D*> PreviousTextureToBePooledResult = PreviousTextureToBePooledPromise->GetFuture();
-		PreviousTextureToBePooledResult.Next([WeakThis = AsWeak(), LinkParams](UTexture2D* PreviousTextureToBePooled)
+		PreviousTextureToBePooledResult.Next([WeakThis = AsWeak(), FrameID](UTexture2D* PreviousTextureToBePooled)
 		{
 			if (!IsValid(PreviousTextureToBePooled))
 			{
@@ -315,7 +371,7 @@ namespace UE::TouchEngine
 				if (PreviousTextureToBePooled->IsRooted()) // if the texture is not rooted, we have been asked to remove it from the set, see RemoveUTextureFromPool
 				{
 					FScopeLock PoolLock(&ThisPin->TexturePoolMutex);
-					ThisPin->TexturePool.Add({LinkParams.FrameData.FrameID, PreviousTextureToBePooled});
+					ThisPin->TexturePool.Add(FImportedTexturePoolKey::FromTexture(PreviousTextureToBePooled), {FrameID, PreviousTextureToBePooled});
 				}
 			}
 			else
@@ -323,78 +379,118 @@ namespace UE::TouchEngine
 				PreviousTextureToBePooled->RemoveFromRoot();
 			}
 		});
-
-		Promise.SetValue( FTouchTextureImportResult::MakeSuccessful(UEDestinationTexture, MoveTemp(PreviousTextureToBePooledPromise)));
+		return PreviousTextureToBePooledPromise;
 	}
-	
-	UTexture2D* FTouchTextureImporter::GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams, bool& bOutAccessRHIViaReferenceTexture)
+
+	FTextureRHIRef FTouchTextureImporter::CreateDestinationTextureRHI_RenderThread(FRHICommandListBase& RHICmdList, const FTextureMetaData& TETextureMetadata, const FName& Identifier)
 	{
-		UTexture2D* UEDestinationTexture = nullptr;
-		if (!ensure(TETextureMetadata.PixelFormat != PF_Unknown))
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.1 [RT] Link Texture Import - Create RHI"), STAT_TE_III_A_1_1, STATGROUP_TouchEngine);
+		FRHITextureCreateDesc TextureDesc = FRHITextureCreateDesc::Create2D(
+			*FString::Printf(TEXT("ImportedTexture %s"), *Identifier.ToString()),
+			TETextureMetadata.SizeX, TETextureMetadata.SizeY,
+			TETextureMetadata.PixelFormat
+		)
+			.SetFlags(ETextureCreateFlags::ShaderResource)
+			.SetInitialState(ERHIAccess::SRVMask);
+
+		if (TETextureMetadata.IsSRGB)
 		{
-			bOutAccessRHIViaReferenceTexture = false;
-			UE_LOG(LogTouchEngine, Error, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] The PlatformMetadata has an unknown Pixel format `%s` for parameter `%s` for frame `%lld`"),
-				   *GetCurrentThreadStr(), GetPixelFormatString(TETextureMetadata.PixelFormat), *LinkParams.Identifier.ToString(), LinkParams.FrameData.FrameID);
+			TextureDesc.AddFlags(ETextureCreateFlags::SRGB);
 		}
-		else if (UTexture2D* PoolTexture = FindPoolTextureMatchingMetadata(TETextureMetadata, LinkParams.FrameData)) // if the UTexture and the TE Texture matches size and format, copy straight into the UTexture resource
+		return RHICmdList.CreateTexture(TextureDesc);
+	}
+
+	void FTouchTextureImporter::EnqueuePendingTextureWrapper_RenderThread(FPendingTextureWrapper&& PendingTextureWrapper)
+	{
+		bool bIsTaskScheduled;
 		{
-			bOutAccessRHIViaReferenceTexture = true;
-			UEDestinationTexture = PoolTexture;
+			FScopeLock Lock(&PendingTextureWrappersMutex);
+			bIsTaskScheduled = !PendingTextureWrappers.IsEmpty();
+			PendingTextureWrappers.Add(MoveTemp(PendingTextureWrapper));
 		}
-		else // otherwise we need to create a new resource
+
+		if (!bIsTaskScheduled)
 		{
-			
-			UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] Need to create new UTexture for parameter `%s`: %dx%d [%s] for frame `%lld`"),
-				   *GetCurrentThreadStr(), *LinkParams.Identifier.ToString(), TETextureMetadata.SizeX, TETextureMetadata.SizeY, GetPixelFormatString(TETextureMetadata.PixelFormat), LinkParams.FrameData.FrameID);
+			AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]()
 			{
-				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.1 [AT] Link Texture Import - Create UTexture"), STAT_TE_III_A_1_1, STATGROUP_TouchEngine);
-				const FString Name = FString::Printf(TEXT("%s [%lld:%f]"), *LinkParams.Identifier.ToString(), LinkParams.FrameData.FrameID, FPlatformTime::Seconds() - GStartTime);
-				const FName UniqueName = MakeUniqueObjectName(GetTransientPackage(), UTexture2D::StaticClass(), FName(Name));
-				UEDestinationTexture = UTexture2D::CreateTransient(TETextureMetadata.SizeX, TETextureMetadata.SizeY, TETextureMetadata.PixelFormat, UniqueName);
-				UEDestinationTexture->NeverStream = true;
-				UEDestinationTexture->SRGB = TETextureMetadata.IsSRGB;
-				UEDestinationTexture->AddToRoot();
-			}
-			{
-				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.2 [AT] Link Texture Import - Update Resource"), STAT_TE_III_A_1_2, STATGROUP_TouchEngine);
-				// Hack to allow us to call UpdateResource from this thread. This should be safe because we just created it, and we are returning it after it has been initialised
-				const ETaskTag PreviousTagScope = FTaskTagScope::SwapTag(ETaskTag::ENone);
+				if (const TSharedPtr<FTouchTextureImporter> ThisPin = WeakThis.Pin())
 				{
-					FTaskTagScope Scope(ETaskTag::EParallelGameThread);
-					UEDestinationTexture->UpdateResource();
+					ThisPin->CreatePendingTextureWrappers_GameThread();
 				}
-				FTaskTagScope::SwapTag(PreviousTagScope);
-			}
-			bOutAccessRHIViaReferenceTexture = false;
-			// Here, accessing the reference texture will not give the expected result as it is not yet pointing to the right RHI
-			// so we access directly Texture->GetResource()->TextureRHI which is the RHI that will be referenced, as seen in FStreamableTextureResource::InitRHI()
+			});
 		}
-		
-		return UEDestinationTexture;
 	}
-	
-	UTexture2D* FTouchTextureImporter::FindPoolTextureMatchingMetadata(const FTextureMetaData& TETextureMetadata, const FTouchEngineInputFrameData& FrameData)
+
+	void FTouchTextureImporter::CreatePendingTextureWrappers_GameThread()
 	{
-		UTexture2D* PooledTexture = nullptr;
-		
-		FScopeLock PoolLock(&TexturePoolMutex);
-		for (int i = 0; i < TexturePool.Num(); ++i)
+		check(IsInGameThread());
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.2 [GT] Link Texture Import - Create UTextures"), STAT_TE_III_A_1_2, STATGROUP_TouchEngine);
+
+		TArray<FPendingTextureWrapper> TextureWrappersToCreate;
 		{
-			FImportedTexturePoolData& TextureData = TexturePool[i];
-			if (TextureData.PooledFrameID >= FrameData.FrameID || !IsValid(TextureData.UETexture))
+			FScopeLock Lock(&PendingTextureWrappersMutex);
+			TextureWrappersToCreate = MoveTemp(PendingTextureWrappers);
+		}
+
+		for (FPendingTextureWrapper& PendingTextureWrapper : TextureWrappersToCreate)
+		{
+			if (TaskSuspender.IsSuspended())
 			{
-				// if the texture was pooled this frame, we do not return it as it could still be in use
+				PendingTextureWrapper.Promise.SetValue(FTouchTextureImportResult::MakeCancelled());
 				continue;
 			}
-			if (CanCopyIntoUTexture(TETextureMetadata, TextureData.UETexture))
+
+			const FTextureMetaData& Metadata = PendingTextureWrapper.TETextureMetadata;
+			const FString Name = FString::Printf(TEXT("%s [%lld:%f]"), *PendingTextureWrapper.Identifier.ToString(), PendingTextureWrapper.FrameData.FrameID, FPlatformTime::Seconds() - GStartTime);
+			const FName UniqueName = MakeUniqueObjectName(GetTransientPackage(), UTouchImportedTexture2D::StaticClass(), FName(Name));
+			UTouchImportedTexture2D* UEDestinationTexture = UTouchImportedTexture2D::Create(Metadata, MoveTemp(PendingTextureWrapper.TextureRHI), UniqueName);
+			UEDestinationTexture->AddToRoot();
+
+			// Instead of UpdateResource, which would allocate a new RHI, the resource adopts the RHI the import was already copied into.
+			// Its initialisation is enqueued after the copy, and before any rendering command using the texture can be, as the promise is only set below.
+			UEDestinationTexture->InitImportedResource_GameThread();
+			INC_DWORD_STAT(STAT_TE_Import_NbTexture2dCreated);
+
 			{
-				PooledTexture = TextureData.UETexture;
-				TexturePool.RemoveAt(i);
-				break;
+				FScopeLock Lock(&LinkDataMutex);
+				FTouchTextureLinkData& TextureLinkData = LinkData.FindOrAdd(PendingTextureWrapper.Identifier);
+				TextureLinkData.UnrealTexture = UEDestinationTexture;
+				TextureLinkData.bIsInProgress = false;
 			}
+
+			PendingTextureWrapper.Promise.SetValue(FTouchTextureImportResult::MakeSuccessful(UEDestinationTexture, MakePreviousTextureToBePooledPromise(PendingTextureWrapper.FrameData.FrameID)));
+		}
+	}
+	
+	void FTouchTextureImporter::FlushPendingTextureWrappers_GameThread()
+	{
+		check(IsInGameThread());
+		if (NumNewTexturesBeingCopied > 0)
+		{
+			// The copy commands of the imports started by the cook are already enqueued, so once they have run, every new texture is pending
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.3 [GT] Link Texture Import - Flush Pending UTextures"), STAT_TE_III_A_1_3, STATGROUP_TouchEngine);
+			FlushRenderingCommands();
 		}
+		CreatePendingTextureWrappers_GameThread();
+	}
 
-		return PooledTexture;
+	UTexture2D* FTouchTextureImporter::FindPoolTextureMatchingMetadata(const FTextureMetaData& TETextureMetadata, const FTouchEngineInputFrameData& FrameData)
+	{
+		FScopeLock PoolLock(&TexturePoolMutex);
+		const TOptional<FImportedTexturePoolData> TextureData = TexturePool.RemoveOldestInBucket(FImportedTexturePoolKey::FromMetaData(TETextureMetadata), [&TETextureMetadata, &FrameData](const FImportedTexturePoolData& Candidate)
+		{
+			// if the texture was pooled this frame, we do not return it as it could still be in use.
+			// The bucket already matches the description, but we still check the RHI as it might not be ready yet
+			return Candidate.PooledFrameID < FrameData.FrameID && IsValid(Candidate.UETexture) && CanCopyIntoUTexture(TETextureMetadata, Candidate.UETexture);
+		});
+
+		return TextureData ? TextureData->UETexture.Get() : nullptr;
+	}
+
+	FTouchTextureImporter::FImportedTexturePoolKey FTouchTextureImporter::FImportedTexturePoolKey::FromTexture(const UTexture2D* Texture)
+	{
+		// The pooled textures are created by UTouchImportedTexture2D::Create with the description of the RHI they wrap, so their PlatformData always describes them
+		return { static_cast<uint32>(Texture->GetSizeX()), static_cast<uint32>(Texture->GetSizeY()), Texture->GetPixelFormat(), static_cast<bool>(Texture->SRGB) };
 	}
 
 	void FTouchTextureImporter::CopyNativeToUnreal_RenderThread(const TSharedPtr<ITouchImportTexture>& TETexture, const FTouchCopyTextureArgs& CopyArgs)
@@ -406,6 +502,7 @@ namespace UE::TouchEngine
 		UE_CLOG(!bSuccessfulCopy, LogTouchEngine, Error, TEXT("   [FTouchTextureImporter::CopyTexture_AnyThread] UNSUCCESSFULLY copied Texture to Unreal Engine for parameter [%s] for frame `%lld`"),*CopyArgs.RequestParams.Identifier.ToString(), CopyArgs.RequestParams.FrameData.FrameID)
 		if (bSuccessfulCopy)
 		{
+			INC_TOUCHENGINE_STAT(STAT_TE_Import_NbCopies, NbImportCopies);
 			FScopeLock Lock(&KeepTexturesAliveMutex);
 			KeepTexturesAliveForCopy.Add({TETexture, CopyArgs.TargetRHI});
 		}
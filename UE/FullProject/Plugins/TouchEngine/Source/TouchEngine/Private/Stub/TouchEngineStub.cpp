@@ -0,0 +1,1608 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "Stub/TouchEngineStub.h"
+
+#if WITH_TOUCHENGINE_STUB
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace UE::TouchEngine::Stub::Private
+{
+	/** Every object returned by the stub is preceded by this header, as TERetain and TERelease only receive the pointer to the object */
+	struct alignas(16) FObjectHeader
+	{
+		std::atomic<int32> RefCount;
+		TEObjectType Type;
+		void (*Destroy)(void* Object);
+
+		FObjectHeader(TEObjectType InType, void (*InDestroy)(void*))
+			: RefCount(1)
+			, Type(InType)
+			, Destroy(InDestroy)
+		{}
+	};
+
+	/** Allocates a reference counted object with a reference count of 1, to be released with TERelease */
+	template<typename T, typename... ArgTypes>
+	T* CreateObject(TEObjectType Type, ArgTypes&&... Args)
+	{
+		static_assert(alignof(T) <= alignof(FObjectHeader), "The object would not be aligned after its header");
+		void* Memory = FMemory::Malloc(sizeof(FObjectHeader) + sizeof(T), alignof(FObjectHeader));
+		new (Memory) FObjectHeader(Type, [](void* Object) { static_cast<T*>(Object)->~T(); });
+		return new (static_cast<uint8*>(Memory) + sizeof(FObjectHeader)) T(Forward<ArgTypes>(Args)...);
+	}
+
+	static FObjectHeader* GetHeader(const void* Object)
+	{
+		return reinterpret_cast<FObjectHeader*>(static_cast<uint8*>(const_cast<void*>(Object)) - sizeof(FObjectHeader));
+	}
+
+	static TArray<ANSICHAR> ToUTF8(const FString& String)
+	{
+		const FTCHARToUTF8 Converter(*String);
+		TArray<ANSICHAR> Result;
+		Result.Append(Converter.Get(), Converter.Length());
+		Result.Add('\0');
+		return Result;
+	}
+
+	static TArray<ANSICHAR> CopyCString(const char* String)
+	{
+		TArray<ANSICHAR> Result;
+		if (String)
+		{
+			Result.Append(String, FCStringAnsi::Strlen(String));
+		}
+		Result.Add('\0');
+		return Result;
+	}
+
+	/** The public structs are the first base of the objects returned, so TERelease finds the header right before them */
+	struct FStubString : TEString
+	{
+		TArray<ANSICHAR> Storage;
+
+		explicit FStubString(const FString& Value)
+			: TEString{ nullptr }
+			, Storage(ToUTF8(Value))
+		{
+			string = Storage.GetData();
+		}
+	};
+
+	struct FStubStringArray : TEStringArray
+	{
+		TArray<TArray<ANSICHAR>> Storage;
+		TArray<const char*> Pointers;
+
+		explicit FStubStringArray(TConstArrayView<FString> Values)
+			: TEStringArray{ 0, nullptr }
+		{
+			Storage.Reserve(Values.Num());
+			Pointers.Reserve(Values.Num());
+			for (const FString& Value : Values)
+			{
+				Pointers.Add(Storage.Add_GetRef(ToUTF8(Value)).GetData());
+			}
+			count = Pointers.Num();
+			strings = Pointers.GetData();
+		}
+	};
+
+	struct FStubLinkInfo : TELinkInfo
+	{
+		TArray<ANSICHAR> LabelStorage;
+		TArray<ANSICHAR> NameStorage;
+		TArray<ANSICHAR> IdentifierStorage;
+	};
+
+	/** A link of a loaded instance */
+	struct FLinkState
+	{
+		/** The description the link was loaded from, with its default values completed up to its count */
+		FStubLink Desc;
+		TArray<FString> Children;
+
+		TArray<double> Values;
+		FString String;
+		TouchObject<TEFloatBuffer> FloatBuffer;
+		TouchObject<TETable> Table;
+
+		bool IsContainer() const { return Desc.Type == TELinkTypeGroup || Desc.Type == TELinkTypeComplex || Desc.Type == TELinkTypeSequence; }
+		bool IsNumeric() const { return Desc.Type == TELinkTypeBoolean || Desc.Type == TELinkTypeDouble || Desc.Type == TELinkTypeInt; }
+		bool IsString() const { return Desc.Type == TELinkTypeString || Desc.Type == TELinkTypeStringData; }
+
+		const TArray<double>* GetNumericValues(TELinkValue Which) const
+		{
+			if (!IsNumeric())
+			{
+				return nullptr;
+			}
+			switch (Which)
+			{
+			case TELinkValueMinimum:
+			case TELinkValueUIMinimum:
+				return &Desc.Minimum;
+			case TELinkValueMaximum:
+			case TELinkValueUIMaximum:
+				return &Desc.Maximum;
+			case TELinkValueDefault:
+				return &Desc.DefaultValues;
+			case TELinkValueCurrent:
+				return &Values;
+			default:
+				return nullptr;
+			}
+		}
+
+		template<typename T>
+		TEResult CopyNumericValues(TELinkValue Which, T* OutValues, int32 Count) const
+		{
+			const TArray<double>* NumericValues = GetNumericValues(Which);
+			if (!NumericValues || !OutValues || Count < 0 || Count > NumericValues->Num())
+			{
+				return TEResultBadUsage;
+			}
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				OutValues[Index] = static_cast<T>((*NumericValues)[Index]);
+			}
+			return TEResultSuccess;
+		}
+	};
+
+	enum class ELoadState : uint8
+	{
+		Unloaded,
+		Loading,
+		Loaded
+	};
+
+	/** The state of a TEInstance, kept alive by the tasks of the stub thread until they are done with it */
+	class FInstanceState : public TSharedFromThis<FInstanceState, ESPMode::ThreadSafe>
+	{
+	public:
+		TEInstance* Instance = nullptr;
+		TEInstanceEventCallback EventCallback = nullptr;
+		TEInstanceLinkCallback LinkCallback = nullptr;
+		std::atomic<TEInstanceStatisticsCallback> StatisticsCallback { nullptr };
+		void* CallbackInfo = nullptr;
+
+		/** Must be obtained to access the members below */
+		FCriticalSection Mutex;
+		FString ToxPath;
+		TETimeMode TimeMode = TETimeExternal;
+		int64 FrameRateNumerator = 60;
+		int32 FrameRateDenominator = 1;
+		ELoadState LoadState = ELoadState::Unloaded;
+		/** Incremented by every configure, load and unload, so a load completing on the stub thread knows whether it was superseded */
+		uint64 LoadSerial = 0;
+		FStubTox Tox;
+		TMap<FString, FLinkState> Links;
+		/** The identifiers of the links without parent, indexed by TEScope */
+		TArray<FString> LinkGroups[2];
+		/** The serial of the frame being cooked, or 0 if no frame is being cooked */
+		uint64 CookingFrameSerial = 0;
+		uint64 LastFrameSerial = 0;
+		int64 NumFramesStarted = 0;
+		int64 CookingTimeValue = 0;
+		int32 CookingTimeScale = 1;
+		TOptional<int64> PreviousFrameTimeValue;
+
+		/** Obtained while calling the callbacks from the stub thread, so the instance cannot be destroyed while they run */
+		FCriticalSection DispatchMutex;
+		bool bDestroyed = false;
+
+		FLinkState* FindLink(const char* Identifier)
+		{
+			return Identifier ? Links.Find(FString(UTF8_TO_TCHAR(Identifier))) : nullptr;
+		}
+
+		/** Resets the links and any frame being cooked. Must be called with Mutex */
+		void ResetLinks()
+		{
+			Links.Reset();
+			LinkGroups[TEScopeInput].Reset();
+			LinkGroups[TEScopeOutput].Reset();
+			CookingFrameSerial = 0;
+		}
+
+		/** Creates the links of Tox. Must be called with Mutex */
+		void CreateLinks()
+		{
+			ResetLinks();
+			for (const FStubLink& LinkDesc : Tox.Links)
+			{
+				FLinkState& Link = Links.Add(LinkDesc.Identifier);
+				Link.Desc = LinkDesc;
+				Link.Desc.Label = LinkDesc.Label.IsEmpty() ? LinkDesc.Identifier : LinkDesc.Label;
+				Link.Desc.Name = LinkDesc.Name.IsEmpty() ? LinkDesc.Identifier : LinkDesc.Name;
+				if (Link.IsNumeric())
+				{
+					Link.Desc.DefaultValues.SetNumZeroed(FMath::Max(Link.Desc.Count, 0));
+					Link.Values = Link.Desc.DefaultValues;
+				}
+				Link.String = LinkDesc.DefaultString;
+			}
+			for (const FStubLink& LinkDesc : Tox.Links)
+			{
+				if (LinkDesc.ParentIdentifier.IsEmpty())
+				{
+					LinkGroups[LinkDesc.Scope == TEScopeOutput ? TEScopeOutput : TEScopeInput].Add(LinkDesc.Identifier);
+				}
+				else if (FLinkState* Parent = Links.Find(LinkDesc.ParentIdentifier))
+				{
+					Parent->Children.Add(LinkDesc.Identifier);
+				}
+			}
+		}
+
+		/** Calls the event callback from the stub thread */
+		void SendEventFromStubThread(TEEvent Event, TEResult Result)
+		{
+			FScopeLock DispatchLock(&DispatchMutex);
+			if (!bDestroyed && EventCallback)
+			{
+				EventCallback(Instance, Event, Result, 0, 1, 0, 1, CallbackInfo);
+			}
+		}
+
+		void CompleteLoad(uint64 Serial);
+		void FinishFrame(uint64 Serial);
+	};
+}
+
+struct TEInstance_
+{
+	TSharedRef<UE::TouchEngine::Stub::Private::FInstanceState, ESPMode::ThreadSafe> State;
+
+	TEInstance_()
+		: State(MakeShared<UE::TouchEngine::Stub::Private::FInstanceState, ESPMode::ThreadSafe>())
+	{
+		State->Instance = this;
+	}
+
+	~TEInstance_()
+	{
+		// Waits for the callbacks being called from the stub thread, and prevents any further one
+		FScopeLock DispatchLock(&State->DispatchMutex);
+		State->bDestroyed = true;
+	}
+};
+
+struct TEFloatBuffer_
+{
+	double Rate = 0.0;
+	uint32 Capacity = 0;
+	uint32 ValueCount = 0;
+	bool bTimeDependent = false;
+	int64 StartTime = 0;
+	TArray<TArray<float>> Channels;
+	TArray<const float*> ChannelPointers;
+	TArray<TArray<ANSICHAR>> Names;
+	TArray<const char*> NamePointers;
+};
+
+struct TETable_
+{
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	/** The cells, row after row. An empty cell is an empty string */
+	TArray<TArray<ANSICHAR>> Cells;
+};
+
+namespace UE::TouchEngine::Stub::Private
+{
+	/** The single thread loads and frames complete on, after their duration */
+	class FStubThread : public FRunnable
+	{
+	public:
+		/** Schedules the given function to be called on the stub thread after the given delay. Returns false if the stub was shut down */
+		static bool Schedule(double DelaySeconds, TUniqueFunction<void()> Function)
+		{
+			FScopeLock Lock(&SingletonMutex);
+			if (bIsShutDown)
+			{
+				return false;
+			}
+			if (!Singleton)
+			{
+				Singleton = MakeUnique<FStubThread>();
+			}
+			Singleton->Enqueue(FPlatformTime::Seconds() + FMath::Max(DelaySeconds, 0.0), MoveTemp(Function));
+			return true;
+		}
+
+		static void Shutdown()
+		{
+			TUniquePtr<FStubThread> ThreadToStop;
+			{
+				FScopeLock Lock(&SingletonMutex);
+				bIsShutDown = true;
+				ThreadToStop = MoveTemp(Singleton);
+			}
+			// Destroyed outside of the lock, as the tasks being run might schedule other ones
+			ThreadToStop.Reset();
+		}
+
+		FStubThread()
+			: WakeUpEvent(FPlatformProcess::GetSynchEventFromPool())
+		{
+			Thread = FRunnableThread::Create(this, TEXT("TouchEngineStub"), 0, TPri_Normal);
+		}
+
+		virtual ~FStubThread() override
+		{
+			Stop();
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+			}
+			FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+		}
+
+		//~ Begin FRunnable Interface
+		virtual uint32 Run() override
+		{
+			while (!bStopping)
+			{
+				TUniqueFunction<void()> Function;
+				double WaitSeconds = 0.1;
+				{
+					FScopeLock Lock(&TasksMutex);
+					if (!Tasks.IsEmpty())
+					{
+						const double Now = FPlatformTime::Seconds();
+						if (Tasks[0].DueTime <= Now)
+						{
+							Function = MoveTemp(Tasks[0].Function);
+							Tasks.RemoveAt(0, 1, EAllowShrinking::No);
+						}
+						else
+						{
+							WaitSeconds = FMath::Min(Tasks[0].DueTime - Now, WaitSeconds);
+						}
+					}
+				}
+
+				if (Function)
+				{
+					Function();
+				}
+				else
+				{
+					WakeUpEvent->Wait(FTimespan::FromSeconds(WaitSeconds));
+				}
+			}
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping = true;
+			WakeUpEvent->Trigger();
+		}
+		//~ End FRunnable Interface
+
+	private:
+		struct FTask
+		{
+			double DueTime;
+			TUniqueFunction<void()> Function;
+		};
+
+		static inline FCriticalSection SingletonMutex;
+		static inline TUniquePtr<FStubThread> Singleton;
+		static inline bool bIsShutDown = false;
+
+		FCriticalSection TasksMutex;
+		/** Sorted by DueTime. Tasks due at the same time run in the order they were scheduled */
+		TArray<FTask> Tasks;
+		FEvent* WakeUpEvent;
+		FRunnableThread* Thread = nullptr;
+		std::atomic<bool> bStopping { false };
+
+		void Enqueue(double DueTime, TUniqueFunction<void()> Function)
+		{
+			{
+				FScopeLock Lock(&TasksMutex);
+				int32 Index = Tasks.Num();
+				while (Index > 0 && Tasks[Index - 1].DueTime > DueTime)
+				{
+					--Index;
+				}
+				Tasks.Insert(FTask{ DueTime, MoveTemp(Function) }, Index);
+			}
+			WakeUpEvent->Trigger();
+		}
+	};
+
+	static FCriticalSection RegisteredToxesMutex;
+	static TMap<FString, FStubTox> RegisteredToxes;
+	static std::atomic<uint64> NumInstanceCalls { 0 };
+	static std::atomic<uint64> NumFloatBufferCreateCalls { 0 };
+	static std::atomic<uint64> NumLoadCalls { 0 };
+
+	static FString NormalizeToxPath(const FString& ToxPath)
+	{
+		FString FullPath = FPaths::ConvertRelativePathToFull(ToxPath);
+		FPaths::NormalizeFilename(FullPath);
+		return FullPath;
+	}
+
+	/** Returns the state of the given instance and counts the call. Null if the instance is null */
+	static FInstanceState* GetState(TEInstance* Instance)
+	{
+		NumInstanceCalls.fetch_add(1, std::memory_order_relaxed);
+		return Instance ? &Instance->State.Get() : nullptr;
+	}
+
+	/** Calls Function with the link matching Identifier while holding the instance mutex */
+	template<typename FunctionType>
+	static TEResult WithLink(TEInstance* Instance, const char* Identifier, FunctionType&& Function)
+	{
+		FInstanceState* State = GetState(Instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+		FScopeLock Lock(&State->Mutex);
+		FLinkState* Link = State->FindLink(Identifier);
+		return Link ? Function(*Link) : TEResultNoMatchingEntity;
+	}
+
+	/** Calls Function with the input link matching Identifier while holding the instance mutex, if it has the given type */
+	template<typename FunctionType>
+	static TEResult WithInputLink(TEInstance* Instance, const char* Identifier, TELinkType Type, FunctionType&& Function)
+	{
+		return WithLink(Instance, Identifier, [Type, &Function](FLinkState& Link)
+		{
+			return Link.Desc.Scope == TEScopeInput && Link.Desc.Type == Type ? Function(Link) : TEResultBadUsage;
+		});
+	}
+
+	/** Same as WithLink, for the control functions of the stub which are not counted as TouchEngine calls */
+	template<typename FunctionType>
+	static TEResult WithLink(TEInstance* Instance, const FString& Identifier, FunctionType&& Function)
+	{
+		if (!Instance)
+		{
+			return TEResultBadUsage;
+		}
+		FInstanceState& State = Instance->State.Get();
+		FScopeLock Lock(&State.Mutex);
+		FLinkState* Link = State.Links.Find(Identifier);
+		return Link ? Function(*Link) : TEResultNoMatchingEntity;
+	}
+
+	static TEFloatBuffer* CreateFloatBuffer(double Rate, int32 NumChannels, uint32 Capacity, const char* const* Names, bool bTimeDependent)
+	{
+		if (NumChannels < 0)
+		{
+			return nullptr;
+		}
+		TEFloatBuffer* Buffer = CreateObject<TEFloatBuffer>(TEObjectTypeFloatBuffer);
+		Buffer->Rate = Rate;
+		Buffer->Capacity = Capacity;
+		Buffer->bTimeDependent = bTimeDependent;
+		Buffer->Channels.SetNum(NumChannels);
+		for (TArray<float>& Channel : Buffer->Channels)
+		{
+			Channel.SetNumZeroed(Capacity);
+			Buffer->ChannelPointers.Add(Channel.GetData());
+		}
+		if (Names)
+		{
+			Buffer->Names.Reserve(NumChannels);
+			for (int32 Index = 0; Index < NumChannels; ++Index)
+			{
+				Buffer->NamePointers.Add(Buffer->Names.Add_GetRef(CopyCString(Names[Index])).GetData());
+			}
+		}
+		return Buffer;
+	}
+
+	static TEFloatBuffer* CopyFloatBuffer(const TEFloatBuffer* Source)
+	{
+		if (!Source)
+		{
+			return nullptr;
+		}
+		TEFloatBuffer* Buffer = CreateFloatBuffer(Source->Rate, Source->Channels.Num(), Source->Capacity, Source->NamePointers.Num() > 0 ? Source->NamePointers.GetData() : nullptr, Source->bTimeDependent);
+		for (int32 Index = 0; Index < Source->Channels.Num(); ++Index)
+		{
+			Buffer->Channels[Index] = Source->Channels[Index];
+			Buffer->ChannelPointers[Index] = Buffer->Channels[Index].GetData();
+		}
+		Buffer->ValueCount = Source->ValueCount;
+		Buffer->StartTime = Source->StartTime;
+		return Buffer;
+	}
+
+	/** Whether the values of Source can be copied to Destination without changing its capacity, channels or names */
+	static bool HasSameLayout(const TEFloatBuffer& Destination, const TEFloatBuffer& Source)
+	{
+		if (Destination.Rate != Source.Rate || Destination.Capacity != Source.Capacity || Destination.bTimeDependent != Source.bTimeDependent
+			|| Destination.Channels.Num() != Source.Channels.Num() || Destination.NamePointers.Num() != Source.NamePointers.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Source.NamePointers.Num(); ++Index)
+		{
+			if (FCStringAnsi::Strcmp(Destination.NamePointers[Index], Source.NamePointers[Index]) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static TETable* CopyTable(const TETable* Source)
+	{
+		if (!Source)
+		{
+			return nullptr;
+		}
+		TETable* Table = CreateObject<TETable>(TEObjectTypeTable);
+		Table->NumRows = Source->NumRows;
+		Table->NumColumns = Source->NumColumns;
+		Table->Cells = Source->Cells;
+		return Table;
+	}
+
+	void FInstanceState::CompleteLoad(uint64 Serial)
+	{
+		TEResult Result;
+		{
+			FScopeLock Lock(&Mutex);
+			if (LoadSerial != Serial || LoadState != ELoadState::Loading)
+			{
+				return;
+			}
+			Result = Tox.LoadResult;
+			if (TEResultGetSeverity(Result) == TESeverityError)
+			{
+				LoadState = ELoadState::Unloaded;
+				ResetLinks();
+			}
+			else
+			{
+				LoadState = ELoadState::Loaded;
+				CreateLinks();
+			}
+		}
+		SendEventFromStubThread(TEEventInstanceDidLoad, Result);
+	}
+
+	void FInstanceState::FinishFrame(uint64 Serial)
+	{
+		FStubFrame Frame;
+		TFunction<void(FStubFrame&)> OnCookFrame;
+		double CookDurationSeconds;
+		{
+			FScopeLock Lock(&Mutex);
+			if (CookingFrameSerial != Serial)
+			{
+				return;
+			}
+			Frame.Instance = Instance;
+			Frame.FrameIndex = NumFramesStarted - 1;
+			Frame.TimeValue = CookingTimeValue;
+			Frame.TimeScale = CookingTimeScale;
+			OnCookFrame = Tox.OnCookFrame;
+			CookDurationSeconds = Tox.CookDurationSeconds;
+		}
+
+		// The outputs are updated without the mutex, as the callback can use the TouchEngine API
+		if (OnCookFrame)
+		{
+			OnCookFrame(Frame);
+		}
+
+		int64 StartTimeValue;
+		{
+			FScopeLock Lock(&Mutex);
+			if (CookingFrameSerial != Serial) // Cancelled while the outputs were updated
+			{
+				return;
+			}
+			CookingFrameSerial = 0;
+			StartTimeValue = Frame.bDropped && PreviousFrameTimeValue.IsSet() ? PreviousFrameTimeValue.GetValue() : Frame.TimeValue;
+			PreviousFrameTimeValue = StartTimeValue;
+		}
+
+		FScopeLock DispatchLock(&DispatchMutex);
+		if (bDestroyed)
+		{
+			return;
+		}
+		if (LinkCallback)
+		{
+			for (const FString& Identifier : Frame.ChangedLinks)
+			{
+				const TArray<ANSICHAR> IdentifierUTF8 = ToUTF8(Identifier);
+				LinkCallback(Instance, TELinkEventValueChange, IdentifierUTF8.GetData(), CallbackInfo);
+			}
+		}
+		if (EventCallback)
+		{
+			EventCallback(Instance, TEEventFrameDidFinish, Frame.Result, StartTimeValue, Frame.TimeScale, StartTimeValue, Frame.TimeScale, CallbackInfo);
+		}
+		if (const TEInstanceStatisticsCallback Callback = StatisticsCallback.load())
+		{
+			const TEInstanceStatistics Statistics { 0, 0, static_cast<int64_t>(CookDurationSeconds * 1e9), -1, 1, Frame.bDropped ? 1 : 0 };
+			Callback(Instance, &Statistics, CallbackInfo);
+		}
+	}
+}
+
+using namespace UE::TouchEngine::Stub;
+using namespace UE::TouchEngine::Stub::Private;
+
+extern "C"
+{
+	// TEObject
+
+	TEObject* TERetain(TEObject* object)
+	{
+		if (object)
+		{
+			GetHeader(object)->RefCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		return object;
+	}
+
+	void TERelease_(TEObject** object)
+	{
+		if (!object || !*object)
+		{
+			return;
+		}
+		FObjectHeader* Header = GetHeader(*object);
+		void* Object = *object;
+		*object = nullptr;
+		if (Header->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Header->Destroy(Object);
+			Header->~FObjectHeader();
+			FMemory::Free(Header);
+		}
+	}
+
+	TEObjectType TEGetType(const TEObject* object)
+	{
+		return object ? GetHeader(object)->Type : TEObjectTypeUnknown;
+	}
+
+	// TEResult
+
+	const char* TEResultGetDescription(TEResult result)
+	{
+		switch (result)
+		{
+		case TEResultSuccess: return "Success";
+		case TEResultInsufficientMemory: return "Insufficient memory";
+		case TEResultGPUAllocationFailed: return "GPU allocation failed";
+		case TEResultTextureFormatNotSupported: return "Texture format not supported";
+		case TEResultTextureComponentMapNotSupported: return "Texture component map not supported";
+		case TEResultExecutableError: return "TouchEngine executable error";
+		case TEResultInternalError: return "Internal error";
+		case TEResultMissingResource: return "Missing resource";
+		case TEResultDroppedSamples: return "Samples were dropped";
+		case TEResultMissedSamples: return "Samples were missed";
+		case TEResultBadUsage: return "Bad usage";
+		case TEResultNoMatchingEntity: return "No matching entity";
+		case TEResultCancelled: return "Cancelled";
+		case TEResultExpiredKey: return "Expired key";
+		case TEResultNoKey: return "No key";
+		case TEResultKeyError: return "Key error";
+		case TEResultFileError: return "File error";
+		case TEResultNewerFileVersion: return "Newer file version";
+		case TEResultTouchEngineNotFound: return "TouchEngine not found";
+		case TEResultTouchEngineBadPath: return "TouchEngine bad path";
+		case TEResultFailedToLaunchTouchEngine: return "Failed to launch TouchEngine";
+		case TEResultFeatureNotSupportedBySystem: return "Feature not supported by the stub TouchEngine";
+		case TEResultOlderEngineVersion: return "Older engine version";
+		case TEResultIncompatibleEngineVersion: return "Incompatible engine version";
+		case TEResultPermissionDenied: return "Permission denied";
+		case TEResultComponentErrors: return "Component errors";
+		case TEResultComponentWarnings: return "Component warnings";
+		default: return nullptr;
+		}
+	}
+
+	TESeverity TEResultGetSeverity(TEResult result)
+	{
+		switch (result)
+		{
+		case TEResultSuccess:
+			return TESeverityNone;
+		case TEResultTextureComponentMapNotSupported:
+		case TEResultDroppedSamples:
+		case TEResultMissedSamples:
+		case TEResultOlderEngineVersion:
+		case TEResultComponentWarnings:
+			return TESeverityWarning;
+		default:
+			return TESeverityError;
+		}
+	}
+
+	// TEFloatBuffer
+
+	TEFloatBuffer* TEFloatBufferCreate(double rate, int32_t channels, uint32_t capacity, const char* const* names)
+	{
+		NumFloatBufferCreateCalls.fetch_add(1, std::memory_order_relaxed);
+		return CreateFloatBuffer(rate, channels, capacity, names, false);
+	}
+
+	TEFloatBuffer* TEFloatBufferCreateTimeDependent(double rate, int32_t channels, uint32_t capacity, const char* const* names)
+	{
+		NumFloatBufferCreateCalls.fetch_add(1, std::memory_order_relaxed);
+		return CreateFloatBuffer(rate, channels, capacity, names, true);
+	}
+
+	TEFloatBuffer* TEFloatBufferCreateCopy(const TEFloatBuffer* buffer)
+	{
+		return CopyFloatBuffer(buffer);
+	}
+
+	TEResult TEFloatBufferSetValues(TEFloatBuffer* buffer, const float** values, uint32_t count)
+	{
+		if (!buffer || !values || count > buffer->Capacity)
+		{
+			return TEResultBadUsage;
+		}
+		for (int32 Index = 0; Index < buffer->Channels.Num(); ++Index)
+		{
+			FMemory::Memcpy(buffer->Channels[Index].GetData(), values[Index], count * sizeof(float));
+		}
+		buffer->ValueCount = count;
+		return TEResultSuccess;
+	}
+
+	TEResult TEFloatBufferSetStartTime(TEFloatBuffer* buffer, int64_t start)
+	{
+		if (!buffer || !buffer->bTimeDependent)
+		{
+			return TEResultBadUsage;
+		}
+		buffer->StartTime = start;
+		return TEResultSuccess;
+	}
+
+	const float* const* TEFloatBufferGetValues(const TEFloatBuffer* buffer)
+	{
+		return buffer && buffer->ChannelPointers.Num() > 0 ? buffer->ChannelPointers.GetData() : nullptr;
+	}
+
+	bool TEFloatBufferIsTimeDependent(const TEFloatBuffer* buffer)
+	{
+		return buffer && buffer->bTimeDependent;
+	}
+
+	int64_t TEFloatBufferGetStartTime(const TEFloatBuffer* buffer)
+	{
+		return buffer ? buffer->StartTime : 0;
+	}
+
+	uint32_t TEFloatBufferGetCapacity(const TEFloatBuffer* buffer)
+	{
+		return buffer ? buffer->Capacity : 0;
+	}
+
+	double TEFloatBufferGetRate(const TEFloatBuffer* buffer)
+	{
+		return buffer ? buffer->Rate : 0.0;
+	}
+
+	int32_t TEFloatBufferGetChannelCount(const TEFloatBuffer* buffer)
+	{
+		return buffer ? buffer->Channels.Num() : 0;
+	}
+
+	uint32_t TEFloatBufferGetValueCount(const TEFloatBuffer* buffer)
+	{
+		return buffer ? buffer->ValueCount : 0;
+	}
+
+	const char* const* TEFloatBufferGetChannelNames(const TEFloatBuffer* buffer)
+	{
+		return buffer && buffer->NamePointers.Num() > 0 ? buffer->NamePointers.GetData() : nullptr;
+	}
+
+	// TETable
+
+	TETable* TETableCreate(void)
+	{
+		return CreateObject<TETable>(TEObjectTypeTable);
+	}
+
+	TETable* TETableCreateCopy(const TETable* table)
+	{
+		return CopyTable(table);
+	}
+
+	int32_t TETableGetRowCount(const TETable* table)
+	{
+		return table ? table->NumRows : 0;
+	}
+
+	int32_t TETableGetColumnCount(const TETable* table)
+	{
+		return table ? table->NumColumns : 0;
+	}
+
+	const char* TETableGetStringValue(const TETable* table, int32_t row, int32_t column)
+	{
+		if (!table || row < 0 || row >= table->NumRows || column < 0 || column >= table->NumColumns)
+		{
+			return nullptr;
+		}
+		const TArray<ANSICHAR>& Cell = table->Cells[row * table->NumColumns + column];
+		return Cell.Num() > 0 ? Cell.GetData() : "";
+	}
+
+	void TETableResize(TETable* table, int32_t rows, int32_t columns)
+	{
+		if (!table || rows < 0 || columns < 0)
+		{
+			return;
+		}
+		TArray<TArray<ANSICHAR>> Cells;
+		Cells.SetNum(rows * columns);
+		for (int32 Row = 0; Row < FMath::Min(rows, table->NumRows); ++Row)
+		{
+			for (int32 Column = 0; Column < FMath::Min(columns, table->NumColumns); ++Column)
+			{
+				Cells[Row * columns + Column] = MoveTemp(table->Cells[Row * table->NumColumns + Column]);
+			}
+		}
+		table->Cells = MoveTemp(Cells);
+		table->NumRows = rows;
+		table->NumColumns = columns;
+	}
+
+	TEResult TETableSetStringValue(TETable* table, int32_t row, int32_t column, const char* value)
+	{
+		if (!table || row < 0 || row >= table->NumRows || column < 0 || column >= table->NumColumns)
+		{
+			return TEResultBadUsage;
+		}
+		table->Cells[row * table->NumColumns + column] = CopyCString(value);
+		return TEResultSuccess;
+	}
+
+	// TEInstance
+
+	TEResult TEInstanceCreate(TEInstanceEventCallback event_callback, TEInstanceLinkCallback link_callback, void* callback_info, TEInstance** instance)
+	{
+		NumInstanceCalls.fetch_add(1, std::memory_order_relaxed);
+		if (!instance)
+		{
+			return TEResultBadUsage;
+		}
+		if (!UE::TouchEngine::Stub::IsEnabled())
+		{
+			*instance = nullptr;
+			return TEResultTouchEngineNotFound;
+		}
+		TEInstance* NewInstance = CreateObject<TEInstance>(TEObjectTypeInstance);
+		NewInstance->State->EventCallback = event_callback;
+		NewInstance->State->LinkCallback = link_callback;
+		NewInstance->State->CallbackInfo = callback_info;
+		*instance = NewInstance;
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceConfigure(TEInstance* instance, const char* path, TETimeMode mode)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+		FScopeLock Lock(&State->Mutex);
+		State->ToxPath = path ? FString(UTF8_TO_TCHAR(path)) : FString();
+		State->TimeMode = mode;
+		State->LoadState = ELoadState::Unloaded;
+		++State->LoadSerial;
+		State->ResetLinks();
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceGetConfiguredEnginePath(TEInstance* instance, TEString** string)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State || !string)
+		{
+			return TEResultBadUsage;
+		}
+		FScopeLock Lock(&State->Mutex);
+		*string = CreateObject<FStubString>(TEObjectTypeString, State->ToxPath.IsEmpty() ? FString() : FString(TEXT("StubTouchDesigner")));
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceLoad(TEInstance* instance)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+		NumLoadCalls.fetch_add(1, std::memory_order_relaxed);
+
+		uint64 Serial;
+		double LoadDurationSeconds;
+		{
+			FScopeLock Lock(&State->Mutex);
+			if (State->ToxPath.IsEmpty())
+			{
+				State->Tox = FStubTox();
+			}
+			else
+			{
+				FScopeLock RegistryLock(&RegisteredToxesMutex);
+				if (const FStubTox* Tox = RegisteredToxes.Find(NormalizeToxPath(State->ToxPath)))
+				{
+					State->Tox = *Tox;
+				}
+				else
+				{
+					State->Tox = FStubTox();
+					State->Tox.LoadResult = TEResultFileError;
+				}
+			}
+			State->ResetLinks();
+			State->LoadState = ELoadState::Loading;
+			State->NumFramesStarted = 0;
+			State->PreviousFrameTimeValue.Reset();
+			Serial = ++State->LoadSerial;
+			LoadDurationSeconds = State->Tox.LoadDurationSeconds;
+		}
+
+		const bool bScheduled = FStubThread::Schedule(LoadDurationSeconds, [WeakState = State->AsWeak(), Serial]()
+		{
+			if (const TSharedPtr<FInstanceState, ESPMode::ThreadSafe> State = WeakState.Pin())
+			{
+				State->CompleteLoad(Serial);
+			}
+		});
+		return bScheduled ? TEResultSuccess : TEResultInternalError;
+	}
+
+	TEResult TEInstanceUnload(TEInstance* instance)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+
+		bool bWasLoading;
+		TOptional<TPair<int64, int32>> CancelledFrameTime;
+		{
+			FScopeLock Lock(&State->Mutex);
+			bWasLoading = State->LoadState == ELoadState::Loading;
+			if (State->CookingFrameSerial != 0)
+			{
+				CancelledFrameTime = TPair<int64, int32>(State->CookingTimeValue, State->CookingTimeScale);
+			}
+			State->LoadState = ELoadState::Unloaded;
+			++State->LoadSerial;
+			State->ResetLinks();
+		}
+
+		// Like TouchEngine, an interrupted load finishes with TEResultCancelled before the instance reports it is unloaded
+		const bool bScheduled = FStubThread::Schedule(0.0, [WeakState = State->AsWeak(), bWasLoading, CancelledFrameTime]()
+		{
+			if (const TSharedPtr<FInstanceState, ESPMode::ThreadSafe> State = WeakState.Pin())
+			{
+				if (CancelledFrameTime)
+				{
+					FScopeLock DispatchLock(&State->DispatchMutex);
+					if (!State->bDestroyed && State->EventCallback)
+					{
+						State->EventCallback(State->Instance, TEEventFrameDidFinish, TEResultCancelled, CancelledFrameTime->Key, CancelledFrameTime->Value, CancelledFrameTime->Key, CancelledFrameTime->Value, State->CallbackInfo);
+					}
+				}
+				if (bWasLoading)
+				{
+					State->SendEventFromStubThread(TEEventInstanceDidLoad, TEResultCancelled);
+				}
+				State->SendEventFromStubThread(TEEventInstanceDidUnload, TEResultSuccess);
+			}
+		});
+		return bScheduled ? TEResultSuccess : TEResultInternalError;
+	}
+
+	TEResult TEInstanceResume(TEInstance* instance)
+	{
+		return GetState(instance) ? TEResultSuccess : TEResultBadUsage;
+	}
+
+	TEResult TEInstanceSetFrameRate(TEInstance* instance, int64_t numerator, int32_t denominator)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State || numerator <= 0 || denominator <= 0)
+		{
+			return TEResultBadUsage;
+		}
+		FScopeLock Lock(&State->Mutex);
+		State->FrameRateNumerator = numerator;
+		State->FrameRateDenominator = denominator;
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceSetStatisticsCallback(TEInstance* instance, TEInstanceStatisticsCallback callback)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+		State->StatisticsCallback = callback;
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceAssociateGraphicsContext(TEInstance* instance, TEGraphicsContext* context)
+	{
+		// The stub does not exchange textures, so any context is accepted
+		return GetState(instance) ? TEResultSuccess : TEResultBadUsage;
+	}
+
+	TEResult TEInstanceAddTextureTransfer(TEInstance* instance, TETexture* texture, TESemaphore* semaphore, uint64_t value)
+	{
+		GetState(instance);
+		return TEResultFeatureNotSupportedBySystem;
+	}
+
+	bool TEInstanceHasTextureTransfer(TEInstance* instance, const TETexture* texture)
+	{
+		GetState(instance);
+		return false;
+	}
+
+	TEResult TEInstanceGetTextureTransfer(TEInstance* instance, const TETexture* texture, TESemaphore** semaphore, uint64_t* waitValue)
+	{
+		GetState(instance);
+		if (semaphore)
+		{
+			*semaphore = nullptr;
+		}
+		return TEResultFeatureNotSupportedBySystem;
+	}
+
+	TEResult TEInstanceStartFrameAtTime(TEInstance* instance, int64_t time_value, int32_t time_scale, bool discontinuity)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+
+		uint64 Serial;
+		double CookDurationSeconds;
+		{
+			FScopeLock Lock(&State->Mutex);
+			if (State->LoadState != ELoadState::Loaded || State->CookingFrameSerial != 0)
+			{
+				return TEResultBadUsage;
+			}
+			if (State->TimeMode == TETimeInternal)
+			{
+				State->CookingTimeScale = static_cast<int32>(FMath::Clamp<int64>(State->FrameRateNumerator, 1, MAX_int32));
+				State->CookingTimeValue = State->NumFramesStarted * State->FrameRateDenominator;
+			}
+			else if (time_scale > 0)
+			{
+				State->CookingTimeValue = time_value;
+				State->CookingTimeScale = time_scale;
+			}
+			else
+			{
+				return TEResultBadUsage;
+			}
+			Serial = State->CookingFrameSerial = ++State->LastFrameSerial;
+			++State->NumFramesStarted;
+			CookDurationSeconds = State->Tox.CookDurationSeconds;
+		}
+
+		const bool bScheduled = FStubThread::Schedule(CookDurationSeconds, [WeakState = State->AsWeak(), Serial]()
+		{
+			if (const TSharedPtr<FInstanceState, ESPMode::ThreadSafe> State = WeakState.Pin())
+			{
+				State->FinishFrame(Serial);
+			}
+		});
+		if (!bScheduled)
+		{
+			FScopeLock Lock(&State->Mutex);
+			State->CookingFrameSerial = 0;
+			return TEResultInternalError;
+		}
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceCancelFrame(TEInstance* instance)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State)
+		{
+			return TEResultBadUsage;
+		}
+
+		int64 TimeValue;
+		int32 TimeScale;
+		{
+			FScopeLock Lock(&State->Mutex);
+			if (State->CookingFrameSerial == 0)
+			{
+				return TEResultSuccess;
+			}
+			State->CookingFrameSerial = 0;
+			TimeValue = State->CookingTimeValue;
+			TimeScale = State->CookingTimeScale;
+		}
+
+		// Like TouchEngine, the frame is reported as cancelled before TEInstanceCancelFrame returns
+		if (State->EventCallback)
+		{
+			State->EventCallback(instance, TEEventFrameDidFinish, TEResultCancelled, TimeValue, TimeScale, TimeValue, TimeScale, State->CallbackInfo);
+		}
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceLinkGetChildren(TEInstance* instance, const char* identifier, TEStringArray** children)
+	{
+		if (!children)
+		{
+			return TEResultBadUsage;
+		}
+		*children = nullptr;
+		if (!identifier)
+		{
+			FInstanceState* State = GetState(instance);
+			if (!State)
+			{
+				return TEResultBadUsage;
+			}
+			FScopeLock Lock(&State->Mutex);
+			TArray<FString> Groups = State->LinkGroups[TEScopeInput];
+			Groups.Append(State->LinkGroups[TEScopeOutput]);
+			*children = CreateObject<FStubStringArray>(TEObjectTypeStringArray, Groups);
+			return TEResultSuccess;
+		}
+		return WithLink(instance, identifier, [children](const FLinkState& Link)
+		{
+			*children = CreateObject<FStubStringArray>(TEObjectTypeStringArray, Link.Children);
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceGetLinkGroups(TEInstance* instance, TEScope scope, TEStringArray** groups)
+	{
+		FInstanceState* State = GetState(instance);
+		if (!State || !groups || (scope != TEScopeInput && scope != TEScopeOutput))
+		{
+			return TEResultBadUsage;
+		}
+		FScopeLock Lock(&State->Mutex);
+		*groups = CreateObject<FStubStringArray>(TEObjectTypeStringArray, State->LinkGroups[scope]);
+		return TEResultSuccess;
+	}
+
+	TEResult TEInstanceLinkGetInfo(TEInstance* instance, const char* identifier, TELinkInfo** info)
+	{
+		if (!info)
+		{
+			return TEResultBadUsage;
+		}
+		*info = nullptr;
+		return WithLink(instance, identifier, [info](const FLinkState& Link)
+		{
+			FStubLinkInfo* LinkInfo = CreateObject<FStubLinkInfo>(TEObjectTypeLinkInfo);
+			LinkInfo->LabelStorage = ToUTF8(Link.Desc.Label);
+			LinkInfo->NameStorage = ToUTF8(Link.Desc.Name);
+			LinkInfo->IdentifierStorage = ToUTF8(Link.Desc.Identifier);
+			LinkInfo->scope = Link.Desc.Scope;
+			LinkInfo->intent = Link.Desc.Intent;
+			LinkInfo->type = Link.Desc.Type;
+			LinkInfo->domain = Link.Desc.Domain;
+			LinkInfo->count = Link.IsContainer() ? Link.Children.Num() : Link.Desc.Count;
+			LinkInfo->label = LinkInfo->LabelStorage.GetData();
+			LinkInfo->name = LinkInfo->NameStorage.GetData();
+			LinkInfo->identifier = LinkInfo->IdentifierStorage.GetData();
+			*info = LinkInfo;
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkGetChoices(TEInstance* instance, const char* identifier, TEStringArray** labels, TEStringArray** values)
+	{
+		if (!labels)
+		{
+			return TEResultBadUsage;
+		}
+		*labels = nullptr;
+		if (values)
+		{
+			*values = nullptr;
+		}
+		return WithLink(instance, identifier, [labels, values](const FLinkState& Link)
+		{
+			if (Link.Desc.ChoiceLabels.Num() > 0)
+			{
+				*labels = CreateObject<FStubStringArray>(TEObjectTypeStringArray, Link.Desc.ChoiceLabels);
+			}
+			if (values && Link.Desc.ChoiceValues.Num() > 0)
+			{
+				*values = CreateObject<FStubStringArray>(TEObjectTypeStringArray, Link.Desc.ChoiceValues);
+			}
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetInterest(TEInstance* instance, const char* identifier, TELinkInterest interest)
+	{
+		return WithLink(instance, identifier, [](const FLinkState&) { return TEResultSuccess; });
+	}
+
+	bool TEInstanceLinkHasValue(TEInstance* instance, const char* identifier, TELinkValue which, int32_t index)
+	{
+		bool bHasValue = false;
+		WithLink(instance, identifier, [which, index, &bHasValue](const FLinkState& Link)
+		{
+			if (const TArray<double>* Values = Link.GetNumericValues(which))
+			{
+				bHasValue = Values->IsValidIndex(index);
+			}
+			else
+			{
+				bHasValue = which == TELinkValueCurrent || which == TELinkValueDefault;
+			}
+			return TEResultSuccess;
+		});
+		return bHasValue;
+	}
+
+	TEResult TEInstanceLinkGetBooleanValue(TEInstance* instance, const char* identifier, TELinkValue which, bool* value)
+	{
+		return WithLink(instance, identifier, [which, value](const FLinkState& Link)
+		{
+			double Value;
+			const TEResult Result = Link.Desc.Type == TELinkTypeBoolean ? Link.CopyNumericValues(which, &Value, 1) : TEResultBadUsage;
+			if (Result == TEResultSuccess && value)
+			{
+				*value = Value != 0.0;
+			}
+			return Result;
+		});
+	}
+
+	TEResult TEInstanceLinkGetDoubleValue(TEInstance* instance, const char* identifier, TELinkValue which, double* value, int32_t count)
+	{
+		return WithLink(instance, identifier, [which, value, count](const FLinkState& Link)
+		{
+			return Link.Desc.Type == TELinkTypeDouble ? Link.CopyNumericValues(which, value, count) : TEResultBadUsage;
+		});
+	}
+
+	TEResult TEInstanceLinkGetIntValue(TEInstance* instance, const char* identifier, TELinkValue which, int32_t* value, int32_t count)
+	{
+		return WithLink(instance, identifier, [which, value, count](const FLinkState& Link)
+		{
+			return Link.Desc.Type == TELinkTypeInt ? Link.CopyNumericValues(which, value, count) : TEResultBadUsage;
+		});
+	}
+
+	TEResult TEInstanceLinkGetStringValue(TEInstance* instance, const char* identifier, TELinkValue which, TEString** string)
+	{
+		if (!string)
+		{
+			return TEResultBadUsage;
+		}
+		*string = nullptr;
+		return WithLink(instance, identifier, [which, string](const FLinkState& Link)
+		{
+			if (!Link.IsString() || (which != TELinkValueCurrent && which != TELinkValueDefault))
+			{
+				return TEResultBadUsage;
+			}
+			*string = CreateObject<FStubString>(TEObjectTypeString, which == TELinkValueCurrent ? Link.String : Link.Desc.DefaultString);
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkGetTextureValue(TEInstance* instance, const char* identifier, TELinkValue which, TETexture** value)
+	{
+		if (!value)
+		{
+			return TEResultBadUsage;
+		}
+		*value = nullptr;
+		return WithLink(instance, identifier, [](const FLinkState& Link)
+		{
+			return Link.Desc.Type == TELinkTypeTexture ? TEResultSuccess : TEResultBadUsage;
+		});
+	}
+
+	TEResult TEInstanceLinkGetTableValue(TEInstance* instance, const char* identifier, TELinkValue which, TETable** value)
+	{
+		if (!value)
+		{
+			return TEResultBadUsage;
+		}
+		*value = nullptr;
+		return WithLink(instance, identifier, [which, value](const FLinkState& Link)
+		{
+			// Like TouchEngine, there are no default values for tables
+			if (Link.Desc.Type != TELinkTypeStringData || which != TELinkValueCurrent)
+			{
+				return TEResultBadUsage;
+			}
+			*value = static_cast<TETable*>(TERetain(Link.Table.get()));
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkGetFloatBufferValue(TEInstance* instance, const char* identifier, TELinkValue which, TEFloatBuffer** value)
+	{
+		if (!value)
+		{
+			return TEResultBadUsage;
+		}
+		*value = nullptr;
+		return WithLink(instance, identifier, [which, value](const FLinkState& Link)
+		{
+			// Like TouchEngine, there are no default values for float buffers
+			if (Link.Desc.Type != TELinkTypeFloatBuffer || which != TELinkValueCurrent)
+			{
+				return TEResultBadUsage;
+			}
+			*value = static_cast<TEFloatBuffer*>(TERetain(Link.FloatBuffer.get()));
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetBooleanValue(TEInstance* instance, const char* identifier, bool value)
+	{
+		return WithInputLink(instance, identifier, TELinkTypeBoolean, [value](FLinkState& Link)
+		{
+			Link.Values = { value ? 1.0 : 0.0 };
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetDoubleValue(TEInstance* instance, const char* identifier, const double* value, int32_t count)
+	{
+		return WithInputLink(instance, identifier, TELinkTypeDouble, [value, count](FLinkState& Link)
+		{
+			if (!value || count <= 0 || count > Link.Values.Num())
+			{
+				return TEResultBadUsage;
+			}
+			for (int32 Index = 0; Index < count; ++Index)
+			{
+				Link.Values[Index] = value[Index];
+			}
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetIntValue(TEInstance* instance, const char* identifier, const int32_t* value, int32_t count)
+	{
+		return WithInputLink(instance, identifier, TELinkTypeInt, [value, count](FLinkState& Link)
+		{
+			if (!value || count <= 0 || count > Link.Values.Num())
+			{
+				return TEResultBadUsage;
+			}
+			for (int32 Index = 0; Index < count; ++Index)
+			{
+				Link.Values[Index] = value[Index];
+			}
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetStringValue(TEInstance* instance, const char* identifier, const char* value)
+	{
+		return WithLink(instance, identifier, [value](FLinkState& Link)
+		{
+			if (Link.Desc.Scope != TEScopeInput || !Link.IsString())
+			{
+				return TEResultBadUsage;
+			}
+			Link.String = value ? FString(UTF8_TO_TCHAR(value)) : FString();
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetTextureValue(TEInstance* instance, const char* identifier, TETexture* texture, TEGraphicsContext* context)
+	{
+		return WithInputLink(instance, identifier, TELinkTypeTexture, [texture](FLinkState&)
+		{
+			// Only clearing the texture is supported, as the stub does not know any texture type
+			return texture ? TEResultFeatureNotSupportedBySystem : TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkSetFloatBufferValue(TEInstance* instance, const char* identifier, const TEFloatBuffer* buffer)
+	{
+		// The buffer is copied, as the caller is free to modify it once the call returns.
+		// The previous copy is overwritten instead when nothing else references it and it has the same layout, so streaming a CHOP does not allocate every frame
+		return WithInputLink(instance, identifier, TELinkTypeFloatBuffer, [buffer](FLinkState& Link)
+		{
+			TEFloatBuffer* Previous = Link.FloatBuffer.get();
+			if (buffer && Previous && GetHeader(Previous)->RefCount.load(std::memory_order_acquire) == 1 && HasSameLayout(*Previous, *buffer))
+			{
+				for (int32 Index = 0; Index < buffer->Channels.Num(); ++Index)
+				{
+					FMemory::Memcpy(Previous->Channels[Index].GetData(), buffer->Channels[Index].GetData(), buffer->Capacity * sizeof(float));
+				}
+				Previous->ValueCount = buffer->ValueCount;
+				Previous->StartTime = buffer->StartTime;
+				return TEResultSuccess;
+			}
+			Link.FloatBuffer.take(CopyFloatBuffer(buffer));
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult TEInstanceLinkAddFloatBuffer(TEInstance* instance, const char* identifier, const TEFloatBuffer* buffer)
+	{
+		return TEInstanceLinkSetFloatBufferValue(instance, identifier, buffer);
+	}
+
+	TEResult TEInstanceLinkSetTableValue(TEInstance* instance, const char* identifier, const TETable* table)
+	{
+		return WithInputLink(instance, identifier, TELinkTypeStringData, [table](FLinkState& Link)
+		{
+			Link.Table.take(CopyTable(table));
+			return TEResultSuccess;
+		});
+	}
+}
+
+namespace UE::TouchEngine::Stub
+{
+	void RegisterTox(const FString& ToxPath, FStubTox Tox)
+	{
+		FScopeLock Lock(&RegisteredToxesMutex);
+		RegisteredToxes.Add(NormalizeToxPath(ToxPath), MoveTemp(Tox));
+	}
+
+	void UnregisterTox(const FString& ToxPath)
+	{
+		FScopeLock Lock(&RegisteredToxesMutex);
+		RegisteredToxes.Remove(NormalizeToxPath(ToxPath));
+	}
+
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, TConstArrayView<double> Values)
+	{
+		return WithLink(Instance, Identifier, [Values](FLinkState& Link)
+		{
+			if (!Link.IsNumeric() || Values.Num() > Link.Values.Num())
+			{
+				return TEResultBadUsage;
+			}
+			for (int32 Index = 0; Index < Values.Num(); ++Index)
+			{
+				Link.Values[Index] = Values[Index];
+			}
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, const FString& Value)
+	{
+		return WithLink(Instance, Identifier, [&Value](FLinkState& Link)
+		{
+			if (!Link.IsString())
+			{
+				return TEResultBadUsage;
+			}
+			Link.String = Value;
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, const TouchObject<TEFloatBuffer>& Value)
+	{
+		return WithLink(Instance, Identifier, [&Value](FLinkState& Link)
+		{
+			if (Link.Desc.Type != TELinkTypeFloatBuffer)
+			{
+				return TEResultBadUsage;
+			}
+			Link.FloatBuffer = Value;
+			return TEResultSuccess;
+		});
+	}
+
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, const TouchObject<TETable>& Value)
+	{
+		return WithLink(Instance, Identifier, [&Value](FLinkState& Link)
+		{
+			if (Link.Desc.Type != TELinkTypeStringData)
+			{
+				return TEResultBadUsage;
+			}
+			Link.Table = Value;
+			return TEResultSuccess;
+		});
+	}
+
+	void SendStatistics(TEInstance* Instance, const TEInstanceStatistics& Statistics)
+	{
+		if (!Instance)
+		{
+			return;
+		}
+		FInstanceState& State = Instance->State.Get();
+		if (const TEInstanceStatisticsCallback Callback = State.StatisticsCallback.load())
+		{
+			Callback(Instance, &Statistics, State.CallbackInfo);
+		}
+	}
+
+	static std::atomic<int32> NumEnableScopes = 0;
+
+	bool IsEnabled()
+	{
+		return NumEnableScopes.load() > 0;
+	}
+
+	FScopedEnable::FScopedEnable()
+	{
+		++NumEnableScopes;
+	}
+
+	FScopedEnable::~FScopedEnable()
+	{
+		--NumEnableScopes;
+	}
+
+	uint64 GetNumInstanceCalls()
+	{
+		return NumInstanceCalls.load(std::memory_order_relaxed);
+	}
+
+	uint64 GetNumFloatBufferCreateCalls()
+	{
+		return NumFloatBufferCreateCalls.load(std::memory_order_relaxed);
+	}
+
+	uint64 GetNumLoadCalls()
+	{
+		return NumLoadCalls.load(std::memory_order_relaxed);
+	}
+
+	void Shutdown()
+	{
+		FStubThread::Shutdown();
+	}
+}
+
+#endif
@@ -0,0 +1,178 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_TOUCHENGINE_STUB
+
+#if !WITH_DEV_AUTOMATION_TESTS
+#error "The stub TouchEngine API is only meant for the automation tests, WITH_TOUCHENGINE_STUB must not be set without them"
+#endif
+
+#include "TouchEngine/TEFloatBuffer.h"
+#include "TouchEngine/TEInstance.h"
+#include "TouchEngine/TETable.h"
+#include "TouchEngine/TouchObject.h"
+
+namespace UE::TouchEngine
+{
+	class FTouchResourceProvider;
+}
+
+/**
+ * In-memory implementation of the TouchEngine C API, compiled in the TouchEngine module instead of the TouchEngine library for the automation tests only,
+ * see TouchEngineAPI.Build.cs. It lets the tests run without TouchDesigner, e.g. on Linux under -nullrhi.
+ *
+ * The stub is disabled until a test enables it with FScopedEnable, so that a build compiling it can never load or cook a tox with fake results:
+ * TEInstanceCreate fails with TEResultTouchEngineNotFound and ITouchEngineModule::IsTouchEngineLibInitialized returns false, like when the library is missing.
+ *
+ * A .tox file loaded by the stub does not need any content: the links TEInstanceLoad finds are the ones registered for its path with RegisterTox.
+ * Loads and frames complete on a single stub thread after the durations given in FStubTox, which is also the thread the TouchEngine callbacks are called from.
+ * Like TouchEngine, cancelling a frame calls the event callback before TEInstanceCancelFrame returns. Textures cannot be exchanged with the stub.
+ */
+namespace UE::TouchEngine::Stub
+{
+	/** A link of a stub .tox file */
+	struct FStubLink
+	{
+		/** The identifier passed to the TouchEngine API. The Label and Name default to it if empty */
+		FString Identifier;
+		/** The group or sequence the link belongs to. Links without parent are the link groups returned by TEInstanceGetLinkGroups */
+		FString ParentIdentifier;
+		FString Label;
+		FString Name;
+		TEScope Scope = TEScopeInput;
+		TELinkType Type = TELinkTypeDouble;
+		TELinkIntent Intent = TELinkIntentNotSpecified;
+		TELinkDomain Domain = TELinkDomainOperator;
+		/** The number of values of Boolean, Double and Int links. The count of groups and sequences is their number of children */
+		int32 Count = 1;
+
+		/** The default values of Boolean, Double and Int links, also their current value once loaded. Zero if empty */
+		TArray<double> DefaultValues;
+		/** The default value of String links, also their current value once loaded */
+		FString DefaultString;
+		/** The limits of Double and Int links, if any, one per value. Also returned as the UI limits */
+		TArray<double> Minimum;
+		TArray<double> Maximum;
+		/** The choices of Int and String links, if any */
+		TArray<FString> ChoiceLabels;
+		TArray<FString> ChoiceValues;
+
+		static FStubLink MakeGroup(const FString& Identifier, TEScope Scope)
+		{
+			FStubLink Link;
+			Link.Identifier = Identifier;
+			Link.Scope = Scope;
+			Link.Type = TELinkTypeGroup;
+			Link.Domain = TELinkDomainNone;
+			return Link;
+		}
+		static FStubLink MakeValue(const FString& Identifier, const FString& ParentIdentifier, TEScope Scope, TELinkType Type, int32 Count = 1)
+		{
+			FStubLink Link;
+			Link.Identifier = Identifier;
+			Link.ParentIdentifier = ParentIdentifier;
+			Link.Scope = Scope;
+			Link.Type = Type;
+			Link.Count = Count;
+			return Link;
+		}
+	};
+
+	/** A frame being cooked by the stub, given to FStubTox::OnCookFrame on the stub thread */
+	struct FStubFrame
+	{
+		TEInstance* Instance = nullptr;
+		/** The number of frames started by the instance before this one */
+		int64 FrameIndex = 0;
+		int64 TimeValue = 0;
+		int32 TimeScale = 1;
+		/** If set, TEEventFrameDidFinish is sent with the start time of the previous frame, which is how TouchEngine reports a dropped frame */
+		bool bDropped = false;
+		/** The result TEEventFrameDidFinish is sent with */
+		TEResult Result = TEResultSuccess;
+		/** The outputs set with SetOutput, for which TELinkEventValueChange is sent before the frame finishes */
+		TArray<FString> ChangedLinks;
+
+		/** Sets the current value of an output link, see SetLinkValue */
+		template<typename ValueType>
+		void SetOutput(const FString& Identifier, const ValueType& Value);
+	};
+
+	/** What TEInstanceLoad finds in a stub .tox file, and how its frames are cooked */
+	struct FStubTox
+	{
+		TArray<FStubLink> Links;
+		/** The result TEEventInstanceDidLoad is sent with */
+		TEResult LoadResult = TEResultSuccess;
+		double LoadDurationSeconds = 0.0;
+		double CookDurationSeconds = 0.0;
+		/** Called on the stub thread for every frame before it finishes, to update the outputs. Can be unset if the outputs never change */
+		TFunction<void(FStubFrame&)> OnCookFrame;
+	};
+
+	/** Whether a FScopedEnable is alive. Can be called from any thread */
+	bool IsEnabled();
+
+	/** Enables the stub for as long as it is alive. Can be nested */
+	class FScopedEnable
+	{
+	public:
+		FScopedEnable();
+		~FScopedEnable();
+		UE_NONCOPYABLE(FScopedEnable);
+	};
+
+	/** Makes TEInstanceLoad find the given links when loading the given .tox file. Can be called again to change what the next loads find */
+	void RegisterTox(const FString& ToxPath, FStubTox Tox);
+	void UnregisterTox(const FString& ToxPath);
+
+	/** Sets the current value of a link without checking its scope or sending TELinkEventValueChange. Returns TEResultBadUsage if the value does not match the type of the link */
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, TConstArrayView<double> Values);
+	inline TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, double Value) { return SetLinkValue(Instance, Identifier, MakeArrayView(&Value, 1)); }
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, const FString& Value);
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, const TouchObject<TEFloatBuffer>& Value);
+	TEResult SetLinkValue(TEInstance* Instance, const FString& Identifier, const TouchObject<TETable>& Value);
+
+	/** Delivers the given statistics to the statistics callback of the instance on the calling thread, as TouchEngine may do from any of its threads */
+	void SendStatistics(TEInstance* Instance, const TEInstanceStatistics& Statistics);
+
+	/** The number of TEInstance functions called so far, from any thread. Used to check that a code path does not call TouchEngine at all */
+	uint64 GetNumInstanceCalls();
+	/** The number of TEFloatBufferCreate and TEFloatBufferCreateTimeDependent calls so far, from any thread. Buffers copied by the stub itself are not counted */
+	uint64 GetNumFloatBufferCreateCalls();
+	/** The number of TEInstanceLoad calls with a valid instance so far, from any thread. Used to check that several requests for the same file share one load */
+	uint64 GetNumLoadCalls();
+
+	/** Creates the resource provider used with the stub, which supports no texture */
+	TSharedPtr<FTouchResourceProvider> CreateResourceProvider();
+
+	/** Stops the stub thread. Pending loads and frames never complete */
+	void Shutdown();
+
+	template<typename ValueType>
+	void FStubFrame::SetOutput(const FString& Identifier, const ValueType& Value)
+	{
+		if (SetLinkValue(Instance, Identifier, Value) == TEResultSuccess)
+		{
+			ChangedLinks.AddUnique(Identifier);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,96 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "Stub/TouchEngineStub.h"
+
+#if WITH_TOUCHENGINE_STUB
+
+#include "Rendering/TouchResourceProvider.h"
+#include "Rendering/Exporting/TouchTextureExporter.h"
+#include "Rendering/Importing/TouchTextureImporter.h"
+#include "Util/FutureSyncPoint.h"
+
+namespace UE::TouchEngine::Stub
+{
+	namespace Private
+	{
+		/** The stub never outputs textures, so there is never anything to import */
+		class FStubTextureImporter : public FTouchTextureImporter
+		{
+		protected:
+			//~ Begin FTouchTextureImporter Interface
+			virtual TSharedPtr<ITouchImportTexture> CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture) override { return nullptr; }
+			virtual FTextureMetaData GetTextureMetaData(const TouchObject<TETexture>& Texture) const override { return {}; }
+			//~ End FTouchTextureImporter Interface
+		};
+
+		/** The stub cannot receive textures, so every export fails */
+		class FStubTextureExporter : public FTouchTextureExporter
+		{
+		public:
+			//~ Begin FTouchTextureExporter Interface
+			virtual bool ShareTexture_RenderThread(const FTouchExportParameters& ParamsConst) override { return false; }
+
+		protected:
+			virtual TSharedPtr<FExportedTouchTexture> CreateTexture(UTexture* InTexture) override { return nullptr; }
+			virtual TEResult AddTETextureTransfer_RenderThread(const FTouchExportParameters& Params, const TSharedRef<FExportedTouchTexture>& Texture) override { return TEResultFeatureNotSupportedBySystem; }
+			//~ End FTouchTextureExporter Interface
+		};
+
+		class FStubResourceProvider : public FTouchResourceProvider
+		{
+		public:
+			FStubResourceProvider()
+				: TextureExporter(MakeShared<FStubTextureExporter>())
+				, TextureImporter(MakeShared<FStubTextureImporter>())
+			{}
+
+			virtual TEGraphicsContext* GetContext() const override { return nullptr; }
+			virtual FTouchLoadInstanceResult ValidateLoadedTouchEngine() override { return FTouchLoadInstanceResult::MakeSuccess(); }
+			virtual TSet<EPixelFormat> GetExportablePixelTypes(TEInstance& InInstance) override { return {}; }
+
+			virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override
+			{
+				TPromise<FTouchSuspendResult> Promise;
+				TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
+
+				TArray<TFuture<FTouchSuspendResult>> Futures;
+				Futures.Emplace(TextureExporter->SuspendAsyncTasks());
+				Futures.Emplace(TextureImporter->SuspendAsyncTasks());
+				FFutureSyncPoint::SyncFutureCompletion<FTouchSuspendResult>(Futures, [Promise = MoveTemp(Promise)]() mutable
+				{
+					Promise.SetValue(FTouchSuspendResult{});
+				});
+
+				return Future;
+			}
+
+		protected:
+			virtual FTouchTextureImporter& GetTextureImporter() override { return TextureImporter.Get(); }
+			virtual FTouchTextureExporter& GetTextureExporter() override { return TextureExporter.Get(); }
+
+		private:
+			TSharedRef<FStubTextureExporter> TextureExporter;
+			TSharedRef<FStubTextureImporter> TextureImporter;
+		};
+	}
+
+	TSharedPtr<FTouchResourceProvider> CreateResourceProvider()
+	{
+		return MakeShared<Private::FStubResourceProvider>();
+	}
+}
+
+#endif
@@ -0,0 +1,102 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+namespace UE::TouchEngine::Tests
+{
+	/**
+	 * Counts the allocations made by the thread which created it, for as long as it is alive, by putting a proxy in front of GMalloc.
+	 * Every call is forwarded to the original allocator, so memory allocated while counting can be freed after and vice versa.
+	 * Only one counter can be alive at a time.
+	 */
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter()
+			: Proxy(GMalloc, FPlatformTLS::GetCurrentThreadId())
+		{
+			check(IsInGameThread());
+			GMalloc = &Proxy;
+		}
+		~FScopedAllocationCounter()
+		{
+			GMalloc = Proxy.Inner;
+		}
+
+		int32 GetNumAllocations() const { return Proxy.NumAllocations.load(); }
+		void Reset() { Proxy.NumAllocations = 0; }
+
+	private:
+		class FCountingMalloc : public FMalloc
+		{
+		public:
+			FCountingMalloc(FMalloc* InInner, uint32 InThreadId)
+				: Inner(InInner)
+				, ThreadId(InThreadId)
+			{}
+
+			FMalloc* Inner;
+			const uint32 ThreadId;
+			std::atomic<int32> NumAllocations = 0;
+
+			virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { Count_AnyThread(); return Inner->Malloc(Count, Alignment); }
+			virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { Count_AnyThread(); return Inner->TryMalloc(Count, Alignment); }
+			virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				if (Count > 0)
+				{
+					Count_AnyThread();
+				}
+				return Inner->Realloc(Original, Count, Alignment);
+			}
+			virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				if (Count > 0)
+				{
+					Count_AnyThread();
+				}
+				return Inner->TryRealloc(Original, Count, Alignment);
+			}
+			virtual void Free(void* Original) override { Inner->Free(Original); }
+			virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+			virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+			virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+			virtual const TCHAR* GetDescriptiveName() override { return TEXT("TouchEngine allocation counter"); }
+
+		private:
+			void Count_AnyThread()
+			{
+				if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+				{
+					++NumAllocations;
+				}
+			}
+		};
+
+		FCountingMalloc Proxy;
+	};
+}
+
+#endif
@@ -0,0 +1,183 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Util/TouchBucketedPool.h"
+#include "Algo/Transform.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	template<typename KeyType, typename ElementType>
+	TArray<ElementType> GetPoolElements(TTouchBucketedPool<KeyType, ElementType>& Pool)
+	{
+		TArray<ElementType> Elements;
+		Pool.ForEach([&Elements](const ElementType& Element) { Elements.Add(Element); });
+		return Elements;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchBucketedPoolAcquireReleaseTest, "TouchEngine.Util.BucketedPool.AcquireRelease", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchBucketedPoolAcquireReleaseTest::RunTest(const FString& Parameters)
+{
+	// Like the texture pools: the key is the description, the element the texture
+	TTouchBucketedPool<int32, int32> Pool;
+	Pool.Add(1, 10);
+	Pool.Add(2, 20);
+	Pool.Add(1, 11);
+	Pool.Add(2, 21);
+	Pool.Add(1, 12);
+	TestEqual(TEXT("Num"), Pool.Num(), 5);
+	TestEqual(TEXT("Buckets"), Pool.GetNumBuckets(), 2);
+	TestTrue(TEXT("The pool is consistent after adding"), Pool.CheckIntegrity());
+
+	int32 NumVisited = 0;
+	TOptional<int32> Acquired = Pool.RemoveOldestInBucket(1, [&NumVisited](const int32&) { ++NumVisited; return true; });
+	TestTrue(TEXT("The oldest element of the bucket is acquired"), Acquired.IsSet() && Acquired.GetValue() == 10);
+	TestEqual(TEXT("Elements visited to acquire the oldest"), NumVisited, 1);
+
+	NumVisited = 0;
+	Acquired = Pool.RemoveOldestInBucket(1, [&NumVisited](const int32& Element) { ++NumVisited; return Element == 12; });
+	TestTrue(TEXT("Elements refused by the predicate are skipped"), Acquired.IsSet() && Acquired.GetValue() == 12);
+	TestEqual(TEXT("Only the elements of the bucket are visited"), NumVisited, 2);
+
+	TestFalse(TEXT("Nothing is acquired from a missing bucket"), Pool.RemoveOldestInBucket(3, [](const int32&) { return true; }).IsSet());
+	TestFalse(TEXT("Nothing is acquired if the predicate refuses everything"), Pool.RemoveOldestInBucket(2, [](const int32&) { return false; }).IsSet());
+	TestTrue(TEXT("The pool is consistent after acquiring"), Pool.CheckIntegrity());
+
+	// Releasing an element makes it the newest of its bucket
+	Pool.Add(1, 10);
+	TestTrue(TEXT("Elements are kept in the order they were released"), Tests::GetPoolElements(Pool) == TArray<int32>{ 20, 11, 21, 10 });
+	Acquired = Pool.RemoveOldestInBucket(1, [](const int32&) { return true; });
+	TestTrue(TEXT("Released elements are acquired after the older ones"), Acquired.IsSet() && Acquired.GetValue() == 11);
+
+	Acquired = Pool.RemoveOldestInBucket(1, [](const int32&) { return true; });
+	TestTrue(TEXT("The last element of a bucket is acquired"), Acquired.IsSet() && Acquired.GetValue() == 10);
+	TestEqual(TEXT("Empty buckets are removed"), Pool.GetNumBuckets(), 1);
+	TestTrue(TEXT("The pool is consistent after emptying a bucket"), Pool.CheckIntegrity());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchBucketedPoolEvictionTest, "TouchEngine.Util.BucketedPool.Eviction", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchBucketedPoolEvictionTest::RunTest(const FString& Parameters)
+{
+	TTouchBucketedPool<int32, int32> Pool;
+	for (int32 Index = 0; Index < 9; ++Index)
+	{
+		Pool.Add(Index % 3, int32(Index));
+	}
+
+	// Like TexturePoolMaintenance, which evicts the oldest textures until the pool is small enough
+	TArray<int32> Evicted;
+	while (Pool.Num() > 4)
+	{
+		TestEqual(TEXT("GetOldest returns the next element to evict"), Pool.GetOldest(), Evicted.Num());
+		Evicted.Add(Pool.RemoveOldest());
+	}
+	TestTrue(TEXT("The oldest elements are evicted first, whatever their bucket"), Evicted == TArray<int32>{ 0, 1, 2, 3, 4 });
+	TestTrue(TEXT("The pool is consistent after evicting"), Pool.CheckIntegrity());
+
+	// Like KeepTexturesAliveForCopy, which removes every texture matching a condition
+	const TArray<int32> Removed = Pool.RemoveAll([](const int32& Element) { return Element % 2 == 0; });
+	TestTrue(TEXT("RemoveAll returns the removed elements oldest first"), Removed == TArray<int32>{ 6, 8 });
+	TestTrue(TEXT("RemoveAll keeps the other elements in order"), Tests::GetPoolElements(Pool) == TArray<int32>{ 5, 7 });
+	TestTrue(TEXT("The pool is consistent after RemoveAll"), Pool.CheckIntegrity());
+
+	Pool.Empty();
+	TestTrue(TEXT("The pool is empty"), Pool.IsEmpty() && Pool.GetNumBuckets() == 0);
+	TestTrue(TEXT("The pool is consistent after Empty"), Pool.CheckIntegrity());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchBucketedPoolIntegrityTest, "TouchEngine.Util.BucketedPool.Integrity", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchBucketedPoolIntegrityTest::RunTest(const FString& Parameters)
+{
+	// Random operations checked against a plain array of (key, element) kept in the order the elements were added
+	TTouchBucketedPool<int32, int32> Pool;
+	TArray<TPair<int32, int32>> Expected;
+	FRandomStream Random(1234);
+	int32 NextElement = 0;
+	int32 NumMismatches = 0;
+	int32 NumCorruptions = 0;
+
+	constexpr int32 NumOperations = 10000;
+	for (int32 Operation = 0; Operation < NumOperations; ++Operation)
+	{
+		const int32 Key = Random.RandRange(0, 7);
+		const int32 Choice = Random.RandRange(0, 9);
+		if (Choice < 5)
+		{
+			Pool.Add(Key, int32(NextElement));
+			Expected.Emplace(Key, NextElement++);
+		}
+		else if (Choice < 8)
+		{
+			// Acquire the oldest even element of the bucket
+			const auto Predicate = [](const int32& Element) { return Element % 2 == 0; };
+			const TOptional<int32> Acquired = Pool.RemoveOldestInBucket(Key, Predicate);
+			const int32 ExpectedIndex = Expected.IndexOfByPredicate([Key, &Predicate](const TPair<int32, int32>& Pair) { return Pair.Key == Key && Predicate(Pair.Value); });
+			if (ExpectedIndex == INDEX_NONE)
+			{
+				NumMismatches += Acquired.IsSet() ? 1 : 0;
+			}
+			else
+			{
+				NumMismatches += Acquired.IsSet() && Acquired.GetValue() == Expected[ExpectedIndex].Value ? 0 : 1;
+				Expected.RemoveAt(ExpectedIndex);
+			}
+		}
+		else if (Choice < 9)
+		{
+			if (!Expected.IsEmpty())
+			{
+				NumMismatches += Pool.RemoveOldest() == Expected[0].Value ? 0 : 1;
+				Expected.RemoveAt(0);
+			}
+		}
+		else
+		{
+			const int32 Divisor = Random.RandRange(5, 20);
+			const TArray<int32> Removed = Pool.RemoveAll([Divisor](const int32& Element) { return Element % Divisor == 0; });
+			TArray<int32> ExpectedRemoved;
+			for (int32 Index = 0; Index < Expected.Num(); ++Index)
+			{
+				if (Expected[Index].Value % Divisor == 0)
+				{
+					ExpectedRemoved.Add(Expected[Index].Value);
+					Expected.RemoveAt(Index--);
+				}
+			}
+			NumMismatches += Removed == ExpectedRemoved ? 0 : 1;
+		}
+
+		NumCorruptions += Pool.CheckIntegrity() ? 0 : 1;
+		NumMismatches += Pool.Num() == Expected.Num() ? 0 : 1;
+	}
+
+	TArray<int32> ExpectedElements;
+	Algo::Transform(Expected, ExpectedElements, [](const TPair<int32, int32>& Pair) { return Pair.Value; });
+	TestTrue(TEXT("The remaining elements are in the order they were added"), Tests::GetPoolElements(Pool) == ExpectedElements);
+	TestEqual(TEXT("Operations which did not match the expected result"), NumMismatches, 0);
+	TestEqual(TEXT("Operations after which the lists were corrupted"), NumCorruptions, 0);
+	return true;
+}
+
+#endif
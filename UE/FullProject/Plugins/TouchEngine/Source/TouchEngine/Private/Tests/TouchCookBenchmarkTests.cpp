@@ -0,0 +1,363 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "Tests/TouchStubHarness.h"
+#include "Logging.h"
+#include "TouchEngineDynamicVariableStruct.h"
+#include "Engine/TEDebug.h"
+#include "Misc/AutomationTest.h"
+#include "Util/TouchHelpers.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchFrameCookerCookCycleBenchmark, "TouchEngine.Benchmarks.FrameCooker.CookCycle", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchFrameCookerCookCycleBenchmark::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("CookCycleBenchmark"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	constexpr int32 NumCooks = 1000;
+	TArray<double> Durations;
+	Durations.Reserve(NumCooks);
+	int32 NumSuccessfulCooks = 0;
+	for (int32 Index = 0; Index < NumCooks; ++Index)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const FCookFrameResult CookFrameResult = Harness.CookAndRelease();
+		Durations.Add(FPlatformTime::Seconds() - StartTime);
+		NumSuccessfulCooks += CookFrameResult.Result == ECookFrameResult::Success ? 1 : 0;
+	}
+
+	TestEqual(TEXT("Successful cooks"), NumSuccessfulCooks, NumCooks);
+	TestEqual(TEXT("Output of the last frame"), Harness.VariableManager->GetDoubleOutput(TEXT("out/frame")), static_cast<double>(NumCooks - 1));
+	TestEqual(TEXT("Value changes received"), Harness.GetNumLinkValueChanges(), NumCooks * 2);
+	Tests::AddDurationInfo(*this, TEXT("Cook cycle"), MoveTemp(Durations));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerGetSetBenchmark, "TouchEngine.Benchmarks.VariableManager.GetSet", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerGetSetBenchmark::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("GetSetBenchmark"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	constexpr int32 NumCalls = 10000;
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+	const FString InputIdentifier = TEXT("in/value");
+	const FString OutputIdentifier = TEXT("out/value");
+	const FTouchLinkHandle InputHandle = VariableManager.GetLinkHandle(InputIdentifier);
+	const FTouchLinkHandle OutputHandle = VariableManager.GetLinkHandle(OutputIdentifier);
+	Stub::SetLinkValue(Harness.Instance, OutputIdentifier, 42.0);
+
+	TArray<double> Value { 0.0 };
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		Value[0] = Index;
+		VariableManager.SetDoubleInput(InputIdentifier, Value);
+	}
+	const double SetByIdentifierTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		Value[0] = Index;
+		VariableManager.SetDoubleInput(InputHandle, Value);
+	}
+	const double SetByHandleTime = FPlatformTime::Seconds() - StartTime;
+
+	double Sum = 0.0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		Sum += VariableManager.GetDoubleOutput(OutputIdentifier);
+	}
+	const double GetByIdentifierTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		Sum += VariableManager.GetDoubleOutput(OutputHandle);
+	}
+	const double GetByHandleTime = FPlatformTime::Seconds() - StartTime;
+
+	double InputValue = 0.0;
+	TEInstanceLinkGetDoubleValue(Harness.Instance, "in/value", TELinkValueCurrent, &InputValue, 1);
+	TestEqual(TEXT("Input value after the last set"), InputValue, static_cast<double>(NumCalls - 1));
+	TestEqual(TEXT("Sum of the outputs read"), Sum, 42.0 * NumCalls * 2);
+	AddInfo(FString::Printf(TEXT("%d calls: SetDoubleInput %.3f ms by identifier, %.3f ms by handle. GetDoubleOutput %.3f ms by identifier, %.3f ms by handle"),
+		NumCalls, SetByIdentifierTime * 1000.0, SetByHandleTime * 1000.0, GetByIdentifierTime * 1000.0, GetByHandleTime * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableContainerCookBenchmark, "TouchEngine.Benchmarks.DynamicVariableContainer.CookInputs", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableContainerCookBenchmark::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("ContainerBenchmark"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	FTouchEngineDynamicVariableContainer Container;
+	Container.ToxParametersLoaded(Harness.VariablesIn, Harness.VariablesOut);
+	FTouchEngineDynamicVariableStruct* InputValue = Container.GetDynamicVariableByIdentifier(TEXT("in/value"));
+	if (!TestNotNull(TEXT("in/value variable"), InputValue))
+	{
+		return false;
+	}
+
+	constexpr int32 NumCooks = 1000;
+	TArray<double> CopyDurations;
+	CopyDurations.Reserve(NumCooks);
+	int32 NumMatchingOutputs = 0;
+	for (int32 Index = 0; Index < NumCooks; ++Index)
+	{
+		const int64 FrameID = Harness.FrameCooker->GetNextFrameID();
+		InputValue->SetValue(static_cast<double>(Index));
+		InputValue->FrameLastUpdated = FrameID;
+
+		const double StartTime = FPlatformTime::Seconds();
+		TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend = Container.CopyInputsForCook(FrameID);
+		CopyDurations.Add(FPlatformTime::Seconds() - StartTime);
+
+		Harness.CookAndRelease(MoveTemp(VariablesToSend));
+		NumMatchingOutputs += Harness.VariableManager->GetDoubleOutput(TEXT("out/value")) == Index ? 1 : 0;
+	}
+
+	TestEqual(TEXT("Outputs matching the inputs sent"), NumMatchingOutputs, NumCooks);
+	Tests::AddDurationInfo(*this, TEXT("CopyInputsForCook"), MoveTemp(CopyDurations));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchFrameCookerCooksInFlightBenchmark, "TouchEngine.Benchmarks.FrameCooker.CooksInFlight", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchFrameCookerCooksInFlightBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCooks = 200;
+	constexpr double CookSeconds = 0.001;
+	constexpr double ProcessingSeconds = 0.001; // The time spent reading the outputs and broadcasting OnEndFrame before releasing each result
+
+	TArray<double, TInlineAllocator<2>> TotalSeconds;
+	for (const int32 MaxCooksInFlight : {1, 2})
+	{
+		Stub::FStubTox Tox = Tests::MakeEchoTox();
+		Tox.CookDurationSeconds = CookSeconds;
+		Tests::FTouchStubHarness Harness(FString::Printf(TEXT("CooksInFlightBenchmark%d"), MaxCooksInFlight), MoveTemp(Tox));
+		if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+		{
+			return false;
+		}
+
+		Tests::FCookTracker Tracker;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumCooks; ++Index)
+		{
+			Tracker.Add(Harness.Cook({}, NumCooks, MaxCooksInFlight), FPlatformTime::Seconds());
+		}
+		if (!TestTrue(TEXT("Every cook got a result"), Tests::WaitUntil([&Tracker, &Harness]() { return Tracker.Pump(*Harness.FrameCooker, ProcessingSeconds); }, 30.0)))
+		{
+			return false;
+		}
+		TotalSeconds.Add(FPlatformTime::Seconds() - StartTime);
+
+		int32 NumSuccessfulCooks = 0;
+		for (const TSharedRef<Tests::FCookTracker::FTrackedCook>& Cook : Tracker.Cooks)
+		{
+			NumSuccessfulCooks += Cook->Future.Get().Result == ECookFrameResult::Success ? 1 : 0;
+		}
+		TestEqual(FString::Printf(TEXT("Successful cooks with MaxCooksInFlight %d"), MaxCooksInFlight), NumSuccessfulCooks, NumCooks);
+		TestEqual(TEXT("Output of the last frame"), Harness.VariableManager->GetDoubleOutput(TEXT("out/frame")), static_cast<double>(NumCooks - 1));
+	}
+
+	AddInfo(FString::Printf(TEXT("%d cooks of %.1f ms, each result processed for %.1f ms: %.1f ms with 1 cook in flight, %.1f ms with 2 cooks in flight (x%.2f)"),
+		NumCooks, CookSeconds * 1000.0, ProcessingSeconds * 1000.0, TotalSeconds[0] * 1000.0, TotalSeconds[1] * 1000.0, TotalSeconds[0] / TotalSeconds[1]));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableContainerLookupBenchmark, "TouchEngine.Benchmarks.DynamicVariableContainer.Lookup", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableContainerLookupBenchmark::RunTest(const FString& Parameters)
+{
+	// A large tox, with the outputs found through the lookup compared to FindOutput which goes through every output
+	constexpr int32 NumVariablesPerScope = 250;
+	FTouchEngineDynamicVariableContainer Container;
+	for (int32 Index = 0; Index < NumVariablesPerScope; ++Index)
+	{
+		for (TArray<FTouchEngineDynamicVariableStruct>* Variables : { &Container.DynVars_Input, &Container.DynVars_Output })
+		{
+			const TCHAR* Scope = Variables == &Container.DynVars_Input ? TEXT("in") : TEXT("out");
+			FTouchEngineDynamicVariableStruct& Variable = Variables->AddDefaulted_GetRef();
+			Variable.VarType = EVarType::Double;
+			Variable.VarName = FString::Printf(TEXT("%sParam%d"), Scope, Index);
+			Variable.VarLabel = FString::Printf(TEXT("%s Param %d"), Scope, Index);
+			Variable.VarIdentifier = FString::Printf(TEXT("%s/param%d"), Scope, Index);
+		}
+	}
+
+	TArray<double> RebuildDurations;
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		Container.InvalidateLookup();
+		const double StartTime = FPlatformTime::Seconds();
+		Container.GetDynamicVariableByIdentifier(TEXT("in/param0"));
+		RebuildDurations.Add(FPlatformTime::Seconds() - StartTime);
+	}
+
+	constexpr int32 NumCalls = 10000;
+	TArray<double> ByIdentifierDurations;
+	TArray<double> ByNameDurations;
+	TArray<double> LinearDurations;
+	ByIdentifierDurations.Reserve(NumCalls);
+	ByNameDurations.Reserve(NumCalls);
+	LinearDurations.Reserve(NumCalls);
+	int32 NumFoundByIdentifier = 0;
+	int32 NumFoundByName = 0;
+	int32 NumFoundLinearly = 0;
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		// Spread over the outputs, so the linear search goes through half of them on average
+		const int32 VariableIndex = (Index * 7919) % NumVariablesPerScope;
+		const FTouchEngineDynamicVariableStruct& Expected = Container.DynVars_Output[VariableIndex];
+
+		double StartTime = FPlatformTime::Seconds();
+		NumFoundByIdentifier += Container.GetDynamicVariableByIdentifier(Expected.VarIdentifier) == &Expected ? 1 : 0;
+		ByIdentifierDurations.Add(FPlatformTime::Seconds() - StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		NumFoundByName += Container.GetDynamicVariableByName(Expected.VarName) == &Expected ? 1 : 0;
+		ByNameDurations.Add(FPlatformTime::Seconds() - StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		NumFoundLinearly += Container.FindOutput(Expected.VarIdentifier, FString()) == &Expected ? 1 : 0;
+		LinearDurations.Add(FPlatformTime::Seconds() - StartTime);
+	}
+
+	TestEqual(TEXT("Variables found by identifier"), NumFoundByIdentifier, NumCalls);
+	TestEqual(TEXT("Variables found by name"), NumFoundByName, NumCalls);
+	TestEqual(TEXT("Variables found by FindOutput"), NumFoundLinearly, NumCalls);
+	const FString Label = FString::Printf(TEXT(" (%d variables)"), NumVariablesPerScope * 2);
+	Tests::AddDurationInfo(*this, TEXT("Lookup rebuild") + Label, MoveTemp(RebuildDurations));
+	Tests::AddDurationInfo(*this, TEXT("GetDynamicVariableByIdentifier") + Label, MoveTemp(ByIdentifierDurations));
+	Tests::AddDurationInfo(*this, TEXT("GetDynamicVariableByName") + Label, MoveTemp(ByNameDurations));
+	Tests::AddDurationInfo(*this, TEXT("FindOutput, linear") + Label, MoveTemp(LinearDurations));
+	return true;
+}
+
+
+namespace UE::TouchEngine::Tests
+{
+	/**
+	 * Sets every input like FTouchVariableManager::SetDoubleInput does, with the UE_LOG_TE_CALL following the TouchEngine call either compiled in or out.
+	 * WITH_TOUCHENGINE_TE_CALL_LOGGING applies to the whole module, so this is how both can be measured in the same build.
+	 */
+	template<bool bWithTECallLogging>
+	double SetDoubleInputsWithTECallLogging(TEInstance* Instance, const TArray<std::string>& Identifiers, const TArray<double>& Value)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (const std::string& Identifier : Identifiers)
+		{
+			const TEResult Result = TEInstanceLinkSetDoubleValue(Instance, Identifier.c_str(), Value.GetData(), Value.Num());
+			if constexpr (bWithTECallLogging)
+			{
+				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetDoubleValue(TEInstance: '%p', identifier: '%hs', value: '%p', count: '%d') [Thread: '%s'] => Returned: '%s'"),
+					Instance,
+					Identifier.c_str(),
+					Value.GetData(),
+					Value.Num(),
+					*GetCurrentThreadStr(),
+					*TEResultToString(Result)
+				);
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerTECallLoggingBenchmark, "TouchEngine.Benchmarks.VariableManager.TECallLogging", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerTECallLoggingBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumVariables = 300;
+	Stub::FStubTox Tox;
+	Tox.Links.Add(Stub::FStubLink::MakeGroup(TEXT("in"), TEScopeInput));
+	TArray<std::string> Identifiers;
+	Identifiers.Reserve(NumVariables);
+	for (int32 Index = 0; Index < NumVariables; ++Index)
+	{
+		const FString Identifier = FString::Printf(TEXT("in/value%d"), Index);
+		Tox.Links.Add(Stub::FStubLink::MakeValue(Identifier, TEXT("in"), TEScopeInput, TELinkTypeDouble));
+		Identifiers.Emplace(TCHAR_TO_UTF8(*Identifier));
+	}
+	Tests::FTouchStubHarness Harness(TEXT("TECallLoggingBenchmark"), MoveTemp(Tox));
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+	TArray<FTouchLinkHandle> Handles;
+	for (const std::string& Identifier : Identifiers)
+	{
+		Handles.Add(VariableManager.GetLinkHandle(UTF8_TO_TCHAR(Identifier.c_str())));
+	}
+
+	// The passes are interleaved so they are equally affected by anything else running on the machine.
+	// LogTouchEngineTECalls keeps its default verbosity, so compiled in logging only costs its verbosity check, as it does for users who have not raised it
+	constexpr int32 NumPasses = 1000;
+	TArray<double> VariableManagerDurations;
+	TArray<double> CompiledInDurations;
+	TArray<double> CompiledOutDurations;
+	VariableManagerDurations.Reserve(NumPasses);
+	CompiledInDurations.Reserve(NumPasses);
+	CompiledOutDurations.Reserve(NumPasses);
+	TArray<double> Value { 0.0 };
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		Value[0] = Pass;
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FTouchLinkHandle Handle : Handles)
+		{
+			VariableManager.SetDoubleInput(Handle, Value);
+		}
+		VariableManagerDurations.Add(FPlatformTime::Seconds() - StartTime);
+		CompiledInDurations.Add(Tests::SetDoubleInputsWithTECallLogging<true>(Harness.Instance, Identifiers, Value));
+		CompiledOutDurations.Add(Tests::SetDoubleInputsWithTECallLogging<false>(Harness.Instance, Identifiers, Value));
+	}
+
+	double LastValue = 0.0;
+	TEInstanceLinkGetDoubleValue(Harness.Instance, Identifiers.Last().c_str(), TELinkValueCurrent, &LastValue, 1);
+	TestEqual(TEXT("Value of the last input after the last pass"), LastValue, static_cast<double>(NumPasses - 1));
+
+	const auto GetMedian = [](TArray<double> Durations) { Durations.Sort(); return Durations[Durations.Num() / 2]; };
+	const double CompiledInMedian = GetMedian(CompiledInDurations);
+	const double CompiledOutMedian = GetMedian(CompiledOutDurations);
+	const FString Label = FString::Printf(TEXT(" (SetInput pass over %d variables)"), NumVariables);
+	Tests::AddDurationInfo(*this, FString::Printf(TEXT("FTouchVariableManager, TE call logging compiled %s"), WITH_TOUCHENGINE_TE_CALL_LOGGING ? TEXT("in") : TEXT("out")) + Label, MoveTemp(VariableManagerDurations));
+	Tests::AddDurationInfo(*this, TEXT("TE call logging compiled in") + Label, MoveTemp(CompiledInDurations));
+	Tests::AddDurationInfo(*this, TEXT("TE call logging compiled out") + Label, MoveTemp(CompiledOutDurations));
+	AddInfo(FString::Printf(TEXT("TE call logging overhead: %.2f us per pass, %.1f ns per call (%+.1f%%)"),
+		(CompiledInMedian - CompiledOutMedian) * 1e6, (CompiledInMedian - CompiledOutMedian) * 1e9 / NumVariables, (CompiledInMedian / CompiledOutMedian - 1.0) * 100.0));
+	return true;
+}
+
+#endif
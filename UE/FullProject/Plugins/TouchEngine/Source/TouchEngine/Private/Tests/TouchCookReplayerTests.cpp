@@ -0,0 +1,160 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "Tests/TouchStubHarness.h"
+#include "Engine/Util/TouchCookRecorder.h"
+#include "Engine/Util/TouchCookReplayer.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** The outputs of the echo tox after a cook */
+	struct FEchoOutputs
+	{
+		ECookFrameResult Result = ECookFrameResult::Count;
+		double Value = 0.0;
+		double Frame = -1.0;
+		FTouchEngineCHOP CHOP;
+
+		static FEchoOutputs Read(FTouchVariableManager& VariableManager, const FCookFrameResult& CookFrameResult)
+		{
+			FEchoOutputs Outputs;
+			Outputs.Result = CookFrameResult.Result;
+			Outputs.Value = VariableManager.GetDoubleOutput(TEXT("out/value"));
+			Outputs.Frame = VariableManager.GetDoubleOutput(TEXT("out/frame"));
+			Outputs.CHOP = VariableManager.GetCHOPOutputView(TEXT("out/chop")).ToCHOP();
+			return Outputs;
+		}
+	};
+
+	/** The inputs of the given frame, with a CHOP whose number of channels and samples change every frame */
+	inline TMap<FString, FTouchEngineDynamicVariableStruct> MakeReplayInputs(const TArray<FTouchEngineDynamicVariableStruct>& VariablesIn, int32 Frame)
+	{
+		TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend;
+		for (const FTouchEngineDynamicVariableStruct& Template : VariablesIn)
+		{
+			if (Template.VarIdentifier == TEXT("in/value"))
+			{
+				FTouchEngineDynamicVariableStruct& Input = VariablesToSend.Add(Template.VarIdentifier, Template);
+				Input.SetValue(Frame * 0.5);
+			}
+			else if (Template.VarIdentifier == TEXT("in/chop"))
+			{
+				FTouchEngineCHOP CHOP;
+				for (int32 ChannelIndex = 0; ChannelIndex < 1 + Frame % 3; ++ChannelIndex)
+				{
+					FTouchEngineCHOPChannel& Channel = CHOP.Channels.AddDefaulted_GetRef();
+					Channel.Name = FString::Printf(TEXT("chan%d"), ChannelIndex + 1);
+					for (int32 SampleIndex = 0; SampleIndex < 4 + Frame; ++SampleIndex)
+					{
+						Channel.Values.Add(Frame * 100.f + GetFloatBufferSample(ChannelIndex, SampleIndex));
+					}
+				}
+				FTouchEngineDynamicVariableStruct& Input = VariablesToSend.Add(Template.VarIdentifier, Template);
+				Input.SetValue(CHOP);
+			}
+		}
+		return VariablesToSend;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchCookReplayerIdenticalOutputsTest, "TouchEngine.CookReplayer.IdenticalOutputs", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchCookReplayerIdenticalOutputsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCooks = 24;
+	const FString RecordingPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("IdenticalOutputs.tecook")));
+
+	// 1. Record the cooks, reading the outputs of each frame like OnEndFrame would
+	TArray<Tests::FEchoOutputs> RecordedOutputs;
+	{
+		Tests::FTouchStubHarness Harness(TEXT("CookReplayRecording"), Tests::MakeEchoTox());
+		if (!TestTrue(TEXT("The tox is loaded for the recording"), Harness.Load()))
+		{
+			return false;
+		}
+		const TSharedRef<FTouchCookRecorder> Recorder = MakeShared<FTouchCookRecorder>(RecordingPath, Harness.ToxPath);
+		if (!TestTrue(TEXT("The recording is started"), Recorder->IsRecording()))
+		{
+			return false;
+		}
+		Harness.FrameCooker->SetCookRecorder(Recorder);
+		for (int32 Frame = 0; Frame < NumCooks; ++Frame)
+		{
+			const FCookFrameResult CookFrameResult = Harness.CookAndRelease(Tests::MakeReplayInputs(Harness.VariablesIn, Frame));
+			RecordedOutputs.Add(Tests::FEchoOutputs::Read(*Harness.VariableManager, CookFrameResult));
+		}
+		Harness.FrameCooker->SetCookRecorder(nullptr);
+		if (!TestTrue(TEXT("The recording is written"), Recorder->Stop()))
+		{
+			return false;
+		}
+	}
+
+	TOptional<FTouchCookRecording> Recording = FTouchCookRecording::LoadFromFile(RecordingPath);
+	IFileManager::Get().Delete(*RecordingPath);
+	if (!TestTrue(TEXT("The recording is loaded"), Recording.IsSet()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Recorded requests"), Recording->Requests.Num(), NumCooks);
+	TestEqual(TEXT("Recorded results"), Recording->Results.Num(), NumCooks);
+
+	// 2. Replay them with a new instance of the same tox, reading the outputs of each replayed frame before it is released
+	Tests::FTouchStubHarness Harness(TEXT("CookReplayReplay"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded for the replay"), Harness.Load()))
+	{
+		return false;
+	}
+	const TSharedRef<TArray<Tests::FEchoOutputs>> ReplayedOutputs = MakeShared<TArray<Tests::FEchoOutputs>>();
+	ReplayedOutputs->SetNum(NumCooks);
+	const TFuture<FTouchCookReplayReport> Report = FTouchCookReplayer::Replay_GameThread(Harness.FrameCooker.ToSharedRef(), MoveTemp(Recording.GetValue()),
+		[ReplayedOutputs, WeakVariableManager = TWeakPtr<FTouchVariableManager>(Harness.VariableManager)](int32 RequestIndex, const FCookFrameResult& CookFrameResult)
+		{
+			const TSharedPtr<FTouchVariableManager> VariableManager = WeakVariableManager.Pin();
+			if (VariableManager && ReplayedOutputs->IsValidIndex(RequestIndex))
+			{
+				(*ReplayedOutputs)[RequestIndex] = Tests::FEchoOutputs::Read(*VariableManager, CookFrameResult);
+			}
+		});
+	if (!TestTrue(TEXT("The replay finished"), Tests::WaitFor(Report)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Replayed results differing from the recording"), Report.Get().NumMismatchedResults, 0);
+	TestEqual(TEXT("Successful replayed cooks"), Report.Get().NumReplayedResults[static_cast<int32>(ECookFrameResult::Success)], NumCooks);
+
+	// 3. Compare the outputs frame by frame
+	for (int32 Frame = 0; Frame < NumCooks; ++Frame)
+	{
+		const Tests::FEchoOutputs& Recorded = RecordedOutputs[Frame];
+		const Tests::FEchoOutputs& Replayed = (*ReplayedOutputs)[Frame];
+		TestTrue(FString::Printf(TEXT("Frame %d was cooked in the recording"), Frame), Recorded.Result == ECookFrameResult::Success);
+		TestTrue(FString::Printf(TEXT("Frame %d has the same result"), Frame), Replayed.Result == Recorded.Result);
+		TestEqual(FString::Printf(TEXT("Frame %d out/value"), Frame), Replayed.Value, Recorded.Value);
+		TestEqual(FString::Printf(TEXT("Frame %d out/frame"), Frame), Replayed.Frame, Recorded.Frame);
+		TestTrue(FString::Printf(TEXT("Frame %d out/chop"), Frame), Replayed.CHOP == Recorded.CHOP && Recorded.CHOP.Channels.Num() == 1 + Frame % 3);
+	}
+	return true;
+}
+
+#endif
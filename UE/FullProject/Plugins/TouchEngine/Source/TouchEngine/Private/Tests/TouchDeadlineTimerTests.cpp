@@ -0,0 +1,109 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Util/TouchDeadlineTimer.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** Records the deadlines fired by a FTouchDeadlineTimer and on which thread */
+	struct FFiredDeadlines
+	{
+		TArray<FTouchDeadlineTimer::FHandle> Handles;
+		bool bAllFiredOnGameThread = true;
+
+		FTouchDeadlineTimer::FOnDeadline MakeCallback()
+		{
+			return [this](FTouchDeadlineTimer::FHandle Handle)
+			{
+				bAllFiredOnGameThread &= IsInGameThread();
+				Handles.Add(Handle);
+			};
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDeadlineTimerFakeClockTest, "TouchEngine.Util.DeadlineTimer.FakeClock", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDeadlineTimerFakeClockTest::RunTest(const FString& Parameters)
+{
+	double FakeNow = 100.0;
+	FTouchDeadlineTimer Timer([&FakeNow]() { return FakeNow; }, false);
+	Tests::FFiredDeadlines Fired;
+	const auto FireAndProcess = [&Timer]()
+	{
+		const double SecondsToWait = Timer.FireExpiredDeadlines();
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		return SecondsToWait;
+	};
+
+	const FTouchDeadlineTimer::FHandle First = Timer.Arm(105.0, Fired.MakeCallback());
+	const FTouchDeadlineTimer::FHandle Last = Timer.Arm(110.0, Fired.MakeCallback());
+	const FTouchDeadlineTimer::FHandle Soonest = Timer.ArmIn(2.0, Fired.MakeCallback());
+	TestTrue(TEXT("Handles are unique"), First != Last && First != Soonest && Soonest != Last);
+
+	TestEqual(TEXT("Seconds until the soonest deadline"), FireAndProcess(), 2.0);
+	TestEqual(TEXT("Nothing fires before its deadline"), Fired.Handles.Num(), 0);
+
+	FakeNow = 105.0;
+	TestEqual(TEXT("Seconds until the last deadline"), FireAndProcess(), 5.0);
+	TestEqual(TEXT("The deadlines reached fired"), Fired.Handles.Num(), 2);
+	TestTrue(TEXT("The soonest deadline fired"), Fired.Handles.Contains(Soonest));
+	TestTrue(TEXT("The first deadline fired"), Fired.Handles.Contains(First));
+	TestTrue(TEXT("Callbacks are called on the GameThread"), Fired.bAllFiredOnGameThread);
+
+	Timer.Disarm(Last);
+	FakeNow = 200.0;
+	TestTrue(TEXT("No deadline is armed anymore"), FireAndProcess() < 0.0);
+	TestEqual(TEXT("A disarmed deadline does not fire"), Fired.Handles.Num(), 2);
+
+	// Once reached, the callback is already on its way to the GameThread and is given its handle so its owner can ignore it
+	const FTouchDeadlineTimer::FHandle Late = Timer.Arm(200.0, Fired.MakeCallback());
+	Timer.FireExpiredDeadlines();
+	Timer.Disarm(Late);
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	TestTrue(TEXT("A deadline disarmed after being reached still fires with its handle"), Fired.Handles.Num() == 3 && Fired.Handles.Last() == Late);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDeadlineTimerThreadTest, "TouchEngine.Util.DeadlineTimer.Thread", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDeadlineTimerThreadTest::RunTest(const FString& Parameters)
+{
+	FTouchDeadlineTimer Timer;
+	Tests::FFiredDeadlines Fired;
+	const double ArmTime = Timer.Now();
+	Timer.ArmIn(0.01, Fired.MakeCallback());
+	Timer.ArmIn(60.0, Fired.MakeCallback()); // Discarded with the timer
+
+	const double EndTime = ArmTime + 5.0;
+	while (Fired.Handles.IsEmpty() && FPlatformTime::Seconds() < EndTime)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+	TestEqual(TEXT("The deadline fired from the timer thread"), Fired.Handles.Num(), 1);
+	TestTrue(TEXT("Not before its deadline"), Timer.Now() - ArmTime >= 0.01);
+	TestTrue(TEXT("Callbacks are called on the GameThread"), Fired.bAllFiredOnGameThread);
+	return true;
+}
+
+#endif
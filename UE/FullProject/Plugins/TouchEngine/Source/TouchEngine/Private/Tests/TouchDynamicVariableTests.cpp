@@ -0,0 +1,719 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "TouchEngineDynamicVariableStruct.h"
+#include "Blueprint/TouchEngineComponent.h"
+#include "Tests/TouchAllocationCounter.h"
+#include "Tests/TouchStubHarness.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** Sets a value of a different layout depending on the index: scalar, array, CHOP, or string array with its table of string offsets. They all fit inline */
+	static void SetRelocationTestValue(FTouchEngineDynamicVariableStruct& Variable, int32 Index)
+	{
+		switch (Index % 4)
+		{
+		case 0:
+			Variable.VarType = EVarType::Double;
+			Variable.SetValue(static_cast<double>(Index));
+			break;
+		case 1:
+			Variable.VarType = EVarType::Double;
+			Variable.bIsArray = true;
+			Variable.SetValue(TArray<double>{ static_cast<double>(Index), 1.0, 2.0 });
+			break;
+		case 2:
+			Variable.VarType = EVarType::CHOP;
+			Variable.SetValueAsCHOP({ static_cast<float>(Index), 1.f, 2.f, 3.f, 4.f, 5.f }, 2, 3);
+			break;
+		default:
+			Variable.VarType = EVarType::String;
+			Variable.bIsArray = true;
+			Variable.SetValue(TArray<FString>{ FString::FromInt(Index), TEXT("Second") });
+			break;
+		}
+	}
+
+	static bool HasRelocationTestValue(const FTouchEngineDynamicVariableStruct& Variable, int32 Index)
+	{
+		switch (Index % 4)
+		{
+		case 0:
+			return Variable.GetValueAsDouble() == Index;
+		case 1:
+			return Variable.GetValueAsDoubleTArray() == TArray<double>{ static_cast<double>(Index), 1.0, 2.0 };
+		case 2:
+			{
+				const FTouchEngineCHOP CHOP = Variable.GetValueAsCHOP();
+				return CHOP.Channels.Num() == 2
+					&& CHOP.Channels[0].Values == TArray<float>{ static_cast<float>(Index), 1.f, 2.f }
+					&& CHOP.Channels[1].Values == TArray<float>{ 3.f, 4.f, 5.f };
+			}
+		default:
+			return Variable.GetValueAsStringArray() == TArray<FString>{ FString::FromInt(Index), TEXT("Second") };
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableRelocationTest, "TouchEngine.DynamicVariable.Relocation", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableRelocationTest::RunTest(const FString& Parameters)
+{
+	// TArray relocates its elements with a memcpy when it grows or when an element is removed, without calling the move constructor
+	constexpr int32 NumVariables = 64;
+	TArray<FTouchEngineDynamicVariableStruct> Variables;
+	for (int32 Index = 0; Index < NumVariables; ++Index)
+	{
+		Tests::SetRelocationTestValue(Variables.AddDefaulted_GetRef(), Index);
+	}
+
+	int32 NumValidValues = 0;
+	for (int32 Index = 0; Index < NumVariables; ++Index)
+	{
+		NumValidValues += Tests::HasRelocationTestValue(Variables[Index], Index) ? 1 : 0;
+	}
+	TestEqual(TEXT("Values after growing the array"), NumValidValues, NumVariables);
+
+	Variables.RemoveAt(0);
+	NumValidValues = 0;
+	for (int32 Index = 0; Index < Variables.Num(); ++Index)
+	{
+		NumValidValues += Tests::HasRelocationTestValue(Variables[Index], Index + 1) ? 1 : 0;
+	}
+	TestEqual(TEXT("Values after removing the first element"), NumValidValues, NumVariables - 1);
+
+	TMap<FString, FTouchEngineDynamicVariableStruct> VariablesByName;
+	for (int32 Index = 0; Index < Variables.Num(); ++Index)
+	{
+		VariablesByName.Add(FString::FromInt(Index + 1), Variables[Index]);
+	}
+	for (int32 Index = 1; Index < NumVariables; Index += 2)
+	{
+		VariablesByName.Remove(FString::FromInt(Index));
+	}
+	VariablesByName.Compact();
+	NumValidValues = 0;
+	for (const TPair<FString, FTouchEngineDynamicVariableStruct>& Pair : VariablesByName)
+	{
+		NumValidValues += Tests::HasRelocationTestValue(Pair.Value, FCString::Atoi(*Pair.Key)) ? 1 : 0;
+	}
+	TestEqual(TEXT("Values after compacting a map"), NumValidValues, VariablesByName.Num());
+
+	// Frees every value, which must all still be owned by their element
+	Variables.Empty();
+	VariablesByName.Empty();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableEmptyCHOPTest, "TouchEngine.DynamicVariable.EmptyCHOP", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableEmptyCHOPTest::RunTest(const FString& Parameters)
+{
+	FTouchEngineDynamicVariableStruct Variable;
+	Variable.VarType = EVarType::CHOP;
+	Variable.SetValueAsCHOP({ 1.f, 2.f }, TArray<FString>());
+	TestTrue(TEXT("A CHOP without channel names is empty"), Variable.GetValueAsCHOP().Channels.IsEmpty());
+	Variable.SetValueAsCHOP({ 1.f, 2.f }, 0, 2);
+	TestTrue(TEXT("A CHOP without channels is empty"), Variable.GetValueAsCHOP().Channels.IsEmpty());
+	Variable.SetValueAsCHOP({}, 2, 0);
+	TestTrue(TEXT("A CHOP without samples is empty"), Variable.GetValueAsCHOP().Channels.IsEmpty());
+	return true;
+}
+
+namespace UE::TouchEngine::Tests
+{
+#if WITH_EDITORONLY_DATA
+	// In editor builds, CHOPs and DATs are also copied with the handle properties of the details panel, so they are left out of the copy test
+	static constexpr int32 NumCopyTestKinds = 7;
+#else
+	static constexpr int32 NumCopyTestKinds = 9;
+#endif
+
+	static TArray<double> MakeCopyTestDoubles(int32 Index, int32 Num)
+	{
+		TArray<double> Values;
+		for (int32 ValueIndex = 0; ValueIndex < Num; ++ValueIndex)
+		{
+			Values.Add(Index + ValueIndex * 0.5);
+		}
+		return Values;
+	}
+
+	static FString MakeCopyTestString(int32 Index, bool bLong)
+	{
+		return bLong ? FString::ChrN(100, TEXT('x')) + FString::FromInt(Index) : FString::FromInt(Index);
+	}
+
+	/** Adds a variable which kind of value depends on the index, from scalars and small vectors stored inline to arrays, strings, CHOPs and DATs stored in an arena */
+	static void AddCopyTestVariable(TArray<FTouchEngineDynamicVariableStruct>& Variables, int32 Index, bool bSetValue)
+	{
+		FTouchEngineDynamicVariableStruct& Variable = Variables.AddDefaulted_GetRef();
+		Variable.VarIdentifier = Variable.VarLabel = Variable.VarName = FString::Printf(TEXT("in/copy%03d"), Index);
+		Variable.VarScope = EVarScope::Input;
+		switch (Index % NumCopyTestKinds)
+		{
+		case 0:
+			Variable.VarType = EVarType::Bool;
+			if (bSetValue) { Variable.SetValue(Index % 2 == 0); }
+			break;
+		case 1:
+			Variable.VarType = EVarType::Int;
+			if (bSetValue) { Variable.SetValue(Index); }
+			break;
+		case 2:
+			Variable.VarType = EVarType::Double;
+			if (bSetValue) { Variable.SetValue(Index * 0.5); }
+			break;
+		case 3:
+			Variable.VarType = EVarType::Double;
+			Variable.bIsArray = true;
+			if (bSetValue) { Variable.SetValue(MakeCopyTestDoubles(Index, 4)); }
+			break;
+		case 4:
+			Variable.VarType = EVarType::Double;
+			Variable.bIsArray = true;
+			if (bSetValue) { Variable.SetValue(MakeCopyTestDoubles(Index, 32)); }
+			break;
+		case 5:
+		case 6:
+			Variable.VarType = EVarType::String;
+			if (bSetValue) { Variable.SetValue(MakeCopyTestString(Index, Index % NumCopyTestKinds == 6)); }
+			break;
+		case 7:
+			{
+				Variable.VarType = EVarType::CHOP;
+				TArray<float> Samples;
+				for (int32 SampleIndex = 0; SampleIndex < 4 * 16; ++SampleIndex)
+				{
+					Samples.Add(Index + SampleIndex);
+				}
+				if (bSetValue) { Variable.SetValueAsCHOP(Samples, 4, 16); }
+				break;
+			}
+		default:
+			// A single column, as only the first cell of each row is serialized
+			Variable.VarType = EVarType::String;
+			Variable.bIsArray = true;
+			if (bSetValue) { Variable.SetValueAsDAT({ MakeCopyTestString(Index, false), MakeCopyTestString(Index, true) }, 2, 1); }
+			break;
+		}
+	}
+
+	static bool HasCopyTestValue(const FTouchEngineDynamicVariableStruct& Variable, int32 Index)
+	{
+		switch (Index % NumCopyTestKinds)
+		{
+		case 0:
+			return Variable.GetValueAsBool() == (Index % 2 == 0);
+		case 1:
+			return Variable.GetValueAsInt() == Index;
+		case 2:
+			return Variable.GetValueAsDouble() == Index * 0.5;
+		case 3:
+			return Variable.GetValueAsDoubleTArray() == MakeCopyTestDoubles(Index, 4);
+		case 4:
+			return Variable.GetValueAsDoubleTArray() == MakeCopyTestDoubles(Index, 32);
+		case 5:
+		case 6:
+			return Variable.GetValueAsString() == MakeCopyTestString(Index, Index % NumCopyTestKinds == 6);
+		case 7:
+			{
+				const FTouchEngineCHOP CHOP = Variable.GetValueAsCHOP();
+				return CHOP.Channels.Num() == 4 && CHOP.Channels[3].Values.Num() == 16 && CHOP.Channels[3].Values[15] == Index + 63;
+			}
+		default:
+			return Variable.GetValueAsStringArray() == TArray<FString>{ MakeCopyTestString(Index, false), MakeCopyTestString(Index, true) };
+		}
+	}
+
+	static int32 CountCopyTestValues(const FTouchEngineDynamicVariableContainer& Container)
+	{
+		int32 NumValidValues = 0;
+		for (int32 Index = 0; Index < Container.DynVars_Input.Num(); ++Index)
+		{
+			NumValidValues += HasCopyTestValue(Container.DynVars_Input[Index], Index) ? 1 : 0;
+		}
+		return NumValidValues;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableContainerCopyAllocationsTest, "TouchEngine.DynamicVariableContainer.CopyAllocations", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableContainerCopyAllocationsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumVariables = 500;
+	TArray<FTouchEngineDynamicVariableStruct> VariablesWithValues;
+	TArray<FTouchEngineDynamicVariableStruct> VariablesWithoutValues;
+	for (int32 Index = 0; Index < NumVariables; ++Index)
+	{
+		Tests::AddCopyTestVariable(VariablesWithValues, Index, true);
+		Tests::AddCopyTestVariable(VariablesWithoutValues, Index, false);
+	}
+
+	// Loading packs the values which do not fit inline in a single arena
+	FTouchEngineDynamicVariableContainer Container;
+	Container.ToxParametersLoaded(VariablesWithValues, {});
+	FTouchEngineDynamicVariableContainer ContainerWithoutValues;
+	ContainerWithoutValues.ToxParametersLoaded(VariablesWithoutValues, {});
+	TestEqual(TEXT("Values once packed"), Tests::CountCopyTestValues(Container), NumVariables);
+
+	// The names of the variables are copied either way, so the values must not add any allocation on top of them
+	const auto CountCopyAllocations = [](FTouchEngineDynamicVariableContainer& Source)
+	{
+		Tests::FScopedAllocationCounter AllocationCounter;
+		FTouchEngineDynamicVariableContainer Copy = Source;
+		Copy = Source;
+		const TMap<FString, FTouchEngineDynamicVariableStruct> VariablesForCook = Source.CopyInputsForCook(1);
+		return AllocationCounter.GetNumAllocations();
+	};
+	const int32 NumAllocationsWithValues = CountCopyAllocations(Container);
+	const int32 NumAllocationsWithoutValues = CountCopyAllocations(ContainerWithoutValues);
+	AddInfo(FString::Printf(TEXT("Copying %d variables twice and for a cook: %d allocations with values, %d without"), NumVariables, NumAllocationsWithValues, NumAllocationsWithoutValues));
+	TestEqual(TEXT("Allocations added by the values when copying"), NumAllocationsWithValues - NumAllocationsWithoutValues, 0);
+
+	FTouchEngineDynamicVariableContainer Copy = Container;
+	TestEqual(TEXT("Values of the copy"), Tests::CountCopyTestValues(Copy), NumVariables);
+	for (int32 Index = 4; Index < NumVariables; Index += Tests::NumCopyTestKinds)
+	{
+		// Setting a value of the copy gives it a value of its own, and the shared values are left as they were
+		Copy.DynVars_Input[Index].SetValue(Tests::MakeCopyTestDoubles(-1, 32));
+	}
+	TestEqual(TEXT("Values of the container after changing the copy"), Tests::CountCopyTestValues(Container), NumVariables);
+	TestTrue(TEXT("The copy has the changed values"), Copy.DynVars_Input[4].GetValueAsDoubleTArray() == Tests::MakeCopyTestDoubles(-1, 32));
+
+	// The values are serialized through their typed getters, so loading them back gives the same bytes
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FTouchEngineDynamicVariableContainer::StaticStruct()->SerializeItem(Writer, &Container, nullptr);
+	FTouchEngineDynamicVariableContainer Loaded;
+	FMemoryReader Reader(Bytes);
+	FTouchEngineDynamicVariableContainer::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+	TestEqual(TEXT("Values once loaded"), Tests::CountCopyTestValues(Loaded), NumVariables);
+	TArray<uint8> LoadedBytes;
+	FMemoryWriter LoadedWriter(LoadedBytes);
+	FTouchEngineDynamicVariableContainer::StaticStruct()->SerializeItem(LoadedWriter, &Loaded, nullptr);
+	TestTrue(TEXT("The loaded values serialize to the same bytes"), LoadedBytes == Bytes);
+	return true;
+}
+
+#if WITH_TOUCHENGINE_STUB
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableCHOPSampleTest, "TouchEngine.DynamicVariable.CHOPSample", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableCHOPSampleTest::RunTest(const FString& Parameters)
+{
+	FTouchEngineDynamicVariableContainer Container;
+	FTouchEngineDynamicVariableStruct& Output = Container.DynVars_Output.AddDefaulted_GetRef();
+	Output.VarIdentifier = TEXT("o/chop");
+	Output.VarName = TEXT("chop");
+	Output.VarType = EVarType::CHOP;
+	float Sample = 0.f;
+	TestFalse(TEXT("A CHOP without value has no sample"), Output.GetCHOPSample(0, INDEX_NONE, Sample));
+
+	const FTouchEngineDynamicVariableContainer& ConstContainer = Container;
+	struct FLayout
+	{
+		int32 NumChannels;
+		int32 NumSamples;
+	};
+	for (const FLayout& Layout : { FLayout{ 1, 1 }, FLayout{ 2, 3 }, FLayout{ 5, 64 }, FLayout{ 16, 7 }, FLayout{ 3, 0 } })
+	{
+		// The value is set from the float buffer of the output the way FTouchEngineDynamicVariableStruct::GetOutput does
+		const FString Context = FString::Printf(TEXT("%dx%d"), Layout.NumChannels, Layout.NumSamples);
+		Output.SetValue(FTouchEngineCHOPView(Tests::MakeFloatBuffer(Layout.NumChannels, Layout.NumSamples)));
+		const FTouchEngineDynamicVariableStruct* FoundOutput = ConstContainer.FindOutput(TEXT("chop"), TEXT("o/"));
+		if (!TestTrue(FString::Printf(TEXT("The output is found by identifier (%s)"), *Context), FoundOutput == &Output))
+		{
+			return false;
+		}
+
+		bool bSamplesMatch = true;
+		for (int32 ChannelIndex = 0; ChannelIndex < Layout.NumChannels; ++ChannelIndex)
+		{
+			for (int32 SampleIndex = 0; SampleIndex < Layout.NumSamples; ++SampleIndex)
+			{
+				bSamplesMatch &= FoundOutput->GetCHOPSample(ChannelIndex, SampleIndex, Sample) && Sample == Tests::GetFloatBufferSample(ChannelIndex, SampleIndex);
+			}
+		}
+		TestTrue(FString::Printf(TEXT("Every sample is read (%s)"), *Context), bSamplesMatch);
+
+		const int32 LastChannel = Layout.NumChannels - 1;
+		if (Layout.NumSamples > 0)
+		{
+			TestTrue(FString::Printf(TEXT("Latest sample of the last channel is found (%s)"), *Context), FoundOutput->GetCHOPSample(LastChannel, INDEX_NONE, Sample));
+			TestEqual(FString::Printf(TEXT("Latest sample of the last channel (%s)"), *Context), Sample, Tests::GetFloatBufferSample(LastChannel, Layout.NumSamples - 1));
+		}
+		else
+		{
+			TestFalse(FString::Printf(TEXT("A CHOP without samples has no latest sample (%s)"), *Context), FoundOutput->GetCHOPSample(LastChannel, INDEX_NONE, Sample));
+		}
+		TestFalse(FString::Printf(TEXT("Samples after the last one are not found (%s)"), *Context), FoundOutput->GetCHOPSample(0, Layout.NumSamples, Sample));
+		TestFalse(FString::Printf(TEXT("Channels after the last one are not found (%s)"), *Context), FoundOutput->GetCHOPSample(Layout.NumChannels, 0, Sample));
+		TestFalse(FString::Printf(TEXT("Negative channels are not found (%s)"), *Context), FoundOutput->GetCHOPSample(-1, 0, Sample));
+	}
+	TestTrue(TEXT("The output is found by name"), ConstContainer.FindOutput(TEXT("CHOP"), FString()) == &Output);
+	TestNull(TEXT("Unknown outputs are not found"), ConstContainer.FindOutput(TEXT("unknown"), TEXT("o/")));
+
+	Output.VarType = EVarType::Float;
+	TestFalse(TEXT("Only CHOP variables are sampled"), Output.GetCHOPSample(0, 0, Sample));
+	Output.VarType = EVarType::CHOP;
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableDATCellsTest, "TouchEngine.DynamicVariable.DATCells", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableDATCellsTest::RunTest(const FString& Parameters)
+{
+	FTouchEngineDynamicVariableStruct Output;
+	Output.VarType = EVarType::String;
+	Output.bIsArray = true;
+	TestTrue(TEXT("An empty DAT has no row"), Output.GetDATNumRows() == 0);
+	TestNull(TEXT("An empty DAT has no object"), Output.GetValueAsDAT());
+	TestTrue(TEXT("An empty DAT has no cached row"), Output.GetDATRow(0).IsEmpty());
+
+	struct FLayout
+	{
+		int32 NumRows;
+		int32 NumColumns;
+	};
+	UTouchEngineDAT* PreviousDAT = nullptr;
+	for (const FLayout& Layout : { FLayout{ 1, 1 }, FLayout{ 2, 3 }, FLayout{ 64, 4 }, FLayout{ 1, 16 }, FLayout{ 3, 0 }, FLayout{ 5, 2 } })
+	{
+		// The value is set from the table of the output the way FTouchEngineDynamicVariableStruct::GetOutput does
+		const FString Context = FString::Printf(TEXT("%dx%d"), Layout.NumRows, Layout.NumColumns);
+		const TouchObject<TETable> Table = Tests::MakeTable(Layout.NumRows, Layout.NumColumns);
+		const FTouchDATView View(Table);
+		{
+			Tests::FScopedAllocationCounter AllocationCounter;
+			Output.SetValue(View);
+			TestEqual(FString::Printf(TEXT("Setting the value does not convert or copy any cell (%s)"), *Context), AllocationCounter.GetNumAllocations(), 0);
+		}
+
+		const bool bEmpty = Layout.NumRows == 0 || Layout.NumColumns == 0;
+		TestEqual(FString::Printf(TEXT("Rows (%s)"), *Context), Output.GetDATNumRows(), bEmpty ? 0 : Layout.NumRows);
+		TestEqual(FString::Printf(TEXT("Columns (%s)"), *Context), Output.GetDATNumColumns(), bEmpty ? 0 : Layout.NumColumns);
+		if (bEmpty)
+		{
+			TestNull(FString::Printf(TEXT("An empty DAT has no object (%s)"), *Context), Output.GetValueAsDAT());
+			TestTrue(FString::Printf(TEXT("An empty DAT has no row (%s)"), *Context), Output.GetDATRow(0).IsEmpty());
+			continue;
+		}
+
+		bool bCellsMatch = true;
+		bool bCellsInTable = true;
+		for (int32 Row = 0; Row < Layout.NumRows; ++Row)
+		{
+			for (int32 Column = 0; Column < Layout.NumColumns; ++Column)
+			{
+				const FUtf8StringView Cell = Output.GetDATCell(Row, Column);
+				bCellsMatch &= FString(Cell) == Tests::GetTableCell(Row, Column);
+				bCellsInTable &= Cell.GetData() == reinterpret_cast<const UTF8CHAR*>(TETableGetStringValue(Table, Row, Column));
+			}
+		}
+		TestTrue(FString::Printf(TEXT("Every cell is read (%s)"), *Context), bCellsMatch);
+		TestTrue(FString::Printf(TEXT("Cells are read from the table without being copied (%s)"), *Context), bCellsInTable);
+		TestTrue(FString::Printf(TEXT("Cells outside of the DAT are empty (%s)"), *Context),
+			Output.GetDATCell(Layout.NumRows, 0).IsEmpty() && Output.GetDATCell(0, Layout.NumColumns).IsEmpty() && Output.GetDATCell(-1, 0).IsEmpty());
+
+		const int32 LastRow = Layout.NumRows - 1;
+		const TArray<FString> RowCells = Output.GetDATRow(LastRow);
+		TestEqual(FString::Printf(TEXT("Cells of the last row (%s)"), *Context), RowCells.Num(), Layout.NumColumns);
+		TestEqual(FString::Printf(TEXT("Last cell of the last row (%s)"), *Context), RowCells.Last(), Tests::GetTableCell(LastRow, Layout.NumColumns - 1));
+		{
+			Tests::FScopedAllocationCounter AllocationCounter;
+			Output.GetDATRow(LastRow);
+			TestEqual(FString::Printf(TEXT("Reading the cached row again does not convert it (%s)"), *Context), AllocationCounter.GetNumAllocations(), 0);
+		}
+		TestTrue(FString::Printf(TEXT("Rows outside of the DAT are empty (%s)"), *Context), Output.GetDATRow(Layout.NumRows).IsEmpty() && Output.GetDATRow(-1).IsEmpty());
+		TestEqual(FString::Printf(TEXT("First row once another row was requested (%s)"), *Context), Output.GetDATRow(0)[0], Tests::GetTableCell(0, 0));
+
+		UTouchEngineDAT* DAT = Output.GetValueAsDAT();
+		if (!TestNotNull(FString::Printf(TEXT("The DAT object is made (%s)"), *Context), DAT))
+		{
+			return false;
+		}
+		TestEqual(FString::Printf(TEXT("The DAT object has the cells (%s)"), *Context), DAT->GetCell(LastRow, Layout.NumColumns - 1), Tests::GetTableCell(LastRow, Layout.NumColumns - 1));
+		TestTrue(FString::Printf(TEXT("The DAT object is reused while the value does not change (%s)"), *Context), Output.GetValueAsDAT() == DAT);
+		TestTrue(FString::Printf(TEXT("A new DAT object is made when the value changes (%s)"), *Context), DAT != PreviousDAT);
+		PreviousDAT = DAT;
+
+		const FTouchEngineDynamicVariableStruct Copy = Output;
+		TestTrue(FString::Printf(TEXT("A copy shares the table (%s)"), *Context), Copy.GetDATCell(LastRow, 0).GetData() == Output.GetDATCell(LastRow, 0).GetData());
+		TestEqual(FString::Printf(TEXT("Every cell is converted for the string array (%s)"), *Context), Copy.GetValueAsStringArray().Num(), Layout.NumRows * Layout.NumColumns);
+	}
+
+	// A string array holds its strings itself, with a single column
+	Output.SetValue(TArray<FString>{ TEXT("first"), TEXT("second") });
+	TestEqual(TEXT("A string array has one row per string"), Output.GetDATNumRows(), 2);
+	TestEqual(TEXT("A string array has a single column"), Output.GetDATNumColumns(), 1);
+	TestTrue(TEXT("The cells of a string array are read"), Output.GetDATCell(1, 0) == UTF8TEXTVIEW("second"));
+	TestEqual(TEXT("The rows of a string array are read"), Output.GetDATRow(1)[0], FString(TEXT("second")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableContainerUnchangedFrameTest, "TouchEngine.DynamicVariableContainer.UnchangedFrameAllocations", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableContainerUnchangedFrameTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("UnchangedFrame"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	FTouchEngineDynamicVariableContainer Container;
+	Container.ToxParametersLoaded(Harness.VariablesIn, Harness.VariablesOut);
+	FTouchEngineDynamicVariableStruct* InputValue = Container.GetDynamicVariableByIdentifier(TEXT("in/value"));
+	FTouchEngineDynamicVariableStruct* InputToggle = Container.GetDynamicVariableByIdentifier(TEXT("in/toggle"));
+	FTouchEngineDynamicVariableStruct* InputCount = Container.GetDynamicVariableByIdentifier(TEXT("in/count"));
+	FTouchEngineDynamicVariableStruct* InputText = Container.GetDynamicVariableByIdentifier(TEXT("in/text"));
+	if (!TestTrue(TEXT("The inputs exist"), InputValue && InputToggle && InputCount && InputText))
+	{
+		return false;
+	}
+
+	// Sets the inputs the way the Blueprint library does, with the same values every frame
+	const auto SetInputs = [&](double Value)
+	{
+		const int64 FrameID = Harness.FrameCooker->GetNextFrameID();
+		InputValue->SetValue(Value);
+		InputValue->SetFrameLastUpdatedIfValueChanged(FrameID);
+		InputToggle->SetValue(true);
+		InputToggle->SetFrameLastUpdatedIfValueChanged(FrameID);
+		InputCount->SetValue(3);
+		InputCount->SetFrameLastUpdatedIfValueChanged(FrameID);
+		InputText->SetValue(FString(TEXT("unchanged")));
+		InputText->SetFrameLastUpdatedIfValueChanged(FrameID);
+		return Container.CopyInputsForCook(FrameID);
+	};
+
+	TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend = SetInputs(1.0);
+	TestEqual(TEXT("Every input is sent on the first cook"), VariablesToSend.Num(), Container.DynVars_Input.Num());
+	Harness.CookAndRelease(MoveTemp(VariablesToSend));
+
+	constexpr int32 NumUnchangedFrames = 100;
+	int32 NumAllocations = 0;
+	int32 NumInputsSent = 0;
+	for (int32 Index = 0; Index < NumUnchangedFrames; ++Index)
+	{
+		{
+			Tests::FScopedAllocationCounter AllocationCounter;
+			VariablesToSend = SetInputs(1.0);
+			NumAllocations += AllocationCounter.GetNumAllocations();
+		}
+		NumInputsSent += VariablesToSend.Num();
+		Harness.CookAndRelease(MoveTemp(VariablesToSend));
+	}
+	TestEqual(TEXT("Allocations made by unchanged frames"), NumAllocations, 0);
+	TestEqual(TEXT("Inputs sent by unchanged frames"), NumInputsSent, 0);
+
+	VariablesToSend = SetInputs(2.0);
+	TestEqual(TEXT("Only the changed input is sent"), VariablesToSend.Num(), 1);
+	TestTrue(TEXT("The changed input is in/value"), VariablesToSend.Contains(TEXT("in/value")));
+	Harness.CookAndRelease(MoveTemp(VariablesToSend));
+	TestEqual(TEXT("The changed input is cooked"), Harness.VariableManager->GetDoubleOutput(TEXT("out/value")), 2.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableContainerHandleLookupTest, "TouchEngine.DynamicVariableContainer.HandleLookup", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableContainerHandleLookupTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("HandleLookup"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	FTouchEngineDynamicVariableContainer Container;
+	Container.ToxParametersLoaded(Harness.VariablesIn, Harness.VariablesOut);
+	const FString Prefix;
+	const TArray<FString> Names = { TEXT("in/value"), TEXT("in/count"), TEXT("out/value"), TEXT("out/frame") };
+
+	// Like a node which name pin is linked to a variable which changes between calls, with a single handle
+	constexpr int32 NumCalls = 10000;
+	FTouchEngineDynamicVariableHandle Handle;
+	int32 NumMatchingVariables = 0;
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		const FString& Name = Names[(Index / 3) % Names.Num()];
+		const FTouchEngineDynamicVariableStruct* DynVar = Container.FindDynamicVariable(Name, Prefix, Handle);
+		NumMatchingVariables += DynVar && DynVar->VarIdentifier == Name ? 1 : 0;
+	}
+	TestEqual(TEXT("Variables found when the name changes"), NumMatchingVariables, NumCalls);
+	TestNull(TEXT("Unknown names are not found"), Container.FindDynamicVariable(TEXT("in/unknown"), Prefix, Handle));
+	TestNull(TEXT("Unknown names are looked up again"), Container.FindDynamicVariable(TEXT("in/unknown"), Prefix, Handle));
+	TestNotNull(TEXT("A handle which did not find its variable can find the next one"), Container.FindDynamicVariable(Names[0], Prefix, Handle));
+
+	TArray<double> ByNameDurations;
+	TArray<double> ByHandleDurations;
+	ByNameDurations.Reserve(NumCalls);
+	ByHandleDurations.Reserve(NumCalls);
+	int32 NumFoundByName = 0;
+	int32 NumFoundByHandle = 0;
+	for (int32 Index = 0; Index < NumCalls; ++Index)
+	{
+		const FString& Name = Names[Index % Names.Num()];
+		FTouchEngineDynamicVariableHandle NewHandle;
+		double StartTime = FPlatformTime::Seconds();
+		NumFoundByName += Container.FindDynamicVariable(Name, Prefix, NewHandle) ? 1 : 0;
+		ByNameDurations.Add(FPlatformTime::Seconds() - StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		NumFoundByHandle += Container.FindDynamicVariable(Name, Prefix, NewHandle) ? 1 : 0;
+		ByHandleDurations.Add(FPlatformTime::Seconds() - StartTime);
+	}
+	TestEqual(TEXT("Variables found by name"), NumFoundByName, NumCalls);
+	TestEqual(TEXT("Variables found by handle"), NumFoundByHandle, NumCalls);
+	Tests::AddDurationInfo(*this, TEXT("FindDynamicVariable by name"), MoveTemp(ByNameDurations));
+	Tests::AddDurationInfo(*this, TEXT("FindDynamicVariable by handle"), MoveTemp(ByHandleDurations));
+
+	// Reloading the variables makes every handle stale
+	Container.ToxParametersLoaded(Harness.VariablesIn, Harness.VariablesOut);
+	const FTouchEngineDynamicVariableStruct* ReloadedVariable = Container.FindDynamicVariable(Names[0], Prefix, Handle);
+	TestTrue(TEXT("The reloaded variable is found"), ReloadedVariable && ReloadedVariable->VarIdentifier == Names[0]);
+	return true;
+}
+
+
+namespace UE::TouchEngine::Tests
+{
+	/** The variable GetDynamicVariableByIdentifier is documented to return, found without the lookup */
+	static const FTouchEngineDynamicVariableStruct* FindByIdentifierLinear(const FTouchEngineDynamicVariableContainer& Container, const FString& VarIdentifier)
+	{
+		for (const TArray<FTouchEngineDynamicVariableStruct>* Variables : { &Container.DynVars_Input, &Container.DynVars_Output })
+		{
+			for (const FTouchEngineDynamicVariableStruct& Variable : *Variables)
+			{
+				if (Variable.VarIdentifier.Equals(VarIdentifier) || Variable.VarLabel.Equals(VarIdentifier) || Variable.VarName.Equals(VarIdentifier))
+				{
+					return &Variable;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	/** The variable GetDynamicVariableByName is documented to return, found without the lookup */
+	static const FTouchEngineDynamicVariableStruct* FindByNameLinear(const FTouchEngineDynamicVariableContainer& Container, const FString& VarName)
+	{
+		const FTouchEngineDynamicVariableStruct* Found = nullptr;
+		for (const TArray<FTouchEngineDynamicVariableStruct>* Variables : { &Container.DynVars_Input, &Container.DynVars_Output })
+		{
+			for (const FTouchEngineDynamicVariableStruct& Variable : *Variables)
+			{
+				if (Variable.VarName.Equals(VarName, ESearchCase::IgnoreCase))
+				{
+					if (Found)
+					{
+						return nullptr;
+					}
+					Found = &Variable;
+				}
+			}
+		}
+		return Found;
+	}
+
+	/** Checks that the lookup returns the same variables as a linear search for every name of the variables and the given extra names */
+	static bool IsLookupConsistent(FAutomationTestBase& Test, FTouchEngineDynamicVariableContainer& Container, const FString& Context, const TArray<FString>& ExtraNames = {})
+	{
+		TArray<FString> Names = ExtraNames;
+		for (const TArray<FTouchEngineDynamicVariableStruct>* Variables : { &Container.DynVars_Input, &Container.DynVars_Output })
+		{
+			for (const FTouchEngineDynamicVariableStruct& Variable : *Variables)
+			{
+				Names.Append({ Variable.VarIdentifier, Variable.VarLabel, Variable.VarName });
+			}
+		}
+
+		int32 NumMismatches = 0;
+		for (const FString& Name : Names)
+		{
+			NumMismatches += Container.GetDynamicVariableByIdentifier(Name) != FindByIdentifierLinear(Container, Name) ? 1 : 0;
+			NumMismatches += Container.GetDynamicVariableByName(Name) != FindByNameLinear(Container, Name) ? 1 : 0;
+		}
+		Test.TestEqual(FString::Printf(TEXT("Lookups differing from a linear search (%s)"), *Context), NumMismatches, 0);
+		return NumMismatches == 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchDynamicVariableContainerLookupConsistencyTest, "TouchEngine.DynamicVariableContainer.LookupConsistency", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchDynamicVariableContainerLookupConsistencyTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("LookupConsistency"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	FTouchEngineDynamicVariableContainer Container;
+	Container.ToxParametersLoaded(Harness.VariablesIn, Harness.VariablesOut);
+	Tests::IsLookupConsistent(*this, Container, TEXT("First load"));
+	FTouchEngineDynamicVariableHandle Handle;
+	Container.FindDynamicVariable(TEXT("in/count"), FString(), Handle);
+
+	// The tox is reloaded with a variable removed and another one added, like after the tox file was edited
+	TArray<FTouchEngineDynamicVariableStruct> ReloadedInputs = Harness.VariablesIn;
+	ReloadedInputs.RemoveAll([](const FTouchEngineDynamicVariableStruct& Variable) { return Variable.VarIdentifier == TEXT("in/count"); });
+	FTouchEngineDynamicVariableStruct Added = ReloadedInputs[0];
+	Added.VarIdentifier = Added.VarLabel = Added.VarName = TEXT("in/added");
+	ReloadedInputs.Add(MoveTemp(Added));
+	Container.ToxParametersLoaded(ReloadedInputs, Harness.VariablesOut);
+	Tests::IsLookupConsistent(*this, Container, TEXT("Reload"), { TEXT("in/count") });
+	TestNull(TEXT("A handle made before the reload is stale"), Container.GetDynamicVariableByHandle(Handle));
+
+#if WITH_EDITOR
+	// The details panel edits the variables in place, then calls PostEditChangeProperty
+	UTouchEngineComponentBase* Component = NewObject<UTouchEngineComponentBase>(GetTransientPackage());
+	Component->DynamicVariables = Container;
+	Tests::IsLookupConsistent(*this, Component->DynamicVariables, TEXT("Component"));
+	const FTouchEngineDynamicVariableStruct* InputsData = Component->DynamicVariables.DynVars_Input.GetData();
+	FTouchEngineDynamicVariableStruct& Edited = Component->DynamicVariables.DynVars_Input.Last();
+	Edited.VarIdentifier = Edited.VarLabel = Edited.VarName = TEXT("in/edited");
+	FPropertyChangedEvent PropertyChangedEvent(FindFProperty<FProperty>(UTouchEngineComponentBase::StaticClass(), GET_MEMBER_NAME_CHECKED(UTouchEngineComponentBase, DynamicVariables)));
+	Component->PostEditChangeProperty(PropertyChangedEvent);
+	TestTrue(TEXT("The details panel edit did not reallocate the variables"), Component->DynamicVariables.DynVars_Input.GetData() == InputsData);
+	Tests::IsLookupConsistent(*this, Component->DynamicVariables, TEXT("Details panel edit"), { TEXT("in/added") });
+	Component->MarkAsGarbage();
+#endif
+
+	// Loading over a container with the same number of variables replaces them without reallocating the arrays
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FTouchEngineDynamicVariableContainer::StaticStruct()->SerializeItem(Writer, &Container, nullptr);
+
+	FTouchEngineDynamicVariableContainer Loaded;
+	Loaded.ToxParametersLoaded(ReloadedInputs, Harness.VariablesOut);
+	for (FTouchEngineDynamicVariableStruct& Variable : Loaded.DynVars_Input)
+	{
+		Variable.VarIdentifier = Variable.VarLabel = Variable.VarName = TEXT("before/") + Variable.VarIdentifier;
+	}
+	Loaded.InvalidateLookup();
+	Tests::IsLookupConsistent(*this, Loaded, TEXT("Before loading"));
+
+	FMemoryReader Reader(Bytes);
+	FTouchEngineDynamicVariableContainer::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+	TestEqual(TEXT("Every input is loaded"), Loaded.DynVars_Input.Num(), Container.DynVars_Input.Num());
+	Tests::IsLookupConsistent(*this, Loaded, TEXT("Serialize"), { TEXT("before/in/value") });
+	return true;
+}
+
+#endif
+
+#endif
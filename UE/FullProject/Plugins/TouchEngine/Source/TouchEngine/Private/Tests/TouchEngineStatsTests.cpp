@@ -0,0 +1,186 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "Tests/TouchStubHarness.h"
+#include "Misc/AutomationTest.h"
+#include "Util/TouchEngineStatsGroup.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchEngineStatsCookTimesTest, "TouchEngine.Stats.CookTimes", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchEngineStatsCookTimesTest::RunTest(const FString& Parameters)
+{
+	Stub::FStubTox Tox = Tests::MakeEchoTox();
+	Tox.CookDurationSeconds = 0.02;
+	Tests::FTouchStubHarness Harness(TEXT("StatsCookTimes"), MoveTemp(Tox));
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchEngineStatCounters& Counters = FTouchEngineStatCounters::Get();
+	Counters.LastCookLatency = -1.0;
+	Counters.LastCookTimeQueued = -1.0;
+	Counters.LastCookTimeInTouchEngine = -1.0;
+
+	const double RequestTime = FPlatformTime::Seconds();
+	if (!TestTrue(TEXT("The frame is cooked"), Harness.CookAndRelease().Result == ECookFrameResult::Success))
+	{
+		return false;
+	}
+	const double ResultTime = FPlatformTime::Seconds();
+
+	const double Latency = Counters.LastCookLatency;
+	const double TimeQueued = Counters.LastCookTimeQueued;
+	const double TimeInTouchEngine = Counters.LastCookTimeInTouchEngine;
+	TestTrue(TEXT("The time queued is set"), TimeQueued >= 0.0);
+	TestTrue(TEXT("The time in TouchEngine includes the stub cook duration"), TimeInTouchEngine >= 0.02);
+	TestTrue(TEXT("The latency includes the time queued and the time in TouchEngine"), Latency >= TimeInTouchEngine && Latency >= TimeQueued);
+	TestTrue(TEXT("The latency is measured within the cook request"), Latency <= ResultTime - RequestTime);
+	AddInfo(FString::Printf(TEXT("Latency %.2f ms, queued %.2f ms, in TouchEngine %.2f ms"), Latency * 1000.0, TimeQueued * 1000.0, TimeInTouchEngine * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchEngineStatsCookCountersTest, "TouchEngine.Stats.CookCounters", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchEngineStatsCookCountersTest::RunTest(const FString& Parameters)
+{
+	// The third frame is reported as dropped by TouchEngine
+	Stub::FStubTox Tox = Tests::MakeEchoTox();
+	Tox.CookDurationSeconds = 0.02;
+	Tox.OnCookFrame = [EchoFrame = MoveTemp(Tox.OnCookFrame)](Stub::FStubFrame& Frame)
+	{
+		EchoFrame(Frame);
+		Frame.bDropped = Frame.FrameIndex == 2;
+	};
+	Tests::FTouchStubHarness Harness(TEXT("StatsCookCounters"), MoveTemp(Tox));
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	const FTouchEngineStatCounters& Counters = FTouchEngineStatCounters::Get();
+
+	const uint64 NbDroppedFramesBefore = Counters.NbDroppedFrames;
+	for (int32 Frame = 0; Frame < 4; ++Frame)
+	{
+		if (!TestTrue(TEXT("The frame is cooked"), Harness.CookAndRelease().Result == ECookFrameResult::Success))
+		{
+			return false;
+		}
+	}
+	TestTrue(TEXT("Dropped frames"), Counters.NbDroppedFrames - NbDroppedFramesBefore == 1);
+
+	// With an input buffer limit of 1, the second request is merged into the third while the first one is cooking
+	const uint64 NbMergedCooksBefore = Counters.NbMergedCooks;
+	const TFuture<FCookFrameResult> FirstCook = Harness.Cook();
+	const TFuture<FCookFrameResult> SecondCook = Harness.Cook();
+	const TFuture<FCookFrameResult> ThirdCook = Harness.Cook();
+	TestTrue(TEXT("Merged cooks"), Counters.NbMergedCooks - NbMergedCooksBefore == 1);
+	if (TestTrue(TEXT("The merged cook has a result"), Tests::WaitFor(SecondCook)))
+	{
+		TestTrue(TEXT("The inputs of the merged cook were discarded"), SecondCook.Get().Result == ECookFrameResult::InputsDiscarded);
+	}
+	for (const TFuture<FCookFrameResult>* Cook : { &FirstCook, &ThirdCook })
+	{
+		if (!TestTrue(TEXT("The cook finished"), Tests::WaitFor(*Cook)))
+		{
+			return false;
+		}
+		if (Cook->Get().OnReadyToStartNextCook)
+		{
+			Cook->Get().OnReadyToStartNextCook->SetValue();
+		}
+	}
+
+	// Cancelling counts the cook in progress and every queued one
+	const uint64 NbCancelledCooksBefore = Counters.NbCancelledCooks;
+	const TFuture<FCookFrameResult> CookToCancel = Harness.Cook({}, 2);
+	const TFuture<FCookFrameResult> QueuedCookToCancel = Harness.Cook({}, 2);
+	if (!TestTrue(TEXT("The first cook is in progress"), Harness.FrameCooker->IsCookingFrame()))
+	{
+		return false;
+	}
+	Harness.FrameCooker->CancelCurrentAndNextCooks();
+	TestTrue(TEXT("Cancelled cooks"), Counters.NbCancelledCooks - NbCancelledCooksBefore == 2);
+	for (const TFuture<FCookFrameResult>* Cook : { &CookToCancel, &QueuedCookToCancel })
+	{
+		if (TestTrue(TEXT("The cancelled cook has a result"), Tests::WaitFor(*Cook)))
+		{
+			TestTrue(TEXT("The cook was cancelled"), Cook->Get().Result == ECookFrameResult::Cancelled);
+			if (Cook->Get().OnReadyToStartNextCook)
+			{
+				Cook->Get().OnReadyToStartNextCook->SetValue();
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchEngineStatsVariableCountersTest, "TouchEngine.Stats.VariableCounters", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchEngineStatsVariableCountersTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("StatsVariableCounters"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+	const FTouchEngineStatCounters& Counters = FTouchEngineStatCounters::Get();
+
+	// The CHOP sent to in/chop is echoed to out/chop by the cook
+	constexpr int32 NumChannels = 3;
+	constexpr int32 NumSamples = 16;
+	FTouchEngineCHOP CHOP;
+	for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+	{
+		FTouchEngineCHOPChannel& Channel = CHOP.Channels.AddDefaulted_GetRef();
+		Channel.Name = FString::Printf(TEXT("chan%d"), ChannelIndex + 1);
+		Channel.Values.Init(static_cast<float>(ChannelIndex), NumSamples);
+	}
+	const uint64 NbSamplesSentBefore = Counters.NbCHOPSamplesSent;
+	VariableManager.SetCHOPInput(VariableManager.GetLinkHandle(TEXT("in/chop")), CHOP);
+	TestTrue(TEXT("CHOP samples sent"), Counters.NbCHOPSamplesSent - NbSamplesSentBefore == NumChannels * NumSamples);
+	if (!TestTrue(TEXT("The frame is cooked"), Harness.CookAndRelease().Result == ECookFrameResult::Success))
+	{
+		return false;
+	}
+
+	const uint64 NbSamplesReceivedBefore = Counters.NbCHOPSamplesReceived;
+	const FTouchEngineCHOPView Received = VariableManager.GetCHOPOutputView(TEXT("out/chop"));
+	TestEqual(TEXT("The CHOP is echoed"), Received.GetNumChannels() * Received.GetNumSamples(), NumChannels * NumSamples);
+	TestTrue(TEXT("CHOP samples received"), Counters.NbCHOPSamplesReceived - NbSamplesReceivedBefore == NumChannels * NumSamples);
+
+	// Only invalidated link infos are queried from TouchEngine again
+	Stub::SetLinkValue(Harness.Instance, TEXT("out/value"), 42.0);
+	const FTouchLinkHandle Handle = VariableManager.GetLinkHandle(TEXT("out/value"));
+	uint64 NbLookupsBefore = Counters.NbLinkInfoLookups;
+	uint64 NbCacheMissesBefore = Counters.NbLinkInfoCacheMisses;
+	VariableManager.GetDoubleOutput(Handle);
+	TestTrue(TEXT("Link info lookups with a cached link info"), Counters.NbLinkInfoLookups - NbLookupsBefore == 1);
+	TestTrue(TEXT("Link info cache misses with a cached link info"), Counters.NbLinkInfoCacheMisses == NbCacheMissesBefore);
+
+	VariableManager.InvalidateLinkInfo_AnyThread("out/value");
+	NbLookupsBefore = Counters.NbLinkInfoLookups;
+	NbCacheMissesBefore = Counters.NbLinkInfoCacheMisses;
+	VariableManager.GetDoubleOutput(Handle);
+	TestTrue(TEXT("Link info lookups after invalidation"), Counters.NbLinkInfoLookups - NbLookupsBefore == 1);
+	TestTrue(TEXT("Link info cache misses after invalidation"), Counters.NbLinkInfoCacheMisses - NbCacheMissesBefore == 1);
+	return true;
+}
+
+#endif
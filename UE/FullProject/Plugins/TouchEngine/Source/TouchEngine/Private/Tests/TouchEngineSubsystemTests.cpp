@@ -0,0 +1,300 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "ToxAsset.h"
+#include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineSubsystem.h"
+#include "Tests/TouchStubHarness.h"
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "UObject/Package.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** Writes a .tox file for the stub, which does not read it, and registers what loading it finds. The new content ensures FToxParameterCache never knows it. Returns an empty path on failure */
+	static FString WriteStubTox(const FString& ToxName, const Stub::FStubTox& Tox)
+	{
+		const FString ToxPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), ToxName + TEXT(".tox")));
+		if (!FFileHelper::SaveStringToFile(FGuid::NewGuid().ToString(), *ToxPath))
+		{
+			return FString();
+		}
+		Stub::RegisterTox(ToxPath, Tox);
+		return ToxPath;
+	}
+
+	static UToxAsset* MakeStubToxAsset(const FString& ToxName, const Stub::FStubTox& Tox)
+	{
+		const FString ToxPath = WriteStubTox(ToxName, Tox);
+		if (ToxPath.IsEmpty())
+		{
+			return nullptr;
+		}
+		UToxAsset* ToxAsset = NewObject<UToxAsset>(GetTransientPackage());
+		ToxAsset->SetFilePath(ToxPath);
+		return ToxAsset;
+	}
+
+	/** Sets an integer console variable of the subsystem for as long as it is alive */
+	class FScopedConsoleVariable
+	{
+	public:
+		FScopedConsoleVariable(const TCHAR* Name, int32 Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+			, PreviousValue(CVar ? CVar->GetInt() : 0)
+		{
+			if (CVar)
+			{
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+		~FScopedConsoleVariable()
+		{
+			if (CVar)
+			{
+				CVar->Set(PreviousValue, ECVF_SetByCode);
+			}
+		}
+		UE_NONCOPYABLE(FScopedConsoleVariable);
+
+	private:
+		IConsoleVariable* CVar;
+		int32 PreviousValue;
+	};
+
+	/** Requests the parameters of every asset at once, ignoring what is cached, and returns how long it took for all of them to be loaded. Returns -1 if any load failed or timed out */
+	static double LoadAll(UTouchEngineSubsystem& Subsystem, TConstArrayView<UToxAsset*> ToxAssets)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<TFuture<FCachedToxFileInfo>> Futures;
+		for (UToxAsset* ToxAsset : ToxAssets)
+		{
+			Futures.Add(Subsystem.GetOrLoadParamsFromTox(ToxAsset, 5.0, true));
+		}
+		for (const TFuture<FCachedToxFileInfo>& Future : Futures)
+		{
+			if (!WaitFor(Future, 10.0) || !Future.Get().LoadResult.IsSuccess())
+			{
+				return -1.0;
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchEngineSubsystemLoaderPoolTest, "TouchEngine.Subsystem.LoaderPool", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchEngineSubsystemLoaderPoolTest::RunTest(const FString& Parameters)
+{
+	using namespace Tests;
+	Stub::FScopedEnable StubEnabled;
+	UTouchEngineSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+	if (!TestNotNull(TEXT("Subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// The stub completes every load after LoadDurationSeconds on its own thread, so loads running at the same time overlap like in TouchEngine
+	constexpr int32 NumToxFiles = 4;
+	Stub::FStubTox Tox = MakeEchoTox();
+	Tox.LoadDurationSeconds = 0.25;
+	TArray<UToxAsset*> ToxAssets;
+	for (int32 Index = 0; Index < NumToxFiles; ++Index)
+	{
+		UToxAsset* ToxAsset = MakeStubToxAsset(FString::Printf(TEXT("SubsystemLoaderPool%d"), Index), Tox);
+		if (!TestNotNull(TEXT("The tox file is written"), ToxAsset))
+		{
+			return false;
+		}
+		ToxAssets.Add(ToxAsset);
+	}
+
+	double SequentialSeconds;
+	{
+		FScopedConsoleVariable MaxConcurrentToxLoads(TEXT("TouchEngine.Subsystem.MaxConcurrentToxLoads"), 1);
+		SequentialSeconds = LoadAll(*Subsystem, ToxAssets);
+	}
+	double ParallelSeconds;
+	{
+		FScopedConsoleVariable MaxConcurrentToxLoads(TEXT("TouchEngine.Subsystem.MaxConcurrentToxLoads"), NumToxFiles);
+		ParallelSeconds = LoadAll(*Subsystem, ToxAssets);
+	}
+	if (!TestTrue(TEXT("Every file is loaded one at a time"), SequentialSeconds >= 0.0) || !TestTrue(TEXT("Every file is loaded at the same time"), ParallelSeconds >= 0.0))
+	{
+		return false;
+	}
+	AddInfo(FString::Printf(TEXT("%d files loaded in %.0f ms one at a time, %.0f ms with %d loader engines (%.1fx)"), NumToxFiles, SequentialSeconds * 1e3, ParallelSeconds * 1e3, NumToxFiles, SequentialSeconds / ParallelSeconds));
+	TestTrue(TEXT("Loading one file at a time takes the sum of the load durations"), SequentialSeconds >= NumToxFiles * Tox.LoadDurationSeconds);
+	TestTrue(TEXT("Loading the files at the same time takes less than half as long"), ParallelSeconds < SequentialSeconds / 2.0);
+
+	// Several assets can point to the same file, and the details panel of each can request it while it loads
+	UToxAsset* SameFileAsset = NewObject<UToxAsset>(GetTransientPackage());
+	SameFileAsset->SetFilePath(ToxAssets[0]->GetAbsoluteFilePath());
+	const TArray<UToxAsset*> SameFileAssets { ToxAssets[0], ToxAssets[0], SameFileAsset };
+	const uint64 NumLoadsBefore = Stub::GetNumLoadCalls();
+	const double CoalescedSeconds = LoadAll(*Subsystem, SameFileAssets);
+	TestTrue(TEXT("Every request for the same file is loaded"), CoalescedSeconds >= 0.0);
+	TestTrue(TEXT("Requests for a file which is already loading share its load"), Stub::GetNumLoadCalls() - NumLoadsBefore == 1);
+	TestTrue(TEXT("Requests for the same file are loaded in a single load duration"), CoalescedSeconds < 2.0 * Tox.LoadDurationSeconds);
+
+	for (UToxAsset* ToxAsset : ToxAssets)
+	{
+		Stub::UnregisterTox(ToxAsset->GetAbsoluteFilePath());
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchEngineSubsystemInstancePoolTest, "TouchEngine.Subsystem.InstancePool", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchEngineSubsystemInstancePoolTest::RunTest(const FString& Parameters)
+{
+	using namespace Tests;
+	Stub::FScopedEnable StubEnabled;
+	UTouchEngineSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+	if (!TestNotNull(TEXT("Subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	const FString EchoToxPath = WriteStubTox(TEXT("SubsystemInstancePoolEcho"), MakeEchoTox());
+	Stub::FStubTox OtherTox;
+	OtherTox.Links.Add(Stub::FStubLink::MakeGroup(TEXT("other"), TEScopeInput));
+	OtherTox.Links.Add(Stub::FStubLink::MakeValue(TEXT("other/gain"), TEXT("other"), TEScopeInput, TELinkTypeDouble));
+	const FString OtherToxPath = WriteStubTox(TEXT("SubsystemInstancePoolOther"), OtherTox);
+	if (!TestFalse(TEXT("The tox files are written"), EchoToxPath.IsEmpty() || OtherToxPath.IsEmpty()))
+	{
+		return false;
+	}
+
+	constexpr int32 PoolSize = 2;
+	constexpr int64 FrameRate = 60;
+	constexpr int32 NumAcquires = 20;
+	TArray<double> ColdDurations;
+	TArray<double> PooledDurations;
+	TArray<TSharedRef<FTouchEngine>> DrainedEngines;
+	{
+		FScopedConsoleVariable InstancePoolSize(TEXT("TouchEngine.Subsystem.InstancePoolSize"), PoolSize);
+		FScopedConsoleVariable InstancePoolFrameRate(TEXT("TouchEngine.Subsystem.InstancePoolFrameRate"), FrameRate);
+
+		// Without the pool, the component creates the engine and LoadTox_GameThread starts its instance
+		for (int32 Index = 0; Index < NumAcquires; ++Index)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			const TSharedRef<FTouchEngine> Engine = MakeShared<FTouchEngine>();
+			Engine->SetFrameRate(FrameRate);
+			const bool bStarted = Engine->Prewarm_GameThread();
+			ColdDurations.Add(FPlatformTime::Seconds() - StartTime);
+			TestTrue(TEXT("A cold instance is started"), bStarted);
+			Engine->DestroyTouchEngine_GameThread();
+		}
+
+		// The first miss schedules the refill, and the pool starts one instance per tick
+		Subsystem->AcquirePooledEngine(FrameRate);
+		for (int32 Index = 0; Index < NumAcquires; ++Index)
+		{
+			if (!TestTrue(TEXT("The pool is warmed"), WaitUntil([Subsystem]() { return Subsystem->GetNumPooledEngines() >= PoolSize; })))
+			{
+				return false;
+			}
+			const double StartTime = FPlatformTime::Seconds();
+			const TSharedPtr<FTouchEngine> Engine = Subsystem->AcquirePooledEngine(FrameRate);
+			PooledDurations.Add(FPlatformTime::Seconds() - StartTime);
+			if (!TestTrue(TEXT("A started instance is acquired from the pool"), Engine.IsValid() && Engine->HasCreatedTouchInstance()))
+			{
+				return false;
+			}
+			Subsystem->ReleaseEngineToPool(Engine.ToSharedRef());
+		}
+		AddDurationInfo(*this, TEXT("Cold instance start"), ColdDurations);
+		AddDurationInfo(*this, TEXT("Pooled instance acquire"), PooledDurations);
+		ColdDurations.Sort();
+		PooledDurations.Sort();
+		TestTrue(TEXT("Acquiring a pooled instance is faster than starting one"), PooledDurations[NumAcquires / 2] < ColdDurations[NumAcquires / 2]);
+
+		// A component loads its tox file in the pooled instance and sets an input, then releases it
+		const TSharedPtr<FTouchEngine> Engine = Subsystem->AcquirePooledEngine(FrameRate);
+		if (!TestTrue(TEXT("An instance is acquired"), Engine.IsValid()))
+		{
+			return false;
+		}
+		TFuture<FTouchLoadResult> LoadFuture = Engine->LoadTox_GameThread(EchoToxPath, nullptr, 5.0);
+		if (!TestTrue(TEXT("The tox is loaded in the pooled instance"), WaitFor(LoadFuture) && LoadFuture.Get().IsSuccess()))
+		{
+			return false;
+		}
+		TEInstance* Instance = Engine->GetResourceProvider()->GetInstance().get();
+		TestEqual(TEXT("The input is set"), Stub::SetLinkValue(Instance, TEXT("in/value"), 42.0), TEResultSuccess);
+
+		// Only the released instance is left in the pool, so it is the next one acquired. It is acquired again before its unload is done
+		while (const TSharedPtr<FTouchEngine> PooledEngine = Subsystem->AcquirePooledEngine(FrameRate))
+		{
+			DrainedEngines.Add(PooledEngine.ToSharedRef());
+		}
+		Subsystem->ReleaseEngineToPool(Engine.ToSharedRef());
+		const TSharedPtr<FTouchEngine> ReusedEngine = Subsystem->AcquirePooledEngine(FrameRate);
+		TestTrue(TEXT("The released instance is reused"), ReusedEngine == Engine);
+		if (ReusedEngine)
+		{
+			TestTrue(TEXT("The reused instance is still started"), ReusedEngine->HasCreatedTouchInstance());
+			TestTrue(TEXT("The reused instance has no tox path"), ReusedEngine->GetToxPath().IsEmpty());
+			TestFalse(TEXT("The reused instance cannot cook"), ReusedEngine->IsReadyToCookFrame());
+			TestFalse(TEXT("The reused instance has no variables"), ReusedEngine->GetVariableManager().IsValid());
+
+			// Another component loads another tox file: it must only see its own links
+			LoadFuture = ReusedEngine->LoadTox_GameThread(OtherToxPath, nullptr, 5.0);
+			if (TestTrue(TEXT("Another tox is loaded in the reused instance"), WaitFor(LoadFuture) && LoadFuture.Get().IsSuccess()))
+			{
+				const FTouchLoadSuccessResult& LoadResult = LoadFuture.Get().SuccessResult.GetValue();
+				TestEqual(TEXT("Inputs of the other tox"), LoadResult.Inputs.Num(), 1);
+				TestTrue(TEXT("The input of the other tox"), LoadResult.Inputs.Num() == 1 && LoadResult.Inputs[0].VarIdentifier == TEXT("other/gain"));
+				TestEqual(TEXT("Outputs of the other tox"), LoadResult.Outputs.Num(), 0);
+			}
+
+			// And reloading the first tox file starts from its default values
+			ReusedEngine->Unload_GameThread();
+			LoadFuture = ReusedEngine->LoadTox_GameThread(EchoToxPath, nullptr, 5.0);
+			if (TestTrue(TEXT("The first tox is loaded again"), WaitFor(LoadFuture) && LoadFuture.Get().IsSuccess()))
+			{
+				double Value = -1.0;
+				TEInstanceLinkGetDoubleValue(ReusedEngine->GetResourceProvider()->GetInstance(), "in/value", TELinkValueCurrent, &Value, 1);
+				TestEqual(TEXT("The input set before the release is reset"), Value, 0.0);
+			}
+			ReusedEngine->DestroyTouchEngine_GameThread();
+		}
+	}
+
+	// The pool size is back to its previous value, so the pool is not refilled once emptied
+	for (const TSharedRef<FTouchEngine>& Engine : DrainedEngines)
+	{
+		Engine->DestroyTouchEngine_GameThread();
+	}
+	while (const TSharedPtr<FTouchEngine> PooledEngine = Subsystem->AcquirePooledEngine(FrameRate))
+	{
+		PooledEngine->DestroyTouchEngine_GameThread();
+	}
+	Stub::UnregisterTox(EchoToxPath);
+	Stub::UnregisterTox(OtherToxPath);
+	return true;
+}
+
+#endif
@@ -0,0 +1,149 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Rendering/Exporting/TouchExportTexturePool.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** Stands for an exported texture, which state is driven by the test instead of dynamic variables, cooks and TouchEngine */
+	struct FFakeExportTexture
+	{
+		int32 Id = 0;
+		int32 Key = 0;
+		bool bIsInUse = true;
+		bool bIsReleasedByTouchEngine = false;
+		int32 NumNoLongerInUseCalls = 0;
+	};
+	using FFakeExportTextureRef = TSharedRef<FFakeExportTexture>;
+
+	struct FFakeExportPolicy
+	{
+		bool IsInUse(const FFakeExportTextureRef& Texture) const { return Texture->bIsInUse; }
+		void OnNoLongerInUse(FFakeExportTextureRef& Texture) const { ++Texture->NumNoLongerInUseCalls; }
+		bool CanBeReused(const FFakeExportTextureRef& Texture) const { return Texture->bIsReleasedByTouchEngine; }
+		TOptional<int32> GetKey(const FFakeExportTextureRef& Texture) const { return Texture->Key; }
+	};
+
+	static FFakeExportTextureRef MakeFakeExportTexture(int32 Id, int32 Key)
+	{
+		FFakeExportTextureRef Texture = MakeShared<FFakeExportTexture>();
+		Texture->Id = Id;
+		Texture->Key = Key;
+		return Texture;
+	}
+
+	/** Makes the texture reusable, the way it becomes once dynamic variables, cooks and TouchEngine are all done with it */
+	static void ReleaseFakeExportTexture(const FFakeExportTextureRef& Texture)
+	{
+		Texture->bIsInUse = false;
+		Texture->bIsReleasedByTouchEngine = true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchExportTexturePoolStatesTest, "TouchEngine.Util.ExportTexturePool.States", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchExportTexturePoolStatesTest::RunTest(const FString& Parameters)
+{
+	TTouchExportTexturePool<int32, Tests::FFakeExportTextureRef> Pool;
+	Tests::FFakeExportPolicy Policy;
+	const Tests::FFakeExportTextureRef Texture = Tests::MakeFakeExportTexture(1, 10);
+	const auto AcceptAll = [](const Tests::FFakeExportTextureRef&) { return true; };
+
+	Pool.AddInUse(Texture);
+	Pool.Maintenance(4, Policy);
+	TestEqual(TEXT("A used texture stays in use"), Pool.Num(EExportTextureState::InUse), 1);
+	TestFalse(TEXT("A texture in use cannot be acquired"), Pool.AcquireAvailable(10, AcceptAll).IsSet());
+
+	Texture->bIsInUse = false;
+	Pool.Maintenance(4, Policy);
+	TestEqual(TEXT("An unused texture waits for TouchEngine"), Pool.Num(EExportTextureState::WaitingForTouchEngine), 1);
+	TestEqual(TEXT("OnNoLongerInUse is called when the texture stops being used"), Texture->NumNoLongerInUseCalls, 1);
+	TestFalse(TEXT("A texture TouchEngine has not released cannot be acquired"), Pool.AcquireAvailable(10, AcceptAll).IsSet());
+
+	Pool.Maintenance(4, Policy);
+	TestEqual(TEXT("OnNoLongerInUse is only called once"), Texture->NumNoLongerInUseCalls, 1);
+
+	Texture->bIsReleasedByTouchEngine = true;
+	Pool.Maintenance(4, Policy);
+	TestEqual(TEXT("A released texture is available"), Pool.Num(EExportTextureState::Available), 1);
+	TestFalse(TEXT("Textures are not acquired for another key"), Pool.AcquireAvailable(11, AcceptAll).IsSet());
+	TestFalse(TEXT("Textures refused by the predicate are not acquired"), Pool.AcquireAvailable(10, [](const Tests::FFakeExportTextureRef&) { return false; }).IsSet());
+
+	const TOptional<Tests::FFakeExportTextureRef> Acquired = Pool.AcquireAvailable(10, AcceptAll);
+	TestTrue(TEXT("An available texture is reused"), Acquired.IsSet() && Acquired.GetValue() == Texture);
+	TestEqual(TEXT("A reused texture is in use"), Pool.Num(EExportTextureState::InUse), 1);
+	TestEqual(TEXT("A reused texture is not available anymore"), Pool.Num(EExportTextureState::Available), 0);
+	TestFalse(TEXT("A reused texture cannot be acquired twice"), Pool.AcquireAvailable(10, AcceptAll).IsSet());
+
+	// The texture is still flagged as unused, so the next maintenance makes it go through the states again
+	Texture->bIsReleasedByTouchEngine = false;
+	Pool.Maintenance(4, Policy);
+	TestEqual(TEXT("A reused texture waits for TouchEngine again"), Pool.Num(EExportTextureState::WaitingForTouchEngine), 1);
+	TestEqual(TEXT("OnNoLongerInUse is called again after a reuse"), Texture->NumNoLongerInUseCalls, 2);
+	TestEqual(TEXT("Textures are never duplicated"), Pool.Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchExportTexturePoolEvictionTest, "TouchEngine.Util.ExportTexturePool.Eviction", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchExportTexturePoolEvictionTest::RunTest(const FString& Parameters)
+{
+	TTouchExportTexturePool<int32, Tests::FFakeExportTextureRef> Pool;
+	Tests::FFakeExportPolicy Policy;
+	TArray<Tests::FFakeExportTextureRef> Textures;
+	for (int32 Id = 0; Id < 6; ++Id)
+	{
+		Textures.Add(Tests::MakeFakeExportTexture(Id, Id % 2));
+		Pool.AddInUse(Textures.Last());
+	}
+
+	// Textures become available in the order they are released, which is the order they are evicted in
+	const int32 ReleaseOrder[] = { 3, 0, 4, 1 };
+	for (const int32 Id : ReleaseOrder)
+	{
+		Tests::ReleaseFakeExportTexture(Textures[Id]);
+		const TArray<Tests::FFakeExportTextureRef> Evicted = Pool.Maintenance(10, Policy);
+		TestTrue(TEXT("Nothing is evicted while the pool is not full"), Evicted.IsEmpty());
+	}
+	TestEqual(TEXT("Available textures"), Pool.Num(EExportTextureState::Available), 4);
+
+	const TArray<Tests::FFakeExportTextureRef> Evicted = Pool.Maintenance(1, Policy);
+	TArray<int32> EvictedIds;
+	for (const Tests::FFakeExportTextureRef& Texture : Evicted)
+	{
+		EvictedIds.Add(Texture->Id);
+	}
+	TestTrue(TEXT("The oldest available textures are evicted first"), EvictedIds == TArray<int32>{ 3, 0, 4 });
+	TestEqual(TEXT("Available textures after eviction"), Pool.Num(EExportTextureState::Available), 1);
+	TestEqual(TEXT("Textures in use are never evicted"), Pool.Num(EExportTextureState::InUse), 2);
+	TestEqual(TEXT("Evicted textures are not owned by the pool anymore"), Pool.Num(), 3);
+
+	const TOptional<Tests::FFakeExportTextureRef> Acquired = Pool.AcquireAvailable(1, [](const Tests::FFakeExportTextureRef&) { return true; });
+	TestTrue(TEXT("The texture which was not evicted is reused"), Acquired.IsSet() && Acquired.GetValue()->Id == 1);
+	TestFalse(TEXT("Evicted textures are not reused"), Pool.AcquireAvailable(0, [](const Tests::FFakeExportTextureRef&) { return true; }).IsSet());
+
+	const TArray<Tests::FFakeExportTextureRef> Emptied = Pool.Empty();
+	TestEqual(TEXT("Empty returns every remaining texture"), Emptied.Num(), 3);
+	TestEqual(TEXT("The pool is empty"), Pool.Num(), 0);
+	TestEqual(TEXT("No texture is in use after Empty"), Pool.Num(EExportTextureState::InUse), 0);
+	return true;
+}
+
+#endif
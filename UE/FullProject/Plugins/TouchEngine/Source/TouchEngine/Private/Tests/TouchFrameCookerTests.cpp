@@ -0,0 +1,201 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "Tests/TouchStubHarness.h"
+#include "TouchEngineDynamicVariableStruct.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchFrameCookerPendingQueueStressTest, "TouchEngine.FrameCooker.PendingQueueStress", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchFrameCookerPendingQueueStressTest::RunTest(const FString& Parameters)
+{
+	Stub::FStubTox Tox = Tests::MakeEchoTox();
+	Tox.CookDurationSeconds = 0.0002; // Long enough for the requests to pile up in the queue
+	Tests::FTouchStubHarness Harness(TEXT("PendingQueueStress"), MoveTemp(Tox));
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	const FTouchEngineDynamicVariableStruct* InputTemplate = Harness.VariablesIn.FindByPredicate([](const FTouchEngineDynamicVariableStruct& Variable) { return Variable.VarIdentifier == TEXT("in/value"); });
+	if (!TestNotNull(TEXT("in/value variable"), InputTemplate))
+	{
+		return false;
+	}
+
+	constexpr int32 NumRequests = 5000;
+	constexpr int32 InputBufferLimit = 8;
+	Tests::FCookTracker Tracker;
+	TArray<double> EnqueueDurations;
+	EnqueueDurations.Reserve(NumRequests);
+
+	const double StressStartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumRequests; ++Index)
+	{
+		FTouchEngineDynamicVariableStruct Input = *InputTemplate;
+		Input.SetValue(static_cast<double>(Index));
+		TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend;
+		VariablesToSend.Add(Input.VarIdentifier, MoveTemp(Input));
+
+		const double RequestTime = FPlatformTime::Seconds();
+		TFuture<FCookFrameResult> Future = Harness.Cook(MoveTemp(VariablesToSend), InputBufferLimit);
+		EnqueueDurations.Add(FPlatformTime::Seconds() - RequestTime);
+		Tracker.Add(MoveTemp(Future), RequestTime);
+		Tracker.Pump(*Harness.FrameCooker);
+	}
+	const double EnqueueEndTime = FPlatformTime::Seconds();
+	if (!TestTrue(TEXT("Every cook got a result"), Tests::WaitUntil([&Tracker, &Harness]() { return Tracker.Pump(*Harness.FrameCooker); }, 30.0)))
+	{
+		return false;
+	}
+	const double StressEndTime = FPlatformTime::Seconds();
+
+	int32 NumCooked = 0;
+	int32 NumDiscarded = 0;
+	int64 LastCookedFrameID = -1;
+	bool bCookedInOrder = true;
+	TArray<double> CookLatencies;
+	for (const TSharedRef<Tests::FCookTracker::FTrackedCook>& Cook : Tracker.Cooks)
+	{
+		const FCookFrameResult& CookFrameResult = Cook->Future.Get();
+		if (CookFrameResult.Result == ECookFrameResult::Success)
+		{
+			++NumCooked;
+			bCookedInOrder &= CookFrameResult.FrameData.FrameID > LastCookedFrameID;
+			LastCookedFrameID = CookFrameResult.FrameData.FrameID;
+			CookLatencies.Add(Cook->ResultTime - Cook->RequestTime);
+		}
+		else if (CookFrameResult.Result == ECookFrameResult::InputsDiscarded)
+		{
+			++NumDiscarded;
+		}
+	}
+
+	TestEqual(TEXT("Every cook was either cooked or discarded"), NumCooked + NumDiscarded, NumRequests);
+	TestTrue(TEXT("Cooks were started in the order they were requested"), bCookedInOrder);
+	TestEqual(TEXT("The last request was cooked"), LastCookedFrameID, Tracker.Cooks.Last()->Future.Get().FrameData.FrameID);
+	TestEqual(TEXT("Output of the last request"), Harness.VariableManager->GetDoubleOutput(TEXT("out/value")), static_cast<double>(NumRequests - 1));
+
+	AddInfo(FString::Printf(TEXT("%d requests with an InputBufferLimit of %d: %d cooked, %d discarded. Enqueued at %.0f requests/s, drained in %.3f s"),
+		NumRequests, InputBufferLimit, NumCooked, NumDiscarded, NumRequests / (EnqueueEndTime - StressStartTime), StressEndTime - StressStartTime));
+	Tests::AddDurationInfo(*this, TEXT("Enqueue"), MoveTemp(EnqueueDurations));
+	Tests::AddDurationInfo(*this, TEXT("Request to result"), MoveTemp(CookLatencies));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchFrameCookerMaxCooksInFlightTest, "TouchEngine.FrameCooker.MaxCooksInFlight", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchFrameCookerMaxCooksInFlightTest::RunTest(const FString& Parameters)
+{
+	for (const int32 MaxCooksInFlight : {1, 2})
+	{
+		Tests::FTouchStubHarness Harness(FString::Printf(TEXT("MaxCooksInFlight%d"), MaxCooksInFlight), Tests::MakeEchoTox());
+		if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+		{
+			return false;
+		}
+
+		const TFuture<FCookFrameResult> FirstCook = Harness.Cook({}, 2, MaxCooksInFlight);
+		const TFuture<FCookFrameResult> SecondCook = Harness.Cook({}, 2, MaxCooksInFlight);
+		if (!TestTrue(TEXT("The first cook finished"), Tests::WaitFor(FirstCook)))
+		{
+			return false;
+		}
+
+		// The first result is not released yet, so the second cook can only start if more than one cook is allowed in flight
+		const bool bSecondCookStarted = Tests::WaitUntil([&Harness, &SecondCook]() { return Harness.FrameCooker->IsCookingFrame() || SecondCook.IsReady(); }, 0.1);
+		TestTrue(FString::Printf(TEXT("The second cook only starts before the first is released with more than 1 cook in flight (MaxCooksInFlight %d)"), MaxCooksInFlight), bSecondCookStarted == (MaxCooksInFlight > 1));
+
+		// Releasing the first result must start the queued cook by itself, without another cook request
+		FirstCook.Get().OnReadyToStartNextCook->SetValue();
+		if (TestTrue(TEXT("The second cook finished"), Tests::WaitFor(SecondCook)))
+		{
+			TestTrue(TEXT("The second cook succeeded"), SecondCook.Get().Result == ECookFrameResult::Success);
+			SecondCook.Get().OnReadyToStartNextCook->SetValue();
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchFrameCookerRestartOnReleaseTest, "TouchEngine.FrameCooker.RestartOnRelease", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchFrameCookerRestartOnReleaseTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("RestartOnRelease"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	// With 2 cooks in flight, the third cook waits in the queue until one of the first two results is released
+	constexpr int32 MaxCooksInFlight = 2;
+	const TFuture<FCookFrameResult> FirstCook = Harness.Cook({}, 3, MaxCooksInFlight);
+	const TFuture<FCookFrameResult> SecondCook = Harness.Cook({}, 3, MaxCooksInFlight);
+	const TFuture<FCookFrameResult> ThirdCook = Harness.Cook({}, 3, MaxCooksInFlight);
+	if (!TestTrue(TEXT("The first two cooks finished"), Tests::WaitUntil([&FirstCook, &SecondCook]() { return FirstCook.IsReady() && SecondCook.IsReady(); })))
+	{
+		return false;
+	}
+	TestFalse(TEXT("The third cook does not start while 2 results are not released"), Tests::WaitUntil([&Harness, &ThirdCook]() { return Harness.FrameCooker->IsCookingFrame() || ThirdCook.IsReady(); }, 0.1));
+
+	// Only the game thread is pumped from here, nothing else asks the frame cooker to execute the pending cook
+	FirstCook.Get().OnReadyToStartNextCook->SetValue();
+	if (TestTrue(TEXT("The third cook finished after the first result was released"), Tests::WaitFor(ThirdCook)))
+	{
+		TestTrue(TEXT("The third cook succeeded"), ThirdCook.Get().Result == ECookFrameResult::Success);
+		ThirdCook.Get().OnReadyToStartNextCook->SetValue();
+	}
+	SecondCook.Get().OnReadyToStartNextCook->SetValue();
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchFrameCookerSynchronizedTimeoutTest, "TouchEngine.FrameCooker.SynchronizedTimeout", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchFrameCookerSynchronizedTimeoutTest::RunTest(const FString& Parameters)
+{
+	Stub::FStubTox Tox = Tests::MakeEchoTox();
+	Tox.CookDurationSeconds = 30.0; // Never done before its timeout
+	Tests::FTouchStubHarness Harness(TEXT("SynchronizedTimeout"), MoveTemp(Tox));
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+
+	double FakeNow = 1000.0;
+	Harness.FrameCooker->SetClock([&FakeNow]() { return FakeNow; });
+	constexpr double CookTimeout = 0.01;
+	const TFuture<FCookFrameResult> Cook = Harness.Cook({}, 1, 1, CookTimeout);
+
+	// Like the component in Synchronized mode, the GameThread is blocked and no GameThread task is processed from here
+	TestFalse(TEXT("The wait is over before the cook is done"), Harness.FrameCooker->WaitForCook_GameThread(Cook, CookTimeout));
+	TestTrue(TEXT("The cook is not cancelled while the clock has not reached its timeout"), Harness.FrameCooker->IsCookingFrame() && !Cook.IsReady());
+
+	FakeNow += CookTimeout;
+	TestFalse(TEXT("The wait reports the timeout"), Harness.FrameCooker->WaitForCook_GameThread(Cook, CookTimeout));
+	if (TestTrue(TEXT("The cook is cancelled before the wait returns"), Cook.IsReady()))
+	{
+		TestTrue(TEXT("The cook timed out"), Cook.Get().Result == ECookFrameResult::TouchEngineCookTimeout);
+		TestFalse(TEXT("No cook is in progress anymore"), Harness.FrameCooker->IsCookingFrame());
+		if (Cook.Get().OnReadyToStartNextCook)
+		{
+			Cook.Get().OnReadyToStartNextCook->SetValue();
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,85 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Util/TouchRingBuffer.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchRingBufferOrderTest, "TouchEngine.Util.RingBuffer.Order", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchRingBufferOrderTest::RunTest(const FString& Parameters)
+{
+	TTouchRingBuffer<int32> RingBuffer;
+	RingBuffer.EnsureCapacity(3);
+	TestEqual(TEXT("Capacity"), RingBuffer.GetCapacity(), 3);
+
+	// Wrap around the end of the storage a few times
+	int32 NextPushed = 0;
+	int32 NextPopped = 0;
+	bool bPoppedInOrder = true;
+	for (int32 Round = 0; Round < 10; ++Round)
+	{
+		while (!RingBuffer.IsFull())
+		{
+			RingBuffer.Push(int32(NextPushed++));
+		}
+		bPoppedInOrder &= RingBuffer.Peek() == NextPopped;
+		bPoppedInOrder &= RingBuffer.Pop() == NextPopped++;
+		bPoppedInOrder &= RingBuffer.Pop() == NextPopped++;
+	}
+	TestTrue(TEXT("Elements are popped in the order they were pushed"), bPoppedInOrder);
+	TestEqual(TEXT("Num"), RingBuffer.Num(), 1);
+
+	// Growing keeps the order of the elements, even when they wrapped around
+	RingBuffer.Push(int32(NextPushed++));
+	RingBuffer.Push(int32(NextPushed++));
+	RingBuffer.EnsureCapacity(5);
+	TestEqual(TEXT("Capacity after growing"), RingBuffer.GetCapacity(), 5);
+	RingBuffer.EnsureCapacity(2);
+	TestEqual(TEXT("Capacity is never decreased"), RingBuffer.GetCapacity(), 5);
+	RingBuffer.Push(int32(NextPushed++));
+	while (!RingBuffer.IsEmpty())
+	{
+		bPoppedInOrder &= RingBuffer.Pop() == NextPopped++;
+	}
+	TestTrue(TEXT("Elements are popped in order after growing"), bPoppedInOrder);
+	TestEqual(TEXT("Every pushed element was popped"), NextPopped, NextPushed);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchRingBufferEmptyTest, "TouchEngine.Util.RingBuffer.Empty", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchRingBufferEmptyTest::RunTest(const FString& Parameters)
+{
+	TTouchRingBuffer<TSharedPtr<int32>> RingBuffer;
+	RingBuffer.EnsureCapacity(4);
+	const TSharedPtr<int32> Element = MakeShared<int32>(42);
+	RingBuffer.Push(CopyTemp(Element));
+	RingBuffer.Push(CopyTemp(Element));
+	TestEqual(TEXT("References held by the buffer"), Element.GetSharedReferenceCount(), 3);
+
+	RingBuffer.Pop();
+	TestEqual(TEXT("Popping releases the slot"), Element.GetSharedReferenceCount(), 2);
+	RingBuffer.Empty();
+	TestTrue(TEXT("Is empty"), RingBuffer.IsEmpty());
+	TestEqual(TEXT("Emptying releases the slots"), Element.GetSharedReferenceCount(), 1);
+	TestEqual(TEXT("Emptying keeps the capacity"), RingBuffer.GetCapacity(), 4);
+	return true;
+}
+
+#endif
@@ -0,0 +1,115 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Util/TouchRollingHistogram.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchRollingHistogramBucketsTest, "TouchEngine.Util.RollingHistogram.Buckets", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchRollingHistogramBucketsTest::RunTest(const FString& Parameters)
+{
+	using FHistogram = FTouchRollingHistogram;
+
+	bool bSmallValuesAreExact = true;
+	for (int64 Value = 0; Value < FHistogram::SubBucketCount; ++Value)
+	{
+		bSmallValuesAreExact &= FHistogram::GetBucketIndex(Value) == Value && FHistogram::GetBucketHighestValue(static_cast<int32>(Value)) == Value;
+	}
+	TestTrue(TEXT("Every value below SubBucketCount has its own bucket"), bSmallValuesAreExact);
+
+	// The buckets must cover every value once: the value after the highest one of a bucket is the first one of the next bucket
+	bool bBucketsAreContiguous = true;
+	for (int32 BucketIndex = 1; BucketIndex < FHistogram::NumBuckets; ++BucketIndex)
+	{
+		const int64 LowestValue = FHistogram::GetBucketHighestValue(BucketIndex - 1) + 1;
+		bBucketsAreContiguous &= FHistogram::GetBucketIndex(LowestValue) == BucketIndex && FHistogram::GetBucketIndex(FHistogram::GetBucketHighestValue(BucketIndex)) == BucketIndex;
+	}
+	TestTrue(TEXT("The buckets are contiguous"), bBucketsAreContiguous);
+	TestTrue(TEXT("The last bucket ends at MaxValue"), FHistogram::GetBucketHighestValue(FHistogram::NumBuckets - 1) == FHistogram::MaxValue);
+
+	TestEqual(TEXT("Negative values are clamped to the first bucket"), FHistogram::GetBucketIndex(-5), 0);
+	TestEqual(TEXT("Values above MaxValue are clamped to the last bucket"), FHistogram::GetBucketIndex(FHistogram::MaxValue + 1000), FHistogram::NumBuckets - 1);
+
+	FRandomStream Random(42);
+	bool bWithinPrecision = true;
+	for (int32 Iteration = 0; Iteration < 10000; ++Iteration)
+	{
+		// Spread the values over every power of two
+		const int64 Value = static_cast<int64>(Random.FRand() * static_cast<double>(static_cast<int64>(1) << Random.RandRange(0, FHistogram::MaxValueBits - 1)));
+		const int64 Reported = FHistogram::GetBucketHighestValue(FHistogram::GetBucketIndex(Value));
+		bWithinPrecision &= Reported >= Value && Reported - Value <= Value / FHistogram::SubBucketHalfCount;
+	}
+	TestTrue(TEXT("The reported values are within 1 / SubBucketHalfCount above the recorded ones"), bWithinPrecision);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchRollingHistogramPercentilesTest, "TouchEngine.Util.RollingHistogram.Percentiles", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchRollingHistogramPercentilesTest::RunTest(const FString& Parameters)
+{
+	FTouchRollingHistogram Histogram(10);
+	TestTrue(TEXT("A new histogram is empty"), Histogram.IsEmpty());
+	TestTrue(TEXT("An empty histogram reports 0"), Histogram.GetPercentile(50.0) == 0);
+
+	for (int64 Value = 0; Value < 10; ++Value)
+	{
+		Histogram.Record(Value);
+	}
+	TestEqual(TEXT("Num"), Histogram.Num(), 10);
+	TestTrue(TEXT("p10"), Histogram.GetPercentile(10.0) == 0);
+	TestTrue(TEXT("p50"), Histogram.GetPercentile(50.0) == 4);
+	TestTrue(TEXT("p90"), Histogram.GetPercentile(90.0) == 8);
+	TestTrue(TEXT("Max"), Histogram.GetMax() == 9);
+	TestEqual(TEXT("Mean"), Histogram.GetMean(), 4.5);
+
+	// The window only keeps the last 10 values, so the first ones are discarded one by one, wrapping around the window a few times
+	for (int64 Value = 20; Value < 50; ++Value)
+	{
+		Histogram.Record(Value);
+	}
+	TestEqual(TEXT("The window does not grow"), Histogram.Num(), 10);
+	TestTrue(TEXT("Discarded values are not reported anymore"), Histogram.GetPercentile(0.0) == 40);
+	TestTrue(TEXT("p50 over the window"), Histogram.GetPercentile(50.0) == 44);
+	TestTrue(TEXT("Max over the window"), Histogram.GetMax() == 49);
+	TestEqual(TEXT("Mean over the window"), Histogram.GetMean(), 44.5);
+
+	// A single large value is reported within the histogram precision
+	Histogram.Record(1000000);
+	const int64 Max = Histogram.GetMax();
+	TestTrue(TEXT("Large values are reported within the precision"), Max >= 1000000 && Max - 1000000 <= 1000000 / FTouchRollingHistogram::SubBucketHalfCount);
+	TestTrue(TEXT("p50 is not moved by an outlier"), Histogram.GetPercentile(50.0) == 45);
+
+	Histogram.SetWindowSize(3);
+	TestTrue(TEXT("Changing the window size discards the values"), Histogram.IsEmpty());
+	TestEqual(TEXT("Window size"), Histogram.GetWindowSize(), 3);
+	Histogram.Record(7);
+	Histogram.Record(5);
+	Histogram.Record(6);
+	Histogram.Record(1);
+	TestTrue(TEXT("Max after resizing"), Histogram.GetMax() == 6);
+	TestTrue(TEXT("p0 after resizing"), Histogram.GetPercentile(0.0) == 1);
+
+	Histogram.Reset();
+	TestTrue(TEXT("Reset empties the window"), Histogram.IsEmpty() && Histogram.GetMax() == 0);
+	TestEqual(TEXT("Reset keeps the window size"), Histogram.GetWindowSize(), 3);
+	return true;
+}
+
+#endif
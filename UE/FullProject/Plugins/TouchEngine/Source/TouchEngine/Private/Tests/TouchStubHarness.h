@@ -0,0 +1,393 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "TouchEngineDynamicVariableStruct.h"
+#include "TouchEngineParserUtils.h"
+#include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchErrorLog.h"
+#include "Engine/Util/TouchFrameCooker.h"
+#include "Engine/Util/TouchVariableManager.h"
+#include "Rendering/TouchResourceProvider.h"
+#include "Stub/TouchEngineStub.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include <atomic>
+#include <string>
+
+namespace UE::TouchEngine::Tests
+{
+	/** Processes the GameThread tasks until Predicate returns true. Returns false if it did not within the timeout */
+	template<typename PredicateType>
+	bool WaitUntil(PredicateType&& Predicate, double TimeoutSeconds = 5.0)
+	{
+		const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (!Predicate())
+		{
+			if (FPlatformTime::Seconds() > EndTime)
+			{
+				return false;
+			}
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::SleepNoStats(0.0f);
+		}
+		return true;
+	}
+
+	template<typename ResultType>
+	bool WaitFor(const TFuture<ResultType>& Future, double TimeoutSeconds = 5.0)
+	{
+		return WaitUntil([&Future]() { return Future.IsReady(); }, TimeoutSeconds);
+	}
+
+	/** Adds the median, 99th percentile and maximum of the given durations to the test output */
+	inline void AddDurationInfo(FAutomationTestBase& Test, const FString& Label, TArray<double> DurationsInSeconds)
+	{
+		if (DurationsInSeconds.IsEmpty())
+		{
+			return;
+		}
+		DurationsInSeconds.Sort();
+		const auto Percentile = [&DurationsInSeconds](double Ratio) { return DurationsInSeconds[FMath::Min(FMath::FloorToInt32(Ratio * DurationsInSeconds.Num()), DurationsInSeconds.Num() - 1)] * 1e6; };
+		Test.AddInfo(FString::Printf(TEXT("%s: %d runs, p50 %.2f us, p99 %.2f us, max %.2f us"), *Label, DurationsInSeconds.Num(), Percentile(0.5), Percentile(0.99), DurationsInSeconds.Last() * 1e6));
+	}
+
+	/** The value of the given sample in the buffers made by MakeFloatBuffer */
+	inline float GetFloatBufferSample(int32 ChannelIndex, int32 SampleIndex, float Offset = 0.f)
+	{
+		return Offset + ChannelIndex * 1000.f + SampleIndex;
+	}
+
+	/** Creates a float buffer the way TouchEngine outputs a CHOP, with channels named chan1, chan2... unless bNamed is false, and samples set by GetFloatBufferSample */
+	inline TouchObject<TEFloatBuffer> MakeFloatBuffer(int32 NumChannels, int32 NumSamples, bool bNamed = true, float Offset = 0.f)
+	{
+		TArray<std::string> Names;
+		TArray<const char*> NamePointers;
+		TArray<TArray<float>> Channels;
+		TArray<const float*> ChannelPointers;
+		Names.Reserve(NumChannels);
+		Channels.SetNum(NumChannels);
+		for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+		{
+			Names.Emplace(TCHAR_TO_UTF8(*FString::Printf(TEXT("chan%d"), ChannelIndex + 1)));
+			Channels[ChannelIndex].SetNumUninitialized(NumSamples);
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+			{
+				Channels[ChannelIndex][SampleIndex] = GetFloatBufferSample(ChannelIndex, SampleIndex, Offset);
+			}
+		}
+		// The pointers are only taken once every name is added, as adding a name can move the previous ones
+		for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+		{
+			NamePointers.Add(Names[ChannelIndex].c_str());
+			ChannelPointers.Add(Channels[ChannelIndex].GetData());
+		}
+
+		TouchObject<TEFloatBuffer> Buffer;
+		Buffer.take(TEFloatBufferCreate(-1.0, NumChannels, NumSamples, bNamed ? NamePointers.GetData() : nullptr));
+		TEFloatBufferSetValues(Buffer, ChannelPointers.GetData(), NumSamples);
+		return Buffer;
+	}
+
+	/** The value of the given cell in the tables made by MakeTable */
+	inline FString GetTableCell(int32 Row, int32 Column)
+	{
+		return FString::Printf(TEXT("r%dc%d"), Row, Column);
+	}
+
+	/** Creates a table the way TouchEngine outputs a DAT, with cells set by GetTableCell */
+	inline TouchObject<TETable> MakeTable(int32 NumRows, int32 NumColumns)
+	{
+		TouchObject<TETable> Table;
+		Table.take(TETableCreate());
+		TETableResize(Table, NumRows, NumColumns);
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			for (int32 Column = 0; Column < NumColumns; ++Column)
+			{
+				TETableSetStringValue(Table, Row, Column, TCHAR_TO_UTF8(*GetTableCell(Row, Column)));
+			}
+		}
+		return Table;
+	}
+
+	/** A tox with inputs and outputs of the main types. Every frame, out/value is set to in/value, out/chop to in/chop and out/frame to the index of the frame */
+	inline Stub::FStubTox MakeEchoTox()
+	{
+		using namespace Stub;
+		FStubTox Tox;
+		Tox.Links.Add(FStubLink::MakeGroup(TEXT("in"), TEScopeInput));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("in/value"), TEXT("in"), TEScopeInput, TELinkTypeDouble));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("in/toggle"), TEXT("in"), TEScopeInput, TELinkTypeBoolean));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("in/count"), TEXT("in"), TEScopeInput, TELinkTypeInt));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("in/text"), TEXT("in"), TEScopeInput, TELinkTypeString));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("in/chop"), TEXT("in"), TEScopeInput, TELinkTypeFloatBuffer));
+		Tox.Links.Add(FStubLink::MakeGroup(TEXT("out"), TEScopeOutput));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("out/value"), TEXT("out"), TEScopeOutput, TELinkTypeDouble));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("out/frame"), TEXT("out"), TEScopeOutput, TELinkTypeDouble));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("out/chop"), TEXT("out"), TEScopeOutput, TELinkTypeFloatBuffer));
+		Tox.Links.Add(FStubLink::MakeValue(TEXT("out/table"), TEXT("out"), TEScopeOutput, TELinkTypeStringData));
+		Tox.OnCookFrame = [](FStubFrame& Frame)
+		{
+			double Value = 0.0;
+			TEInstanceLinkGetDoubleValue(Frame.Instance, "in/value", TELinkValueCurrent, &Value, 1);
+			Frame.SetOutput(TEXT("out/value"), Value);
+			Frame.SetOutput(TEXT("out/frame"), static_cast<double>(Frame.FrameIndex));
+
+			TouchObject<TEFloatBuffer> Chop;
+			TEInstanceLinkGetFloatBufferValue(Frame.Instance, "in/chop", TELinkValueCurrent, Chop.take());
+			if (Chop)
+			{
+				Frame.SetOutput(TEXT("out/chop"), Chop);
+			}
+		};
+		return Tox;
+	}
+
+	/**
+	 * Loads a stub .tox and creates its FTouchVariableManager and FTouchFrameCooker the way FTouchEngine does, without any UObject or texture.
+	 * The TouchEngine events are forwarded to the frame cooker like FTouchEngine::TouchEventCallback_AnyThread does. Must be used on GameThread.
+	 */
+	class FTouchStubHarness
+	{
+	public:
+		FTouchStubHarness(const FString& ToxName, Stub::FStubTox Tox, TETimeMode InTimeMode = TETimeInternal)
+			: ToxPath(FPaths::Combine(FPaths::AutomationTransientDir(), ToxName + TEXT(".tox")))
+			, TimeMode(InTimeMode)
+		{
+			Stub::RegisterTox(ToxPath, MoveTemp(Tox));
+			TEInstanceCreate(&EventCallback_AnyThread, &LinkCallback_AnyThread, &Callbacks, Instance.take());
+			ResourceProvider = Stub::CreateResourceProvider();
+			ResourceProvider->ConfigureInstance(Instance);
+			TEInstanceConfigure(Instance, TCHAR_TO_UTF8(*ToxPath), TimeMode);
+		}
+
+		~FTouchStubHarness()
+		{
+			if (FrameCooker)
+			{
+				FrameCooker->CancelCurrentAndNextCooks();
+				FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+				FrameCooker->ResetTouchEngineInstance();
+				VariableManager->ResetTouchEngineInstance();
+			}
+			ResourceProvider->ClearSavedInstance();
+			// This is the last reference to the instance, its destruction waits for the callbacks in progress and prevents any further one
+			Instance.reset();
+			Callbacks.FrameCooker.Reset();
+			FrameCooker.Reset();
+			VariableManager.Reset();
+			ResourceProvider.Reset();
+			Stub::UnregisterTox(ToxPath);
+		}
+
+		/** Loads the tox and parses its variables like FTouchEngine::FinishLoadInstance_AnyThread. Returns false if it failed or timed out */
+		bool Load(double TimeoutSeconds = 5.0)
+		{
+			if (TEInstanceLoad(Instance) != TEResultSuccess
+				|| !WaitUntil([this]() { return Callbacks.bLoadFinished.load(); }, TimeoutSeconds)
+				|| Callbacks.LoadResult.load() != TEResultSuccess)
+			{
+				return false;
+			}
+
+			for (const TEScope Scope : { TEScopeInput, TEScopeOutput })
+			{
+				TArray<FTouchEngineDynamicVariableStruct>& Variables = Scope == TEScopeInput ? VariablesIn : VariablesOut;
+				TouchObject<TEStringArray> Groups;
+				if (TEInstanceGetLinkGroups(Instance, Scope, Groups.take()) != TEResultSuccess)
+				{
+					return false;
+				}
+				for (int32 Index = 0; Index < Groups->count; ++Index)
+				{
+					if (FTouchEngineParserUtils::Parse(Instance, Groups->strings[Index], Variables) != TEResultSuccess)
+					{
+						return false;
+					}
+				}
+			}
+
+			VariableManager = MakeShared<FTouchVariableManager>(Instance, ResourceProvider, ErrorLog);
+			VariableManager->CacheLinkInfos(VariablesIn);
+			VariableManager->CacheLinkInfos(VariablesOut);
+			FrameCooker = MakeShared<FTouchFrameCooker>(Instance, *VariableManager, *ResourceProvider);
+			FrameCooker->SetTimeMode(TimeMode);
+			Callbacks.FrameCooker = FrameCooker;
+			return true;
+		}
+
+		/** Requests a cook of the next frame, like UTouchEngineComponentBase does every tick */
+		TFuture<FCookFrameResult> Cook(TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend = {}, int32 InputBufferLimit = 1, int32 MaxCooksInFlight = 1, double CookTimeoutInSeconds = -1.0)
+		{
+			FCookFrameRequest CookFrameRequest;
+			CookFrameRequest.FrameTimeInSeconds = FrameCooker->GetNextFrameID() / 60.0;
+			CookFrameRequest.TimeScale = 60000;
+			CookFrameRequest.FrameData.FrameID = FrameCooker->GetNextFrameID();
+			CookFrameRequest.VariablesToSend = MoveTemp(VariablesToSend);
+			CookFrameRequest.CookTimeoutInSeconds = CookTimeoutInSeconds;
+			return FrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit, MaxCooksInFlight);
+		}
+
+		/** Cooks the next frame, waits for its result and releases it so the next cook can start. The result is Count if it timed out */
+		FCookFrameResult CookAndRelease(TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend = {})
+		{
+			const TFuture<FCookFrameResult> Future = Cook(MoveTemp(VariablesToSend));
+			if (!WaitFor(Future))
+			{
+				return FCookFrameResult();
+			}
+			FCookFrameResult CookFrameResult = Future.Get();
+			if (CookFrameResult.OnReadyToStartNextCook)
+			{
+				CookFrameResult.OnReadyToStartNextCook->SetValue();
+			}
+			return CookFrameResult;
+		}
+
+		int32 GetNumLinkValueChanges() const { return Callbacks.NumLinkValueChanges.load(); }
+
+		/** Declared first, so the stub is enabled before the instance is created and until everything else is destroyed */
+		Stub::FScopedEnable StubEnabled;
+		const FString ToxPath;
+		const TETimeMode TimeMode;
+		TouchObject<TEInstance> Instance;
+		TSharedPtr<FTouchResourceProvider> ResourceProvider;
+		TSharedPtr<FTouchErrorLog> ErrorLog = MakeShared<FTouchErrorLog>(nullptr);
+		TSharedPtr<FTouchVariableManager> VariableManager;
+		TSharedPtr<FTouchFrameCooker> FrameCooker;
+		TArray<FTouchEngineDynamicVariableStruct> VariablesIn;
+		TArray<FTouchEngineDynamicVariableStruct> VariablesOut;
+
+	private:
+		/** The info passed to the TouchEngine callbacks */
+		struct FCallbacks
+		{
+			/** Only set on GameThread while no frame is cooking */
+			TWeakPtr<FTouchFrameCooker> FrameCooker;
+			std::atomic<bool> bLoadFinished { false };
+			std::atomic<TEResult> LoadResult { TEResultSuccess };
+			std::atomic<int32> NumLinkValueChanges { 0 };
+			TOptional<int64> LastFrameStartTimeValue;
+		};
+		FCallbacks Callbacks;
+
+		static void EventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale, void* Info)
+		{
+			FCallbacks& Callbacks = *static_cast<FCallbacks*>(Info);
+			switch (Event)
+			{
+			case TEEventInstanceDidLoad:
+				Callbacks.LastFrameStartTimeValue.Reset();
+				Callbacks.LoadResult = Result;
+				Callbacks.bLoadFinished = true;
+				break;
+			case TEEventFrameDidFinish:
+				{
+					const bool bFrameDropped = Callbacks.LastFrameStartTimeValue.IsSet() && Callbacks.LastFrameStartTimeValue.GetValue() == StartTimeValue;
+					if (const TSharedPtr<FTouchFrameCooker> FrameCooker = Callbacks.FrameCooker.Pin())
+					{
+						FrameCooker->OnFrameFinishedCooking_AnyThread(Result, bFrameDropped, static_cast<double>(StartTimeValue) / StartTimeScale, static_cast<double>(EndTimeValue) / EndTimeScale);
+					}
+					Callbacks.LastFrameStartTimeValue = StartTimeValue;
+					break;
+				}
+			default:
+				break;
+			}
+		}
+
+		static void LinkCallback_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier, void* Info)
+		{
+			if (Event == TELinkEventValueChange)
+			{
+				++static_cast<FCallbacks*>(Info)->NumLinkValueChanges;
+			}
+		}
+	};
+
+	/** Keeps track of cooks requested without waiting for them, releasing their results as soon as they are ready so the next pending cook can start */
+	struct FCookTracker
+	{
+		struct FTrackedCook
+		{
+			TFuture<FCookFrameResult> Future;
+			double RequestTime = 0.0;
+			double ResultTime = 0.0;
+			bool bReleased = false;
+		};
+
+		TArray<TSharedRef<FTrackedCook>> Cooks;
+		int32 FirstUnreleasedCook = 0;
+
+		void Add(TFuture<FCookFrameResult>&& Future, double RequestTime)
+		{
+			TSharedRef<FTrackedCook> Cook = MakeShared<FTrackedCook>();
+			Cook->RequestTime = RequestTime;
+			// The continuation runs on the thread setting the result, so ResultTime is written before the returned future is ready
+			Cook->Future = Future.Next([WeakCook = TWeakPtr<FTrackedCook>(Cook)](FCookFrameResult CookFrameResult)
+			{
+				if (const TSharedPtr<FTrackedCook> TrackedCook = WeakCook.Pin())
+				{
+					TrackedCook->ResultTime = FPlatformTime::Seconds();
+				}
+				return CookFrameResult;
+			});
+			Cooks.Add(MoveTemp(Cook));
+		}
+
+		/**
+		 * Releases the ready cooks and starts the next pending one. Returns true when every cook has been released.
+		 * ProcessingSeconds simulates the time spent by the user on each result before releasing it, like OnEndFrame would.
+		 */
+		bool Pump(FTouchFrameCooker& FrameCooker, double ProcessingSeconds = 0.0)
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			for (int32 Index = FirstUnreleasedCook; Index < Cooks.Num(); ++Index)
+			{
+				FTrackedCook& Cook = *Cooks[Index];
+				if (Cook.bReleased || !Cook.Future.IsReady())
+				{
+					continue;
+				}
+				if (ProcessingSeconds > 0.0)
+				{
+					FPlatformProcess::SleepNoStats(ProcessingSeconds);
+				}
+				if (const TSharedPtr<TPromise<void>>& OnReadyToStartNextCook = Cook.Future.Get().OnReadyToStartNextCook)
+				{
+					OnReadyToStartNextCook->SetValue();
+				}
+				Cook.bReleased = true;
+			}
+			while (FirstUnreleasedCook < Cooks.Num() && Cooks[FirstUnreleasedCook]->bReleased)
+			{
+				++FirstUnreleasedCook;
+			}
+			FrameCooker.ExecuteNextPendingCookFrame_GameThread();
+			return FirstUnreleasedCook == Cooks.Num();
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,220 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DynamicRHI.h"
+#include "RenderingThread.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Rendering/Importing/ITouchImportTexture.h"
+#include "Rendering/Importing/TouchImportedTexture2D.h"
+#include "Rendering/Importing/TouchImportParams.h"
+#include "Rendering/Importing/TouchTextureImporter.h"
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** Only describes the texture TouchEngine would send, the copy itself is recorded by FRecordingTextureImporter */
+	class FFakeImportTexture : public ITouchImportTexture
+	{
+	public:
+		explicit FFakeImportTexture(const FTextureMetaData& InMetadata) : Metadata(InMetadata) {}
+
+		virtual FTextureMetaData GetTextureMetaData() const override { return Metadata; }
+		virtual ECopyTouchToUnrealResult CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer) override { return ECopyTouchToUnrealResult::Success; }
+		virtual bool IsCurrentCopyDone() override { return true; }
+
+	private:
+		FTextureMetaData Metadata;
+	};
+
+	/**
+	 * Imports textures without TouchEngine and records, in order, the copies made on the render thread and the events the tests add.
+	 * Only relies on the RHI abstraction, so it runs with -nullrhi as well.
+	 */
+	class FRecordingTextureImporter : public FTouchTextureImporter
+	{
+	public:
+		FTextureMetaData Metadata { 4, 4, PF_B8G8R8A8, false };
+
+		void AddEvent(const FString& Event)
+		{
+			FScopeLock Lock(&EventsMutex);
+			Events.Add(Event);
+		}
+		TArray<FString> GetEvents()
+		{
+			FScopeLock Lock(&EventsMutex);
+			return Events;
+		}
+		/** Only accessed on the render thread */
+		FTextureRHIRef LastCopyTarget;
+
+	protected:
+		//~ Begin FTouchTextureImporter Interface
+		virtual TSharedPtr<ITouchImportTexture> CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture) override { return MakeShared<FFakeImportTexture>(Metadata); }
+		virtual FTextureMetaData GetTextureMetaData(const TouchObject<TETexture>& Texture) const override { return Metadata; }
+		virtual FTouchTextureTransfer GetTextureTransfer(const FTouchImportParameters& ImportParams) override { return {}; }
+		virtual void CopyNativeToUnreal_RenderThread(const TSharedPtr<ITouchImportTexture>& TETexture, const FTouchCopyTextureArgs& CopyArgs) override
+		{
+			LastCopyTarget = CopyArgs.TargetRHI;
+			AddEvent(TEXT("Copy"));
+		}
+		//~ End FTouchTextureImporter Interface
+
+	private:
+		FCriticalSection EventsMutex;
+		TArray<FString> Events;
+	};
+
+	/**
+	 * Imports a texture for FrameID, and once it resolves, uses it on the render thread the way a material would, recording whether its resource was initialised by then.
+	 * @param PreviousTexture The texture the import replaces, which goes back to the pool
+	 */
+	static TFuture<UTexture2D*> ImportAndUseTexture(const TSharedRef<FRecordingTextureImporter>& Importer, int64 FrameID, UTexture2D* PreviousTexture = nullptr)
+	{
+		FTouchEngineInputFrameData FrameData;
+		FrameData.FrameID = FrameID;
+		const FTouchImportParameters LinkParams { nullptr, TEXT("out/top"), nullptr, FrameData };
+		return Importer->ImportTexture_AnyThread(LinkParams, nullptr)
+			.Next([Importer, PreviousTexture](const FTouchTextureImportResult& Result) -> UTexture2D*
+			{
+				if (Result.PreviousTextureToBePooledPromise)
+				{
+					Result.PreviousTextureToBePooledPromise->SetValue(PreviousTexture);
+				}
+				if (Result.ResultType != EImportResultType::Success)
+				{
+					Importer->AddEvent(TEXT("Failed"));
+					return nullptr;
+				}
+
+				Importer->AddEvent(TEXT("Resolved"));
+				UTexture2D* Texture = Result.ConvertedTextureObject.GetValue();
+				FTextureResource* Resource = Texture->GetResource();
+				ENQUEUE_RENDER_COMMAND(UseImportedTexture)([Importer, Resource](FRHICommandListImmediate& RHICmdList)
+				{
+					Importer->AddEvent(Resource && Resource->IsInitialized() ? TEXT("Used") : TEXT("Used before initialised"));
+				});
+				return Texture;
+			});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchTextureImporterNewTextureTest, "TouchEngine.Rendering.TextureImporter.NewTexture", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchTextureImporterNewTextureTest::RunTest(const FString& Parameters)
+{
+	if (GDynamicRHI->GetInterfaceType() == ERHIInterfaceType::Vulkan)
+	{
+		AddInfo(TEXT("Textures cannot be imported on Vulkan"));
+		return true;
+	}
+
+	const TSharedRef<Tests::FRecordingTextureImporter> Importer = MakeShared<Tests::FRecordingTextureImporter>();
+	TFuture<UTexture2D*> Import = Tests::ImportAndUseTexture(Importer, 1);
+
+	// The GameThread task creating the UTexture2D cannot run while we are on GameThread, so the import is still pending after the copy
+	FlushRenderingCommands();
+	TestFalse(TEXT("The import of a new texture is pending until its UTexture2D is created"), Import.IsReady());
+	TestTrue(TEXT("The copy runs before the UTexture2D exists"), Importer->GetEvents() == TArray<FString>{ TEXT("Copy") });
+
+	// What Synchronized mode does before reading the outputs of the cook
+	Importer->FlushPendingTextureWrappers_GameThread();
+	TestTrue(TEXT("Flushing the pending textures resolves the import right away"), Import.IsReady());
+	UTexture2D* Texture = Import.IsReady() ? Import.Get() : nullptr;
+	if (!TestNotNull(TEXT("Imported texture"), Texture))
+	{
+		return false;
+	}
+	TestTrue(TEXT("The imported texture keeps its RHI when its resource is recreated"), Texture->IsA<UTouchImportedTexture2D>());
+
+	FTextureResource* Resource = Texture->GetResource();
+	bool bAdoptedCopiedRHI = false;
+	ENQUEUE_RENDER_COMMAND(CheckResource)([Importer, Resource, &bAdoptedCopiedRHI](FRHICommandListImmediate& RHICmdList)
+	{
+		bAdoptedCopiedRHI = Resource && Resource->TextureRHI == Importer->LastCopyTarget;
+	});
+	FlushRenderingCommands();
+	TestTrue(TEXT("The texture is copied, then resolved, then only used once initialised"), Importer->GetEvents() == TArray<FString>{ TEXT("Copy"), TEXT("Resolved"), TEXT("Used") });
+	TestTrue(TEXT("The resource adopts the RHI the import was copied into"), bAdoptedCopiedRHI);
+
+	// UpdateResource does not recreate any resource when rendering is disabled, so we recreate it the way it does
+	if (FApp::CanEverRender())
+	{
+		Texture->UpdateResource();
+	}
+	else
+	{
+		Texture->ReleaseResource();
+		Cast<UTouchImportedTexture2D>(Texture)->InitImportedResource_GameThread();
+	}
+	FTextureResource* RecreatedResource = Texture->GetResource();
+	bool bKeptImportedRHI = false;
+	ENQUEUE_RENDER_COMMAND(CheckRecreatedResource)([Importer, RecreatedResource, &bKeptImportedRHI](FRHICommandListImmediate& RHICmdList)
+	{
+		bKeptImportedRHI = RecreatedResource && RecreatedResource->IsInitialized() && RecreatedResource->TextureRHI == Importer->LastCopyTarget;
+	});
+	FlushRenderingCommands();
+	TestTrue(TEXT("A recreated resource adopts the imported RHI instead of an empty one"), bKeptImportedRHI);
+
+	Texture->RemoveFromRoot();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchTextureImporterPooledTextureTest, "TouchEngine.Rendering.TextureImporter.PooledTexture", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchTextureImporterPooledTextureTest::RunTest(const FString& Parameters)
+{
+	if (GDynamicRHI->GetInterfaceType() == ERHIInterfaceType::Vulkan)
+	{
+		AddInfo(TEXT("Textures cannot be imported on Vulkan"));
+		return true;
+	}
+
+	const TSharedRef<Tests::FRecordingTextureImporter> Importer = MakeShared<Tests::FRecordingTextureImporter>();
+	TFuture<UTexture2D*> FirstImport = Tests::ImportAndUseTexture(Importer, 1);
+	Importer->FlushPendingTextureWrappers_GameThread();
+	UTexture2D* FirstTexture = FirstImport.IsReady() ? FirstImport.Get() : nullptr;
+
+	// The second import replaces the first texture, which goes back to the pool
+	TFuture<UTexture2D*> SecondImport = Tests::ImportAndUseTexture(Importer, 2, FirstTexture);
+	Importer->FlushPendingTextureWrappers_GameThread();
+	UTexture2D* SecondTexture = SecondImport.IsReady() ? SecondImport.Get() : nullptr;
+	if (!TestNotNull(TEXT("First texture"), FirstTexture) || !TestNotNull(TEXT("Second texture"), SecondTexture))
+	{
+		return false;
+	}
+	TestTrue(TEXT("The first texture is only pooled once replaced, so the second import needs a new texture"), FirstTexture != SecondTexture);
+
+	// A pooled texture is already initialised, so its import resolves without waiting for the GameThread
+	FlushRenderingCommands();
+	TFuture<UTexture2D*> ThirdImport = Tests::ImportAndUseTexture(Importer, 3, SecondTexture);
+	TestTrue(TEXT("The import of a pooled texture resolves immediately"), ThirdImport.IsReady());
+	TestTrue(TEXT("The oldest pooled texture is reused"), ThirdImport.IsReady() && ThirdImport.Get() == FirstTexture);
+
+	FlushRenderingCommands();
+	const TArray<FString> Events = Importer->GetEvents();
+	TestFalse(TEXT("No texture is used before it is initialised"), Events.Contains(TEXT("Used before initialised")));
+	TestFalse(TEXT("No import failed"), Events.Contains(TEXT("Failed")));
+
+	FirstTexture->RemoveFromRoot();
+	SecondTexture->RemoveFromRoot();
+	return true;
+}
+
+#endif
@@ -0,0 +1,169 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Util/TouchTripleBuffer.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+#include <atomic>
+
+#if WITH_TOUCHENGINE_STUB
+#include "Engine/TouchEngine.h"
+#include "Rendering/TouchResourceProvider.h"
+#include "Stub/TouchEngineStub.h"
+#endif
+
+using namespace UE::TouchEngine;
+
+namespace UE::TouchEngine::Tests
+{
+	/** A value which is torn if its two halves do not match */
+	struct FTripleBufferTestValue
+	{
+		int32 Producer = -1;
+		int64 Sequence = 0;
+		int64 NegatedSequence = 0;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchTripleBufferProducersTest, "TouchEngine.Util.TripleBuffer.MultipleProducers", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchTripleBufferProducersTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumProducers = 4;
+	constexpr int64 NumWritesPerProducer = 20000;
+	TTouchTripleBuffer<Tests::FTripleBufferTestValue> Buffer;
+
+	std::atomic<int32> NumProducersDone = 0;
+	TArray<TFuture<void>> Producers;
+	for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+	{
+		Producers.Add(Async(EAsyncExecution::Thread, [&Buffer, &NumProducersDone, Producer]()
+		{
+			for (int64 Sequence = 1; Sequence <= NumWritesPerProducer; ++Sequence)
+			{
+				Buffer.Write({ Producer, Sequence, -Sequence });
+			}
+			++NumProducersDone;
+		}));
+	}
+
+	// Each producer writes increasing sequences, so a value read after another one of the same producer must not be older
+	int64 LastSequences[NumProducers] = {};
+	int32 NumReads = 0;
+	bool bReadTornValue = false;
+	bool bReadOlderValue = false;
+	const auto ReadValue = [&]()
+	{
+		Tests::FTripleBufferTestValue Value;
+		if (!Buffer.Read(Value))
+		{
+			return;
+		}
+		++NumReads;
+		if (Value.Producer < 0 || Value.Producer >= NumProducers || Value.Sequence != -Value.NegatedSequence)
+		{
+			bReadTornValue = true;
+			return;
+		}
+		bReadOlderValue |= Value.Sequence < LastSequences[Value.Producer];
+		LastSequences[Value.Producer] = Value.Sequence;
+	};
+	while (NumProducersDone < NumProducers)
+	{
+		ReadValue();
+	}
+	for (TFuture<void>& Producer : Producers)
+	{
+		Producer.Wait();
+	}
+	ReadValue();
+
+	AddInfo(FString::Printf(TEXT("%d values read out of %lld written"), NumReads, NumProducers * NumWritesPerProducer));
+	TestFalse(TEXT("No value is torn by concurrent producers"), bReadTornValue);
+	TestFalse(TEXT("The values of a producer are read in order"), bReadOlderValue);
+	bool bReadLastValue = false;
+	for (const int64 LastSequence : LastSequences)
+	{
+		bReadLastValue |= LastSequence == NumWritesPerProducer;
+	}
+	TestTrue(TEXT("The last value written is read"), bReadLastValue);
+
+	Tests::FTripleBufferTestValue Value;
+	TestFalse(TEXT("Nothing is left to read"), Buffer.Read(Value));
+	return true;
+}
+
+#if WITH_TOUCHENGINE_STUB
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchEngineConcurrentStatisticsTest, "TouchEngine.Statistics.ConcurrentReports", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchEngineConcurrentStatisticsTest::RunTest(const FString& Parameters)
+{
+	Stub::FScopedEnable StubEnabled;
+	const TSharedRef<FTouchEngine> Engine = MakeShared<FTouchEngine>();
+	if (!TestTrue(TEXT("Instance created"), Engine->Prewarm_GameThread()) || !TestNotNull(TEXT("Resource provider"), Engine->GetResourceProvider().Get()))
+	{
+		return false;
+	}
+	TEInstance* Instance = Engine->GetResourceProvider()->GetInstance().get();
+
+	// TouchEngine can deliver statistics from any of its threads, so several threads report at the same time while GameThread reads them
+	constexpr int32 NumReporters = 4;
+	constexpr int32 NumReportsPerReporter = 5000;
+	std::atomic<int32> NumReportersDone = 0;
+	TArray<TFuture<void>> Reporters;
+	for (int32 Reporter = 0; Reporter < NumReporters; ++Reporter)
+	{
+		Reporters.Add(Async(EAsyncExecution::Thread, [Instance, &NumReportersDone, Reporter]()
+		{
+			for (int32 Report = 1; Report <= NumReportsPerReporter; ++Report)
+			{
+				// Both memory values are the same in each report, so a snapshot mixing two reports can be told apart
+				const int64 Memory = static_cast<int64>(Reporter) * NumReportsPerReporter + Report;
+				const TEInstanceStatistics Statistics { Memory, Memory, 1000000, -1, 2, 1 };
+				Stub::SendStatistics(Instance, Statistics);
+			}
+			++NumReportersDone;
+		}));
+	}
+
+	bool bReadTornStatistics = false;
+	while (NumReportersDone < NumReporters)
+	{
+		const FTouchEngineStatistics Statistics = Engine->GetStatistics_GameThread();
+		bReadTornStatistics |= Statistics.bIsValid && Statistics.MemoryUsedGPU != Statistics.MemoryUsedCPU;
+	}
+	for (TFuture<void>& Reporter : Reporters)
+	{
+		Reporter.Wait();
+	}
+
+	const FTouchEngineStatistics Statistics = Engine->GetStatistics_GameThread();
+	TestFalse(TEXT("No statistics are torn by concurrent reports"), bReadTornStatistics);
+	TestTrue(TEXT("Statistics were reported"), Statistics.bIsValid);
+	TestTrue(TEXT("The memory of a single report is read"), Statistics.MemoryUsedGPU == Statistics.MemoryUsedCPU);
+	TestTrue(TEXT("Every processed frame is counted"), Statistics.FramesProcessed == 2 * NumReporters * NumReportsPerReporter);
+	TestTrue(TEXT("Every dropped frame is counted"), Statistics.FramesDropped == NumReporters * NumReportsPerReporter);
+	TestEqual(TEXT("The frame time is averaged over the frames of a report"), Statistics.FrameTimeCPU, 0.0005);
+
+	Engine->DestroyTouchEngine_GameThread();
+	return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,298 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "Tests/TouchAllocationCounter.h"
+#include "Tests/TouchStubHarness.h"
+#include "Algo/Compare.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerLinkInfoCacheTest, "TouchEngine.VariableManager.LinkInfoCache", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerLinkInfoCacheTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("LinkInfoCache"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+	Stub::SetLinkValue(Harness.Instance, TEXT("out/value"), 42.0);
+
+	const FTouchLinkHandle Handle = VariableManager.GetLinkHandle(TEXT("out/value"));
+	TestEqual(TEXT("Handles are stable"), VariableManager.GetLinkHandle(TEXT("out/value")).Index, Handle.Index);
+	TestNotEqual(TEXT("Each link has its own handle"), VariableManager.GetLinkHandle(TEXT("out/frame")).Index, Handle.Index);
+
+	// The link infos were cached when the tox loaded, so reading the value only calls TEInstanceLinkGetDoubleValue
+	int32 NumCalls = Stub::GetNumInstanceCalls();
+	TestEqual(TEXT("Output value"), VariableManager.GetDoubleOutput(Handle), 42.0);
+	TestEqual(TEXT("TouchEngine calls with a cached link info"), Stub::GetNumInstanceCalls() - NumCalls, 1);
+
+	VariableManager.InvalidateLinkInfo_AnyThread("out/value");
+	NumCalls = Stub::GetNumInstanceCalls();
+	TestEqual(TEXT("Output value after invalidation"), VariableManager.GetDoubleOutput(Handle), 42.0);
+	TestEqual(TEXT("TouchEngine calls after invalidation"), Stub::GetNumInstanceCalls() - NumCalls, 2);
+
+	NumCalls = Stub::GetNumInstanceCalls();
+	VariableManager.GetDoubleOutput(Handle);
+	TestEqual(TEXT("The link info is cached again after being queried"), Stub::GetNumInstanceCalls() - NumCalls, 1);
+
+	VariableManager.InvalidateAllLinkInfos_AnyThread();
+	NumCalls = Stub::GetNumInstanceCalls();
+	VariableManager.GetDoubleOutput(Handle);
+	TestEqual(TEXT("TouchEngine calls after invalidating all links"), Stub::GetNumInstanceCalls() - NumCalls, 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerConcurrentInvalidationTest, "TouchEngine.VariableManager.ConcurrentInvalidation", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerConcurrentInvalidationTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("ConcurrentInvalidation"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+	Stub::SetLinkValue(Harness.Instance, TEXT("out/value"), 42.0);
+	const FTouchLinkHandle Handle = VariableManager.GetLinkHandle(TEXT("out/value"));
+
+	// TouchEngine invalidates the link infos from its own threads while the GameThread adds links and reads values
+	std::atomic_bool bStop = false;
+	TFuture<int32> Invalidations = Async(EAsyncExecution::Thread, [&VariableManager, &bStop]()
+	{
+		int32 NumInvalidations = 0;
+		while (!bStop)
+		{
+			VariableManager.InvalidateLinkInfo_AnyThread("out/value");
+			VariableManager.InvalidateLinkInfo_AnyThread("added/link");
+			VariableManager.InvalidateAllLinkInfos_AnyThread();
+			++NumInvalidations;
+		}
+		return NumInvalidations;
+	});
+
+	constexpr int32 NumIterations = 10000;
+	int32 NumCorrectValues = 0;
+	FTouchLinkHandle FirstAddedHandle;
+	for (int32 Index = 0; Index < NumIterations; ++Index)
+	{
+		const FTouchLinkHandle AddedHandle = VariableManager.GetLinkHandle(FString::Printf(TEXT("added/%d"), Index));
+		FirstAddedHandle = Index == 0 ? AddedHandle : FirstAddedHandle;
+		NumCorrectValues += VariableManager.GetDoubleOutput(Handle) == 42.0 ? 1 : 0;
+	}
+	bStop = true;
+	const int32 NumInvalidations = Invalidations.Get();
+
+	TestEqual(TEXT("Values read while the link info was invalidated"), NumCorrectValues, NumIterations);
+	TestEqual(TEXT("Handles added while the link infos were invalidated are stable"), VariableManager.GetLinkHandle(TEXT("added/0")).Index, FirstAddedHandle.Index);
+	AddInfo(FString::Printf(TEXT("%d invalidation rounds during %d reads"), NumInvalidations, NumIterations));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerCHOPInputStreamingTest, "TouchEngine.VariableManager.CHOPInputStreaming", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerCHOPInputStreamingTest::RunTest(const FString& Parameters)
+{
+	// Nothing else references the input buffer, so the stub keeps a single copy of it like TouchEngine does
+	Stub::FStubTox Tox;
+	Tox.Links.Add(Stub::FStubLink::MakeGroup(TEXT("in"), TEScopeInput));
+	Tox.Links.Add(Stub::FStubLink::MakeValue(TEXT("in/chop"), TEXT("in"), TEScopeInput, TELinkTypeFloatBuffer));
+	Tests::FTouchStubHarness Harness(TEXT("CHOPInputStreaming"), MoveTemp(Tox));
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+	const FTouchLinkHandle Handle = VariableManager.GetLinkHandle(TEXT("in/chop"));
+
+	constexpr int32 NumChannels = 64;
+	constexpr int32 NumSamples = 512;
+	constexpr int32 NumFrames = 120;
+	FTouchEngineCHOP CHOP;
+	CHOP.Channels.SetNum(NumChannels);
+	for (int32 Index = 0; Index < NumChannels; ++Index)
+	{
+		CHOP.Channels[Index].Name = FString::Printf(TEXT("chan%d"), Index + 1);
+		CHOP.Channels[Index].Values.SetNumZeroed(NumSamples);
+	}
+
+	const uint64 NumCreateCallsBefore = Stub::GetNumFloatBufferCreateCalls();
+	int32 NumAllocationsAfterFirstFrame = 0;
+	TArray<double> SendDurations;
+	SendDurations.Reserve(NumFrames);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (FTouchEngineCHOPChannel& Channel : CHOP.Channels)
+		{
+			Channel.Values[Frame % NumSamples] = static_cast<float>(Frame);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		{
+			Tests::FScopedAllocationCounter AllocationCounter;
+			VariableManager.SetCHOPInput(Handle, CHOP);
+			NumAllocationsAfterFirstFrame += Frame > 0 ? AllocationCounter.GetNumAllocations() : 0;
+		}
+		SendDurations.Add(FPlatformTime::Seconds() - StartTime);
+
+		if (!TestTrue(TEXT("The frame is cooked"), Harness.CookAndRelease().Result == ECookFrameResult::Success))
+		{
+			return false;
+		}
+	}
+	TestTrue(TEXT("TEFloatBufferCreate is only called for the first frame"), Stub::GetNumFloatBufferCreateCalls() - NumCreateCallsBefore == 1);
+	TestEqual(TEXT("Allocations made by the frames after the first one"), NumAllocationsAfterFirstFrame, 0);
+	Tests::AddDurationInfo(*this, FString::Printf(TEXT("SetCHOPInput %dx%d"), NumChannels, NumSamples), SendDurations);
+
+	TouchObject<TEFloatBuffer> Received;
+	TEInstanceLinkGetFloatBufferValue(Harness.Instance, "in/chop", TELinkValueCurrent, Received.take());
+	const FTouchEngineCHOPView ReceivedView(Received);
+	if (TestTrue(TEXT("TouchEngine received the CHOP"), ReceivedView.GetNumChannels() == NumChannels && ReceivedView.GetNumSamples() == NumSamples))
+	{
+		TestTrue(TEXT("TouchEngine received the values of the last frame"), Algo::Compare(ReceivedView.GetChannel(NumChannels - 1), CHOP.Channels.Last().Values));
+		TestEqual(TEXT("TouchEngine received the channel names"), ReceivedView.GetChannelName(NumChannels - 1), CHOP.Channels.Last().Name);
+	}
+
+	// A different layout needs a new buffer
+	CHOP.Channels.Last().Name = TEXT("renamed");
+	VariableManager.SetCHOPInput(Handle, CHOP);
+	TestTrue(TEXT("TEFloatBufferCreate is called again when a channel is renamed"), Stub::GetNumFloatBufferCreateCalls() - NumCreateCallsBefore == 2);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerCHOPViewTest, "TouchEngine.VariableManager.CHOPView", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerCHOPViewTest::RunTest(const FString& Parameters)
+{
+	struct FLayout
+	{
+		int32 NumChannels;
+		int32 NumSamples;
+		bool bNamed;
+	};
+	for (const FLayout& Layout : { FLayout{ 1, 1, true }, FLayout{ 3, 5, true }, FLayout{ 4, 7, false }, FLayout{ 64, 512, true }, FLayout{ 2, 0, true } })
+	{
+		const FString Context = FString::Printf(TEXT("%dx%d%s"), Layout.NumChannels, Layout.NumSamples, Layout.bNamed ? TEXT("") : TEXT(" unnamed"));
+		const FTouchEngineCHOPView View(Tests::MakeFloatBuffer(Layout.NumChannels, Layout.NumSamples, Layout.bNamed));
+		TestEqual(FString::Printf(TEXT("Number of channels (%s)"), *Context), View.GetNumChannels(), Layout.NumChannels);
+		TestEqual(FString::Printf(TEXT("Number of samples (%s)"), *Context), View.GetNumSamples(), Layout.NumSamples);
+
+		// Channel spans and names
+		bool bChannelsMatch = true;
+		bool bNamesMatch = true;
+		for (int32 ChannelIndex = 0; ChannelIndex < Layout.NumChannels; ++ChannelIndex)
+		{
+			const TConstArrayView<float> Channel = View.GetChannel(ChannelIndex);
+			bChannelsMatch &= Channel.Num() == Layout.NumSamples;
+			for (int32 SampleIndex = 0; bChannelsMatch && SampleIndex < Channel.Num(); ++SampleIndex)
+			{
+				bChannelsMatch &= Channel[SampleIndex] == Tests::GetFloatBufferSample(ChannelIndex, SampleIndex);
+			}
+			const FString ExpectedName = Layout.bNamed ? FString::Printf(TEXT("chan%d"), ChannelIndex + 1) : FString();
+			bNamesMatch &= View.GetChannelName(ChannelIndex) == ExpectedName && (View.GetChannelNameAsCStr(ChannelIndex) != nullptr) == Layout.bNamed;
+		}
+		TestTrue(FString::Printf(TEXT("The channels are read from the buffer (%s)"), *Context), bChannelsMatch);
+		TestTrue(FString::Printf(TEXT("The channel names are read from the buffer (%s)"), *Context), bNamesMatch);
+		TestEqual(FString::Printf(TEXT("Number of channel names (%s)"), *Context), View.GetChannelNames().Num(), Layout.NumChannels);
+		TestTrue(FString::Printf(TEXT("A channel out of range is empty (%s)"), *Context), View.GetChannel(-1).IsEmpty() && View.GetChannel(Layout.NumChannels).IsEmpty() && View.GetChannelNameAsCStr(Layout.NumChannels) == nullptr);
+
+		// GetSample bounds
+		const int32 LastChannel = Layout.NumChannels - 1;
+		float Sample = -1.f;
+		TestFalse(FString::Printf(TEXT("No sample before the first channel (%s)"), *Context), View.GetSample(-1, 0, Sample));
+		TestFalse(FString::Printf(TEXT("No sample after the last channel (%s)"), *Context), View.GetSample(Layout.NumChannels, 0, Sample));
+		TestFalse(FString::Printf(TEXT("No sample at a negative index (%s)"), *Context), View.GetSample(LastChannel, -2, Sample));
+		TestFalse(FString::Printf(TEXT("No sample after the last one (%s)"), *Context), View.GetSample(LastChannel, Layout.NumSamples, Sample));
+		if (Layout.NumSamples > 0)
+		{
+			TestTrue(FString::Printf(TEXT("First sample (%s)"), *Context), View.GetSample(LastChannel, 0, Sample) && Sample == Tests::GetFloatBufferSample(LastChannel, 0));
+			TestTrue(FString::Printf(TEXT("INDEX_NONE reads the latest sample (%s)"), *Context), View.GetSample(LastChannel, INDEX_NONE, Sample) && Sample == Tests::GetFloatBufferSample(LastChannel, Layout.NumSamples - 1));
+		}
+		else
+		{
+			TestFalse(FString::Printf(TEXT("No latest sample in an empty channel (%s)"), *Context), View.GetSample(LastChannel, INDEX_NONE, Sample));
+		}
+
+		// ToCHOP, full and ranged
+		const FTouchEngineCHOP Full = View.ToCHOP();
+		bool bFullMatches = Full.Channels.Num() == Layout.NumChannels;
+		for (int32 ChannelIndex = 0; bFullMatches && ChannelIndex < Layout.NumChannels; ++ChannelIndex)
+		{
+			bFullMatches &= Algo::Compare(Full.Channels[ChannelIndex].Values, View.GetChannel(ChannelIndex)) && Full.Channels[ChannelIndex].Name == View.GetChannelName(ChannelIndex);
+		}
+		TestTrue(FString::Printf(TEXT("ToCHOP copies every channel and name (%s)"), *Context), bFullMatches);
+
+		const int32 StartSample = Layout.NumSamples / 2;
+		const FTouchEngineCHOP Range = View.ToCHOP(StartSample, 3);
+		const int32 ExpectedRangeNum = FMath::Min(3, Layout.NumSamples - StartSample);
+		bool bRangeMatches = Range.Channels.Num() == Layout.NumChannels;
+		for (int32 ChannelIndex = 0; bRangeMatches && ChannelIndex < Layout.NumChannels; ++ChannelIndex)
+		{
+			bRangeMatches &= Range.Channels[ChannelIndex].Values.Num() == ExpectedRangeNum;
+			for (int32 Index = 0; bRangeMatches && Index < ExpectedRangeNum; ++Index)
+			{
+				bRangeMatches &= Range.Channels[ChannelIndex].Values[Index] == Tests::GetFloatBufferSample(ChannelIndex, StartSample + Index);
+			}
+		}
+		TestTrue(FString::Printf(TEXT("ToCHOP copies the samples of the range, clamped to the samples available (%s)"), *Context), bRangeMatches);
+		const FTouchEngineCHOP OutOfRange = View.ToCHOP(Layout.NumSamples + 10, 5);
+		TestTrue(FString::Printf(TEXT("ToCHOP of a range after the last sample has empty channels (%s)"), *Context), OutOfRange.Channels.Num() == Layout.NumChannels && OutOfRange.GetNumSamples() == 0);
+	}
+
+	const FTouchEngineCHOPView Empty;
+	float Sample;
+	TestTrue(TEXT("An empty view has no channel"), !Empty.IsValid() && Empty.GetNumChannels() == 0 && Empty.GetNumSamples() == 0 && !Empty.GetSample(0, INDEX_NONE, Sample) && Empty.ToCHOP().Channels.IsEmpty());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchVariableManagerCHOPViewLifetimeTest, "TouchEngine.VariableManager.CHOPViewLifetime", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTouchVariableManagerCHOPViewLifetimeTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("CHOPViewLifetime"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	FTouchVariableManager& VariableManager = *Harness.VariableManager;
+
+	// The view and the link are the only references to the buffer
+	Stub::SetLinkValue(Harness.Instance, TEXT("out/chop"), Tests::MakeFloatBuffer(2, 4));
+	const FTouchEngineCHOPView FirstView = VariableManager.GetCHOPOutputView(TEXT("out/chop"));
+	const float* FirstData = FirstView.GetChannel(1).GetData();
+	if (!TestTrue(TEXT("The first value is read"), FirstView.GetNumChannels() == 2 && FirstView.GetNumSamples() == 4))
+	{
+		return false;
+	}
+
+	// TouchEngine replaces the value of the link, and the variable manager replaces the view it kept for the output
+	constexpr float Offset = 0.5f;
+	Stub::SetLinkValue(Harness.Instance, TEXT("out/chop"), Tests::MakeFloatBuffer(3, 8, true, Offset));
+	const FTouchEngineCHOPView SecondView = VariableManager.GetCHOPOutputView(TEXT("out/chop"));
+	TestTrue(TEXT("The new value is read"), SecondView.GetNumChannels() == 3 && SecondView.GetNumSamples() == 8 && SecondView.GetChannel(0)[0] == Tests::GetFloatBufferSample(0, 0, Offset));
+
+	TestTrue(TEXT("The first view still has its buffer"), FirstView.GetNumChannels() == 2 && FirstView.GetNumSamples() == 4);
+	TestTrue(TEXT("The first view still points to the same samples"), FirstView.GetChannel(1).GetData() == FirstData);
+	float Sample = -1.f;
+	TestTrue(TEXT("The first view still reads the first value"), FirstView.GetSample(1, INDEX_NONE, Sample) && Sample == Tests::GetFloatBufferSample(1, 3));
+	TestEqual(TEXT("The first view still reads the first names"), FirstView.GetChannelName(1), FString(TEXT("chan2")));
+	return true;
+}
+
+#endif
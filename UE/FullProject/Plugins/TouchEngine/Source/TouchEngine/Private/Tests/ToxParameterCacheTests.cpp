@@ -0,0 +1,92 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TOUCHENGINE_STUB
+
+#include "Engine/Util/ToxParameterCache.h"
+#include "Tests/TouchStubHarness.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+
+using namespace UE::TouchEngine;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FToxParameterCacheTest, "TouchEngine.ToxParameterCache.HitAndMiss", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FToxParameterCacheTest::RunTest(const FString& Parameters)
+{
+	Tests::FTouchStubHarness Harness(TEXT("ToxParameterCache"), Tests::MakeEchoTox());
+	if (!TestTrue(TEXT("The tox is loaded"), Harness.Load()))
+	{
+		return false;
+	}
+	const FTouchLoadResult LoadResult = FTouchLoadResult::MakeSuccess(Harness.VariablesIn, Harness.VariablesOut);
+
+	// The stub does not read tox files, so any content works. A new one every run ensures nothing was cached by a previous run
+	const FString ToxPath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ToxParameterCacheContent.tox"));
+	if (!TestTrue(TEXT("The tox file is written"), FFileHelper::SaveStringToFile(FGuid::NewGuid().ToString(), *ToxPath)))
+	{
+		return false;
+	}
+	FToxParameterCacheKey Key = FToxParameterCache::MakeKey(ToxPath);
+	Key.TouchEngineVersion = TEXT("TouchEngine");
+	Key.TouchDesignerPath = TEXT("TouchDesigner");
+	TestTrue(TEXT("The key is valid"), Key.IsValid());
+	TestFalse(TEXT("A tox file never saved is a miss"), FToxParameterCache::Load(Key).IsSet());
+
+	FToxParameterCache::Save(Key, LoadResult);
+	const TOptional<FTouchLoadResult> CachedResult = FToxParameterCache::Load(Key);
+	if (TestTrue(TEXT("A saved tox file is a hit"), CachedResult.IsSet() && CachedResult->IsSuccess()))
+	{
+		const FTouchLoadSuccessResult& Cached = CachedResult->SuccessResult.GetValue();
+		TestEqual(TEXT("Cached inputs"), Cached.Inputs.Num(), Harness.VariablesIn.Num());
+		TestEqual(TEXT("Cached outputs"), Cached.Outputs.Num(), Harness.VariablesOut.Num());
+		for (int32 Index = 0; Index < FMath::Min(Cached.Inputs.Num(), Harness.VariablesIn.Num()); ++Index)
+		{
+			TestEqual(TEXT("Cached input identifier"), Cached.Inputs[Index].VarIdentifier, Harness.VariablesIn[Index].VarIdentifier);
+			TestTrue(TEXT("Cached input type"), Cached.Inputs[Index].VarType == Harness.VariablesIn[Index].VarType);
+		}
+	}
+
+	FToxParameterCacheKey UnknownTouchDesignerKey = Key;
+	UnknownTouchDesignerKey.TouchDesignerPath.Reset();
+	TestTrue(TEXT("Entries are used until the TouchDesigner installation is known"), FToxParameterCache::Load(UnknownTouchDesignerKey).IsSet());
+
+	FToxParameterCacheKey OtherTouchEngineKey = Key;
+	OtherTouchEngineKey.TouchEngineVersion = TEXT("OtherTouchEngine");
+	TestFalse(TEXT("Entries saved with another TouchEngine library are a miss"), FToxParameterCache::Load(OtherTouchEngineKey).IsSet());
+
+	FToxParameterCacheKey OtherTouchDesignerKey = Key;
+	OtherTouchDesignerKey.TouchDesignerPath = TEXT("OtherTouchDesigner");
+	TestFalse(TEXT("Entries saved with another TouchDesigner installation are a miss"), FToxParameterCache::Load(OtherTouchDesignerKey).IsSet());
+
+	FFileHelper::SaveStringToFile(FGuid::NewGuid().ToString(), *ToxPath);
+	FToxParameterCacheKey ChangedToxKey = FToxParameterCache::MakeKey(ToxPath);
+	ChangedToxKey.TouchEngineVersion = Key.TouchEngineVersion;
+	ChangedToxKey.TouchDesignerPath = Key.TouchDesignerPath;
+	TestFalse(TEXT("A changed tox file has another hash"), ChangedToxKey.ToxHash == Key.ToxHash);
+	TestFalse(TEXT("A changed tox file is a miss"), FToxParameterCache::Load(ChangedToxKey).IsSet());
+
+	FToxParameterCache::Save(ChangedToxKey, FTouchLoadResult::MakeFailure(TEXT("Failure")));
+	TestFalse(TEXT("Failed loads are not saved"), FToxParameterCache::Load(ChangedToxKey).IsSet());
+
+	IFileManager::Get().Delete(*ToxPath);
+	TestFalse(TEXT("The key of a missing tox file is invalid"), FToxParameterCache::MakeKey(ToxPath).IsValid());
+	return true;
+}
+
+#endif
@@ -36,6 +36,8 @@ void FTouchEngineDynamicVariableContainer::ToxParametersLoaded(const TArray<FTou
 	{
 		DynVars_Input = VariablesIn;
 		DynVars_Output = VariablesOut;
+		PackValues();
+		InvalidateLookup();
 		return;
 	}
 
@@ -74,6 +76,8 @@ void FTouchEngineDynamicVariableContainer::ToxParametersLoaded(const TArray<FTou
 
 	DynVars_Input = MoveTemp(InVarsCopy);
 	DynVars_Output = MoveTemp(OutVarsCopy);
+	PackValues();
+	InvalidateLookup();
 }
 
 void FTouchEngineDynamicVariableContainer::EnsureMetadataIsSet(const TArray<FTouchEngineDynamicVariableStruct>& VariablesIn)
@@ -100,6 +104,50 @@ void FTouchEngineDynamicVariableContainer::Reset()
 {
 	DynVars_Input = {};
 	DynVars_Output = {};
+	InvalidateLookup();
+}
+
+void FTouchEngineDynamicVariableContainer::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		PackValues();
+		InvalidateLookup();
+	}
+}
+
+void FTouchEngineDynamicVariableContainer::PackValues()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("DynVarContainer - PackValues"), STAT_TE_FTouchEngineDynamicVariableContainerPackValues, STATGROUP_TouchEngine);
+
+	int32 NumBytes = 0;
+	int32 NumValues = 0;
+	for (const TArray<FTouchEngineDynamicVariableStruct>* DynVars : { &DynVars_Input, &DynVars_Output })
+	{
+		for (const FTouchEngineDynamicVariableStruct& DynVar : *DynVars)
+		{
+			const int32 ArenaSize = DynVar.GetValueArenaSize();
+			NumBytes += ArenaSize;
+			NumValues += ArenaSize > 0 ? 1 : 0;
+		}
+	}
+	if (NumValues < 2)
+	{
+		// A single value already has an arena of its own
+		return;
+	}
+
+	const TRefCountPtr<UE::TouchEngine::FTouchValueArena> Arena = UE::TouchEngine::FTouchValueArena::Create(NumBytes);
+	for (TArray<FTouchEngineDynamicVariableStruct>* DynVars : { &DynVars_Input, &DynVars_Output })
+	{
+		for (FTouchEngineDynamicVariableStruct& DynVar : *DynVars)
+		{
+			if (DynVar.GetValueArenaSize() > 0)
+			{
+				DynVar.MoveValueToArena(Arena);
+			}
+		}
+	}
 }
 
 void FTouchEngineDynamicVariableContainer::SendInputs(UE::TouchEngine::FTouchVariableManager& VariableManager, const FTouchEngineInputFrameData& FrameData)
@@ -136,14 +184,29 @@ void FTouchEngineDynamicVariableContainer::SetupForFirstCook(const TSharedPtr<UE
 TMap<FString, FTouchEngineDynamicVariableStruct> FTouchEngineDynamicVariableContainer::CopyInputsForCook(int64 CurrentFrameID)
 {
 	TMap<FString, FTouchEngineDynamicVariableStruct> VariablesForCook;
-	
+
+	// First pass to only allocate once, and not at all if nothing changed
+	int32 NumChangedInputs = 0;
 	for (FTouchEngineDynamicVariableStruct& Input : DynVars_Input)
 	{
 		if (Input.FrameLastUpdated == -1)
 		{
 			// Force sending Inputs that have not been set or that have been reset
-			Input.FrameLastUpdated = CurrentFrameID;
+			Input.SetFrameLastUpdatedIfValueChanged(CurrentFrameID);
+		}
+		if (Input.FrameLastUpdated == CurrentFrameID)
+		{
+			++NumChangedInputs;
 		}
+	}
+	if (NumChangedInputs == 0)
+	{
+		return VariablesForCook;
+	}
+	
+	VariablesForCook.Reserve(NumChangedInputs);
+	for (FTouchEngineDynamicVariableStruct& Input : DynVars_Input)
+	{
 		if (Input.FrameLastUpdated == CurrentFrameID) 
 		{
 			VariablesForCook.Add(Input.VarIdentifier, Input);
@@ -151,6 +214,8 @@ TMap<FString, FTouchEngineDynamicVariableStruct> FTouchEngineDynamicVariableCont
 			{
 				Input.SetValue(false);
 				Input.bNeedBoolReset = false;
+				// TouchEngine resets the pulse on its side, so there is no need to send this value on the next cook
+				Input.StampedValueGeneration = Input.ValueGeneration;
 			}
 		}
 	}
@@ -160,60 +225,183 @@ TMap<FString, FTouchEngineDynamicVariableStruct> FTouchEngineDynamicVariableCont
 
 FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByName(const FString& VarName)
 {
-	FTouchEngineDynamicVariableStruct* Var = nullptr;
+	EnsureLookupIsValid();
+	const int32* LookupIndex = NameLookup.Find(VarName);
+	if (!LookupIndex || *LookupIndex == AmbiguousLookupIndex) // variable with duplicate names, don't try to distinguish between them
+	{
+		return nullptr;
+	}
 
-	for (int i = 0; i < DynVars_Input.Num(); i++)
+	FTouchEngineDynamicVariableStruct* Var = GetDynamicVariableByLookupIndex(*LookupIndex);
+	if (Var->VarName != VarName) // the variable was renamed in place without the lookup being invalidated
 	{
-		if (DynVars_Input[i].VarName == VarName)
-		{
-			if (!Var)
-			{
-				Var = &DynVars_Input[i];
-			}
-			else
-			{
-				// variable with duplicate names, don't try to distinguish between them
-				return nullptr;
-			}
-		}
+		InvalidateLookup();
+		EnsureLookupIsValid();
+		LookupIndex = NameLookup.Find(VarName);
+		return LookupIndex && *LookupIndex != AmbiguousLookupIndex ? GetDynamicVariableByLookupIndex(*LookupIndex) : nullptr;
 	}
+	return Var;
+}
 
-	for (int i = 0; i < DynVars_Output.Num(); i++)
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByIdentifier(const FString& VarIdentifier)
+{
+	EnsureLookupIsValid();
+	const int32* LookupIndex = IdentifierLookup.Find(VarIdentifier);
+	if (!LookupIndex)
+	{
+		return nullptr;
+	}
+
+	FTouchEngineDynamicVariableStruct* Var = GetDynamicVariableByLookupIndex(*LookupIndex);
+	if (!Var->VarIdentifier.Equals(VarIdentifier) && !Var->VarLabel.Equals(VarIdentifier) && !Var->VarName.Equals(VarIdentifier)) // the variable was renamed in place without the lookup being invalidated
+	{
+		InvalidateLookup();
+		EnsureLookupIsValid();
+		LookupIndex = IdentifierLookup.Find(VarIdentifier);
+		return LookupIndex ? GetDynamicVariableByLookupIndex(*LookupIndex) : nullptr;
+	}
+	return Var;
+}
+
+void FTouchEngineDynamicVariableContainer::EnsureLookupIsValid()
+{
+	if (IndexedNumInputs == DynVars_Input.Num() && IndexedNumOutputs == DynVars_Output.Num()
+		&& IndexedInputsData == DynVars_Input.GetData() && IndexedOutputsData == DynVars_Output.GetData())
+	{
+		return;
+	}
+
+	const int32 NumVariables = DynVars_Input.Num() + DynVars_Output.Num();
+	IdentifierLookup.Reset();
+	IdentifierLookup.Reserve(NumVariables * 3);
+	NameLookup.Reset();
+	NameLookup.Reserve(NumVariables);
+
+	// Inputs are added first and only the first match is kept, to return the same variable as a linear search would
+	for (int32 LookupIndex = 0; LookupIndex < NumVariables; ++LookupIndex)
 	{
-		if (DynVars_Output[i].VarName == VarName)
+		const FTouchEngineDynamicVariableStruct* Var = GetDynamicVariableByLookupIndex(LookupIndex);
+		IdentifierLookup.FindOrAdd(Var->VarIdentifier, LookupIndex);
+		IdentifierLookup.FindOrAdd(Var->VarLabel, LookupIndex);
+		IdentifierLookup.FindOrAdd(Var->VarName, LookupIndex);
+
+		if (int32* ExistingIndex = NameLookup.Find(Var->VarName))
 		{
-			if (!Var)
-			{
-				Var = &DynVars_Output[i];
-			}
-			else
-			{
-				// variable with duplicate names, don't try to distinguish between them
-				return nullptr;
-			}
+			*ExistingIndex = AmbiguousLookupIndex;
+		}
+		else
+		{
+			NameLookup.Add(Var->VarName, LookupIndex);
 		}
 	}
-	return Var;
+
+	IndexedInputsData = DynVars_Input.GetData();
+	IndexedOutputsData = DynVars_Output.GetData();
+	IndexedNumInputs = DynVars_Input.Num();
+	IndexedNumOutputs = DynVars_Output.Num();
+
+	static std::atomic<uint32> NextLookupGeneration = 1;
+	LookupGeneration = NextLookupGeneration++;
 }
 
-FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByIdentifier(const FString& VarIdentifier)
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::FindDynamicVariable(const FString& VarName, const FString& Prefix, FTouchEngineDynamicVariableHandle& Handle)
 {
-	for (int32 i = 0; i < DynVars_Input.Num(); i++)
+	if (Handle.IsFor(VarName, Prefix))
 	{
-		if (DynVars_Input[i].VarIdentifier.Equals(VarIdentifier) || DynVars_Input[i].VarLabel.Equals(VarIdentifier) || DynVars_Input[i].VarName.Equals(VarIdentifier))
+		if (FTouchEngineDynamicVariableStruct* DynVar = GetDynamicVariableByHandle(Handle))
 		{
-			return &DynVars_Input[i];
+			return DynVar;
 		}
 	}
 
-	for (int32 i = 0; i < DynVars_Output.Num(); i++)
+	const FString VarNameWithPrefix = GetNameWithPrefix(VarName, Prefix);
+	FTouchEngineDynamicVariableStruct* DynVar = GetDynamicVariableByIdentifier(VarNameWithPrefix);
+	if (!DynVar)
+	{
+		// failed to find by name, try to find by visible name
+		DynVar = GetDynamicVariableByName(VarNameWithPrefix);
+	}
+
+	Handle = MakeHandle(DynVar);
+	Handle.SetLookupName(VarName, Prefix);
+	return DynVar;
+}
+
+const FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::FindOutput(const FString& VarName, const FString& Prefix) const
+{
+	const FString VarNameWithPrefix = GetNameWithPrefix(VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* FoundByName = nullptr;
+	bool bIsNameAmbiguous = false;
+	for (const FTouchEngineDynamicVariableStruct& Output : DynVars_Output)
 	{
-		if (DynVars_Output[i].VarIdentifier.Equals(VarIdentifier) || DynVars_Output[i].VarLabel.Equals(VarIdentifier) || DynVars_Output[i].VarName.Equals(VarIdentifier))
+		if (Output.VarIdentifier.Equals(VarNameWithPrefix) || Output.VarLabel.Equals(VarNameWithPrefix) || Output.VarName.Equals(VarNameWithPrefix))
+		{
+			return &Output;
+		}
+		if (Output.VarName.Equals(VarNameWithPrefix, ESearchCase::IgnoreCase))
 		{
-			return &DynVars_Output[i];
+			bIsNameAmbiguous |= FoundByName != nullptr;
+			FoundByName = &Output;
 		}
 	}
-	return nullptr;
+	return bIsNameAmbiguous ? nullptr : FoundByName; // variable with duplicate names, don't try to distinguish between them
+}
+
+FString FTouchEngineDynamicVariableContainer::GetNameWithPrefix(const FString& VarName, const FString& Prefix)
+{
+	if (VarName.StartsWith("p/") || VarName.StartsWith("i/") || VarName.StartsWith("o/"))
+	{
+		// Legacy names. The user was previously required to explicitly supply the prefix in Blueprint
+		return VarName;
+	}
+	return Prefix + VarName;
+}
+
+FTouchEngineDynamicVariableHandle FTouchEngineDynamicVariableContainer::MakeHandle(const FTouchEngineDynamicVariableStruct* DynVar)
+{
+	EnsureLookupIsValid();
+
+	FTouchEngineDynamicVariableHandle Handle;
+	if (!DynVar)
+	{
+		return Handle;
+	}
+
+	if (DynVar >= DynVars_Input.GetData() && DynVar < DynVars_Input.GetData() + DynVars_Input.Num())
+	{
+		Handle.LookupIndex = DynVar - DynVars_Input.GetData();
+	}
+	else if (DynVar >= DynVars_Output.GetData() && DynVar < DynVars_Output.GetData() + DynVars_Output.Num())
+	{
+		Handle.LookupIndex = DynVars_Input.Num() + (DynVar - DynVars_Output.GetData());
+	}
+	else
+	{
+		return Handle;
+	}
+	Handle.Generation = LookupGeneration;
+	return Handle;
+}
+
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByHandle(const FTouchEngineDynamicVariableHandle& Handle)
+{
+	if (!Handle.IsSet())
+	{
+		return nullptr;
+	}
+
+	// This also detects if the arrays were reallocated since the handle was made, in which case the lookup is rebuilt with a new generation
+	EnsureLookupIsValid();
+	if (Handle.Generation != LookupGeneration || Handle.LookupIndex < 0 || Handle.LookupIndex >= DynVars_Input.Num() + DynVars_Output.Num())
+	{
+		return nullptr;
+	}
+	return GetDynamicVariableByLookupIndex(Handle.LookupIndex);
+}
+
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByLookupIndex(int32 LookupIndex)
+{
+	return LookupIndex < DynVars_Input.Num() ? &DynVars_Input[LookupIndex] : &DynVars_Output[LookupIndex - DynVars_Input.Num()];
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -250,112 +438,242 @@ void FTouchEngineDynamicVariableStruct::Copy(const FTouchEngineDynamicVariableSt
 	WeakTouchResourceProvider = Other->WeakTouchResourceProvider;
 	
 	FrameLastUpdated = Other->FrameLastUpdated;
+	ValueGeneration = Other->ValueGeneration;
+	StampedValueGeneration = Other->StampedValueGeneration;
 	DropDownData = Other->DropDownData;
 }
 
+void FTouchEngineDynamicVariableStruct::Move(FTouchEngineDynamicVariableStruct& Other)
+{
+	Clear();
+
+	VarLabel = MoveTemp(Other.VarLabel);
+	VarName = MoveTemp(Other.VarName);
+	VarIdentifier = MoveTemp(Other.VarIdentifier);
+	ParentIdentifier = MoveTemp(Other.ParentIdentifier);
+	VarScope = Other.VarScope;
+	VarType = Other.VarType;
+	VarIntent = Other.VarIntent;
+	Count = Other.Count;
+	Size = Other.Size;
+	bIsArray = Other.bIsArray;
+	ChannelNames = MoveTemp(Other.ChannelNames);
+
+	ClampMin = MoveTemp(Other.ClampMin);
+	ClampMax = MoveTemp(Other.ClampMax);
+	UIMin = MoveTemp(Other.UIMin);
+	UIMax = MoveTemp(Other.UIMax);
+	DefaultValue = MoveTemp(Other.DefaultValue);
+
+	// We take over the value, so Other is left without any
+	FMemory::Memcpy(InlineValue, Other.InlineValue, sizeof(InlineValue));
+	ValueArena = MoveTemp(Other.ValueArena);
+	ValueOffset = Other.ValueOffset;
+	ValueNumBytes = Other.ValueNumBytes;
+	ValueNumStrings = Other.ValueNumStrings;
+	DATValue = MoveTemp(Other.DATValue);
+	Other.ValueNumBytes = INDEX_NONE;
+	Other.ValueNumStrings = 0;
+	Other.DATValue = FTouchDATView();
+	Other.Count = 0;
+	Other.Size = 0;
+	ExportedTexture = MoveTemp(Other.ExportedTexture);
+	WeakTouchResourceProvider = MoveTemp(Other.WeakTouchResourceProvider);
+
+	FrameLastUpdated = Other.FrameLastUpdated;
+	ValueGeneration = Other.ValueGeneration;
+	StampedValueGeneration = Other.StampedValueGeneration;
+	DropDownData = MoveTemp(Other.DropDownData);
+
+#if WITH_EDITORONLY_DATA
+	CHOPProperty = MoveTemp(Other.CHOPProperty);
+	FloatBufferProperty = MoveTemp(Other.FloatBufferProperty);
+	StringArrayProperty = MoveTemp(Other.StringArrayProperty);
+	TextureProperty = Other.TextureProperty;
+
+	Vector2DProperty = Other.Vector2DProperty;
+	VectorProperty = Other.VectorProperty;
+	Vector4Property = Other.Vector4Property;
+	ColorProperty = Other.ColorProperty;
+
+	IntPointProperty = Other.IntPointProperty;
+	IntVectorProperty = Other.IntVectorProperty;
+	IntVector4Property = Other.IntVector4Property;
+#endif
+}
+
 void FTouchEngineDynamicVariableStruct::Clear()
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("DynVar - Clear"), STAT_TE_FTouchEngineDynamicVariableStructClear, STATGROUP_TouchEngine);
 
 	// We are not clearing the ClampMin, the ClampMax and the DefaultValue as this is called from SetValue which would reset them.
 	// It should be fine as a DynamicVar is not supposed to change type
+
+	// Every SetValue which actually changes the value goes through here
+	++ValueGeneration;
+	CachedDAT.Reset();
+	CachedDATRowIndex = INDEX_NONE;
+	CachedDATRow.Reset();
 	
-	if (Value == nullptr)
+	if (!HasValue())
 	{
 		return;
 	}
 
-	switch (VarType)
+	if (VarType == EVarType::Texture)
 	{
-	case EVarType::Bool:
-		{
-			if (bIsArray)
-			{
-				delete[] static_cast<bool*>(Value);
-			}
-			else
-			{
-				delete static_cast<bool*>(Value);
-			}
-			break;
-		}
-	case EVarType::Int:
-		{
-			if (Count <= 1 && !bIsArray)
-			{
-				delete static_cast<int*>(Value);
-			}
-			else
-			{
-				delete[] static_cast<int*>(Value);
-			}
-			break;
-		}
-	case EVarType::Double:
-		{
-			if (Count <= 1 && !bIsArray)
-			{
-				delete static_cast<double*>(Value);
-			}
-			else
-			{
-				delete[] static_cast<double*>(Value);
-			}
-			break;
-		}
-	case EVarType::Float:
-		{
-			if (bIsArray)
-			{
-				delete[] static_cast<float*>(Value);
-			}
-			else
-			{
-				delete static_cast<float*>(Value);
-			}
-			break;
-		}
-	case EVarType::CHOP:
-		{
-			for (int i = 0; i < Count; i++)
-			{
-				delete[] static_cast<float**>(Value)[i];
-			}
+		// The value is the pointer to the UTexture itself, which we do not own
+		ExportedTexture = nullptr;
+	}
 
-			delete[] static_cast<float**>(Value);
-			break;
-		}
-	case EVarType::String:
-		{
-			if (!bIsArray)
-			{
-				delete[] static_cast<char*>(Value);
-			}
-			else
-			{
-				for (int i = 0; i < Count; i++)
-				{
-					delete[] static_cast<char**>(Value)[i];
-				}
+	// Inline values have nothing to free, and the arena is freed with its last reference
+	ValueArena.SafeRelease();
+	ValueNumBytes = INDEX_NONE;
+	ValueNumStrings = 0;
+	DATValue = FTouchDATView();
+	ChannelNames.Reset();
+}
 
-				delete[] static_cast<char**>(Value);
-			}
-			break;
-		}
-	case EVarType::Texture:
-		{
-			Value = nullptr;
-			ExportedTexture = nullptr;
-			break;
-		}
-	default:
-		break;
+const void* FTouchEngineDynamicVariableStruct::GetValueData() const
+{
+	if (ValueNumBytes == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	return ValueArena ? static_cast<const void*>(ValueArena->GetData(ValueOffset)) : static_cast<const void*>(InlineValue);
+}
+
+void* FTouchEngineDynamicVariableStruct::AllocateValue(int32 NumBytes)
+{
+	check(!HasValue());
+	ValueNumBytes = FMath::Max(NumBytes, 0);
+	ValueNumStrings = 0;
+	if (ValueNumBytes <= InlineValueCapacity)
+	{
+		return InlineValue;
 	}
 
-	Value = nullptr;
-	ChannelNames.Reset();
+	ValueArena = UE::TouchEngine::FTouchValueArena::Create(ValueNumBytes);
+	ValueOffset = ValueArena->Allocate(ValueNumBytes);
+	return ValueArena->GetData(ValueOffset);
+}
+
+void* FTouchEngineDynamicVariableStruct::GetWritableValueData()
+{
+	if (ValueNumBytes == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	++ValueGeneration;
+	CachedDAT.Reset();
+	CachedDATRowIndex = INDEX_NONE;
+	CachedDATRow.Reset();
+	if (ValueArena && ValueArena->IsShared())
+	{
+		const TRefCountPtr<UE::TouchEngine::FTouchValueArena> SharedArena = MoveTemp(ValueArena);
+		const uint8* SharedValue = SharedArena->GetData(ValueOffset);
+		const int32 NumBytes = ValueNumBytes;
+		const int32 NumStrings = ValueNumStrings;
+		ValueNumBytes = INDEX_NONE;
+		void* NewValue = AllocateValue(NumBytes);
+		FMemory::Memcpy(NewValue, SharedValue, NumBytes);
+		ValueNumStrings = NumStrings;
+	}
+	return const_cast<void*>(GetValueData());
+}
+
+bool FTouchEngineDynamicVariableStruct::HasSameValueMemory(const void* Data, int32 NumBytes) const
+{
+	return HasValue() && ValueNumStrings == 0 && ValueNumBytes == NumBytes && FMemory::Memcmp(GetValueData(), Data, NumBytes) == 0;
+}
+
+float* FTouchEngineDynamicVariableStruct::AllocateCHOPValue(int32 NumChannels, int32 NumSamples)
+{
+	return static_cast<float*>(AllocateValue(NumChannels * NumSamples * sizeof(float)));
+}
+
+uint32* FTouchEngineDynamicVariableStruct::AllocateStringArrayValue(int32 NumStrings, int32 NumChars)
+{
+	uint32* Table = static_cast<uint32*>(AllocateValue(NumStrings * sizeof(uint32) + NumChars));
+	ValueNumStrings = NumStrings;
+	return Table;
+}
+
+void FTouchEngineDynamicVariableStruct::SetStringArrayValue(const TArray<FString>& Strings)
+{
+	int32 NumChars = 0;
+	for (const FString& String : Strings)
+	{
+		NumChars += String.Len() + 1; // the ANSI conversion gives one char per TCHAR
+	}
+
+	uint32* Table = AllocateStringArrayValue(Strings.Num(), NumChars);
+	uint32 Offset = Strings.Num() * sizeof(uint32);
+	for (int32 Index = 0; Index < Strings.Num(); ++Index)
+	{
+		const auto AnsiString = StringCast<ANSICHAR>(*Strings[Index]);
+		const int32 NumStringChars = Strings[Index].Len() + 1;
+		FMemory::Memcpy(reinterpret_cast<uint8*>(Table) + Offset, AnsiString.Get(), NumStringChars);
+		Table[Index] = Offset;
+		Offset += NumStringChars;
+	}
+}
+
+const char* FTouchEngineDynamicVariableStruct::GetValueString(int32 Index) const
+{
+	check(Index >= 0 && Index < ValueNumStrings);
+	const uint8* Data = static_cast<const uint8*>(GetValueData());
+	return reinterpret_cast<const char*>(Data + reinterpret_cast<const uint32*>(Data)[Index]);
+}
+
+void FTouchEngineDynamicVariableStruct::CopyValueMemory(const FTouchEngineDynamicVariableStruct& Other)
+{
+	if (&Other == this)
+	{
+		return;
+	}
+
+	Clear();
+	if (!Other.HasValue())
+	{
+		return;
+	}
+
+	// A DAT output is never modified either, so its table is referenced as well
+	DATValue = Other.DATValue;
+	if (Other.ValueNumBytes == INDEX_NONE)
+	{
+		return;
+	}
+
+	// A value in an arena is never modified once shared, so it is referenced instead of copied
+	ValueNumBytes = Other.ValueNumBytes;
+	ValueNumStrings = Other.ValueNumStrings;
+	if (Other.ValueArena)
+	{
+		ValueArena = Other.ValueArena;
+		ValueOffset = Other.ValueOffset;
+	}
+	else
+	{
+		FMemory::Memcpy(InlineValue, Other.InlineValue, ValueNumBytes);
+	}
+}
+
+int32 FTouchEngineDynamicVariableStruct::GetValueArenaSize() const
+{
+	return ValueArena ? UE::TouchEngine::FTouchValueArena::GetAlignedSize(ValueNumBytes) : 0;
 }
 
+void FTouchEngineDynamicVariableStruct::MoveValueToArena(const TRefCountPtr<UE::TouchEngine::FTouchValueArena>& Arena)
+{
+	check(ValueArena);
+	const int32 Offset = Arena->Allocate(ValueNumBytes);
+	FMemory::Memcpy(Arena->GetData(Offset), ValueArena->GetData(ValueOffset), ValueNumBytes);
+	ValueArena = Arena;
+	ValueOffset = Offset;
+}
 
 FString FTouchEngineDynamicVariableStruct::GetCleanVariableName() const
 {
@@ -368,84 +686,84 @@ FString FTouchEngineDynamicVariableStruct::GetCleanVariableName() const
 
 bool FTouchEngineDynamicVariableStruct::GetValueAsBool() const
 {
-	return Value ? *static_cast<bool*>(Value) : false;
+	return HasValue() ? *static_cast<const bool*>(GetValueData()) : false;
 }
 
 int FTouchEngineDynamicVariableStruct::GetValueAsInt() const
 {
-	return Value ? *static_cast<int*>(Value) : 0;
+	return HasValue() ? *static_cast<const int*>(GetValueData()) : 0;
 }
 
 int FTouchEngineDynamicVariableStruct::GetValueAsIntIndexed(const int Index) const
 {
-	return Value ? GetValueAsIntTArray()[Index] : 0; //todo: handle out of bounds
+	return HasValue() ? GetValueAsIntTArray()[Index] : 0; //todo: handle out of bounds
 }
 
-int* FTouchEngineDynamicVariableStruct::GetValueAsIntArray() const
+const int* FTouchEngineDynamicVariableStruct::GetValueAsIntArray() const
 {
-	return Value ? static_cast<int*>(Value) : nullptr;
+	return static_cast<const int*>(GetValueData());
 }
 
 TArray<int> FTouchEngineDynamicVariableStruct::GetValueAsIntTArray() const
 {
-	if (VarType != EVarType::Int || !bIsArray || !Value || Count == 0)
+	if (VarType != EVarType::Int || !bIsArray || !HasValue() || Count == 0)
 	{
 		return TArray<int>();
 	}
 
-	TArray<int> returnArray(static_cast<int*>(Value), Count);
+	TArray<int> returnArray(static_cast<const int*>(GetValueData()), Count);
 	return returnArray;
 }
 
 double FTouchEngineDynamicVariableStruct::GetValueAsDouble() const
 {
-	return Value ? *static_cast<double*>(Value) : 0;
+	return HasValue() ? *static_cast<const double*>(GetValueData()) : 0;
 }
 
 double FTouchEngineDynamicVariableStruct::GetValueAsDoubleIndexed(const int Index) const
 {
-	return Value ? GetValueAsDoubleTArray()[Index] : 0; //todo: handle out of bounds
+	return HasValue() ? GetValueAsDoubleTArray()[Index] : 0; //todo: handle out of bounds
 }
 
-double* FTouchEngineDynamicVariableStruct::GetValueAsDoubleArray() const
+const double* FTouchEngineDynamicVariableStruct::GetValueAsDoubleArray() const
 {
-	return Value ? static_cast<double*>(Value) : nullptr;
+	return static_cast<const double*>(GetValueData());
 }
 
 TArray<double> FTouchEngineDynamicVariableStruct::GetValueAsDoubleTArray() const
 {
-	if (VarType != EVarType::Double || !bIsArray || !Value || Count == 0)
+	if (VarType != EVarType::Double || !bIsArray || !HasValue() || Count == 0)
 	{
 		return TArray<double>();
 	}
 
-	const TArray<double> returnArray(static_cast<double*>(Value), Count);
+	const TArray<double> returnArray(static_cast<const double*>(GetValueData()), Count);
 	return returnArray;
 }
 
 float FTouchEngineDynamicVariableStruct::GetValueAsFloat() const
 {
-	return Value ? *static_cast<float*>(Value) : 0;
+	return HasValue() ? *static_cast<const float*>(GetValueData()) : 0;
 }
 
 double FTouchEngineDynamicVariableStruct::GetValueAsFloatIndexed(int Index) const
 {
-	return Value ? GetValueAsFloatTArray()[Index] : 0; //todo: handle out of bounds
+	return HasValue() ? GetValueAsFloatTArray()[Index] : 0; //todo: handle out of bounds
 }
 
-float* FTouchEngineDynamicVariableStruct::GetValueAsFloatArray() const
+const float* FTouchEngineDynamicVariableStruct::GetValueAsFloatArray() const
 {
-	return Value ? static_cast<float*>(Value) : nullptr;
+	return static_cast<const float*>(GetValueData());
 }
 
 TArray<float> FTouchEngineDynamicVariableStruct::GetValueAsFloatTArray() const
 {
-	if (VarType != EVarType::Float || !bIsArray || !Value || Count == 0)
+	if (VarType != EVarType::Float || !bIsArray || !HasValue() || Count == 0)
 	{
 		return TArray<float>();
 	}
 
-	const TArray<float> returnArray(static_cast<float*>(Value), Count);
+	const TArray<float> returnArray(static_cast<const float*>(GetValueData()), Count);
 	return returnArray;
 }
 
@@ -487,7 +805,8 @@ FString FTouchEngineDynamicVariableStruct::GetValueAsString() const
 	}
 	if (VarType == EVarType::String)
 	{
-		return Value ? FString(UTF8_TO_TCHAR(static_cast<char*>(Value))) : FString();
+		const char* String = static_cast<const char*>(GetValueData());
+		return String ? FString(UTF8_TO_TCHAR(String)) : FString();
 	}
 	return FString();
 }
@@ -496,23 +815,35 @@ TArray<FString> FTouchEngineDynamicVariableStruct::GetValueAsStringArray() const
 {
 	TArray<FString> TempValue = TArray<FString>();
 
-	if (!Value || Count == 0)
+	if (!HasValue() || Count == 0)
 	{
 		return TempValue;
 	}
 
-	char** Buffer = static_cast<char**>(Value);
+	if (DATValue.IsValid())
+	{
+		// Every cell is requested, so they are all converted here, row after row
+		TempValue.Reserve(DATValue.GetNumRows() * DATValue.GetNumColumns());
+		for (int32 Row = 0; Row < DATValue.GetNumRows(); ++Row)
+		{
+			for (int32 Column = 0; Column < DATValue.GetNumColumns(); ++Column)
+			{
+				TempValue.Emplace(DATValue.GetCell(Row, Column));
+			}
+		}
+		return TempValue;
+	}
 
-	for (int i = 0; i < Count; i++)
+	for (int i = 0; i < FMath::Min(Count, ValueNumStrings); i++)
 	{
-		TempValue.Add(Buffer[i]);
+		TempValue.Add(GetValueString(i));
 	}
 	return TempValue;
 }
 
 UTexture* FTouchEngineDynamicVariableStruct::GetValueAsTexture() const
 {
-	return static_cast<UTexture*>(Value);
+	return VarType == EVarType::Texture && HasValue() ? *static_cast<UTexture* const*>(GetValueData()) : nullptr;
 }
 
 const TSharedPtr<UE::TouchEngine::FExportedTouchTexture>& FTouchEngineDynamicVariableStruct::GetExportedTexture() const
@@ -523,7 +854,7 @@ const TSharedPtr<UE::TouchEngine::FExportedTouchTexture>& FTouchEngineDynamicVar
 
 UDEPRECATED_TouchEngineCHOPMinimal* FTouchEngineDynamicVariableStruct::GetValueAsCHOP_DEPRECATED() const
 {
-	if (!Value)
+	if (!HasValue())
 	{
 		return nullptr;
 	}
@@ -537,15 +868,24 @@ UDEPRECATED_TouchEngineCHOPMinimal* FTouchEngineDynamicVariableStruct::GetValueA
 
 FTouchEngineCHOP FTouchEngineDynamicVariableStruct::GetValueAsCHOP() const
 {
-	if (!Value)
+	if (!HasValue() || Count <= 0)
 	{
 		return FTouchEngineCHOP();
 	}
 
-	float** TempBuffer = static_cast<float**>(Value);
-	const int ChannelLength = Count == 0 ? 0 : (Size / sizeof(float)) / Count;
+	// The Channels are stored one after the other
+	const float* Samples = static_cast<const float*>(GetValueData());
+	const int ChannelLength = (Size / sizeof(float)) / Count;
 
-	return FTouchEngineCHOP::FromChannels(TempBuffer, Count, ChannelLength, ChannelNames);
+	FTouchEngineCHOP Chop;
+	Chop.Channels.Reserve(Count);
+	for (int i = 0; i < Count; i++)
+	{
+		FTouchEngineCHOPChannel& Channel = Chop.Channels.AddDefaulted_GetRef();
+		Channel.Name = ChannelNames.IsValidIndex(i) ? ChannelNames[i] : FString();
+		Channel.Values.Append(Samples + i * ChannelLength, ChannelLength);
+	}
+	return Chop;
 }
 
 FTouchEngineCHOP FTouchEngineDynamicVariableStruct::GetValueAsCHOP(const UTouchEngineInfo* EngineInfo) const
@@ -560,29 +900,124 @@ FTouchEngineCHOP FTouchEngineDynamicVariableStruct::GetValueAsCHOP(const UTouchE
 	return Chop;
 }
 
-UTouchEngineDAT* FTouchEngineDynamicVariableStruct::GetValueAsDAT() const
+bool FTouchEngineDynamicVariableStruct::GetCHOPSample(int32 ChannelIndex, int32 SampleIndex, float& OutValue) const
 {
-	if (!Value)
+	if (VarType != EVarType::CHOP || !HasValue() || ChannelIndex < 0 || ChannelIndex >= Count)
 	{
-		return nullptr;
+		return false;
 	}
 
-	TArray<FString> stringArrayBuffer = TArray<FString>();
+	const int ChannelLength = (Size / sizeof(float)) / Count;
+	if (SampleIndex == INDEX_NONE)
+	{
+		SampleIndex = ChannelLength - 1;
+	}
+	if (SampleIndex < 0 || SampleIndex >= ChannelLength)
+	{
+		return false;
+	}
 
-	char** Buffer = static_cast<char**>(Value);
+	OutValue = static_cast<const float*>(GetValueData())[ChannelIndex * ChannelLength + SampleIndex];
+	return true;
+}
 
-	//todo: Count and Size have a different meaning in SetValue(const TArray<FString>& InValue) and in SetValueAsDAT(const TArray<FString>& InValue, const int NumRows, const int NumColumns)
-	for (int i = 0; i < Size; i++)
+UTouchEngineDAT* FTouchEngineDynamicVariableStruct::GetValueAsDAT() const
+{
+	const int32 NumRows = GetDATNumRows();
+	if (NumRows == 0)
 	{
-		stringArrayBuffer.Add(UTF8_TO_TCHAR(Buffer[i]));
+		return nullptr;
+	}
+	if (UTouchEngineDAT* DAT = CachedDAT.Get())
+	{
+		return DAT;
 	}
 
 	UTouchEngineDAT* RetVal = NewObject<UTouchEngineDAT>();
-	RetVal->CreateChannels(stringArrayBuffer, Count, stringArrayBuffer.Num() / Count);
+	const int32 NumColumns = GetDATNumColumns();
+	RetVal->NumRows = NumRows;
+	RetVal->NumColumns = NumColumns;
+	// The cells are converted straight from the value or the table into the object, without an intermediate array
+	RetVal->ValuesAppended.Reserve(NumRows * NumColumns);
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		for (int32 Column = 0; Column < NumColumns; ++Column)
+		{
+			RetVal->ValuesAppended.Emplace(GetDATCell(Row, Column));
+		}
+	}
 
+	CachedDAT = RetVal;
 	return RetVal;
 }
 
+int32 FTouchEngineDynamicVariableStruct::GetDATNumRows() const
+{
+	if (VarType != EVarType::String || !bIsArray)
+	{
+		return 0;
+	}
+	if (DATValue.IsValid())
+	{
+		return DATValue.GetNumRows();
+	}
+	// The number of cells is the size of the string table, as Size is in bytes for string arrays set with SetValue(const TArray<FString>&)
+	if (!HasValue() || Count <= 0 || ValueNumStrings % Count != 0)
+	{
+		return 0;
+	}
+	return Count;
+}
+
+int32 FTouchEngineDynamicVariableStruct::GetDATNumColumns() const
+{
+	const int32 NumRows = GetDATNumRows();
+	if (NumRows == 0)
+	{
+		return 0;
+	}
+	return DATValue.IsValid() ? DATValue.GetNumColumns() : ValueNumStrings / NumRows;
+}
+
+FUtf8StringView FTouchEngineDynamicVariableStruct::GetDATCell(int32 Row, int32 Column) const
+{
+	const int32 NumColumns = GetDATNumColumns();
+	if (Row < 0 || Row >= GetDATNumRows() || Column < 0 || Column >= NumColumns)
+	{
+		return {};
+	}
+	if (DATValue.IsValid())
+	{
+		return DATValue.GetCell(Row, Column);
+	}
+	const char* Cell = GetValueString(Row * NumColumns + Column);
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Cell));
+}
+
+const TArray<FString>& FTouchEngineDynamicVariableStruct::GetDATRow(int32 Row) const
+{
+	if (Row == CachedDATRowIndex)
+	{
+		return CachedDATRow;
+	}
+
+	CachedDATRow.Reset();
+	CachedDATRowIndex = INDEX_NONE;
+	if (Row < 0 || Row >= GetDATNumRows())
+	{
+		return CachedDATRow;
+	}
+
+	const int32 NumColumns = GetDATNumColumns();
+	CachedDATRow.Reserve(NumColumns);
+	for (int32 Column = 0; Column < NumColumns; ++Column)
+	{
+		CachedDATRow.Emplace(GetDATCell(Row, Column));
+	}
+	CachedDATRowIndex = Row;
+	return CachedDATRow;
+}
+
 
 void FTouchEngineDynamicVariableStruct::SetValue(UObject* newValue, const size_t _size)
 {
@@ -590,11 +1025,11 @@ void FTouchEngineDynamicVariableStruct::SetValue(UObject* newValue, const size_t
 	if (newValue == nullptr)
 	{
 		Clear();
-		Value = nullptr;
 		return;
 	}
 
-	Value = static_cast<void*>(newValue);
+	Clear();
+	*static_cast<UObject**>(AllocateValue(sizeof(UObject*))) = newValue;
 	Size = _size;
 }
 
@@ -602,15 +1037,18 @@ void FTouchEngineDynamicVariableStruct::SetValue(const bool InValue)
 {
 	if (VarType == EVarType::Bool)
 	{
-		Clear();
-
-		Value = new bool;
-		*static_cast<bool*>(Value) = InValue;
-
 		if (InValue && VarIntent == EVarIntent::Pulse)
 		{
 			bNeedBoolReset = true;
 		}
+
+		if (HasSameValueMemory(&InValue, sizeof(bool)))
+		{
+			return;
+		}
+		Clear();
+
+		*static_cast<bool*>(AllocateValue(sizeof(bool))) = InValue;
 	}
 }
 
@@ -618,10 +1056,13 @@ void FTouchEngineDynamicVariableStruct::SetValue(const int32 InValue)
 {
 	if (VarType == EVarType::Int)
 	{
+		if (HasSameValueMemory(&InValue, sizeof(int)))
+		{
+			return;
+		}
 		Clear();
 
-		Value = new int;
-		*static_cast<int*>(Value) = InValue;
+		*static_cast<int*>(AllocateValue(sizeof(int))) = InValue;
 	}
 }
 
@@ -629,14 +1070,13 @@ void FTouchEngineDynamicVariableStruct::SetValue(const TArray<int>& InValue)
 {
 	if (VarType == EVarType::Int && bIsArray)
 	{
-		Clear();
-
-		Value = new int*[InValue.Num()];
-
-		for (int i = 0; i < InValue.Num(); i++)
+		if (HasSameValueMemory(InValue.GetData(), InValue.Num() * sizeof(int)))
 		{
-			static_cast<int*>(Value)[i] = InValue[i];
+			return;
 		}
+		Clear();
+
+		FMemory::Memcpy(AllocateValue(InValue.Num() * sizeof(int)), InValue.GetData(), InValue.Num() * sizeof(int));
 
 		Count = InValue.Num();
 		Size = sizeof(int) * Count;
@@ -679,10 +1119,13 @@ void FTouchEngineDynamicVariableStruct::SetValue(const double InValue)
 {
 	if (VarType == EVarType::Double)
 	{
+		if (HasSameValueMemory(&InValue, sizeof(double)))
+		{
+			return;
+		}
 		Clear();
 
-		Value = new double;
-		*static_cast<double*>(Value) = InValue;
+		*static_cast<double*>(AllocateValue(sizeof(double))) = InValue;
 	}
 }
 
@@ -690,14 +1133,13 @@ void FTouchEngineDynamicVariableStruct::SetValue(const TArray<double>& InValue)
 {
 	if (VarType == EVarType::Double && bIsArray)
 	{
-		Clear();
-
-		Value = new double*[InValue.Num()];
-
-		for (int i = 0; i < InValue.Num(); i++)
+		if (HasSameValueMemory(InValue.GetData(), InValue.Num() * sizeof(double)))
 		{
-			static_cast<double*>(Value)[i] = InValue[i];
+			return;
 		}
+		Clear();
+
+		FMemory::Memcpy(AllocateValue(InValue.Num() * sizeof(double)), InValue.GetData(), InValue.Num() * sizeof(double));
 
 		Count = InValue.Num();
 		Size = sizeof(double) * Count;
@@ -749,10 +1191,13 @@ void FTouchEngineDynamicVariableStruct::SetValue(const float InValue)
 {
 	if (VarType == EVarType::Float)
 	{
+		if (HasSameValueMemory(&InValue, sizeof(float)))
+		{
+			return;
+		}
 		Clear();
 
-		Value = new float;
-		*static_cast<float*>(Value) = InValue;
+		*static_cast<float*>(AllocateValue(sizeof(float))) = InValue;
 	}
 }
 
@@ -761,21 +1206,18 @@ void FTouchEngineDynamicVariableStruct::SetValue(const TArray<float>& InValue)
 	if (InValue.Num() == 0)
 	{
 		Clear();
-
-		Value = nullptr;
 		return;
 	}
 
 	if (VarType == EVarType::Float && bIsArray)
 	{
-		Clear();
-
-		Value = new float[InValue.Num()];
-
-		for (int i = 0; i < InValue.Num(); i++)
+		if (HasSameValueMemory(InValue.GetData(), InValue.Num() * sizeof(float)))
 		{
-			static_cast<float*>(Value)[i] = InValue[i];
+			return;
 		}
+		Clear();
+
+		FMemory::Memcpy(AllocateValue(InValue.Num() * sizeof(float)), InValue.GetData(), InValue.Num() * sizeof(float));
 
 #if WITH_EDITORONLY_DATA
 		FloatBufferProperty = InValue;
@@ -865,11 +1307,11 @@ void FTouchEngineDynamicVariableStruct::SetValue(const TArray<float>& InValue)
 #endif
 
 		Clear();
-		Value = new double[InValue.Num()];
+		double* Doubles = static_cast<double*>(AllocateValue(InValue.Num() * sizeof(double)));
 
 		for (int i = 0; i < InValue.Num(); i++)
 		{
-			static_cast<double*>(Value)[i] = static_cast<double>(InValue[i]);
+			Doubles[i] = static_cast<double>(InValue[i]);
 		}
 
 		Count = InValue.Num();
@@ -908,17 +1350,11 @@ void FTouchEngineDynamicVariableStruct::SetValue(const FTouchEngineCHOP& InValue
 	Size = Count * ChannelLength * sizeof(float); // Data.Num() * sizeof(float);
 	bIsArray = true;
 
-	Value = new float*[Count];
 	{
-		// int32 Index = 0;
+		float* Samples = AllocateCHOPValue(Count, ChannelLength);
 		for (int i = 0; i < Count; i++)
 		{
-			static_cast<float**>(Value)[i] = new float[InValue.Channels[i].Values.Num()];
-			for (int j = 0; j < ChannelLength; j++)
-			{
-				static_cast<float**>(Value)[i][j] = InValue.Channels[i].Values[j];
-				// ++Index;
-			}
+			FMemory::Memcpy(Samples + i * ChannelLength, InValue.Channels[i].Values.GetData(), FMath::Min(InValue.Channels[i].Values.Num(), ChannelLength) * sizeof(float));
 		}
 	}
 
@@ -955,6 +1391,35 @@ void FTouchEngineDynamicVariableStruct::SetValue(const FTouchEngineCHOP& InValue
 #endif
 }
 
+void FTouchEngineDynamicVariableStruct::SetValue(const FTouchEngineCHOPView& InValue)
+{
+	if (VarType != EVarType::CHOP)
+	{
+		return;
+	}
+
+#if WITH_EDITORONLY_DATA
+	// The details panel displays CHOPProperty, so the copy is needed in editor builds
+	SetValue(InValue.ToCHOP());
+#else
+	Clear();
+
+	Count = InValue.GetNumChannels();
+	const int32 ChannelLength = InValue.GetNumSamples();
+	Size = Count * ChannelLength * sizeof(float);
+	bIsArray = true;
+
+	float* Samples = AllocateCHOPValue(Count, ChannelLength);
+	ChannelNames.Reset(Count);
+	for (int i = 0; i < Count; i++)
+	{
+		const TConstArrayView<float> Channel = InValue.GetChannel(i);
+		FMemory::Memcpy(Samples + i * ChannelLength, Channel.GetData(), FMath::Min(Channel.Num(), ChannelLength) * sizeof(float));
+		ChannelNames.Emplace(InValue.GetChannelName(i));
+	}
+#endif
+}
+
 void FTouchEngineDynamicVariableStruct::SetValueAsCHOP(const TArray<float>& InValue, const int NumChannels, const int NumSamples)
 {
 	if (VarType != EVarType::CHOP)
@@ -971,7 +1436,7 @@ void FTouchEngineDynamicVariableStruct::SetValueAsCHOP(const TArray<float>& InVa
 	CHOPProperty = FTouchEngineCHOP();
 #endif
 	
-	if (!InValue.Num() || InValue.Num() != NumChannels * NumSamples)
+	if (NumChannels <= 0 || NumSamples <= 0 || InValue.Num() != NumChannels * NumSamples)
 	{
 		// OnValueChanged.Broadcast(*this);
 		return;
@@ -981,17 +1446,8 @@ void FTouchEngineDynamicVariableStruct::SetValueAsCHOP(const TArray<float>& InVa
 	Size = NumSamples * NumChannels * sizeof(float);
 	bIsArray = true;
 
-	Value = new float*[Count];
-
-	for (int i = 0; i < NumChannels; i++)
-	{
-		static_cast<float**>(Value)[i] = new float[NumSamples];
-
-		for (int j = 0; j < NumSamples; j++)
-		{
-			static_cast<float**>(Value)[i][j] = InValue[i * NumSamples + j];
-		}
-	}
+	// The channels are stored one after the other in the value, like in InValue
+	FMemory::Memcpy(AllocateCHOPValue(NumChannels, NumSamples), InValue.GetData(), NumChannels * NumSamples * sizeof(float));
 
 #if WITH_EDITORONLY_DATA
 	if (&FloatBufferProperty != &InValue)
@@ -1012,6 +1468,10 @@ void FTouchEngineDynamicVariableStruct::SetValueAsCHOP(const TArray<float>& InVa
 	Clear();
 
 	const int32 NumChannels = InChannelNames.Num();
+	if (NumChannels == 0)
+	{
+		return;
+	}
 	const int32 NumSamples = InValue.Num() / NumChannels;
 
 	if (!InValue.Num() || InValue.Num() != NumChannels * NumSamples)
@@ -1056,6 +1516,34 @@ void FTouchEngineDynamicVariableStruct::SetValueAsDAT(const TArray<FString>& InV
 	bIsArray = true;
 }
 
+void FTouchEngineDynamicVariableStruct::SetValue(const FTouchDATView& InValue)
+{
+	if (VarType != EVarType::String)
+	{
+		return;
+	}
+
+	Clear();
+	bIsArray = true;
+
+	const int32 NumRows = InValue.GetNumRows();
+	const int32 NumColumns = InValue.GetNumColumns();
+	const int32 NumCells = NumRows * NumColumns;
+	if (NumCells == 0)
+	{
+		Count = 0;
+		Size = 0;
+		return;
+	}
+
+	// The table is referenced instead of copied, so a cook does not convert any cell and the readers only convert the cells they access
+	DATValue = InValue;
+	Count = NumRows;
+	Size = NumCells;
+
+	// StringArrayProperty is not filled as the details panel does not display the value of DAT outputs
+}
+
 void FTouchEngineDynamicVariableStruct::SetValue(const FString& InValue)
 {
 	if (VarType == EVarType::String)
@@ -1063,17 +1551,16 @@ void FTouchEngineDynamicVariableStruct::SetValue(const FString& InValue)
 		// Even if it is a dropdown, we do not force the value to be one of the dropdown value as per the description of TEInstanceLinkGetChoiceValues:
 		//  "This list should not be considered exhaustive and users should be allowed to enter their own values as well as those in this list."
 		
-		Clear();
-
 		const auto AnsiString = StringCast<ANSICHAR>(*InValue);
 		const char* Buffer = AnsiString.Get();
-
-		Value = new char[strlen(Buffer) + 1]; //todo: store the value as FString?
-
-		for (int i = 0; i < strlen(Buffer) + 1; i++)
+		const int32 NumChars = strlen(Buffer) + 1;
+		if (HasSameValueMemory(Buffer, NumChars))
 		{
-			static_cast<char*>(Value)[i] = Buffer[i];
+			return;
 		}
+		Clear();
+
+		FMemory::Memcpy(AllocateValue(NumChars), Buffer, NumChars); //todo: store the value as FString?
 	}
 	else if (VarType == EVarType::Int && VarIntent == EVarIntent::DropDown)
 	{
@@ -1100,7 +1587,6 @@ void FTouchEngineDynamicVariableStruct::SetValue(const TArray<FString>& InValue)
 	{
 		Clear();
 
-		Value = nullptr;
 		Count = 0;
 		Size = 0;
 		return;
@@ -1108,23 +1594,9 @@ void FTouchEngineDynamicVariableStruct::SetValue(const TArray<FString>& InValue)
 
 	Clear();
 
-	Value = new char*[InValue.Num()];
-	Size = 0;
-
+	SetStringArrayValue(InValue);
 	Count = InValue.Num();
-
-	for (int i = 0; i < InValue.Num(); i++)
-	{
-		const auto AnsiString = StringCast<ANSICHAR>(*(InValue[i]));
-		const char* TempValue = AnsiString.Get();
-
-		static_cast<char**>(Value)[i] = new char[(InValue[i]).Len() + 1];
-		Size += InValue[i].Len() + 1;
-		for (int j = 0; j < InValue[i].Len() + 1; j++)
-		{
-			static_cast<char**>(Value)[i][j] = TempValue[j];
-		}
-	}
+	Size = ValueNumBytes - Count * sizeof(uint32);
 
 #if WITH_EDITORONLY_DATA
 	StringArrayProperty = InValue;
@@ -1175,67 +1647,22 @@ void FTouchEngineDynamicVariableStruct::SetValue(const FTouchEngineDynamicVariab
 		return;
 	}
 	
-	switch (Other->VarType)
+	if (Other->VarType == EVarType::Texture)
 	{
-	case EVarType::Bool:
-		{
-			SetValue(Other->GetValueAsBool());
-			break;
-		}
-	case EVarType::Int:
-		{
-			if (!Other->bIsArray)
-			{
-				SetValue(Other->GetValueAsInt());
-			}
-			else
-			{
-				SetValue(Other->GetValueAsIntTArray());
-			}
+		SetValue(Other->GetValueAsTexture());
+	}
+	else
+	{
+		// All the other values are plain memory, so they are shared or copied as-is instead of going through temporary arrays, CHOPs and DATs
+		CopyValueMemory(*Other);
+		Count = Other->Count;
+		Size = Other->Size;
+		ChannelNames = Other->ChannelNames;
 
-			break;
-		}
-	case EVarType::Double:
-		{
-			if (!Other->bIsArray)
-			{
-				SetValue(Other->GetValueAsDouble());
-			}
-			else
-			{
-				SetValue(Other->GetValueAsDoubleTArray());
-			}
-			break;
-		}
-	case EVarType::Float:
-		{
-			SetValue(Other->GetValueAsFloat());
-			break;
-		}
-	case EVarType::CHOP:
-		{
-			SetValue(Other->GetValueAsCHOP());
-			break;
-		}
-	case EVarType::String:
-		{
-			if (!Other->bIsArray)
-			{
-				SetValue(Other->GetValueAsString());
-			}
-			else
-			{
-				SetValue(Other->GetValueAsDAT());
-			}
-			break;
-		}
-	case EVarType::Texture:
+		if (VarType == EVarType::Bool && VarIntent == EVarIntent::Pulse && GetValueAsBool())
 		{
-			SetValue(Other->GetValueAsTexture());
-			break;
+			bNeedBoolReset = true;
 		}
-	default:
-		break;
 	}
 
 #if WITH_EDITORONLY_DATA
@@ -1261,7 +1688,16 @@ void FTouchEngineDynamicVariableStruct::SetFrameLastUpdatedFromNextCookFrame(con
 {
 	if (IsValid(EngineInfo))
 	{
-		FrameLastUpdated = EngineInfo->Engine->GetNextFrameID();
+		SetFrameLastUpdatedIfValueChanged(EngineInfo->Engine->GetNextFrameID());
+	}
+}
+
+void FTouchEngineDynamicVariableStruct::SetFrameLastUpdatedIfValueChanged(int64 FrameID)
+{
+	if (FrameLastUpdated == -1 || ValueGeneration != StampedValueGeneration)
+	{
+		FrameLastUpdated = FrameID;
+		StampedValueGeneration = ValueGeneration;
 	}
 }
 
@@ -1655,6 +2091,28 @@ void FTouchEngineDynamicVariableStruct::HandleDropDownBoxValueChanged(const TSha
 #endif
 
 
+void FTouchEngineDynamicVariableStruct::SerializeMetadata(FArchive& Ar)
+{
+	Ar << DefaultValue;
+	Ar << ClampMin;
+	Ar << ClampMax;
+	Ar << UIMin;
+	Ar << UIMax;
+	
+	int DropDownCount = DropDownData.Num();
+	Ar << DropDownCount;
+	for (int i = 0; i < DropDownCount; ++i)
+	{
+		if (DropDownData.Num() <= i)
+		{
+			DropDownData.Add({});
+		}
+		Ar << DropDownData[i].Index;
+		Ar << DropDownData[i].Value;
+		Ar << DropDownData[i].Label;
+	}
+}
+
 bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 {
 	// write / read all normal variables
@@ -1670,25 +2128,7 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 	if (Ar.IsTransacting()) // we only care for the undo/redo buffer
 	{
 		//todo: this should be saved not just when transacting, so the values would have bounds before the tox file is loaded
-		Ar << DefaultValue;
-		Ar << ClampMin;
-		Ar << ClampMax;
-		Ar << UIMin;
-		Ar << UIMax;
-		
-		int DropDownCount = DropDownData.Num();
-		Ar << DropDownCount;
-		for (int i = 0; i < DropDownCount; ++i)
-		{
-			if (DropDownData.Num() <= i)
-			{
-				DropDownData.Add({});
-			}
-			Ar << DropDownData[i].Index;
-			Ar << DropDownData[i].Value;
-			Ar << DropDownData[i].Label;
-		}
-		
+		SerializeMetadata(Ar);
 		Ar << FrameLastUpdated;
 	}
 	
@@ -1781,7 +2221,7 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 				{
 					for (int i = 0; i < Count; i++)
 					{
-						int TempIntIndex = Value ? static_cast<int*>(Value)[i] : 0;
+						int TempIntIndex = HasValue() ? GetValueAsIntArray()[i] : 0;
 						Ar << TempIntIndex;
 					}
 				}
@@ -1798,7 +2238,7 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 				{
 					for (int i = 0; i < Count; i++)
 					{
-						double TempDoubleIndex = Value ? static_cast<double*>(Value)[i] : 0.0;
+						double TempDoubleIndex = HasValue() ? GetValueAsDoubleArray()[i] : 0.0;
 						Ar << TempDoubleIndex;
 					}
 				}
@@ -1868,12 +2308,13 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 				}
 				else
 				{
-					Value = new int[Count];
+					Clear();
 					Size = sizeof(int) * Count;
+					int* Values = static_cast<int*>(AllocateValue(Size));
 
 					for (int i = 0; i < Count; i++)
 					{
-						Ar << static_cast<int*>(Value)[i];
+						Ar << Values[i];
 					}
 				}
 				break;
@@ -1888,12 +2329,13 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 				}
 				else
 				{
-					Value = new double[Count];
+					Clear();
 					Size = sizeof(double) * Count;
+					double* Values = static_cast<double*>(AllocateValue(Size));
 
 					for (int i = 0; i < Count; i++)
 					{
-						Ar << static_cast<double*>(Value)[i];
+						Ar << Values[i];
 					}
 				}
 				break;
@@ -2420,10 +2862,10 @@ void FTouchEngineDynamicVariableStruct::GetOutput(const UTouchEngineInfo* Engine
 		}
 	case EVarType::CHOP:
 		{
-			FTouchEngineCHOP Chop;
+			FTouchEngineCHOPView Chop;
 			{
 				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      III.B.1a [GT] Post Cook - DynVar - Get Output CHOP"), STAT_TE_III_B_1_CHOPa, STATGROUP_TouchEngine);
-				Chop = EngineInfo->GetCHOPOutput(VarIdentifier); //no need to check if valid as this is checked down the track
+				Chop = EngineInfo->GetCHOPOutputView(VarIdentifier); //no need to check if valid as this is checked down the track
 			}
 			{
 				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      III.B.1b [GT] Post Cook - DynVar - Get Output CHOP - SetValue"), STAT_TE_III_B_1_CHOPb, STATGROUP_TouchEngine);
@@ -2441,22 +2883,7 @@ void FTouchEngineDynamicVariableStruct::GetOutput(const UTouchEngineInfo* Engine
 			}
 			else
 			{
-				const FTouchDATFull Op = EngineInfo->GetTableOutput(VarIdentifier);
-
-				TArray<FString> Buffer;
-
-				const int32 RowCount = TETableGetRowCount(Op.TableData);
-				const int32 ColumnCount = TETableGetColumnCount(Op.TableData);
-
-				for (int i = 0; i < RowCount; i++)
-				{
-					for (int j = 0; j < ColumnCount; j++)
-					{
-						Buffer.Add(UTF8_TO_TCHAR(TETableGetStringValue(Op.TableData, i, j)));
-					}
-				}
-
-				SetValueAsDAT(Buffer, RowCount, ColumnCount);
+				SetValue(FTouchDATView(EngineInfo->GetTableOutput(VarIdentifier)));
 			}
 			break;
 		}
@@ -15,13 +15,17 @@
 #include "TouchEngineModule.h"
 
 #include "Logging.h"
+#include "Engine/Util/TouchDeadlineTimer.h"
+#include "Engine/Util/ToxParameterCache.h"
 #if WITH_EDITOR
 #include "MessageLogModule.h"
 #endif
 #include "Interfaces/IPluginManager.h"
 #include "Rendering/TouchResourceProvider.h"
+#include "Stub/TouchEngineStub.h"
 #include "TouchEngine/TEResult.h"
 
+#include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "TouchEngineModule"
@@ -46,6 +50,10 @@ namespace UE::TouchEngine
 	void FTouchEngineModule::ShutdownModule()
 	{
 		ResourceFactories.Reset();
+		FTouchDeadlineTimer::Shutdown();
+#if WITH_TOUCHENGINE_STUB
+		Stub::Shutdown();
+#endif
 		UnloadTouchEngineLib();
 
 #if WITH_EDITOR
@@ -68,7 +76,11 @@ namespace UE::TouchEngine
 
 	bool FTouchEngineModule::IsTouchEngineLibInitialized() const
 	{
+#if WITH_TOUCHENGINE_STUB
+		return Stub::IsEnabled();
+#else
 		return TouchEngineLibHandle != nullptr;
+#endif
 	}
 
 	void FTouchEngineModule::UnbindResourceProvider(const FString& NameOfRHI)
@@ -78,6 +90,14 @@ namespace UE::TouchEngine
 
 	TSharedPtr<FTouchResourceProvider> FTouchEngineModule::CreateResourceProvider(const FString& NameOfRHI)
 	{
+#if WITH_TOUCHENGINE_STUB
+		// No RHI module is compiled alongside the stub, which does not exchange textures anyway
+		if (Stub::IsEnabled() && !ResourceFactories.Contains(NameOfRHI))
+		{
+			return Stub::CreateResourceProvider();
+		}
+#endif
+
 		if (const FResourceProviderFactory* Factory = ResourceFactories.Find(NameOfRHI)
 			; ensure(IsTouchEngineLibInitialized()) && ensure(Factory))
 		{
@@ -103,6 +123,10 @@ namespace UE::TouchEngine
 
 	void FTouchEngineModule::LoadTouchEngineLib()
 	{
+#if WITH_TOUCHENGINE_STUB
+		UE_LOG(LogTouchEngine, Warning, TEXT("This build uses the stub TouchEngine API of the automation tests instead of the TouchEngine library. TouchEngine is unavailable outside of these tests."));
+		FToxParameterCache::SetTouchEngineVersion(TEXT("Stub"));
+#else
 #if WITH_EDITOR
 		const FString BasePath = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir(), TEXT("/Binaries/ThirdParty/Win64"));
 #else
@@ -120,11 +144,15 @@ namespace UE::TouchEngine
 		FPlatformProcess::PopDllDirectory(*BasePath);
 		
 		UE_CLOG(!IsTouchEngineLibInitialized(), LogTouchEngine, Error, TEXT("Failed to load TouchEngine library: %s"), *FullPathToDLL);
+
+		// The timestamp also catches libraries replaced without their version being bumped, like development builds
+		FToxParameterCache::SetTouchEngineVersion(FPlatformMisc::GetFileVersion(FullPathToDLL) + TEXT(" ") + IFileManager::Get().GetTimeStamp(*FullPathToDLL).ToString());
+#endif
 	}
 
 	void FTouchEngineModule::UnloadTouchEngineLib()
 	{
-		if (IsTouchEngineLibInitialized())
+		if (TouchEngineLibHandle)
 		{
 			FPlatformProcess::FreeDllHandle(TouchEngineLibHandle);
 			TouchEngineLibHandle = nullptr;
@@ -0,0 +1,70 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Util/TouchEngineTrace.h"
+
+namespace UE::TouchEngine
+{
+	const TCHAR* LexToString(ECookTimelineEvent Event)
+	{
+		switch (Event)
+		{
+		case ECookTimelineEvent::CookEnqueued: return TEXT("CookEnqueued");
+		case ECookTimelineEvent::CookStarted: return TEXT("CookStarted");
+		case ECookTimelineEvent::FrameStartedInTouchEngine: return TEXT("FrameStartedInTouchEngine");
+		case ECookTimelineEvent::FrameFinishedInTouchEngine: return TEXT("FrameFinishedInTouchEngine");
+		case ECookTimelineEvent::ExportStarted: return TEXT("ExportStarted");
+		case ECookTimelineEvent::ExportTransferAdded: return TEXT("ExportTransferAdded");
+		case ECookTimelineEvent::ExportFinalised: return TEXT("ExportFinalised");
+		case ECookTimelineEvent::ImportStarted: return TEXT("ImportStarted");
+		case ECookTimelineEvent::ImportCopyEnqueued: return TEXT("ImportCopyEnqueued");
+		case ECookTimelineEvent::ImportLinked: return TEXT("ImportLinked");
+		case ECookTimelineEvent::CookFinished: return TEXT("CookFinished");
+		default: return TEXT("Unknown");
+		}
+	}
+}
+
+#if UE_TOUCHENGINE_TRACE_ENABLED
+
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(TouchEngineChannel)
+
+namespace UE::TouchEngine
+{
+	void FTouchEngineTrace::OutputCookTimelineEvent(ECookTimelineEvent Event, int64 FrameID, const FName& Identifier)
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel))
+		{
+			return;
+		}
+
+		TCHAR IdentifierBuffer[NAME_SIZE];
+		if (Identifier.IsNone())
+		{
+			IdentifierBuffer[0] = TEXT('\0');
+		}
+		else
+		{
+			Identifier.ToString(IdentifierBuffer, NAME_SIZE);
+		}
+
+		// The FrameID is part of the text, so the Log view of Unreal Insights can be filtered on a frame
+		TRACE_BOOKMARK(TEXT("TouchEngine %s [Frame %lld] %s"), LexToString(Event), FrameID, IdentifierBuffer);
+	}
+}
+
+#endif
@@ -15,12 +15,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "TouchEngineDynamicVariableStruct.h"
 #include "Engine/TouchVariables.h"
 #include "Engine/Util/TouchErrorLog.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "TouchBlueprintFunctionLibrary.generated.h"
 
-struct FTouchEngineDynamicVariableStruct;
 class UTexture;
 class UTexture2D;
 class UDEPRECATED_TouchEngineCHOPMinimal;
@@ -53,19 +53,19 @@ public:
 	// Setters for TouchEngine dynamic variables accessed through the TouchEngine Input K2 Node
 
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetFloatByName(UTouchEngineComponentBase* Target, FString VarName, float Value, FString Prefix);
+	static bool SetFloatByName(UTouchEngineComponentBase* Target, FString VarName, float Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetFloatArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<float> Value, FString Prefix);
+	static bool SetFloatArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<float> Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetIntByName(UTouchEngineComponentBase* Target, FString VarName, int32 Value, FString Prefix);
+	static bool SetIntByName(UTouchEngineComponentBase* Target, FString VarName, int32 Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetInt64ByName(UTouchEngineComponentBase* Target, FString VarName, int64 Value, FString Prefix);
+	static bool SetInt64ByName(UTouchEngineComponentBase* Target, FString VarName, int64 Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetIntArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<int> Value, FString Prefix);
+	static bool SetIntArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<int> Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetBoolByName(UTouchEngineComponentBase* Target, FString VarName, bool Value, FString Prefix);
+	static bool SetBoolByName(UTouchEngineComponentBase* Target, FString VarName, bool Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetNameByName(UTouchEngineComponentBase* Target, FString VarName, FName Value, FString Prefix);
+	static bool SetNameByName(UTouchEngineComponentBase* Target, FString VarName, FName Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	/**
 	 * Set a texture by Name 
 	 * @param Target The Component holding the input
@@ -74,33 +74,33 @@ public:
 	 * @param Prefix 
 	 */
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetTextureByName(UTouchEngineComponentBase* Target, FString VarName, UTexture* Value, FString Prefix);
+	static bool SetTextureByName(UTouchEngineComponentBase* Target, FString VarName, UTexture* Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetClassByName(UTouchEngineComponentBase* Target, FString VarName, class UClass* Value, FString Prefix);
+	static bool SetClassByName(UTouchEngineComponentBase* Target, FString VarName, class UClass* Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetByteByName(UTouchEngineComponentBase* Target, FString VarName, uint8 Value, FString Prefix);
+	static bool SetByteByName(UTouchEngineComponentBase* Target, FString VarName, uint8 Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetStringByName(UTouchEngineComponentBase* Target, FString VarName, FString Value, FString Prefix);
+	static bool SetStringByName(UTouchEngineComponentBase* Target, FString VarName, FString Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetStringArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<FString> Value, FString Prefix);
+	static bool SetStringArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<FString> Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetTextByName(UTouchEngineComponentBase* Target, FString VarName, FText Value, FString Prefix);
+	static bool SetTextByName(UTouchEngineComponentBase* Target, FString VarName, FText Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetColorByName(UTouchEngineComponentBase* Target, FString VarName, FColor Value, FString Prefix);
+	static bool SetColorByName(UTouchEngineComponentBase* Target, FString VarName, FColor Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetLinearColorByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor Value, FString Prefix);
+	static bool SetLinearColorByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetVectorByName(UTouchEngineComponentBase* Target, FString VarName, FVector Value, FString Prefix);
+	static bool SetVectorByName(UTouchEngineComponentBase* Target, FString VarName, FVector Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetVector2DByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D Value, FString Prefix);
+	static bool SetVector2DByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetVector4ByName(UTouchEngineComponentBase* Target, FString VarName, FVector4 Value, FString Prefix);
+	static bool SetVector4ByName(UTouchEngineComponentBase* Target, FString VarName, FVector4 Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetEnumByName(UTouchEngineComponentBase* Target, FString VarName, uint8 Value, FString Prefix);
+	static bool SetEnumByName(UTouchEngineComponentBase* Target, FString VarName, uint8 Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetChopByName(UTouchEngineComponentBase* Target, FString VarName, const FTouchEngineCHOP& Value, FString Prefix);
+	static bool SetChopByName(UTouchEngineComponentBase* Target, FString VarName, const FTouchEngineCHOP& Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool SetChopChannelByName(UTouchEngineComponentBase* Target, FString VarName, const FTouchEngineCHOPChannel& Value, FString Prefix);
+	static bool SetChopChannelByName(UTouchEngineComponentBase* Target, FString VarName, const FTouchEngineCHOPChannel& Value, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 
 	// Getters for TouchEngine dynamic variables accessed through the TouchEngine Output K2 Node
 
@@ -108,68 +108,96 @@ public:
 	 * @param Value A texture valid for this frame and only until it is updated in a future cook. If you want to keep the texture for longer, see `Keep Frame Texture` 
 	 */
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetTextureByName(UTouchEngineComponentBase* Target, FString VarName, UPARAM(DisplayName = "Frame Texture") UTexture*& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetTextureByName(UTouchEngineComponentBase* Target, FString VarName, UPARAM(DisplayName = "Frame Texture") UTexture*& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	/**
 	 * @param Value A texture valid for this frame and only until it is updated in a future cook. If you want to keep the texture for longer, see `Keep Frame Texture` 
 	 */
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetTexture2DByName(UTouchEngineComponentBase* Target, FString VarName, UPARAM(DisplayName = "Frame Texture") UTexture2D*& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetTexture2DByName(UTouchEngineComponentBase* Target, FString VarName, UPARAM(DisplayName = "Frame Texture") UTexture2D*& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetStringArrayByName(UTouchEngineComponentBase* Target, FString VarName, UTouchEngineDAT*& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetStringArrayByName(UTouchEngineComponentBase* Target, FString VarName, UTouchEngineDAT*& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetFloatArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<float>& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetFloatArrayByName(UTouchEngineComponentBase* Target, FString VarName, TArray<float>& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetStringByName(UTouchEngineComponentBase* Target, FString VarName, FString& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetStringByName(UTouchEngineComponentBase* Target, FString VarName, FString& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetFloatByName(UTouchEngineComponentBase* Target, FString VarName, float& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetFloatByName(UTouchEngineComponentBase* Target, FString VarName, float& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetCHOPByName(UTouchEngineComponentBase* Target, FString VarName, FTouchEngineCHOP& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetCHOPByName(UTouchEngineComponentBase* Target, FString VarName, FTouchEngineCHOP& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
+
+	/**
+	 * Returns a single sample of a CHOP output as of the last cook, without copying the rest of the CHOP and without calling TouchEngine.
+	 * Prefer this over getting the whole CHOP output when only a few values are needed.
+	 * @param SampleIndex The index of the sample in the Channel, or -1 to get the latest sample
+	 * @return True if the output, the Channel and the sample were found
+	 */
+	UFUNCTION(BlueprintPure, meta = (AdvancedDisplay = "Prefix"), Category = "TouchEngine|CHOP")
+	static bool GetCHOPOutputSample(const UTouchEngineComponentBase* Target, FString VarName, int32 ChannelIndex, int32 SampleIndex, float& Value, FString Prefix = "o/");
+
+	/**
+	 * Returns the number of rows and columns of a DAT output as of the last cook, without converting its cells.
+	 * @return True if the output was found and holds a DAT
+	 */
+	UFUNCTION(BlueprintPure, meta = (AdvancedDisplay = "Prefix"), Category = "TouchEngine|DAT")
+	static bool GetDATOutputSize(const UTouchEngineComponentBase* Target, FString VarName, int32& NumRows, int32& NumColumns, FString Prefix = "o/");
+	/**
+	 * Returns a single cell of a DAT output as of the last cook. Only this cell is converted, so prefer this over getting the whole DAT when only a few cells are needed.
+	 * @return True if the output and the cell were found
+	 */
+	UFUNCTION(BlueprintPure, meta = (AdvancedDisplay = "Prefix"), Category = "TouchEngine|DAT")
+	static bool GetDATOutputCell(const UTouchEngineComponentBase* Target, FString VarName, int32 Row, int32 Column, FString& Value, FString Prefix = "o/");
+	/**
+	 * Returns a single row of a DAT output as of the last cook. Only the cells of this row are converted.
+	 * @return True if the output and the row were found
+	 */
+	UFUNCTION(BlueprintPure, meta = (AdvancedDisplay = "Prefix"), Category = "TouchEngine|DAT")
+	static bool GetDATOutputRow(const UTouchEngineComponentBase* Target, FString VarName, int32 Row, TArray<FString>& Values, FString Prefix = "o/");
 
 
 	// Get latest value given to an input
 
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetFloatInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, float& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetFloatInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, float& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetFloatArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<float>& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetFloatArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<float>& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetDoubleArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<double>& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetDoubleArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<double>& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetIntInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, int32& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetIntInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, int32& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetInt64InputLatestByName(UTouchEngineComponentBase* Target, FString VarName, int64& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetInt64InputLatestByName(UTouchEngineComponentBase* Target, FString VarName, int64& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetIntArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<int>& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetIntArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<int>& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetBoolInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, bool& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetBoolInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, bool& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetNameInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FName& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetNameInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FName& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetTextureInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, UTexture*& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetTextureInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, UTexture*& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetTexture2DInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, UTexture2D*& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetTexture2DInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, UTexture2D*& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetClassInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, class UClass*& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetClassInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, class UClass*& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetByteInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, uint8& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetByteInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, uint8& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetStringInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FString& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetStringInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FString& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetStringArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<FString>& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetStringArrayInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, TArray<FString>& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetTextInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FText& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetTextInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FText& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetColorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FColor& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetColorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FColor& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetLinearColorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetLinearColorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetVectorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetVectorInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetVector4InputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector4& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetVector4InputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector4& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetVector2DInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetVector2DInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, FVector2D& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
-	static bool GetEnumInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, uint8& Value, int64& FrameLastUpdated, FString Prefix);
+	static bool GetEnumInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, uint8& Value, int64& FrameLastUpdated, FString Prefix, UPARAM(ref) FTouchEngineDynamicVariableHandle& Handle);
 
 	/**
 	 * Force the recreation of the internal Texture Samplers based on the current value of the Texture Filter, AddressX, AddressY, AddressZ, and MipBias.
@@ -238,8 +266,14 @@ public:
 
 
 private:
-	/** Returns the dynamic variable with the identifier in the TouchEngineComponent if possible. If the Variable is found, this also means that the given Target was not null. */
-	static FTouchEngineDynamicVariableStruct* TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix);
+	/** Returns the dynamic variable with the identifier in the TouchEngineComponent if possible. If the Variable is found, this also means that the given Target was not null.
+	 * The Handle is used to skip the lookup by name if it still references a variable of the Target, and is updated with the found variable otherwise. */
+	static FTouchEngineDynamicVariableStruct* TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix, FTouchEngineDynamicVariableHandle& Handle);
+	/**
+	 * Returns the output with the given name and type in the TouchEngineComponent, or nullptr after logging an error. Used by the pure getters, which only read
+	 * the values copied into the outputs at the end of the last cook, so they can be evaluated any number of times without touching TouchEngine or the Target.
+	 */
+	static const FTouchEngineDynamicVariableStruct* TryGetOutput(const UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix, EVarType VarType, const FName& FunctionName);
 	/** Logs an error in the given UTouchEngineComponentBase struct */
 	static void LogTouchEngineError(const UTouchEngineComponentBase* Target, UE::TouchEngine::FTouchErrorLog::EErrorType ErrorType, const FString& VarName, const FName& FunctionName, const FString& AdditionalDescription = FString());
 };
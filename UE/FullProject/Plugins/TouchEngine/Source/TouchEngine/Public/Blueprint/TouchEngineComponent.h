@@ -19,6 +19,7 @@
 #include "TouchEngineDynamicVariableStruct.h"
 #include "Engine/TouchEngine.h"
 #include "Engine/Util/CookFrameData.h"
+#include "Util/TouchRollingHistogram.h"
 #include "TouchEngineComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTouchEngineComponent, Display, All)
@@ -128,6 +129,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", meta=(ClampMin=1, UIMin=1, UIMax=30))
 	int32 InputBufferLimit = 10;
 
+	/**
+	 * Sets the maximum number of cooks in flight. TouchEngine cooks one frame at a time, and above 1, it could start cooking the next frame
+	 * while the outputs of the previous frames are still being imported and broadcast in OnEndFrame.
+	 * TouchEngine only keeps the latest value of each output, so the outputs read during OnEndFrame could then come from a more recent cook.
+	 * Until the outputs are captured for each frame when it finishes cooking, this is limited to 1.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=1, ClampMax=1, UIMin=1, UIMax=1, EditCondition="CookMode != ETouchEngineCookMode::Synchronized"))
+	int32 MaxCooksInFlight = 1;
+
 	/** Container for all dynamic variables */
 	UPROPERTY(EditAnywhere, meta = (NoResetToDefault), Category = "Tox File")
 	FTouchEngineDynamicVariableContainer DynamicVariables;
@@ -175,6 +185,14 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=0.01, UIMin=0.01, UIMax=0.5, ForceUnits="s"))
 	double CookTimeout = 0.3;
+
+	/**
+	 * The number of frames covered by Get Latency Report.
+	 * Recording a frame has a fixed cost regardless of this value, which only changes the memory used: 2 bytes per frame for each of the 4 values reported, on top of their fixed 16 KB.
+	 * Changing it discards the frames already recorded.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=1, UIMin=60, UIMax=36000))
+	int32 LatencyReportWindowSize = 3600;
 	
 	UTouchEngineComponentBase();
 
@@ -222,6 +240,50 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "TouchEngine|TOP")
 	bool KeepFrameTexture(UTexture2D* FrameTexture, UTexture2D*& Texture);
+
+	/**
+	 * Gets the latest statistics reported by TouchEngine about its own work, like the time it spends on a frame or the memory it uses.
+	 * Compared to the Latency of On End Frame, this tells whether the time of a slow frame was spent in the tox or in UE.
+	 * @param Statistics The latest statistics reported
+	 * @return true if TouchEngine has reported statistics for the running instance
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|States")
+	bool GetTouchEngineStatistics(FTouchEngineStatistics& Statistics);
+
+	/**
+	 * Gets the p50, p95, p99 and max of the latencies and cook durations of the last frames, as well as the rate of dropped frames.
+	 * The values are within about 3% of the ones received in On End Frame. The number of frames covered is set by Latency Report Window Size.
+	 * @param Report The distribution of the last frames
+	 * @return true if at least one frame was recorded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|States")
+	bool GetLatencyReport(FTouchEngineLatencyReport& Report) const;
+
+	/** Discards the frames recorded for Get Latency Report. Done automatically when the TouchEngine is stopped or unloaded */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|States")
+	void ResetLatencyReport();
+
+	/**
+	 * Starts recording every cook request with its input values, and every cook result with its timings, to reproduce performance issues offline with Replay Cook Recording.
+	 * The recording is stopped automatically when the TouchEngine is stopped or unloaded.
+	 * @param FilePath The file to write. A relative path is relative to the Saved/TouchEngine/CookRecordings folder of the project
+	 * @return true if the recording started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Recording")
+	bool StartCookRecording(const FString& FilePath);
+
+	/** Stops the recording started with Start Cook Recording and writes its file. Returns true if the file was written */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Recording")
+	bool StopCookRecording();
+
+	/**
+	 * Sends the requests of a recording made with Start Cook Recording through the loaded tox file as fast as possible, in the same order relative to their results as when they were recorded.
+	 * The component does not start new cooks during the replay and the outputs are not updated. The comparison of the results with the recording is logged when the replay is done.
+	 * @param FilePath The file to replay. A relative path is relative to the Saved/TouchEngine/CookRecordings folder of the project
+	 * @return true if the replay started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Recording")
+	bool ReplayCookRecording(const FString& FilePath);
 	
 	//~ Begin UObject Interface
 	virtual void BeginDestroy() override;
@@ -327,6 +389,23 @@ private:
 
 	FDelegateHandle ParamsLoadedDelegateHandle;
 	FDelegateHandle LoadFailedDelegateHandle;
+
+	// The histograms of the latency report. Each one stores its 4 KB of bucket counts inline, so they make every component 16 KB larger,
+	// and allocates 2 bytes per frame of LatencyReportWindowSize.
+	/** The Latency of the last frames, in microseconds */
+	UE::TouchEngine::FTouchRollingHistogram LatencyHistogram;
+	/** The TickLatency of the last frames */
+	UE::TouchEngine::FTouchRollingHistogram TickLatencyHistogram;
+	/** The TouchEngine cook duration of the last successful frames which were not dropped, in microseconds */
+	UE::TouchEngine::FTouchRollingHistogram CookDurationHistogram;
+	/** 1 for the last frames which were dropped, 0 otherwise */
+	UE::TouchEngine::FTouchRollingHistogram DroppedFrameHistogram;
+
+	/** Records the frame in the histograms of the latency report */
+	void RecordLatency(const FTouchEngineOutputFrameData& OutputFrameData, bool bWasCookSuccessful);
+
+	/** True while a cook recording is replayed, during which the component does not start new cooks */
+	bool bIsReplayingCooks = false;
 	
 	void StartNewCook(double TimeInSeconds);
 	void OnCookFinished(const UE::TouchEngine::FCookFrameResult& CookFrameResult);
@@ -29,6 +29,38 @@ struct FTouchEngineInputFrameData
 	double StartTime = 0.0;
 };
 
+/** The statistics TouchEngine reports about its own work, which tell apart the cost of the tox from the overhead of UE */
+USTRUCT(BlueprintType)
+struct FTouchEngineStatistics
+{
+	GENERATED_BODY()
+
+	/** False until TouchEngine has reported statistics for the running instance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	bool bIsValid = false;
+
+	/** The GPU memory used by TouchEngine, in bytes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	int64 MemoryUsedGPU = 0;
+	/** The CPU memory used by TouchEngine, in bytes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	int64 MemoryUsedCPU = 0;
+
+	/** The CPU time of a frame in TouchEngine, in seconds, averaged over the frames covered by the last statistics reported */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double FrameTimeCPU = 0.0;
+	/** The GPU time of a frame in TouchEngine, in seconds, averaged over the frames covered by the last statistics reported. Delayed by one frame, -1 if not available with the version of TouchDesigner used */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double FrameTimeGPU = -1.0;
+
+	/** The number of frames processed by TouchEngine since the instance was created */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	int64 FramesProcessed = 0;
+	/** The number of frames dropped by TouchEngine since the instance was created, -1 if not available with the version of TouchDesigner used */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	int64 FramesDropped = -1;
+};
+
 USTRUCT(BlueprintType)
 struct FTouchEngineOutputFrameData
 {
@@ -65,4 +97,49 @@ struct FTouchEngineOutputFrameData
 	/** The internal end_time of this Cook returned by TouchEngine. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
 	double CookEndTime = 0.0;
-};
\ No newline at end of file
+
+	/** The latest statistics reported by TouchEngine when this cook was processed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	FTouchEngineStatistics TouchEngineStatistics;
+};
+
+/** Percentiles of a value over the frames of the latency report window */
+USTRUCT(BlueprintType)
+struct FTouchEngineLatencyPercentiles
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double P50 = 0.0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double P95 = 0.0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double P99 = 0.0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double Max = 0.0;
+};
+
+/** The distribution of the FTouchEngineOutputFrameData of the last frames, to detect tail latency without having to record every frame */
+USTRUCT(BlueprintType)
+struct FTouchEngineLatencyReport
+{
+	GENERATED_BODY()
+
+	/** The number of frames the report covers, which is at most the Latency Report Window Size of the component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	int32 NumFrames = 0;
+
+	/** The number of seconds it took since On Start Frame was called */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	FTouchEngineLatencyPercentiles Latency;
+	/** The number of ticks it took since On Start Frame was called */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	FTouchEngineLatencyPercentiles TickLatency;
+	/** The number of seconds TouchEngine reported between the start and the end of the cook. Only covers the successful frames which were not dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	FTouchEngineLatencyPercentiles CookDuration;
+
+	/** The ratio, between 0 and 1, of frames which were dropped by TouchEngine */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	double DroppedFrameRate = 0.0;
+};
@@ -21,6 +21,7 @@
 #include "TouchEngineDynamicVariableStruct.h"
 #include "TouchVariables.h"
 #include "Util/TouchErrorLog.h"
+#include "Util/TouchTripleBuffer.h"
 
 #include "PixelFormat.h"
 #include "Rendering/TouchResourceProvider.h"
@@ -42,6 +43,7 @@ DECLARE_MULTICAST_DELEGATE(FTouchOnCookFinished);
 
 namespace UE::TouchEngine
 {
+	class FTouchCookRecorder;
 	class FTouchFrameCooker;
 	class FTouchVariableManager;
 	class FTouchResourceProvider;
@@ -64,11 +66,13 @@ namespace UE::TouchEngine
 		
 		static void TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale, void* Info);
 		static void	LinkValueCallback_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier, void* Info);
+		static void StatisticsCallback_AnyThread(TEInstance* Instance, const TEInstanceStatistics* Statistics, void* Info);
 	};
 	
 	class TOUCHENGINE_API FTouchEngine : public TSharedFromThis<FTouchEngine>
 	{
 		friend class UTouchEngineInfo;
+		friend class FTouchCookReplayer;
 		friend FTouchEngineHazardPointer;
 	public:
 
@@ -77,6 +81,11 @@ namespace UE::TouchEngine
 		/** Starts a new TE instance or reuses the active one to load a .tox file. The future is executed on the game thread once the file has been loaded. */
 		TFuture<FTouchLoadResult> LoadTox_GameThread(const FString& InToxPath, UTouchEngineComponentBase* Component, double TimeoutInSeconds = 0);
 		
+		/**
+		 * Creates the TE instance, sets its frame rate and associates the graphics context without loading any .tox file, so that a later LoadTox_GameThread only has to configure and load the instance.
+		 * Used by the instance pool of UTouchEngineSubsystem to absorb the cost of starting TouchEngine ahead of time. Does nothing if the instance was already created.
+		 */
+		bool Prewarm_GameThread();
 		/** Unloads the .tox file. Calls TEInstanceUnload on the TE instance suspending it but keeping the process alive; you can call LoadTox to resume it. */
 		void Unload_GameThread();
 		/** Will end up calling TERelease on the instance. Kills the process. */
@@ -85,9 +94,19 @@ namespace UE::TouchEngine
 		/** Returns the FrameID to be used for the next cook. */
 		int64 GetNextFrameID() const;
 
-		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
+		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 MaxCooksInFlight = 1);
 		/** Execute the next queued CookFrameRequest if no cook is on going */
 		bool ExecuteNextPendingCookFrame_GameThread() const;
+
+		/**
+		 * Starts recording the cook requests and their results to the given file, to be replayed with FTouchCookReplayer. Stops the previous recording if any.
+		 * The recording carries on if the tox file is reloaded. A relative path is relative to FTouchCookRecording::GetRecordingDirectory().
+		 * @return false if the file could not be created
+		 */
+		bool StartCookRecording_GameThread(const FString& FilePath);
+		/** Stops the recording started with StartCookRecording_GameThread and finalizes its file. Returns false if nothing was recorded or if the file could not be written */
+		bool StopCookRecording_GameThread();
+		bool IsRecordingCooks() const { return CookRecorder.IsValid(); }
 		
 		void SetCookMode(bool bIsIndependent);
 		bool SetFrameRate(int64 FrameRate);
@@ -99,8 +118,8 @@ namespace UE::TouchEngine
 		bool SetImportedTexturePoolSize(int ImportedTexturePoolSize);
 
 		/* Code to be reviewed */
-		FTouchEngineCHOP GetCHOPOutputSingleSample(const FString& Identifier) const	{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutputSingleSample(Identifier) : FTouchEngineCHOP{}; }
 		FTouchEngineCHOP GetCHOPOutput(const FString& Identifier) const				{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutput(Identifier) : FTouchEngineCHOP{}; }
+		FTouchEngineCHOPView GetCHOPOutputView(const FString& Identifier) const		{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutputView(Identifier) : FTouchEngineCHOPView{}; }
 		UTexture2D* GetTOPOutput(const FString& Identifier) const					{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetTOPOutput(Identifier) : nullptr; }
 		bool GetBooleanOutput(const FString& Identifier) const			{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetBooleanOutput(Identifier) : bool{}; }
 		double GetDoubleOutput(const FString& Identifier) const			{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetDoubleOutput(Identifier) : double{}; }
@@ -119,6 +138,9 @@ namespace UE::TouchEngine
 
 		bool GetSupportedPixelFormat(TSet<TEnumAsByte<EPixelFormat>>& SupportedPixelFormat) const;
 
+		/** Returns the latest statistics reported by TouchEngine for the running instance, and updates the TouchEngine stats group if new ones were reported since the last call */
+		FTouchEngineStatistics GetStatistics_GameThread();
+
 		TSharedPtr<FTouchVariableManager> GetVariableManager() const
 		{
 			return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager : nullptr;
@@ -131,10 +153,20 @@ namespace UE::TouchEngine
 			}
 			return false;
 		}
+		/** Links the new textures imported by the finished cook right away instead of waiting for the GameThread task, see FTouchTextureImporter::FlushPendingTextureWrappers_GameThread */
+		void FlushPendingTextureImports_GameThread() const
+		{
+			if (LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.ResourceProvider))
+			{
+				TouchResources.ResourceProvider->GetTextureImporter().FlushPendingTextureWrappers_GameThread();
+			}
+		}
 
 		void CancelCurrentAndNextCooks_GameThread(ECookFrameResult CookFrameResult);
 		bool CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameResult CookFrameResult = ECookFrameResult::Cancelled);
 		bool CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds);
+		/** Blocks the GameThread until the given cook is done or its timeout is reached, in which case the cook in progress is cancelled before returning. Returns true if the cook was done in time */
+		bool WaitForCook_GameThread(const TFuture<void>& CookFuture, double CookTimeoutInSeconds);
 		const TSharedPtr<FTouchResourceProvider>& GetResourceProvider() const { return TouchResources.ResourceProvider;}
 
 	private:
@@ -178,7 +210,8 @@ namespace UE::TouchEngine
 		FString	LastToxPathAttemptedToLoad;
 		double LastLoadTimeoutInSeconds = 10.0;
 		FCriticalSection LoadTimeoutTaskLock;
-		TOptional<FDelegateHandle> LoadTimeoutTaskHandle;
+		/** The handle of the deadline armed in the FTouchDeadlineTimer to unload the tox if it has not loaded in time */
+		TOptional<uint64> LoadTimeoutTaskHandle;
 		TOptional<TEResult> LastLoadResult;
 		
 		enum class ELoadState
@@ -204,12 +237,28 @@ namespace UE::TouchEngine
 		float TargetFrameRate = 60.f;
 		TETimeMode TimeMode = TETimeInternal;
 
+		/**
+		 * The statistics reported by TouchEngine, handed over from the threads of the callback to the GameThread, which never waits for them.
+		 * FramesProcessed and FramesDropped are not part of it as they accumulate over all the reports, see StatisticsFramesProcessed and StatisticsFramesDropped.
+		 */
+		TTouchTripleBuffer<FTouchEngineStatistics> ReportedStatistics;
+		std::atomic<int64> StatisticsFramesProcessed = 0;
+		/** -1 until a report with the number of frames dropped was received */
+		std::atomic<int64> StatisticsFramesDropped = -1;
+		/** The statistics returned by GetStatistics_GameThread */
+		FTouchEngineStatistics LatestStatistics_GameThread;
+
 		/** Systems that are only valid while there is a TouchEngine (being) loaded. */
 		FTouchResources TouchResources;
+
+		/** Set between StartCookRecording_GameThread and StopCookRecording_GameThread, and given to every FrameCooker created in between */
+		TSharedPtr<FTouchCookRecorder> CookRecorder;
 		
 		TFuture<FTouchLoadResult> LoadTouchEngine(const FString& InToxPath, double TimeoutInSeconds);
 		/** Create a TouchEngine instance, if none exists, and set up the engine with the tox path. This won't call TEInstanceLoad. */
 		bool InstantiateEngineWithToxFile(const FString& InToxPath);
+		/** Creates the resource provider and the TE instance, sets the frame rate and associates the graphics context. Expects no instance to exist. */
+		bool CreateTouchEngineInstance_GameThread();
 
 		// Handlers for loading tox
 		void TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale);
@@ -223,6 +272,9 @@ namespace UE::TouchEngine
 		void ResumeLoadAfterUnload_GameThread();
 
 		void LinkValue_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier);
+		void Statistics_AnyThread(const TEInstanceStatistics& Statistics);
+		/** Discards the statistics of the previous instance, called before a new instance is created */
+		void ResetStatistics_GameThread();
 
 		void SharedCleanUp();
 		void CreateNewLoadPromise();
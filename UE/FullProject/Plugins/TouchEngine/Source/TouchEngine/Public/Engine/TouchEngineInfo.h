@@ -59,8 +59,11 @@ public:
 	TFuture<UE::TouchEngine::FTouchLoadResult> LoadTox(const FString& AbsolutePath, class UTouchEngineComponentBase* Component, double TimeoutInSeconds = -1.0);
 	bool Unload();
 	void Destroy();
+	/** Hands the TouchEngine instance over to the instance pool of UTouchEngineSubsystem to be reused by another component, or destroys it if the pool is full. A new engine is created for this object */
+	void Recycle();
 	
 	FTouchEngineCHOP GetCHOPOutput(const FString& Identifier) const;
+	FTouchEngineCHOPView GetCHOPOutputView(const FString& Identifier) const;
 	UTexture2D* GetTOPOutput(const FString& Identifier) const;
 	FTouchDATFull GetTableOutput(const FString& Identifier) const;
 	bool GetBooleanOutput(const FString& Identifier) const;
@@ -75,9 +78,11 @@ public:
 	 * @param CookFrameRequest The CookFrameRequest
 	 * @param InputBufferLimit  Sets the maximum number of cooks we will enqueue while another cook is processing by TouchEngine. If the limit is reached, older cooks will be discarded.
 	 * If set to less than 0, there will be no limit to the amount of cooks enqueued.
+	 * @param MaxCooksInFlight The maximum number of cooks which can be started before the results of the previous ones have been processed. 1 fully serializes the cooks.
+	 * Currently limited to 1, as the outputs are read from TouchEngine when the result is processed and could otherwise come from a more recent cook.
 	 * @return 
 	 */
-	TFuture<UE::TouchEngine::FCookFrameResult> CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
+	TFuture<UE::TouchEngine::FCookFrameResult> CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 MaxCooksInFlight = 1);
 	/** Execute the next queued CookFrameRequest if no cook is on going */
 	bool ExecuteNextPendingCookFrame_GameThread() const;
 	
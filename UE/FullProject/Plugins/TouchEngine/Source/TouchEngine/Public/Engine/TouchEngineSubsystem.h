@@ -28,6 +28,9 @@ class UTouchEngineInfo;
 
 namespace UE::TouchEngine
 {
+	class FTouchEngine;
+	struct FToxParameterCacheKey;
+	
 	struct TOUCHENGINE_API FCachedToxFileInfo
 	{
 		const FTouchLoadResult LoadResult;
@@ -57,6 +60,9 @@ public:
 	/**
 	 * Gets or loads the params from the given tox file path. Executes the future (possibly immediately) once the data is available.
 	 * The Subsystem is used to load Tox files and to cache the values so the details panel could quickly display the values in the Editor UI without having to reload the files everytime.
+	 * Up to TouchEngine.Subsystem.MaxConcurrentToxLoads files are loaded at the same time, each in its own TouchEngine instance, and requests for a file which is already loading share the same load.
+	 * Successfully loaded parameters are also persisted on disk (see FToxParameterCache) so they can be retrieved in later sessions without loading the file in TouchEngine,
+	 * as long as the file content, the TouchEngine library and the TouchDesigner installation did not change. The file is hashed on a worker thread, so this never completes immediately for a file which is not cached in memory.
 	 * 
 	 * @params AbsoluteOrRelativeToContentFolder A path to the .tox file: either absolute or relative to the project's content folder.
 	 * @params LoadTimeoutInSeconds The number of seconds to wait for the load to complete before timing out
@@ -89,7 +95,22 @@ public:
 	 */
 	void LoadPixelFormats(const UTouchEngineInfo* ComponentEngineInfo);
 
-	TObjectPtr<UTouchEngineInfo> GetTempEngineInfo() const { return EngineForLoading; }
+	/**
+	 * Takes a TouchEngine instance which has already been started with the given frame rate out of the instance pool, so the caller only pays for loading the tox file.
+	 * The pool keeps TouchEngine.Subsystem.InstancePoolSize instances started at TouchEngine.Subsystem.InstancePoolFrameRate, and is refilled on the following ticks.
+	 * @return The engine, or nullptr if the pool has no instance with this frame rate, in which case a refill is scheduled
+	 */
+	TSharedPtr<UE::TouchEngine::FTouchEngine> AcquirePooledEngine(int64 FrameRate);
+	/**
+	 * Unloads the tox file of the given engine and keeps its TouchEngine instance in the pool to be reused by AcquirePooledEngine.
+	 * The engine is destroyed instead if the pool is full or if it has no running instance. The caller must not use the engine after this call.
+	 */
+	void ReleaseEngineToPool(const TSharedRef<UE::TouchEngine::FTouchEngine>& Engine);
+	/** The number of started TouchEngine instances currently waiting in the instance pool */
+	int32 GetNumPooledEngines() const { return EnginePool.Num(); }
+
+	/** Returns the first TouchEngine instance of the loader pool, or nullptr if the subsystem has not loaded any file yet */
+	TObjectPtr<UTouchEngineInfo> GetTempEngineInfo() const { return LoaderEngines.IsEmpty() ? nullptr : LoaderEngines[0]; }
 	
 private:
 	struct FLoadTask
@@ -97,9 +118,24 @@ private:
 		UToxAsset* ToxAsset;
 		TPromise<UE::TouchEngine::FCachedToxFileInfo> Promise;
 		double LoadTimeoutInSeconds;
+		/** False when the request forces a reload, in which case the parameters persisted by FToxParameterCache are ignored */
+		bool bUseParameterCache;
 	};
 	
-	TOptional<FLoadTask> ActiveTask;
+	/** A tox file being loaded by one of the LoaderEngines */
+	struct FActiveLoad
+	{
+		FString AbsolutePath;
+		/** Kept alive by LoaderEngines */
+		UTouchEngineInfo* LoaderEngine;
+		/** All the requests for AbsolutePath made while it was loading. They all receive the same result */
+		TArray<FLoadTask> Tasks;
+		/** Set by the worker which hashes the tox file before it is loaded, to save the parameters in FToxParameterCache once loaded */
+		TSharedPtr<UE::TouchEngine::FToxParameterCacheKey> ParameterCacheKey;
+	};
+	
+	TArray<FActiveLoad> ActiveLoads;
+	/** Tasks waiting for a loader engine to be available, in the order they were requested */
 	TArray<FLoadTask> TaskQueue;
 
 	TMap<FString, UE::TouchEngine::FTouchLoadResult> CachedFileData;
@@ -111,10 +147,23 @@ private:
 	UPROPERTY(Transient)
 	TSet<TEnumAsByte<EPixelFormat>> CachedSupportedPixelFormats;
 
-	/** TouchEngine instance used to load items into the details panel */
+	/** Pool of TouchEngine instances used to load items into the details panel. Grows up to TouchEngine.Subsystem.MaxConcurrentToxLoads instances */
 	UPROPERTY(Transient)
-	TObjectPtr<UTouchEngineInfo> EngineForLoading;
-
-	TFuture<UE::TouchEngine::FCachedToxFileInfo> EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds);
-	void ExecuteLoadTask(FLoadTask&& LoadTask);
+	TArray<TObjectPtr<UTouchEngineInfo>> LoaderEngines;
+
+	/** Started TouchEngine instances with no tox file loaded, ready to be handed to a component */
+	TArray<TSharedRef<UE::TouchEngine::FTouchEngine>> EnginePool;
+	bool bIsEnginePoolRefillScheduled = false;
+
+	/** Starts a new instance on a later tick if the pool has less than TouchEngine.Subsystem.InstancePoolSize instances. One instance is started per tick to spread the cost */
+	void ScheduleEnginePoolRefill();
+	void RefillEnginePool();
+
+	TFuture<UE::TouchEngine::FCachedToxFileInfo> EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds, bool bUseParameterCache);
+	/** Looks the file up in FToxParameterCache on a worker thread, as hashing it reads the whole file, then loads it in the LoaderEngine if it was not found */
+	void ExecuteLoadTask(FLoadTask&& LoadTask, UTouchEngineInfo* LoaderEngine);
+	void OnParameterCacheLookupCompleted(UTouchEngineInfo* LoaderEngine, TSharedRef<UE::TouchEngine::FToxParameterCacheKey> Key, TOptional<UE::TouchEngine::FTouchLoadResult> CachedResult);
+	void OnLoadCompleted(UTouchEngineInfo* LoaderEngine, const UE::TouchEngine::FTouchLoadResult& LoadResult, bool bIsFromParameterCache = false);
+	/** Returns an engine of the pool which is not loading any file, creating one if the pool is not full yet. Returns nullptr if all the engines are busy */
+	UTouchEngineInfo* FindOrCreateIdleLoaderEngine();
 };
\ No newline at end of file
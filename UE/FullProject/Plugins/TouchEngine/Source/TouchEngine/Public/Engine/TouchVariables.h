@@ -15,6 +15,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "TouchEngine/TEFloatBuffer.h"
 #include "TouchEngine/TETable.h"
 #include "TouchEngine/TouchObject.h"
 #include "TouchVariables.generated.h"
@@ -79,6 +81,42 @@ struct TOUCHENGINE_API FTouchEngineCHOP
 	bool Serialize(FArchive& Ar);
 };
 
+/**
+ * A read-only view of a CHOP output, backed directly by the TEFloatBuffer returned by TouchEngine.
+ * The view keeps the buffer alive, so the channels can be read without being copied. Use ToCHOP to get a copy that can be used in Blueprint.
+ */
+struct TOUCHENGINE_API FTouchEngineCHOPView
+{
+	FTouchEngineCHOPView() = default;
+	explicit FTouchEngineCHOPView(TouchObject<TEFloatBuffer> InBuffer);
+
+	bool IsValid() const { return Buffer.get() != nullptr; }
+	bool IsTimeDependent() const;
+	int32 GetNumChannels() const;
+	int32 GetNumSamples() const;
+
+	/** Returns the samples of the given Channel. The returned view is only valid while this FTouchEngineCHOPView or a copy of it is alive. */
+	TConstArrayView<float> GetChannel(int32 ChannelIndex) const;
+	/** Returns NumSamples samples of the given Channel starting at StartSample, clamped to the samples available. The returned view has the same lifetime as the one returned by GetChannel. */
+	TConstArrayView<float> GetChannelSamples(int32 ChannelIndex, int32 StartSample, int32 NumSamples) const;
+	/** Reads a single sample without copying the Channel. A SampleIndex of INDEX_NONE reads the latest sample. Returns false if the Channel or the sample does not exist */
+	bool GetSample(int32 ChannelIndex, int32 SampleIndex, float& OutValue) const;
+	/** Returns the name of the given Channel as given by TouchEngine, or nullptr if the Channel has no name */
+	const char* GetChannelNameAsCStr(int32 ChannelIndex) const;
+	FString GetChannelName(int32 ChannelIndex) const;
+	TArray<FString> GetChannelNames() const;
+
+	/** Copies the Channels into a FTouchEngineCHOP */
+	FTouchEngineCHOP ToCHOP() const { return ToCHOP(0, GetNumSamples()); }
+	/** Copies NumSamples samples of every Channel starting at StartSample into a FTouchEngineCHOP, clamped to the samples available */
+	FTouchEngineCHOP ToCHOP(int32 StartSample, int32 NumSamples) const;
+
+	const TouchObject<TEFloatBuffer>& GetBuffer() const { return Buffer; }
+
+private:
+	TouchObject<TEFloatBuffer> Buffer;
+};
+
 USTRUCT(BlueprintType, DisplayName = "TouchEngine DAT Channel")
 struct TOUCHENGINE_API FTouchEngineDATLine
 {
@@ -155,3 +193,31 @@ struct FTouchDATFull
 	TArray<FString> RowNames;
 	TArray<FString> ColumnNames;
 };
+
+/**
+ * A read-only view of a DAT output, backed directly by the TETable returned by TouchEngine.
+ * The view keeps the table alive and exposes the cells as the UTF-8 strings given by TouchEngine. They are only converted to FString when requested,
+ * so reading a few cells of a large table does not convert the whole table.
+ */
+struct TOUCHENGINE_API FTouchDATView
+{
+	FTouchDATView() = default;
+	explicit FTouchDATView(TouchObject<TETable> InTable);
+	explicit FTouchDATView(const FTouchDATFull& InDAT) : FTouchDATView(InDAT.TableData) {}
+
+	bool IsValid() const { return Table.get() != nullptr; }
+	int32 GetNumRows() const { return NumRows; }
+	int32 GetNumColumns() const { return NumColumns; }
+
+	/** Returns the cell as given by TouchEngine, or an empty view if the cell does not exist. The returned view is only valid while this FTouchDATView or a copy of it is alive. */
+	FUtf8StringView GetCell(int32 Row, int32 Column) const;
+	FString GetCellAsString(int32 Row, int32 Column) const;
+
+	const TouchObject<TETable>& GetTable() const { return Table; }
+
+private:
+	TouchObject<TETable> Table;
+	/** Queried once when the view is made, as the table is not modified afterwards and GetCell checks them for every cell */
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+};
@@ -62,6 +62,9 @@ namespace UE::TouchEngine
 
 		/** A copy of the variables and their values needed for that cook */
 		TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend;
+
+		/** The number of seconds after the request was made after which the cook is cancelled with TouchEngineCookTimeout. No timeout is armed if less or equal to 0 */
+		double CookTimeoutInSeconds = -1.0;
 	};
 
 	
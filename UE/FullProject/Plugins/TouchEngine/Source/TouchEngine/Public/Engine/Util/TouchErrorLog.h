@@ -30,6 +30,8 @@ namespace UE::TouchEngine
 	{
 	public:
 		FTouchErrorLog(TWeakObjectPtr<UTouchEngineComponentBase> InComponent);
+		/** Changes the component the messages are reported for, when the engine is handed over to another component. Must be called from the game thread */
+		void SetComponent(TWeakObjectPtr<UTouchEngineComponentBase> InComponent);
 		
 		void AddResult(const FString& ResultString, TEResult Result, const FString& VarName = FString(), const FName& FunctionName = FName(), const FString& AdditionalDescription = FString());
 		void AddWarning(const FString& Message, const FString& VarName = FString(), const FName& FunctionName = FName(), const FString& AdditionalDescription = FString());
@@ -46,6 +46,16 @@ namespace UE::TouchEngine
 		ETextureUpdateErrorCode ErrorCode;
 	};
 
+	/**
+	 * A stable handle to a link of the TouchEngine instance, given by FTouchVariableManager::GetLinkHandle.
+	 * Accessing a variable through its handle uses the cached TELinkInfo and identifier instead of calling TEInstanceLinkGetInfo and converting the identifier every time.
+	 */
+	struct FTouchLinkHandle
+	{
+		int32 Index = INDEX_NONE;
+		bool IsValid() const { return Index != INDEX_NONE; }
+	};
+
 	class FTouchVariableManager : public TSharedFromThis<FTouchVariableManager>
 	{
 	public:
@@ -58,24 +68,56 @@ namespace UE::TouchEngine
 		 */
 		UTexture2D* UpdateLinkedTOP(FName ParamName, UTexture2D* Texture);
 		
-		FTouchEngineCHOP GetCHOPOutputSingleSample(const FString& Identifier);
-		FTouchEngineCHOP GetCHOPOutput(const FString& Identifier);
-		UTexture2D* GetTOPOutput(const FString& Identifier);
-		bool GetBooleanOutput(const FString& Identifier);
-		double GetDoubleOutput(const FString& Identifier);
-		int32_t GetIntegerOutput(const FString& Identifier);
-		TouchObject<TEString> GetStringOutput(const FString& Identifier);
-		FTouchDATFull GetTableOutput(const FString& Identifier) const;
+		/**
+		 * Returns the handle of the link with the given identifier, adding it to the link info cache if needed.
+		 * The handle stays valid for the lifetime of this FTouchVariableManager, even if the link info is invalidated. Must be called on GameThread.
+		 */
+		FTouchLinkHandle GetLinkHandle(const FString& Identifier) const;
+		/** Queries and caches the link info of the given variables. Called once the tox is loaded so the first cook does not have to query them */
+		void CacheLinkInfos(const TArray<FTouchEngineDynamicVariableStruct>& Variables);
+		/** Invalidates the cached link info of the given link, which will be queried again on next use. Can be called from any thread */
+		void InvalidateLinkInfo_AnyThread(const char* Identifier);
+		/** Invalidates all the cached link infos, which will be queried again on next use. Can be called from any thread */
+		void InvalidateAllLinkInfos_AnyThread();
+
+		FTouchEngineCHOP GetCHOPOutput(const FString& Identifier) { return GetCHOPOutput(GetLinkHandle(Identifier)); }
+		FTouchEngineCHOPView GetCHOPOutputView(const FString& Identifier) { return GetCHOPOutputView(GetLinkHandle(Identifier)); }
+		UTexture2D* GetTOPOutput(const FString& Identifier) { return GetTOPOutput(GetLinkHandle(Identifier)); }
+		bool GetBooleanOutput(const FString& Identifier) { return GetBooleanOutput(GetLinkHandle(Identifier)); }
+		double GetDoubleOutput(const FString& Identifier) { return GetDoubleOutput(GetLinkHandle(Identifier)); }
+		int32_t GetIntegerOutput(const FString& Identifier) { return GetIntegerOutput(GetLinkHandle(Identifier)); }
+		TouchObject<TEString> GetStringOutput(const FString& Identifier) { return GetStringOutput(GetLinkHandle(Identifier)); }
+		FTouchDATFull GetTableOutput(const FString& Identifier) const { return GetTableOutput(GetLinkHandle(Identifier)); }
 		TArray<FString> GetCHOPChannelNames(const FString& Identifier) const;
 
-		void SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel);
-		void SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP);
-		TFuture<bool> SetTOPInput(const FString& Identifier, const TSharedPtr<FExportedTouchTexture>& Texture, const FTouchEngineInputFrameData& FrameData);
-		void SetBooleanInput(const FString& Identifier, const bool& Op);
-		void SetDoubleInput(const FString& Identifier, const TArray<double>& Op);
-		void SetIntegerInput(const FString& Identifier, const TArray<int32_t>& Op);
-		void SetStringInput(const FString& Identifier, const char*& Op);
-		void SetTableInput(const FString& Identifier, const FTouchDATFull& Op);
+		/** Returns a copy of the CHOP output. Prefer GetCHOPOutputView when the values do not need to be kept */
+		FTouchEngineCHOP GetCHOPOutput(FTouchLinkHandle Handle) { return GetCHOPOutputView(Handle).ToCHOP(); }
+		/** Returns a view on the float buffer of the CHOP output, without copying the values */
+		FTouchEngineCHOPView GetCHOPOutputView(FTouchLinkHandle Handle);
+		UTexture2D* GetTOPOutput(FTouchLinkHandle Handle);
+		bool GetBooleanOutput(FTouchLinkHandle Handle);
+		double GetDoubleOutput(FTouchLinkHandle Handle);
+		int32_t GetIntegerOutput(FTouchLinkHandle Handle);
+		TouchObject<TEString> GetStringOutput(FTouchLinkHandle Handle);
+		FTouchDATFull GetTableOutput(FTouchLinkHandle Handle) const;
+
+		void SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel) { SetCHOPInputSingleSample(GetLinkHandle(Identifier), CHOPChannel); }
+		void SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP) { SetCHOPInput(GetLinkHandle(Identifier), CHOP); }
+		TFuture<bool> SetTOPInput(const FString& Identifier, const TSharedPtr<FExportedTouchTexture>& Texture, const FTouchEngineInputFrameData& FrameData) { return SetTOPInput(GetLinkHandle(Identifier), Texture, FrameData); }
+		void SetBooleanInput(const FString& Identifier, const bool& Op) { SetBooleanInput(GetLinkHandle(Identifier), Op); }
+		void SetDoubleInput(const FString& Identifier, const TArray<double>& Op) { SetDoubleInput(GetLinkHandle(Identifier), Op); }
+		void SetIntegerInput(const FString& Identifier, const TArray<int32_t>& Op) { SetIntegerInput(GetLinkHandle(Identifier), Op); }
+		void SetStringInput(const FString& Identifier, const char*& Op) { SetStringInput(GetLinkHandle(Identifier), Op); }
+		void SetTableInput(const FString& Identifier, const FTouchDATFull& Op) { SetTableInput(GetLinkHandle(Identifier), Op); }
+
+		void SetCHOPInputSingleSample(FTouchLinkHandle Handle, const FTouchEngineCHOPChannel& CHOPChannel);
+		void SetCHOPInput(FTouchLinkHandle Handle, const FTouchEngineCHOP& CHOP);
+		TFuture<bool> SetTOPInput(FTouchLinkHandle Handle, const TSharedPtr<FExportedTouchTexture>& Texture, const FTouchEngineInputFrameData& FrameData);
+		void SetBooleanInput(FTouchLinkHandle Handle, const bool& Op);
+		void SetDoubleInput(FTouchLinkHandle Handle, const TArray<double>& Op);
+		void SetIntegerInput(FTouchLinkHandle Handle, const TArray<int32_t>& Op);
+		void SetStringInput(FTouchLinkHandle Handle, const char*& Op);
+		void SetTableInput(FTouchLinkHandle Handle, const FTouchDATFull& Op);
 
 		/** Sets in which frame a TouchEngine Parameter was last updated. This should come from a LinkValue Callback */
 		void SetFrameLastUpdatedForParameter(const FString& Identifier, int64 FrameID);
@@ -98,8 +140,8 @@ namespace UE::TouchEngine
 		TSharedPtr<FTouchResourceProvider> ResourceProvider;
 		TSharedPtr<FTouchErrorLog> ErrorLog;
 
-		TMap<FString, FTouchEngineCHOPChannel> CHOPChannelOutputs;
-		TMap<FString, FTouchEngineCHOP> CHOPOutputs;
+		/** The last float buffer received for each CHOP output, used to get the channel names */
+		TMap<FString, FTouchEngineCHOPView> CHOPOutputs;
 		TMap<FName, TouchObject<TETexture>> TOPInputs;
 		FCriticalSection TOPInputsLock;
 		TMap<FName, UTexture2D*> TOPOutputs;
@@ -108,16 +150,51 @@ namespace UE::TouchEngine
 		/** The FrameID the parameters were last updated */
 		TMap<FString, int64> LastFrameParameterUpdated; //todo: could this be a FName? we would need more guarantees on what names can be given to TouchEngine parameters to ensure no clashes
 
+		struct FCachedLinkInfo
+		{
+			FString Identifier;
+			/** The identifier converted once, to be passed to the TouchEngine API */
+			TArray<ANSICHAR> IdentifierAnsi;
+			/** The last TELinkInfo returned by TEInstanceLinkGetInfo. Null if it was never queried or if it was invalidated */
+			TouchObject<TELinkInfo> LinkInfo;
+			/** Increased every time LinkInfo is invalidated, so a TELinkInfo queried before an invalidation is not cached after it */
+			uint32 Generation = 0;
+			/** For float buffer inputs, the buffer sent on the last frame. It is updated in place and only recreated when the layout changes. Only accessed on GameThread */
+			TouchObject<TEFloatBuffer> InputFloatBuffer;
+			/** The channel names InputFloatBuffer was created with */
+			TArray<FString> InputChannelNames;
+		};
+		/**
+		 * The cached links, indexed by FTouchLinkHandle. Links are only ever added on GameThread so the handles stay valid.
+		 * Identifier and IdentifierAnsi never change once added, so they can be read on GameThread without the lock.
+		 */
+		mutable TArray<FCachedLinkInfo> CachedLinkInfos;
+		mutable TMap<FString, int32> CachedLinkHandles;
+		/** Must be obtained to read or write CachedLinkHandles, or the LinkInfo and Generation of CachedLinkInfos, which can be invalidated from any thread */
+		mutable FCriticalSection CachedLinkInfosLock;
+
+		const FString& GetLinkIdentifier(FTouchLinkHandle Handle) const { return CachedLinkInfos[Handle.Index].Identifier; }
+		const char* GetLinkIdentifierAsCStr(FTouchLinkHandle Handle) const { return CachedLinkInfos[Handle.Index].IdentifierAnsi.GetData(); }
+		/** Returns the cached TELinkInfo of the link, calling TEInstanceLinkGetInfo if it is not cached yet */
+		TEResult GetCachedLinkInfo(FTouchLinkHandle Handle, TouchObject<TELinkInfo>& LinkInfo) const;
+
 		/**
-		 * Helper Function to call TEInstanceLinkGetInfo and take care of common error logging.
-		 * Returns true if TEInstanceLinkGetInfo was successful, as well as the expected scope and type matches.
+		 * Helper Function to get the cached TELinkInfo and take care of common error logging.
+		 * Returns true if the link info was retrieved successfully, as well as the expected scope and type matches.
 		 */
-		bool GetLinkInfo(const FString& Identifier,TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const;
+		bool GetLinkInfo(FTouchLinkHandle Handle, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const;
 		/**
-		 * Helper Function to call TEInstanceLinkGetInfo and take care of common error logging.
-		 * Returns true if TEInstanceLinkGetInfo was successful, as well as the expected scope and type matches.
+		 * Helper Function to get the cached TELinkInfo and take care of common error logging.
+		 * Returns true if the link info was retrieved successfully, as well as the expected scope and type matches.
 		 * This overload does not check for the type, if multiple types can be specified for example
 		 */
-		bool GetLinkInfo(const FString& Identifier,TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, const FName& FunctionName) const;
+		bool GetLinkInfo(FTouchLinkHandle Handle, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, const FName& FunctionName) const;
+
+		/**
+		 * Copies the given channels into the float buffer kept for the input link and sends it to TouchEngine.
+		 * The buffer is only recreated when the number of channels, the number of samples or the channel names differ from the previous call.
+		 * NamedChannels is only used for the channel names and can be empty if the channels are unnamed.
+		 */
+		void SendFloatBufferInput(FTouchLinkHandle Handle, TArrayView<const float*> DataPointers, int32 Capacity, TConstArrayView<FTouchEngineCHOPChannel> NamedChannels, const FName& FunctionName);
 	};
 }
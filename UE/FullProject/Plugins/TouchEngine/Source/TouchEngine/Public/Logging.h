@@ -19,3 +19,18 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogTouchEngine, Display, All)
 DEFINE_LOG_CATEGORY_STATIC(LogTouchEngineTECalls, Error, All)
+
+/**
+ * When enabled, the calls made to the TouchEngine C API are logged in LogTouchEngineTECalls (which is suppressed by default and needs to be raised to Log or Verbose at runtime).
+ * When disabled, UE_LOG_TE_CALL expands to nothing so neither the logging nor the evaluation of its arguments are compiled in.
+ * Disabled by default in Shipping and Test builds, and can be overriden by defining it in the Build.cs of the project.
+ */
+#ifndef WITH_TOUCHENGINE_TE_CALL_LOGGING
+#define WITH_TOUCHENGINE_TE_CALL_LOGGING !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+#if WITH_TOUCHENGINE_TE_CALL_LOGGING
+#define UE_LOG_TE_CALL(Verbosity, Format, ...) UE_LOG(LogTouchEngineTECalls, Verbosity, Format, ##__VA_ARGS__)
+#else
+#define UE_LOG_TE_CALL(Verbosity, Format, ...)
+#endif
@@ -0,0 +1,191 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Util/TouchBucketedPool.h"
+
+namespace UE::TouchEngine
+{
+	/** The state of a texture owned by a TTouchExportTexturePool */
+	enum class EExportTextureState : uint8
+	{
+		/** Used by a dynamic variable and/or by the current cook */
+		InUse,
+		/** Not used by Unreal anymore, but TouchEngine has not released it yet */
+		WaitingForTouchEngine,
+		/** Can be reused for a texture matching its key */
+		Available,
+		Count
+	};
+
+	/**
+	 * The pooling policy of the exported textures, without any RHI dependency.
+	 * Every texture is stored once with a state tag, and the Available ones are also bucketed by key, so finding a texture to reuse only looks at
+	 * textures of the right description, and the maintenance is a single pass which changes the state tags instead of moving textures between containers.
+	 * The queries about the textures (are they still in use, what is their key...) are made through the Policy passed to Maintenance.
+	 * This class is not thread-safe, the owner is responsible for guarding it.
+	 */
+	template<typename KeyType, typename TextureType>
+	class TTouchExportTexturePool
+	{
+	public:
+		int32 Num() const { return Entries.Num(); }
+		int32 Num(EExportTextureState State) const { return NumPerState[static_cast<uint8>(State)]; }
+
+		/** Adds a newly created texture, which is considered in use until the next call to Maintenance */
+		void AddInUse(const TextureType& Texture)
+		{
+			Entries.Add(FEntry{ Texture, EExportTextureState::InUse });
+			++NumPerState[static_cast<uint8>(EExportTextureState::InUse)];
+		}
+
+		/**
+		 * Returns the oldest Available texture matching the key for which CanBeReused returns true, and marks it as in use.
+		 * @param CanBeReused Called with a const TextureType&
+		 */
+		template<typename PredicateType>
+		TOptional<TextureType> AcquireAvailable(const KeyType& Key, PredicateType CanBeReused)
+		{
+			const TOptional<int32> EntryIndex = AvailableEntries.RemoveOldestInBucket(Key, [this, &CanBeReused](const int32 Index)
+			{
+				return CanBeReused(Entries[Index].Texture);
+			});
+			if (!EntryIndex)
+			{
+				return {};
+			}
+			SetState(*EntryIndex, EExportTextureState::InUse);
+			return Entries[*EntryIndex].Texture;
+		}
+
+		/**
+		 * Updates the state of every texture and trims the Available textures down to PoolSize, evicting the oldest first.
+		 * @param Policy Must implement:
+		 *   bool IsInUse(const TextureType&) which returns true while a texture is used by a dynamic variable or by the current cook,
+		 *   void OnNoLongerInUse(TextureType&) which is called once when a texture stops being in use,
+		 *   bool CanBeReused(const TextureType&) which returns true once TouchEngine is done with a texture,
+		 *   TOptional<KeyType> GetKey(const TextureType&) which returns the key of a texture that can be reused.
+		 * @return The evicted textures, which are not owned by the pool anymore and need to be released by the caller
+		 */
+		template<typename PolicyType>
+		TArray<TextureType> Maintenance(int32 PoolSize, PolicyType& Policy)
+		{
+			TArray<int32> UnhealthyAvailableEntries;
+			for (auto It = Entries.CreateIterator(); It; ++It)
+			{
+				const int32 EntryIndex = It.GetIndex();
+				FEntry& Entry = *It;
+				switch (Entry.State)
+				{
+				case EExportTextureState::InUse:
+					if (!Policy.IsInUse(Entry.Texture))
+					{
+						Policy.OnNoLongerInUse(Entry.Texture);
+						SetState(EntryIndex, EExportTextureState::WaitingForTouchEngine);
+						TryMakeAvailable(EntryIndex, Policy);
+					}
+					break;
+				case EExportTextureState::WaitingForTouchEngine:
+					TryMakeAvailable(EntryIndex, Policy);
+					break;
+				case EExportTextureState::Available:
+					if (!ensure(Policy.CanBeReused(Entry.Texture)))
+					{
+						UnhealthyAvailableEntries.Add(EntryIndex);
+					}
+					break;
+				default:
+					checkNoEntry();
+				}
+			}
+
+			if (!UnhealthyAvailableEntries.IsEmpty())
+			{
+				AvailableEntries.RemoveAll([&UnhealthyAvailableEntries](const int32 EntryIndex) { return UnhealthyAvailableEntries.Contains(EntryIndex); });
+				for (const int32 EntryIndex : UnhealthyAvailableEntries)
+				{
+					SetState(EntryIndex, EExportTextureState::InUse);
+				}
+			}
+
+			TArray<TextureType> EvictedTextures;
+			while (AvailableEntries.Num() > FMath::Max(PoolSize, 0))
+			{
+				const int32 EntryIndex = AvailableEntries.RemoveOldest(); // we remove the oldest first as they have been here the longest
+				EvictedTextures.Add(Entries[EntryIndex].Texture);
+				RemoveEntry(EntryIndex);
+			}
+			return EvictedTextures;
+		}
+
+		/** Removes every texture from the pool and returns them, to be released by the caller */
+		TArray<TextureType> Empty()
+		{
+			TArray<TextureType> Textures;
+			Textures.Reserve(Entries.Num());
+			for (const FEntry& Entry : Entries)
+			{
+				Textures.Add(Entry.Texture);
+			}
+			Entries.Empty();
+			AvailableEntries.Empty();
+			FMemory::Memzero(NumPerState);
+			return Textures;
+		}
+
+	private:
+		struct FEntry
+		{
+			TextureType Texture;
+			EExportTextureState State;
+		};
+
+		/** Every texture owned by the pool. The indices are stable, which allows AvailableEntries to reference them */
+		TSparseArray<FEntry> Entries;
+		/** The indices in Entries of the Available textures, bucketed by key and kept in the order they became available */
+		TTouchBucketedPool<KeyType, int32> AvailableEntries;
+		int32 NumPerState[static_cast<uint8>(EExportTextureState::Count)] = {};
+
+		void SetState(int32 EntryIndex, EExportTextureState NewState)
+		{
+			FEntry& Entry = Entries[EntryIndex];
+			--NumPerState[static_cast<uint8>(Entry.State)];
+			++NumPerState[static_cast<uint8>(NewState)];
+			Entry.State = NewState;
+		}
+
+		template<typename PolicyType>
+		void TryMakeAvailable(int32 EntryIndex, PolicyType& Policy)
+		{
+			const TextureType& Texture = Entries[EntryIndex].Texture;
+			if (Policy.CanBeReused(Texture))
+			{
+				if (const TOptional<KeyType> Key = Policy.GetKey(Texture))
+				{
+					SetState(EntryIndex, EExportTextureState::Available);
+					AvailableEntries.Add(*Key, int32(EntryIndex));
+				}
+			}
+		}
+
+		void RemoveEntry(int32 EntryIndex)
+		{
+			--NumPerState[static_cast<uint8>(Entries[EntryIndex].State)];
+			Entries.RemoveAt(EntryIndex);
+		}
+	};
+}
@@ -16,6 +16,7 @@
 
 #include "CoreMinimal.h"
 #include "ExportedTouchTexture.h"
+#include "TouchExportTexturePool.h"
 #include "Util/TaskSuspender.h"
 
 class FRHICommandListImmediate;
@@ -38,7 +39,7 @@ namespace UE::TouchEngine
 		virtual ~FTouchTextureExporter()
 		{
 			checkf(
-				CachedInputTextures.IsEmpty(),
+				TexturePool.Num() == 0,
 				TEXT("ReleaseTextures was either not called or did not clean up the exported textures correctly.")
 			);
 		}
@@ -121,12 +122,41 @@ namespace UE::TouchEngine
 		/** Release the texture, ensuring it has been released by TouchEngine before we let it be destroyed */
 		void ReleaseTexture(TSharedRef<FExportedTouchTexture>& Texture);
 
-		/** list of input textures that are either used by DynVars and/or used are currently being cooked */
-		TArray<TSharedRef<FTextureData>> CachedInputTextures;
-		/** The Texture Pool of textures not yet available for reuse. Their availability will be checked in TexturePoolMaintenance and they will be moved to the Texture Pool once ready */
-		TArray<TSharedRef<FTextureData>> FutureTexturesToPool;
-		/** The pool of available textures to be reused. Managed and trimmed in TexturePoolMaintenance */
-		TArray<TSharedRef<FTextureData>> TexturePool;
+		/** The description a pooled texture needs to match to receive a copy of a UTexture, see FExportedTouchTexture::CanFitTexture */
+		struct FExportedTexturePoolKey
+		{
+			FIntPoint Size = FIntPoint::ZeroValue;
+			EPixelFormat PixelFormat = PF_Unknown;
+			uint8 NumMips = 0;
+			uint8 NumSamples = 0;
+			bool bIsSRGB = false;
+
+			static TOptional<FExportedTexturePoolKey> FromRHI(const FRHITexture* TextureRHI);
+
+			bool operator==(const FExportedTexturePoolKey& Other) const
+			{
+				return Size == Other.Size && PixelFormat == Other.PixelFormat && NumMips == Other.NumMips && NumSamples == Other.NumSamples && bIsSRGB == Other.bIsSRGB;
+			}
+			friend uint32 GetTypeHash(const FExportedTexturePoolKey& Key)
+			{
+				return HashCombine(GetTypeHash(Key.Size), ::GetTypeHash(static_cast<uint32>(Key.PixelFormat) << 17 | static_cast<uint32>(Key.NumMips) << 9 | static_cast<uint32>(Key.NumSamples) << 1 | static_cast<uint32>(Key.bIsSRGB)));
+			}
+		};
+		/** Answers the queries of the TexturePool about the exported textures */
+		struct FTexturePoolPolicy
+		{
+			TWeakPtr<FTouchResourceProvider> WeakProvider;
+
+			bool IsInUse(const TSharedRef<FTextureData>& TextureData) const;
+			void OnNoLongerInUse(TSharedRef<FTextureData>& TextureData) const;
+			bool CanBeReused(const TSharedRef<FTextureData>& TextureData) const { return TextureData->CanBeReused(); }
+			TOptional<FExportedTexturePoolKey> GetKey(const TSharedRef<FTextureData>& TextureData) const;
+		};
+		/**
+		 * Every texture created by this exporter, tagged with whether they are used by DynVars or the current cook, waiting for TouchEngine to release them,
+		 * or available to be reused. Managed and trimmed in TexturePoolMaintenance
+		 */
+		TTouchExportTexturePool<FExportedTexturePoolKey, TSharedRef<FTextureData>> TexturePool;
 
 		/** Tracks the tasks of releasing textures. */
 		FTaskSuspender PendingTextureReleases;
@@ -0,0 +1,52 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "Engine/Texture2D.h"
+#include "TouchImportedTexture2D.generated.h"
+
+namespace UE::TouchEngine
+{
+	struct FTextureMetaData;
+}
+
+/**
+ * The UTexture2D created for a TOP output imported from TouchEngine.
+ * Its content lives in an RHI texture created and filled on the render thread before this object existed, and every resource it creates adopts this RHI,
+ * so a later call to UpdateResource (changing a property in the editor, for example) keeps the imported content instead of replacing it with an empty texture.
+ */
+UCLASS(Transient, NotBlueprintable, NotBlueprintType)
+class TOUCHENGINE_API UTouchImportedTexture2D : public UTexture2D
+{
+	GENERATED_BODY()
+public:
+
+	/** Creates a transient texture described by Metadata which wraps ImportedTextureRHI. Its resource still needs to be created and initialised, see InitImportedResource_GameThread */
+	static UTouchImportedTexture2D* Create(const UE::TouchEngine::FTextureMetaData& Metadata, FTextureRHIRef ImportedTextureRHI, FName Name);
+
+	/** Creates the resource adopting the imported RHI and enqueues its initialisation. Unlike UpdateResource, this also works when FApp::CanEverRender is false (with -nullrhi for example) */
+	void InitImportedResource_GameThread();
+
+	//~ Begin UTexture Interface
+	virtual FTextureResource* CreateResource() override;
+	//~ End UTexture Interface
+
+private:
+	/** The RHI texture the imports are copied into, adopted by every resource of this texture */
+	FTextureRHIRef ImportedTextureRHI;
+};
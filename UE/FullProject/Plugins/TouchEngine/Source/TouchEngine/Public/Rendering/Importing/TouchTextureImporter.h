@@ -18,9 +18,12 @@
 #include "ITouchImportTexture.h"
 
 #include "Util/TaskSuspender.h"
+#include "Util/TouchBucketedPool.h"
 
 #include "Async/TaskGraphInterfaces.h"
 
+#include <atomic>
+
 class FRHICommandListImmediate;
 class FRHICommandList;
 class FRHICommandListBase;
@@ -74,6 +77,13 @@ namespace UE::TouchEngine
 		{
 			RemoveUnusedAliveTextures();
 		}
+
+		/**
+		 * The UTexture2D of a new texture is created by a GameThread task, after its copy has run on the render thread, so its import usually resolves after the cook result is processed.
+		 * This waits for the copies already enqueued and creates their UTexture2D right away, which resolves the imports of a finished cook before its outputs are read.
+		 * Used in Synchronized mode where the outputs must be the ones of this frame. In the other modes, the GameThread task links them whenever it runs, up to a frame after the cook result.
+		 */
+		void FlushPendingTextureWrappers_GameThread();
 	
 	protected:
 
@@ -106,9 +116,32 @@ namespace UE::TouchEngine
 			int64 PooledFrameID;
 			TObjectPtr<UTexture2D> UETexture;
 		};
+		/** The description a pooled texture needs to match to receive an imported texture, see CanCopyIntoUTexture */
+		struct FImportedTexturePoolKey
+		{
+			uint32 SizeX = 0;
+			uint32 SizeY = 0;
+			EPixelFormat PixelFormat = PF_Unknown;
+			bool bIsSRGB = false;
+
+			static FImportedTexturePoolKey FromMetaData(const FTextureMetaData& MetaData) { return { MetaData.SizeX, MetaData.SizeY, MetaData.PixelFormat, MetaData.IsSRGB }; }
+			static FImportedTexturePoolKey FromTexture(const UTexture2D* Texture);
+
+			bool operator==(const FImportedTexturePoolKey& Other) const
+			{
+				return SizeX == Other.SizeX && SizeY == Other.SizeY && PixelFormat == Other.PixelFormat && bIsSRGB == Other.bIsSRGB;
+			}
+			friend uint32 GetTypeHash(const FImportedTexturePoolKey& Key)
+			{
+				return HashCombine(HashCombine(::GetTypeHash(Key.SizeX), ::GetTypeHash(Key.SizeY)), ::GetTypeHash(static_cast<uint32>(Key.PixelFormat) << 1 | static_cast<uint32>(Key.bIsSRGB)));
+			}
+		};
 		FCriticalSection TexturePoolMutex;
-		/** The texture pool itself, keeping hold of the temporary UTexture created to reuse them when an import is needed, saving the need to go back to GameThread to create a new one */
-		TArray<FImportedTexturePoolData> TexturePool;
+		/**
+		 * The texture pool itself, keeping hold of the temporary UTexture created to reuse them when an import is needed, saving the need to go back to GameThread to create a new one.
+		 * Textures are bucketed by description so an import only looks at the textures it could be copied into, and kept in the order they were pooled so the oldest are evicted first.
+		 */
+		TTouchBucketedPool<FImportedTexturePoolKey, FImportedTexturePoolData> TexturePool;
 
 		FCriticalSection KeepTexturesAliveMutex;
 		/** Array of textures to keep alive while we are copying them */
@@ -122,8 +155,30 @@ namespace UE::TouchEngine
 		 */
 		void ExecuteLinkTextureRequest_AnyThread(TPromise<FTouchTextureImportResult>&& Promise, const FTouchImportParameters& LinkParams, const TSharedPtr<FTouchFrameCooker>& FrameCooker);
 		
-		UTexture2D* GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams, bool& bOutAccessRHIViaReferenceTexture);
 		UTexture2D* FindPoolTextureMatchingMetadata(const FTextureMetaData& TETextureMetadata, const FTouchEngineInputFrameData& FrameData);
+
+		/** A texture imported into an RHI created on the render thread, waiting for its UTexture2D to be created on GameThread */
+		struct FPendingTextureWrapper
+		{
+			FName Identifier;
+			FTouchEngineInputFrameData FrameData;
+			FTextureMetaData TETextureMetadata;
+			FTextureRHIRef TextureRHI;
+			/** The promise of the import, only set once the UTexture2D is bound to TextureRHI so the texture is never used before it is initialised */
+			TPromise<FTouchTextureImportResult> Promise;
+		};
+		FCriticalSection PendingTextureWrappersMutex;
+		/** The textures waiting for their UTexture2D. A single GameThread task is scheduled when the first one is added, and creates them all at once */
+		TArray<FPendingTextureWrapper> PendingTextureWrappers;
+		/** The imports which need a new texture and whose copy has not run yet on the render thread, see FlushPendingTextureWrappers_GameThread */
+		std::atomic<int32> NumNewTexturesBeingCopied = 0;
+
+		/** Creates the RHI texture an import is copied into when no pooled texture matches. The UTexture2D wrapping it is created later, see CreatePendingTextureWrappers_GameThread */
+		static FTextureRHIRef CreateDestinationTextureRHI_RenderThread(FRHICommandListBase& RHICmdList, const FTextureMetaData& TETextureMetadata, const FName& Identifier);
+		void EnqueuePendingTextureWrapper_RenderThread(FPendingTextureWrapper&& PendingTextureWrapper);
+		void CreatePendingTextureWrappers_GameThread();
+		/** Creates the promise to fill with the texture previously linked to the parameter, which will be put back in the pool */
+		TSharedPtr<TPromise<UTexture2D*>> MakePreviousTextureToBePooledPromise(int64 FrameID);
 	};
 }
 
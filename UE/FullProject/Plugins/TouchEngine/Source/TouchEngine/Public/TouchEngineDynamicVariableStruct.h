@@ -21,6 +21,7 @@
 #include "Rendering/Exporting/ExportedTouchTexture.h"
 #include "Util/TouchHelpers.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchValueArena.h"
 #include "TouchEngineDynamicVariableStruct.generated.h"
 
 struct FTouchEngineInputFrameData;
@@ -39,6 +40,8 @@ class UTouchEngineComponentBase;
 class UTouchEngineInfo;
 enum class ECheckBoxState : uint8;
 struct FTouchEngineCHOP;
+struct FTouchEngineCHOPView;
+struct FTouchDATView;
 
 /*
 * possible intents of dynamic variables based on TEScope
@@ -228,12 +231,14 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 
 	FTouchEngineDynamicVariableStruct() = default;
 	~FTouchEngineDynamicVariableStruct();
-	FTouchEngineDynamicVariableStruct(FTouchEngineDynamicVariableStruct&& Other) noexcept { Copy(&Other); }
+	FTouchEngineDynamicVariableStruct(FTouchEngineDynamicVariableStruct&& Other) noexcept { Move(Other); }
 	FTouchEngineDynamicVariableStruct(const FTouchEngineDynamicVariableStruct& Other) { Copy(&Other); }
-	FTouchEngineDynamicVariableStruct& operator=(FTouchEngineDynamicVariableStruct&& Other) noexcept { Copy(&Other); return *this; }
+	FTouchEngineDynamicVariableStruct& operator=(FTouchEngineDynamicVariableStruct&& Other) noexcept { if (this != &Other) { Move(Other); } return *this; }
 	FTouchEngineDynamicVariableStruct& operator=(const FTouchEngineDynamicVariableStruct& Other) { Copy(&Other); return *this; }
 	
 	void Copy(const FTouchEngineDynamicVariableStruct* Other);
+	/** Takes ownership of the value of Other without copying it. Other is left without any value */
+	void Move(FTouchEngineDynamicVariableStruct& Other);
 
 	// Display name of variable
 	UPROPERTY(VisibleAnywhere, Category = "Properties")
@@ -274,8 +279,6 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	UPROPERTY(Transient)
 	bool bReuseExistingTexture_DEPRECATED = false;
 
-	// Pointer to variable value
-	void* Value = nullptr;
 	size_t Size = 0; // todo: Is the size necessary? Almost never used
 
 	/* The minimum value this variable should be able to have. Retrieved from TELinkValueMinimum and is equivalent to the clamp min in TouchDesigner */
@@ -318,18 +321,21 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 		return Values.IsValidIndex(Index) ? Values[Index] : T {};
 	}
 	
+	/** Returns true if a value was set, even if it is an empty array. The value itself is only accessible through the getters below */
+	bool HasValue() const { return ValueNumBytes != INDEX_NONE || DATValue.IsValid(); }
 	bool GetValueAsBool() const;
 	int GetValueAsInt() const;
 	int GetValueAsIntIndexed(int Index) const;
-	int* GetValueAsIntArray() const;
+	/** Returns the values of an int array. They may be shared with copies of this variable, so they must not be modified */
+	const int* GetValueAsIntArray() const;
 	TArray<int> GetValueAsIntTArray() const;
 	double GetValueAsDouble() const;
 	double GetValueAsDoubleIndexed(int Index) const;
-	double* GetValueAsDoubleArray() const;
+	const double* GetValueAsDoubleArray() const;
 	TArray<double> GetValueAsDoubleTArray() const;
 	float GetValueAsFloat() const;
 	double GetValueAsFloatIndexed(int Index) const;
-	float* GetValueAsFloatArray() const;
+	const float* GetValueAsFloatArray() const;
 	TArray<float> GetValueAsFloatTArray() const;
 	FColor GetValueAsColor() const { return GetValueAsLinearColor().QuantizeRound(); }
 	FLinearColor GetValueAsLinearColor() const;
@@ -341,7 +347,27 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	UDEPRECATED_TouchEngineCHOPMinimal* GetValueAsCHOP_DEPRECATED() const;
 	FTouchEngineCHOP GetValueAsCHOP() const;
 	FTouchEngineCHOP GetValueAsCHOP(const UTouchEngineInfo* EngineInfo) const;
+	/**
+	 * Reads a single sample of the CHOP stored in this variable, without copying the rest of the CHOP.
+	 * @param SampleIndex The index of the sample in the Channel, or INDEX_NONE to get the latest sample
+	 * @return True if this is a CHOP variable holding a value and the Channel and the sample were found
+	 */
+	bool GetCHOPSample(int32 ChannelIndex, int32 SampleIndex, float& OutValue) const;
+	/**
+	 * Returns the value as a UTouchEngineDAT. The object is created on the first call after the value changed, and returned again by the next calls,
+	 * so it must not be modified.
+	 */
 	UTouchEngineDAT* GetValueAsDAT() const;
+	/** The number of rows of the DAT stored in this variable, or 0 if it does not hold a string array. A string array set with SetValue(const TArray<FString>&) has a single column */
+	int32 GetDATNumRows() const;
+	int32 GetDATNumColumns() const;
+	/** Returns the cell of the DAT stored in this variable without converting it, or an empty view if the cell does not exist. The view is only valid until the value changes */
+	FUtf8StringView GetDATCell(int32 Row, int32 Column) const;
+	/**
+	 * Returns the cells of a row of the DAT stored in this variable, or an empty array if the row does not exist. The row is converted on the first call
+	 * and kept until the value changes or another row is requested, so reading the cells of the same row again does not convert them again.
+	 */
+	const TArray<FString>& GetDATRow(int32 Row) const;
 
 	/** Return a value clamped by ClampMin and ClampMax if available*/
 	template <typename T>
@@ -404,16 +430,25 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	void SetValue(const FLinearColor& InValue) { SetValue(TArray<float>{InValue.R, InValue.G, InValue.B, InValue.A});}
 	void SetValue(const FVector& InValue) { SetValue(TArray<double>{InValue.X, InValue.Y, InValue.Z});}
 	void SetValue(const FTouchEngineCHOP& InValue);
+	/** Copies the channels of the view once, without going through an intermediate FTouchEngineCHOP outside of the editor */
+	void SetValue(const FTouchEngineCHOPView& InValue);
 	void SetValueAsCHOP(const TArray<float>& InValue, int NumChannels, int NumSamples);
 	void SetValueAsCHOP(const TArray<float>& InValue, const TArray<FString>& InChannelNames);
 	void SetValue(const UTouchEngineDAT* InValue);
 	void SetValueAsDAT(const TArray<FString>& InValue, int NumRows, int NumColumns);
+	/** Copies the UTF-8 cells of the view once, without converting them to FString outside of the editor */
+	void SetValue(const FTouchDATView& InValue);
 	void SetValue(const FString& InValue);
 	void SetValue(const TArray<FString>& InValue);
 	void SetValue(UTexture* InValue);
 	void SetValue(const FTouchEngineDynamicVariableStruct* Other);
 	
 	void SetFrameLastUpdatedFromNextCookFrame(const UTouchEngineInfo* EngineInfo);
+	/**
+	 * Sets FrameLastUpdated to the given frame if the value changed since it was last stamped, or if it was never stamped.
+	 * Setting a variable to the value it already has does not change it, so it is not sent again on the next cook.
+	 */
+	void SetFrameLastUpdatedIfValueChanged(int64 FrameID);
 
 	bool HasSameValue(const FTouchEngineDynamicVariableStruct* Other) const;
 	template <typename T>
@@ -437,6 +472,8 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	
 	/** Function called when serializing this struct to a FArchive */
 	bool Serialize(FArchive& Ar);
+	/** Serializes the data retrieved from TouchEngine when the tox file is loaded which is not part of Serialize: the default value, the ranges and the dropdown entries */
+	void SerializeMetadata(FArchive& Ar);
 	/** Function called when copying the object, exporting the Value as string */
 	FString ExportValue(const EPropertyPortFlags PortFlags = PPF_Delimited) const;
 	/**
@@ -652,6 +689,69 @@ private:
 	};
 	TArray<FDropDownEntry> DropDownData;
 
+	/** Values of up to this many bytes, like scalars, vectors, short strings and the texture pointer, are stored in InlineValue and never allocate */
+	static constexpr int32 InlineValueCapacity = 32;
+	/**
+	 * The value when it fits inline. Only plain bytes are stored here and never a pointer to them, so the struct stays valid when TArray and TMap
+	 * relocate it without calling Move.
+	 */
+	uint64 InlineValue[InlineValueCapacity / sizeof(uint64)] = {};
+	/**
+	 * The arena holding the value when it does not fit inline. It is shared with the copies of this variable and with the other variables of the
+	 * container it was packed by, so it is never modified in place once shared, see GetWritableValueData.
+	 */
+	TRefCountPtr<UE::TouchEngine::FTouchValueArena> ValueArena;
+	/** The offset of the value in ValueArena */
+	int32 ValueOffset = 0;
+	/** The number of bytes of the value, or INDEX_NONE if there is no value */
+	int32 ValueNumBytes = INDEX_NONE;
+	/** The number of strings of a string array or DAT. Such a value starts with a table of the offsets of each null-terminated string in the value */
+	int32 ValueNumStrings = 0;
+	/**
+	 * The table of a DAT output set by SetValue(const FTouchDATView&), in place of a value in InlineValue or ValueArena. The table is not modified once
+	 * given by TouchEngine, so it is shared with the copies of this variable, and its cells are only converted when they are read.
+	 */
+	FTouchDATView DATValue;
+
+	/** Returns the value memory, or nullptr if there is no value or the value is DATValue. Only valid until the value changes */
+	const void* GetValueData() const;
+	/**
+	 * Makes room for a value of NumBytes, inline or in a new arena, and returns its memory which is not initialized. The previous value must have been cleared.
+	 * A new arena is made of a single allocation and not shared yet, so the memory can be filled right away.
+	 */
+	void* AllocateValue(int32 NumBytes);
+	/**
+	 * Returns the value memory to be modified in place, or nullptr if there is no value. If the arena of the value is shared, the value is first copied
+	 * to an arena of its own so the copies of this variable keep their value. Counts as a value change.
+	 */
+	void* GetWritableValueData();
+	/** Allocates the NumChannels * NumSamples floats of a CHOP, one Channel after the other */
+	float* AllocateCHOPValue(int32 NumChannels, int32 NumSamples);
+	/** Allocates a table of the offsets of NumStrings strings followed by NumChars for the strings, and returns the table. See GetValueString */
+	uint32* AllocateStringArrayValue(int32 NumStrings, int32 NumChars);
+	/** Allocates and fills the value with the null-terminated ANSI version of each string */
+	void SetStringArrayValue(const TArray<FString>& Strings);
+	/** Returns the null-terminated string at the given index of a string array or DAT value */
+	const char* GetValueString(int32 Index) const;
+	/** Replaces the value of this struct by the value of Other, sharing its arena if it has one. Does not handle Textures */
+	void CopyValueMemory(const FTouchEngineDynamicVariableStruct& Other);
+	/** Returns true if the value holds exactly the given NumBytes of plain memory. Used by SetValue to skip values which did not change */
+	bool HasSameValueMemory(const void* Data, int32 NumBytes) const;
+	/** Returns the number of bytes the value would use in an arena, or 0 if it is inline or there is no value. Used to pack the values of a container */
+	int32 GetValueArenaSize() const;
+	/** Copies the value to the given arena, which must have room for it, and references it from there. Used to pack the values of a container */
+	void MoveValueToArena(const TRefCountPtr<UE::TouchEngine::FTouchValueArena>& Arena);
+
+	/** Incremented by Clear, which every SetValue changing the value goes through */
+	uint32 ValueGeneration = 0;
+	/** The object last returned by GetValueAsDAT, reset by Clear. Not owned, so it is created again if it was garbage collected */
+	mutable TWeakObjectPtr<UTouchEngineDAT> CachedDAT;
+	/** The index of the row last converted by GetDATRow, or INDEX_NONE. Reset with CachedDATRow by Clear, and not copied with the value */
+	mutable int32 CachedDATRowIndex = INDEX_NONE;
+	mutable TArray<FString> CachedDATRow;
+	/** The ValueGeneration at the time FrameLastUpdated was last set by SetFrameLastUpdatedIfValueChanged */
+	uint32 StampedValueGeneration = 0;
+
 	// sets void pointer to UObject pointer, does not copy memory
 	void SetValue(UObject* InValue, size_t InSize);
 	void Clear();
@@ -773,6 +873,42 @@ DECLARE_MULTICAST_DELEGATE(FTouchOnReset);
 // Callback for when the TouchEngine instance fails to load a tox file
 DECLARE_MULTICAST_DELEGATE_OneParam(FTouchOnLoadFailed, const FString&);
 
+/**
+ * A cached reference to a variable of a FTouchEngineDynamicVariableContainer, used by the Blueprint nodes to only look up their variable by name on their first call.
+ * The handle becomes stale when the variables of the container are reloaded, like when a new tox is loaded, in which case the variable needs to be looked up by name again.
+ * It also remembers the name it was looked up with, as the name pin of a node can be linked and change between calls.
+ */
+USTRUCT(BlueprintType, meta = (BlueprintInternalUseOnly = "true"))
+struct TOUCHENGINE_API FTouchEngineDynamicVariableHandle
+{
+	GENERATED_BODY()
+
+	bool IsSet() const { return Generation != 0; }
+	void Reset() { *this = FTouchEngineDynamicVariableHandle(); }
+
+	/** Returns true if the handle was made for the variable found with the given name and prefix (case-sensitive, like the lookup) */
+	bool IsFor(const FString& InVarName, const FString& InPrefix) const
+	{
+		return VarName.Equals(InVarName, ESearchCase::CaseSensitive) && Prefix.Equals(InPrefix, ESearchCase::CaseSensitive);
+	}
+	void SetLookupName(const FString& InVarName, const FString& InPrefix)
+	{
+		VarName = InVarName;
+		Prefix = InPrefix;
+	}
+
+private:
+	friend struct FTouchEngineDynamicVariableContainer;
+
+	/** The index of the variable in the container, Inputs first */
+	int32 LookupIndex = INDEX_NONE;
+	/** The generation of the lookup of the container when this handle was made. 0 if the handle is not set */
+	uint32 Generation = 0;
+	/** The name and prefix the variable was looked up with, see SetLookupName */
+	FString VarName;
+	FString Prefix;
+};
+
 /**
  * Holds all input and output variables for an instance of the "UTouchEngineComponentBase" component class.
  * Also holds callbacks from the TouchEngine to get info about when parameters are loaded
@@ -800,13 +936,87 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableContainer
 	void SetupForFirstCook(const TSharedPtr<UE::TouchEngine::FTouchResourceProvider>& TouchResourceProvider);
 
 	/**
-	 * This function will return a new FTouchEngineDynamicVariableContainer with a copy of the inputs that have changed this frame, and no outputs.
+	 * Returns a copy of the inputs that have changed for the given frame, keyed by identifier.
+	 * An input is considered changed when its FrameLastUpdated matches the frame, so nothing is allocated or copied when no input changed.
+	 * FrameLastUpdated is only moved when the value actually changed, see FTouchEngineDynamicVariableStruct::SetFrameLastUpdatedIfValueChanged.
 	 * This will also reset any Pulse variable to their default values
 	 */
 	TMap<FString, FTouchEngineDynamicVariableStruct> CopyInputsForCook(int64 CurrentFrameID);
 	
+	/** Returns the variable with the given VarName (case-insensitive), or nullptr if none or more than one variable have this name */
 	FTouchEngineDynamicVariableStruct* GetDynamicVariableByName(const FString& VarName);
+	/** Returns the first variable, Inputs first, which VarIdentifier, VarLabel or VarName is equal to the given string (case-sensitive) */
 	FTouchEngineDynamicVariableStruct* GetDynamicVariableByIdentifier(const FString& VarIdentifier);
+
+	/**
+	 * Marks the lookup index used by GetDynamicVariableByName and GetDynamicVariableByIdentifier as outdated, to be rebuilt on next use.
+	 * Must be called when the variables are modified in place without reallocating DynVars_Input or DynVars_Output, like after an undo.
+	 */
+	void InvalidateLookup() { IndexedNumInputs = INDEX_NONE; }
+	/**
+	 * Invalidates the lookup once loaded, as loading can replace the variables without reallocating DynVars_Input or DynVars_Output.
+	 * Also packs the loaded values, see PackValues.
+	 */
+	void PostSerialize(const FArchive& Ar);
+	/**
+	 * Moves the values of all the variables which do not fit inline, like arrays, CHOPs and strings, to a single arena shared by the whole container.
+	 * Called once the variables are loaded, so a container holds one allocation for all its values instead of one per value. Copying the container
+	 * then only adds a reference to the arena, and a variable which is set again gets an arena of its own.
+	 */
+	void PackValues();
+
+	/**
+	 * Returns the variable found by GetDynamicVariableByIdentifier, or else by GetDynamicVariableByName, for the name with the prefix (see GetNameWithPrefix).
+	 * If the Handle was made by a previous call with the same name and prefix and is still valid, the variable it references is returned without any lookup.
+	 * Otherwise the Handle is updated with the found variable. Used by the Blueprint nodes, which keep a Handle each.
+	 */
+	FTouchEngineDynamicVariableStruct* FindDynamicVariable(const FString& VarName, const FString& Prefix, FTouchEngineDynamicVariableHandle& Handle);
+	/**
+	 * Returns the first Output which VarIdentifier, VarLabel or VarName is equal to the name with the prefix (case-sensitive), or else the only Output with this VarName (case-insensitive).
+	 * Unlike FindDynamicVariable, this does not use or rebuild the lookup, so it can be called on a const container, but it goes through every Output.
+	 */
+	const FTouchEngineDynamicVariableStruct* FindOutput(const FString& VarName, const FString& Prefix) const;
+	/** Returns Prefix + VarName, or VarName if it already starts with a legacy prefix which users were previously required to supply */
+	static FString GetNameWithPrefix(const FString& VarName, const FString& Prefix);
+
+	/** Returns a handle to the given variable of this container which can be passed to GetDynamicVariableByHandle, or an unset handle if the variable is not part of this container */
+	FTouchEngineDynamicVariableHandle MakeHandle(const FTouchEngineDynamicVariableStruct* DynVar);
+	/** Returns the variable referenced by the handle, or nullptr if the handle is not set, was made by another container, or was made before the variables were reloaded */
+	FTouchEngineDynamicVariableStruct* GetDynamicVariableByHandle(const FTouchEngineDynamicVariableHandle& Handle);
+
+private:
+	/** Matches the case-sensitive FString::Equals used to compare the identifiers */
+	struct FCaseSensitiveLookupKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+	{
+		static bool Matches(KeyInitType A, KeyInitType B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(KeyInitType Key) { return FCrc::StrCrc32(*Key); }
+	};
+	/** Value of NameLookup when more than one variable has the same name */
+	static constexpr int32 AmbiguousLookupIndex = -2;
+
+	/** The VarIdentifier, VarLabel and VarName of every variable, mapped to the first matching variable. Indices above DynVars_Input.Num() are Outputs */
+	TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveLookupKeyFuncs> IdentifierLookup;
+	/** The VarName of every variable, case-insensitive */
+	TMap<FString, int32> NameLookup;
+	/** The state of the arrays when the lookup was built. If the arrays are reallocated or resized, the lookup is rebuilt */
+	const FTouchEngineDynamicVariableStruct* IndexedInputsData = nullptr;
+	const FTouchEngineDynamicVariableStruct* IndexedOutputsData = nullptr;
+	int32 IndexedNumInputs = INDEX_NONE;
+	int32 IndexedNumOutputs = INDEX_NONE;
+	/** Unique across all containers and changed every time the lookup is rebuilt, so handles made by another container or before a reload are detected as stale */
+	uint32 LookupGeneration = 0;
+
+	void EnsureLookupIsValid();
+	FTouchEngineDynamicVariableStruct* GetDynamicVariableByLookupIndex(int32 LookupIndex);
+};
+
+template<>
+struct TStructOpsTypeTraits<FTouchEngineDynamicVariableContainer> : public TStructOpsTypeTraitsBase2<FTouchEngineDynamicVariableContainer>
+{
+	enum
+	{
+		WithPostSerialize = true,	// struct has a PostSerialize function which is called after it is serialized
+	};
 };
 
 // Templated function definitions
@@ -1330,14 +1540,14 @@ void FTouchEngineDynamicVariableStruct::HandleValueChanged(T InValue, const UTou
 template <typename T>
 void FTouchEngineDynamicVariableStruct::HandleValueChangedWithIndex(T InValue, int32 Index, const UTouchEngineInfo* EngineInfo)
 {
-	if (!Value)
+	if (!HasValue())
 	{
 		// if the value doesn't exist,
-		Value = new T[Count];
 		Size = sizeof(T) * Count;
+		FMemory::Memzero(AllocateValue(Size), Size);
 	}
 
-	static_cast<T*>(Value)[Index] = InValue;
+	static_cast<T*>(GetWritableValueData())[Index] = InValue;
 	SetFrameLastUpdatedFromNextCookFrame(EngineInfo);
 }
 #endif
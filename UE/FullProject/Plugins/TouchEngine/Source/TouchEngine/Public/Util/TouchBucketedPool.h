@@ -0,0 +1,281 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * A pool of elements grouped in buckets by key, used to reuse textures matching a given description.
+	 * Elements are kept in the order they were added, both across the whole pool and within each bucket, so finding the oldest element of a bucket
+	 * and evicting the oldest element of the pool are done without scanning the other buckets, and removing an element never shifts the others.
+	 * This class does not know anything about the RHI and is not thread-safe, the owner is responsible for guarding it.
+	 */
+	template<typename KeyType, typename ElementType>
+	class TTouchBucketedPool
+	{
+	public:
+		int32 Num() const { return NumElements; }
+		bool IsEmpty() const { return NumElements == 0; }
+		int32 GetNumBuckets() const { return Buckets.Num(); }
+
+		/** Adds the element as the newest element of the pool and of the bucket matching the key */
+		void Add(const KeyType& Key, ElementType&& Element)
+		{
+			const int32 NodeIndex = AllocateNode();
+			FNode& Node = Nodes[NodeIndex];
+			Node.Key = Key;
+			Node.Element.Emplace(MoveTemp(Element));
+
+			LinkAsNewest(NodeIndex, PoolList, &FNode::PoolLink);
+			FList& Bucket = Buckets.FindOrAdd(Key);
+			LinkAsNewest(NodeIndex, Bucket, &FNode::BucketLink);
+			++NumElements;
+		}
+
+		/**
+		 * Removes and returns the oldest element of the bucket matching the key for which Predicate returns true. Elements of other buckets are not visited.
+		 * @param Predicate Called with a const ElementType&, oldest first
+		 */
+		template<typename PredicateType>
+		TOptional<ElementType> RemoveOldestInBucket(const KeyType& Key, PredicateType Predicate)
+		{
+			if (const FList* Bucket = Buckets.Find(Key))
+			{
+				for (int32 NodeIndex = Bucket->Oldest; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].BucketLink.Newer)
+				{
+					if (Predicate(Nodes[NodeIndex].Element.GetValue()))
+					{
+						return RemoveNode(NodeIndex);
+					}
+				}
+			}
+			return {};
+		}
+
+		/** Returns the element which was added first. The pool must not be empty. */
+		const ElementType& GetOldest() const
+		{
+			check(!IsEmpty());
+			return Nodes[PoolList.Oldest].Element.GetValue();
+		}
+
+		/** Removes and returns the element which was added first. The pool must not be empty. */
+		ElementType RemoveOldest()
+		{
+			check(!IsEmpty());
+			return RemoveNode(PoolList.Oldest).GetValue();
+		}
+
+		/** Calls Callable with an ElementType& for every element, oldest first */
+		template<typename CallableType>
+		void ForEach(CallableType Callable)
+		{
+			for (int32 NodeIndex = PoolList.Oldest; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].PoolLink.Newer)
+			{
+				Callable(Nodes[NodeIndex].Element.GetValue());
+			}
+		}
+
+		/** Removes every element for which Predicate returns true when called with an ElementType&, and returns them oldest first */
+		template<typename PredicateType>
+		TArray<ElementType> RemoveAll(PredicateType Predicate)
+		{
+			TArray<ElementType> RemovedElements;
+			for (int32 NodeIndex = PoolList.Oldest; NodeIndex != INDEX_NONE;)
+			{
+				const int32 NextIndex = Nodes[NodeIndex].PoolLink.Newer;
+				if (Predicate(Nodes[NodeIndex].Element.GetValue()))
+				{
+					RemovedElements.Add(RemoveNode(NodeIndex).GetValue());
+				}
+				NodeIndex = NextIndex;
+			}
+			return RemovedElements;
+		}
+
+		/**
+		 * Walks the pool list and every bucket list in both directions, and returns false if a link, a bucket key or an element count does not match.
+		 * Costs a full scan of the pool, so it is only meant for tests and checks.
+		 */
+		bool CheckIntegrity() const
+		{
+			int32 NumInPool = 0;
+			if (!CheckList(PoolList, &FNode::PoolLink, NumInPool, [](const FNode&) { return true; }) || NumInPool != NumElements)
+			{
+				return false;
+			}
+
+			int32 NumInBuckets = 0;
+			for (const TPair<KeyType, FList>& Bucket : Buckets)
+			{
+				int32 NumInBucket = 0;
+				const bool bIsValidBucket = CheckList(Bucket.Value, &FNode::BucketLink, NumInBucket, [&Bucket](const FNode& Node) { return Node.Key == Bucket.Key; });
+				if (!bIsValidBucket || NumInBucket == 0)
+				{
+					return false;
+				}
+				NumInBuckets += NumInBucket;
+			}
+			if (NumInBuckets != NumElements)
+			{
+				return false;
+			}
+
+			int32 NumFreeNodes = 0;
+			for (int32 NodeIndex = FirstFreeNode; NodeIndex != INDEX_NONE && NumFreeNodes <= Nodes.Num(); NodeIndex = Nodes[NodeIndex].PoolLink.Newer)
+			{
+				if (!Nodes.IsValidIndex(NodeIndex) || Nodes[NodeIndex].Element.IsSet())
+				{
+					return false;
+				}
+				++NumFreeNodes;
+			}
+			return NumFreeNodes + NumElements == Nodes.Num();
+		}
+
+		void Empty()
+		{
+			Nodes.Empty();
+			Buckets.Empty();
+			PoolList = FList();
+			FirstFreeNode = INDEX_NONE;
+			NumElements = 0;
+		}
+
+	private:
+		struct FLink
+		{
+			int32 Older = INDEX_NONE;
+			int32 Newer = INDEX_NONE;
+		};
+		struct FList
+		{
+			int32 Oldest = INDEX_NONE;
+			int32 Newest = INDEX_NONE;
+		};
+		struct FNode
+		{
+			/** Unset when the node is free */
+			TOptional<ElementType> Element;
+			KeyType Key;
+			/** Links to the other nodes of the pool, or to the next free node when the node is free */
+			FLink PoolLink;
+			/** Links to the other nodes of the same bucket */
+			FLink BucketLink;
+		};
+
+		/** The storage of the elements. Nodes are reused once their element is removed, so the indices stay stable */
+		TArray<FNode> Nodes;
+		TMap<KeyType, FList> Buckets;
+		FList PoolList;
+		int32 FirstFreeNode = INDEX_NONE;
+		int32 NumElements = 0;
+
+		int32 AllocateNode()
+		{
+			if (FirstFreeNode == INDEX_NONE)
+			{
+				return Nodes.AddDefaulted();
+			}
+			const int32 NodeIndex = FirstFreeNode;
+			FirstFreeNode = Nodes[NodeIndex].PoolLink.Newer;
+			Nodes[NodeIndex].PoolLink = FLink();
+			return NodeIndex;
+		}
+
+		TOptional<ElementType> RemoveNode(int32 NodeIndex)
+		{
+			FNode& Node = Nodes[NodeIndex];
+			Unlink(NodeIndex, PoolList, &FNode::PoolLink);
+			FList& Bucket = Buckets.FindChecked(Node.Key);
+			Unlink(NodeIndex, Bucket, &FNode::BucketLink);
+			if (Bucket.Oldest == INDEX_NONE)
+			{
+				Buckets.Remove(Node.Key);
+			}
+			--NumElements;
+
+			TOptional<ElementType> Element = MoveTemp(Node.Element);
+			Node.Element.Reset();
+			Node.PoolLink.Newer = FirstFreeNode;
+			FirstFreeNode = NodeIndex;
+			return Element;
+		}
+
+		/** Checks the links of the list in both directions and that every node holds an element matching Predicate. Adds the number of nodes of the list to OutNum */
+		template<typename PredicateType>
+		bool CheckList(const FList& List, FLink FNode::* LinkMember, int32& OutNum, PredicateType Predicate) const
+		{
+			int32 Older = INDEX_NONE;
+			int32 NumVisited = 0;
+			for (int32 NodeIndex = List.Oldest; NodeIndex != INDEX_NONE; NodeIndex = (Nodes[NodeIndex].*LinkMember).Newer)
+			{
+				if (!Nodes.IsValidIndex(NodeIndex) || ++NumVisited > Nodes.Num())
+				{
+					return false;
+				}
+				const FNode& Node = Nodes[NodeIndex];
+				if ((Node.*LinkMember).Older != Older || !Node.Element.IsSet() || !Predicate(Node))
+				{
+					return false;
+				}
+				Older = NodeIndex;
+			}
+			OutNum += NumVisited;
+			return List.Newest == Older;
+		}
+
+		void LinkAsNewest(int32 NodeIndex, FList& List, FLink FNode::* LinkMember)
+		{
+			FLink& Link = Nodes[NodeIndex].*LinkMember;
+			Link.Older = List.Newest;
+			Link.Newer = INDEX_NONE;
+			if (List.Newest != INDEX_NONE)
+			{
+				(Nodes[List.Newest].*LinkMember).Newer = NodeIndex;
+			}
+			else
+			{
+				List.Oldest = NodeIndex;
+			}
+			List.Newest = NodeIndex;
+		}
+
+		void Unlink(int32 NodeIndex, FList& List, FLink FNode::* LinkMember)
+		{
+			FLink& Link = Nodes[NodeIndex].*LinkMember;
+			if (Link.Older != INDEX_NONE)
+			{
+				(Nodes[Link.Older].*LinkMember).Newer = Link.Newer;
+			}
+			else
+			{
+				List.Oldest = Link.Newer;
+			}
+			if (Link.Newer != INDEX_NONE)
+			{
+				(Nodes[Link.Newer].*LinkMember).Older = Link.Older;
+			}
+			else
+			{
+				List.Newest = Link.Older;
+			}
+			Link = FLink();
+		}
+	};
+}
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include <atomic>
 
 DECLARE_STATS_GROUP(TEXT("TouchEngine"), STATGROUP_TouchEngine, STATCAT_Advanced)
 
@@ -23,3 +24,77 @@ DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Export - Texture Pool - Nb Textures in Pool
 
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Nb Textures in Pool"), STAT_TE_ImportedTexturePool_NbTexturesPool, STATGROUP_TouchEngine)
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - No Texture2d Created for Import"), STAT_TE_Import_NbTexture2dCreated, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Import - Nb Copies per Frame"), STAT_TE_Import_NbCopies, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Export - Nb Copies per Frame"), STAT_TE_Export_NbCopies, STATGROUP_TouchEngine)
+
+DECLARE_CYCLE_STAT(TEXT("Cook - Latency"), STAT_TE_Cook_Latency, STATGROUP_TouchEngine)
+DECLARE_CYCLE_STAT(TEXT("Cook - Time Queued"), STAT_TE_Cook_TimeQueued, STATGROUP_TouchEngine)
+DECLARE_CYCLE_STAT(TEXT("Cook - Time in TouchEngine"), STAT_TE_Cook_TimeInTouchEngine, STATGROUP_TouchEngine)
+DECLARE_CYCLE_STAT(TEXT("II. [GT] Synchronized Wait"), STAT_TE_II, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook - Nb Dropped Frames"), STAT_TE_Cook_NbDroppedFrames, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook - Nb Cancelled Cooks"), STAT_TE_Cook_NbCancelled, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook - Nb Merged Cooks"), STAT_TE_Cook_NbMerged, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Variables - CHOP Samples Sent"), STAT_TE_CHOP_NbSamplesSent, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Variables - CHOP Samples Received"), STAT_TE_CHOP_NbSamplesReceived, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Variables - Link Info Lookups"), STAT_TE_LinkInfo_NbLookups, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Variables - Link Info Cache Misses"), STAT_TE_LinkInfo_NbCacheMisses, STATGROUP_TouchEngine)
+
+DECLARE_MEMORY_STAT(TEXT("TouchEngine - GPU Memory Used"), STAT_TE_Instance_MemoryUsedGPU, STATGROUP_TouchEngine)
+DECLARE_MEMORY_STAT(TEXT("TouchEngine - CPU Memory Used"), STAT_TE_Instance_MemoryUsedCPU, STATGROUP_TouchEngine)
+DECLARE_CYCLE_STAT(TEXT("TouchEngine - Frame Time CPU"), STAT_TE_Instance_FrameTimeCPU, STATGROUP_TouchEngine)
+DECLARE_CYCLE_STAT(TEXT("TouchEngine - Frame Time GPU"), STAT_TE_Instance_FrameTimeGPU, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("TouchEngine - Nb Dropped Frames"), STAT_TE_Instance_NbFramesDropped, STATGROUP_TouchEngine)
+
+namespace UE::TouchEngine
+{
+	/** Converts a duration measured with FPlatformTime::Seconds() to the cycles expected by SET_CYCLE_COUNTER */
+	inline int64 SecondsToStatCycles(double Seconds)
+	{
+		return static_cast<int64>(FMath::Max(0.0, Seconds) / FPlatformTime::GetSecondsPerCycle());
+	}
+
+	/**
+	 * Running totals of the cook and variable stats above, updated alongside them by the TOUCHENGINE_STAT macros below.
+	 * The stats can only be read from the stats thread, and not at all when STATS is disabled, so these are what tests and tools read instead.
+	 * The totals never reset: read them before and after the work being measured.
+	 */
+	struct FTouchEngineStatCounters
+	{
+		std::atomic<uint64> NbDroppedFrames = 0;
+		std::atomic<uint64> NbCancelledCooks = 0;
+		std::atomic<uint64> NbMergedCooks = 0;
+		std::atomic<uint64> NbCHOPSamplesSent = 0;
+		std::atomic<uint64> NbCHOPSamplesReceived = 0;
+		std::atomic<uint64> NbLinkInfoLookups = 0;
+		std::atomic<uint64> NbLinkInfoCacheMisses = 0;
+		std::atomic<uint64> NbImportCopies = 0;
+		std::atomic<uint64> NbExportCopies = 0;
+
+		/** The durations of the last cook, in seconds. Negative until a cook has set them */
+		std::atomic<double> LastCookLatency = -1.0;
+		std::atomic<double> LastCookTimeQueued = -1.0;
+		std::atomic<double> LastCookTimeInTouchEngine = -1.0;
+
+		TOUCHENGINE_API static FTouchEngineStatCounters& Get();
+	};
+}
+
+/** Increments a counter or accumulator stat of the TouchEngine group, and the matching total of FTouchEngineStatCounters */
+#define INC_TOUCHENGINE_STAT_BY(Stat, Counter, Amount) \
+	do \
+	{ \
+		const uint32 TouchEngineStatAmount = static_cast<uint32>(Amount); \
+		INC_DWORD_STAT_BY(Stat, TouchEngineStatAmount); \
+		UE::TouchEngine::FTouchEngineStatCounters::Get().Counter.fetch_add(TouchEngineStatAmount, std::memory_order_relaxed); \
+	} while (0)
+#define INC_TOUCHENGINE_STAT(Stat, Counter) INC_TOUCHENGINE_STAT_BY(Stat, Counter, 1)
+
+/** Sets a cycle stat of the TouchEngine group from a duration in seconds, and the matching duration of FTouchEngineStatCounters */
+#define SET_TOUCHENGINE_CYCLE_STAT(Stat, Counter, Seconds) \
+	do \
+	{ \
+		const double TouchEngineStatSeconds = (Seconds); \
+		SET_CYCLE_COUNTER(Stat, UE::TouchEngine::SecondsToStatCycles(TouchEngineStatSeconds)); \
+		UE::TouchEngine::FTouchEngineStatCounters::Get().Counter.store(TouchEngineStatSeconds, std::memory_order_relaxed); \
+	} while (0)
@@ -0,0 +1,77 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+#ifndef UE_TOUCHENGINE_TRACE_ENABLED
+#define UE_TOUCHENGINE_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+#if UE_TOUCHENGINE_TRACE_ENABLED
+/**
+ * The channel of the TouchEngine cook timeline. Enable it with -trace=default,TouchEngine to record it in Unreal Insights.
+ * The events are recorded as bookmarks, so Insights shows them in the Timing view and the Log view without any custom analyzer.
+ */
+UE_TRACE_CHANNEL_EXTERN(TouchEngineChannel, TOUCHENGINE_API)
+#endif
+
+namespace UE::TouchEngine
+{
+	/**
+	 * The stages of a cook traced on the TouchEngine channel. They all carry the FrameID of the FTouchEngineInputFrameData of the cook, so the work of one frame
+	 * can be followed across the GameThread, the RenderThread and the TouchEngine callback threads.
+	 */
+	enum class ECookTimelineEvent : uint8
+	{
+		/** The cook was added to the PendingCookQueue, see FTouchFrameCooker::EnqueueCookFrame */
+		CookEnqueued,
+		/** The cook was popped from the queue and its inputs are being sent, see FTouchFrameCooker::ExecuteNextPendingCookFrame_GameThread */
+		CookStarted,
+		/** TEInstanceStartFrameAtTime is about to be called */
+		FrameStartedInTouchEngine,
+		/** TouchEngine is done with the frame, see FTouchFrameCooker::OnFrameFinishedCooking_AnyThread */
+		FrameFinishedInTouchEngine,
+		/** A texture input started to be exported */
+		ExportStarted,
+		/** The texture transfer of an exported texture was added */
+		ExportTransferAdded,
+		/** The copy of an exported texture was enqueued */
+		ExportFinalised,
+		/** A texture output was received from TouchEngine */
+		ImportStarted,
+		/** The copy of an imported texture was enqueued */
+		ImportCopyEnqueued,
+		/** The imported texture was linked to its output */
+		ImportLinked,
+		/** The results of the cook were processed on GameThread, see UTouchEngineComponentBase::OnCookFinished */
+		CookFinished,
+	};
+
+	TOUCHENGINE_API const TCHAR* LexToString(ECookTimelineEvent Event);
+
+	struct TOUCHENGINE_API FTouchEngineTrace
+	{
+		/** Emits a cook timeline event from any thread, as a bookmark reading "TouchEngine <Event> [Frame <FrameID>] <Identifier>". The Identifier is the input or output the event relates to, if any */
+		static void OutputCookTimelineEvent(ECookTimelineEvent Event, int64 FrameID, const FName& Identifier = NAME_None);
+	};
+}
+
+#if UE_TOUCHENGINE_TRACE_ENABLED
+#define UE_TRACE_TOUCHENGINE_COOK_EVENT(Event, FrameID, ...) UE::TouchEngine::FTouchEngineTrace::OutputCookTimelineEvent(UE::TouchEngine::ECookTimelineEvent::Event, FrameID, ##__VA_ARGS__)
+#else
+#define UE_TRACE_TOUCHENGINE_COOK_EVENT(Event, FrameID, ...)
+#endif
@@ -0,0 +1,98 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * A FIFO queue backed by a fixed-capacity circular buffer.
+	 * Pushing and popping never shifts the stored elements, and the storage is only reallocated when the capacity is increased.
+	 * This class is not thread-safe, the owner is responsible for guarding it.
+	 */
+	template<typename T>
+	class TTouchRingBuffer
+	{
+	public:
+		int32 Num() const { return Count; }
+		bool IsEmpty() const { return Count == 0; }
+		bool IsFull() const { return Count == Slots.Num(); }
+		int32 GetCapacity() const { return Slots.Num(); }
+
+		/** Ensures the buffer can hold at least NewCapacity elements, keeping the existing elements in order. The capacity is never decreased. */
+		void EnsureCapacity(int32 NewCapacity)
+		{
+			if (NewCapacity <= Slots.Num())
+			{
+				return;
+			}
+
+			TArray<TOptional<T>> NewSlots;
+			NewSlots.SetNum(NewCapacity);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				NewSlots[Index] = MoveTemp(Slots[GetSlotIndex(Index)]);
+			}
+			Slots = MoveTemp(NewSlots);
+			Head = 0;
+		}
+
+		/** Adds the element at the back of the queue. The buffer must not be full. */
+		void Push(T&& Element)
+		{
+			check(!IsFull());
+			Slots[GetSlotIndex(Count)].Emplace(MoveTemp(Element));
+			++Count;
+		}
+
+		/** Removes and returns the oldest element of the queue. The buffer must not be empty. */
+		T Pop()
+		{
+			check(!IsEmpty());
+			TOptional<T>& Slot = Slots[Head];
+			T Element = MoveTemp(Slot.GetValue());
+			Slot.Reset();
+			Head = (Head + 1) % Slots.Num();
+			--Count;
+			return Element;
+		}
+
+		/** Returns the oldest element of the queue, which is the next one to be popped. The buffer must not be empty. */
+		T& Peek()
+		{
+			check(!IsEmpty());
+			return Slots[Head].GetValue();
+		}
+
+		void Empty()
+		{
+			for (TOptional<T>& Slot : Slots)
+			{
+				Slot.Reset();
+			}
+			Head = 0;
+			Count = 0;
+		}
+
+	private:
+		TArray<TOptional<T>> Slots;
+		/** The slot of the oldest element */
+		int32 Head = 0;
+		int32 Count = 0;
+
+		int32 GetSlotIndex(int32 QueueIndex) const { return (Head + QueueIndex) % Slots.Num(); }
+	};
+}
@@ -0,0 +1,156 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * A histogram of the last WindowSize recorded values, used to report percentiles over a rolling window.
+	 * The buckets are laid out like an HDR histogram: every value below SubBucketCount has its own bucket, and every power of two above it is split into SubBucketHalfCount buckets.
+	 * The values reported are therefore within 1 / SubBucketHalfCount of the recorded ones.
+	 * The bucket counts are stored inline (NumBuckets * 4 bytes, 4 KB), and the window is heap allocated with 2 bytes per value.
+	 * Recording is O(1) and queries are O(NumBuckets). Values are non-negative integers, the owner picks the unit (i.e. microseconds) matching the precision it needs.
+	 * This class is not thread-safe, the owner is responsible for guarding it.
+	 */
+	class FTouchRollingHistogram
+	{
+	public:
+		static constexpr int32 SubBucketBits = 6;
+		static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+		static constexpr int32 SubBucketHalfCount = SubBucketCount / 2;
+		/** Values above MaxValue are clamped. When recording microseconds, this is more than 19 hours */
+		static constexpr int32 MaxValueBits = 36;
+		static constexpr int64 MaxValue = (static_cast<int64>(1) << MaxValueBits) - 1;
+		static constexpr int32 NumBuckets = SubBucketCount + (MaxValueBits - SubBucketBits) * SubBucketHalfCount;
+		static_assert(NumBuckets <= MAX_uint16, "The bucket indices are stored as uint16 in the window");
+
+		explicit FTouchRollingHistogram(int32 InWindowSize = 1)
+		{
+			SetWindowSize(InWindowSize);
+		}
+
+		/** Sets the number of values the percentiles are computed over. Discards the recorded values. */
+		void SetWindowSize(int32 InWindowSize)
+		{
+			const int32 WindowSize = FMath::Max(1, InWindowSize);
+			Window.Empty(WindowSize);
+			Window.SetNumZeroed(WindowSize);
+			Reset();
+		}
+		int32 GetWindowSize() const { return Window.Num(); }
+		int32 Num() const { return Count; }
+		bool IsEmpty() const { return Count == 0; }
+
+		/** Records the value, discarding the oldest one if the window is full */
+		void Record(int64 Value)
+		{
+			const int32 BucketIndex = GetBucketIndex(Value);
+			++BucketCounts[BucketIndex];
+			if (Count == Window.Num()) // The oldest value is overwritten
+			{
+				--BucketCounts[Window[Head]];
+				Window[Head] = static_cast<uint16>(BucketIndex);
+				Head = (Head + 1) % Window.Num();
+			}
+			else
+			{
+				Window[(Head + Count) % Window.Num()] = static_cast<uint16>(BucketIndex);
+				++Count;
+			}
+		}
+
+		void Reset()
+		{
+			Head = 0;
+			Count = 0;
+			FMemory::Memzero(BucketCounts);
+		}
+
+		/** Returns the smallest value greater or equal to Percentile percent of the values in the window, up to the histogram precision. Returns 0 if the window is empty. */
+		int64 GetPercentile(double Percentile) const
+		{
+			if (IsEmpty())
+			{
+				return 0;
+			}
+
+			const uint32 Rank = static_cast<uint32>(FMath::Clamp<int64>(FMath::CeilToInt64(Percentile / 100.0 * Count), 1, Count));
+			uint32 CumulatedCount = 0;
+			for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+			{
+				CumulatedCount += BucketCounts[BucketIndex];
+				if (CumulatedCount >= Rank)
+				{
+					return GetBucketHighestValue(BucketIndex);
+				}
+			}
+			return MaxValue;
+		}
+		int64 GetMax() const { return GetPercentile(100.0); }
+
+		/** Returns the mean of the values in the window, up to the histogram precision. Exact if all values are below SubBucketCount. */
+		double GetMean() const
+		{
+			if (IsEmpty())
+			{
+				return 0.0;
+			}
+
+			double Sum = 0.0;
+			for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+			{
+				Sum += static_cast<double>(BucketCounts[BucketIndex]) * GetBucketHighestValue(BucketIndex);
+			}
+			return Sum / Count;
+		}
+
+		static int32 GetBucketIndex(int64 Value)
+		{
+			const int64 ClampedValue = FMath::Clamp<int64>(Value, 0, MaxValue);
+			if (ClampedValue < SubBucketCount)
+			{
+				return static_cast<int32>(ClampedValue);
+			}
+
+			// Keep the SubBucketBits most significant bits of the value, the top one always being set
+			const int32 Shift = static_cast<int32>(FMath::FloorLog2_64(static_cast<uint64>(ClampedValue))) - SubBucketBits + 1;
+			const int32 SubBucketIndex = static_cast<int32>(ClampedValue >> Shift) - SubBucketHalfCount;
+			return SubBucketCount + (Shift - 1) * SubBucketHalfCount + SubBucketIndex;
+		}
+
+		static int64 GetBucketHighestValue(int32 BucketIndex)
+		{
+			if (BucketIndex < SubBucketCount)
+			{
+				return BucketIndex;
+			}
+
+			const int32 Shift = (BucketIndex - SubBucketCount) / SubBucketHalfCount + 1;
+			const int64 SubBucketValue = (BucketIndex - SubBucketCount) % SubBucketHalfCount + SubBucketHalfCount;
+			return ((SubBucketValue + 1) << Shift) - 1;
+		}
+
+	private:
+		/** The bucket index of each value in the window, as a circular buffer of GetWindowSize() slots. A plain uint16 array as this is the only memory growing with the window */
+		TArray<uint16> Window;
+		/** The slot of the oldest value */
+		int32 Head = 0;
+		int32 Count = 0;
+		uint32 BucketCounts[NumBuckets];
+	};
+}
@@ -0,0 +1,72 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Hands the latest value written by producer threads over to a consumer thread, without the consumer ever taking a lock.
+	 * The producer and the consumer each own a slot and swap it with the shared one, so a value is never read while it is being written.
+	 * Several threads can write, as TouchEngine delivers its callbacks from any of its threads: they are serialized by a lock the consumer never takes,
+	 * so a producer only waits for another producer. Values written between two reads are overwritten, only the latest one is read.
+	 * There must only be one consumer at a time.
+	 */
+	template<typename T>
+	class TTouchTripleBuffer
+	{
+	public:
+		/** Publishes a new value. Called by any producer */
+		void Write(const T& Value)
+		{
+			// The slot owned by the producers is only written under this lock, so two producers cannot write it at the same time or both publish it
+			FScopeLock Lock(&ProducerMutex);
+			Slots[WriteIndex] = Value;
+			const uint8 PreviousSharedState = SharedState.exchange(WriteIndex | NewValueFlag, std::memory_order_acq_rel);
+			WriteIndex = PreviousSharedState & IndexMask;
+		}
+
+		/** Sets OutValue to the latest published value and returns true if a value was published since the last call. Called by the consumer */
+		bool Read(T& OutValue)
+		{
+			if ((SharedState.load(std::memory_order_relaxed) & NewValueFlag) == 0)
+			{
+				return false;
+			}
+			const uint8 PreviousSharedState = SharedState.exchange(ReadIndex, std::memory_order_acq_rel);
+			ReadIndex = PreviousSharedState & IndexMask;
+			OutValue = Slots[ReadIndex];
+			return true;
+		}
+
+	private:
+		static constexpr uint8 IndexMask = 0x3;
+		static constexpr uint8 NewValueFlag = 0x4;
+
+		T Slots[3];
+		/** Serializes the producers */
+		FCriticalSection ProducerMutex;
+		/** The slot owned by the producers, guarded by ProducerMutex */
+		uint8 WriteIndex = 0;
+		/** The index of the shared slot, with NewValueFlag set if it holds a value the consumer has not read yet */
+		std::atomic<uint8> SharedState = 1;
+		/** The slot owned by the consumer */
+		uint8 ReadIndex = 2;
+	};
+}
@@ -0,0 +1,90 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/RefCounting.h"
+#include <atomic>
+
+namespace UE::TouchEngine
+{
+	/**
+	 * A single allocation holding the values of one or more dynamic variables which do not fit in their inline storage, like arrays, CHOPs and strings.
+	 * Values are referenced by their offset in the arena and never by pointer, so the variables referencing them can be relocated by TArray and TMap.
+	 * The arena is reference counted and a value is never modified once its arena is shared, so copying a variable only copies a reference.
+	 * The reference count is thread-safe as copies of the variables are handed to the cook, but allocating in the arena is not: only the thread which
+	 * created the arena allocates in it, and only before handing it to other threads.
+	 */
+	class alignas(16) FTouchValueArena
+	{
+	public:
+		/** The alignment of the arena and of every value allocated in it */
+		static constexpr int32 Alignment = 16;
+
+		/** Creates an arena of Capacity bytes, made of a single allocation. The memory is not initialized */
+		static TRefCountPtr<FTouchValueArena> Create(int32 Capacity)
+		{
+			void* Memory = FMemory::Malloc(sizeof(FTouchValueArena) + Capacity, Alignment);
+			return new (Memory) FTouchValueArena(Capacity);
+		}
+		/** Returns the number of bytes a value of NumBytes uses in an arena, including the padding keeping the next value aligned */
+		static int32 GetAlignedSize(int32 NumBytes) { return Align(NumBytes, Alignment); }
+
+		UE_NONCOPYABLE(FTouchValueArena);
+
+		/** Reserves NumBytes and returns their offset in the arena. The arena must have enough room left, see GetAlignedSize */
+		int32 Allocate(int32 NumBytes)
+		{
+			check(NumBytes >= 0 && NumAllocatedBytes + GetAlignedSize(NumBytes) <= Capacity);
+			const int32 Offset = NumAllocatedBytes;
+			NumAllocatedBytes += GetAlignedSize(NumBytes);
+			return Offset;
+		}
+
+		uint8* GetData(int32 Offset) { return reinterpret_cast<uint8*>(this + 1) + Offset; }
+		const uint8* GetData(int32 Offset) const { return reinterpret_cast<const uint8*>(this + 1) + Offset; }
+		int32 GetCapacity() const { return Capacity; }
+		int32 GetNumAllocatedBytes() const { return NumAllocatedBytes; }
+
+		/** Returns true if the arena is referenced more than once, in which case none of its values can be modified in place */
+		bool IsShared() const { return NumRefs.load(std::memory_order_acquire) > 1; }
+
+		uint32 AddRef() const { return NumRefs.fetch_add(1, std::memory_order_relaxed) + 1; }
+		uint32 Release() const
+		{
+			const uint32 NewNumRefs = NumRefs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+			if (NewNumRefs == 0)
+			{
+				FTouchValueArena* This = const_cast<FTouchValueArena*>(this);
+				This->~FTouchValueArena();
+				FMemory::Free(This);
+			}
+			return NewNumRefs;
+		}
+		uint32 GetRefCount() const { return NumRefs.load(std::memory_order_relaxed); }
+
+	private:
+		explicit FTouchValueArena(int32 InCapacity)
+			: Capacity(InCapacity)
+		{}
+		~FTouchValueArena() = default;
+
+		mutable std::atomic<uint32> NumRefs = 0;
+		const int32 Capacity;
+		int32 NumAllocatedBytes = 0;
+	};
+	static_assert(sizeof(FTouchValueArena) == FTouchValueArena::Alignment, "The values must start right after the arena header and be aligned");
+}
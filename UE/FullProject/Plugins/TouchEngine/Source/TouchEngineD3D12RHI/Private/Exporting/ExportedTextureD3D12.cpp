@@ -136,8 +136,7 @@ namespace UE::TouchEngine::D3DX12
 				nullptr,
 				nullptr
 			);
-			const void* NullPointer = nullptr;
-			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEVulkanTextureCreate(textureHandle: '%p' [UE: '%s'], type: '%d', format: '%d', width: '%d', height: '%d', origin: '%s', map: '%s', callback: '%p', info: '%p') [Thread: '%s']  =>  Returned '%p'"),
+			UE_LOG_TE_CALL(Log, TEXT("  TEVulkanTextureCreate(textureHandle: '%p' [UE: '%s'], type: '%d', format: '%d', width: '%d', height: '%d', origin: '%s', map: '%s', callback: '%p', info: '%p') [Thread: '%s']  =>  Returned '%p'"),
 				SharingHandle,
 				*DebugName,
 				TED3DHandleTypeD3D12ResourceNT,
@@ -146,8 +145,8 @@ namespace UE::TouchEngine::D3DX12
 				GetSharedTextureRHI_RenderThread()->GetSizeY(),
 				TEXT("TETextureOriginTopLeft"),
 				*FString::Printf(TEXT("[r: %d, g: %d, b: %d, a: %d]"), kTETextureComponentMapIdentity.r, kTETextureComponentMapIdentity.g, kTETextureComponentMapIdentity.b, kTETextureComponentMapIdentity.a),
-				NullPointer,
-				NullPointer,
+				static_cast<const void*>(nullptr),
+				static_cast<const void*>(nullptr),
 				*GetCurrentThreadStr(),
 				SharedTexture
 			)
@@ -77,7 +77,7 @@ namespace UE::TouchEngine::D3DX12
 		D3DTexture->CopyCompletedFence->DebugName = FString::Printf(TEXT("Fence_%lld"), Params.FrameData.FrameID);
 		const uint64 WaitValue = D3DTexture->CopyCompletedFence->LastValue; //  we need to wait until that fence value is reached
 		
-		UE_LOG(LogTouchEngineTECalls, Verbose, TEXT("  TEInstanceAddTextureTransfer(TEInstance: '%p', texture: [TE: '%p', UE: '%s'], semaphore: '%p' ('%s'), value: '%lld') [Thread: '%s', Parameter: '%s', CookingFrame '%lld', CurrentSemaphoreValue: '%lld]"),
+		UE_LOG_TE_CALL(Verbose, TEXT("  TEInstanceAddTextureTransfer(TEInstance: '%p', texture: [TE: '%p', UE: '%s'], semaphore: '%p' ('%s'), value: '%lld') [Thread: '%s', Parameter: '%s', CookingFrame '%lld', CurrentSemaphoreValue: '%lld]"),
 			Params.Instance.get(),
 			Texture->GetTouchRepresentation_RenderThread().get(),
 			*Texture->DebugName,
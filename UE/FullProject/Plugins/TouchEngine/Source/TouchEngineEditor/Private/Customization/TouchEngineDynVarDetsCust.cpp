@@ -338,7 +338,7 @@ uint32 FTouchEngineDynamicVariableStructDetailsCustomization::GenerateInputVaria
 				);
 
 				// check for strange state world Property details panel can be in
-				if (DynVar->TextureProperty == nullptr && DynVar->Value)
+				if (DynVar->TextureProperty == nullptr && DynVar->HasValue())
 				{
 					// value is set but texture Property is empty, set texture Property from value
 					DynVar->TextureProperty = DynVar->GetValueAsTexture();
@@ -92,6 +92,7 @@ void UTouchInputGetK2Node::ExpandNode(FKismetCompilerContext& CompilerContext, U
 	CallFunction->AllocateDefaultPins();
 	CallFunction->FindPinChecked(FPinNames::Prefix)->DefaultValue = "i/";
 	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFunction, this);
+	ConnectVariableHandle(CompilerContext, SourceGraph, CallFunction);
 
 	ValidateLegacyVariableNames(FPinNames::InputName, CompilerContext, "i/");
 
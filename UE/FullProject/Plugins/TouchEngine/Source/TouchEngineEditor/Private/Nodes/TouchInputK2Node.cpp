@@ -277,6 +277,7 @@ void UTouchInputK2Node::ExpandNode(FKismetCompilerContext& CompilerContext, UEdG
 	CallFunction->AllocateDefaultPins();
 	CallFunction->FindPinChecked(FPinNames::Prefix)->DefaultValue = "i/";
 	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFunction, this);
+	ConnectVariableHandle(CompilerContext, SourceGraph, CallFunction);
 
 	ValidateLegacyVariableNames(FPinNames::InputName, CompilerContext, "i/");
 
@@ -20,6 +20,8 @@
 #include "EdGraphSchema_K2.h"
 #include "Engine/Texture.h"
 #include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_TemporaryVariable.h"
 #include "KismetCompiler.h"
 
 #define LOCTEXT_NAMESPACE "TouchK2NodeBase"
@@ -41,7 +43,8 @@ const FName UTouchK2NodeBase::FFunctionParametersNames::ParameterName			{ TEXT("
 const FName UTouchK2NodeBase::FFunctionParametersNames::Value					{ TEXT("Value") };
 const FName UTouchK2NodeBase::FFunctionParametersNames::Prefix					{ TEXT("Prefix") };
 const FName UTouchK2NodeBase::FFunctionParametersNames::OutputFrameLastUpdated	{ TEXT("FrameLastUpdated") };
-const TArray<FName> UTouchK2NodeBase::FFunctionParametersNames::DefaultParameters {TouchEngineComponent, ParameterName, Value, Prefix};
+const FName UTouchK2NodeBase::FFunctionParametersNames::Handle					{ TEXT("Handle") };
+const TArray<FName> UTouchK2NodeBase::FFunctionParametersNames::DefaultParameters {TouchEngineComponent, ParameterName, Value, Prefix, Handle};
 
 FSlateIcon UTouchK2NodeBase::GetIconAndTint(FLinearColor& OutColor) const
 {
@@ -132,6 +135,21 @@ UEdGraphPin* UTouchK2NodeBase::CreateTouchComponentPin(const FText& Tooltip)
 	return InObjectPin;
 }
 
+void UTouchK2NodeBase::ConnectVariableHandle(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UK2Node_CallFunction* CallFunction)
+{
+	UK2Node_TemporaryVariable* HandleVariable = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	HandleVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	HandleVariable->VariableType.PinSubCategoryObject = FTouchEngineDynamicVariableHandle::StaticStruct();
+	HandleVariable->bIsPersistent = SourceGraph->GetSchema()->GetGraphType(SourceGraph) == GT_Ubergraph;
+	HandleVariable->AllocateDefaultPins();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(HandleVariable, this);
+
+	if (!CompilerContext.GetSchema()->TryCreateConnection(HandleVariable->GetVariablePin(), CallFunction->FindPinChecked(FFunctionParametersNames::Handle)))
+	{
+		CompilerContext.MessageLog.Error(*LOCTEXT("HandleNotConnected", "Unable to create the variable handle of the node @@.").ToString(), this);
+	}
+}
+
 bool UTouchK2NodeBase::IsPinCategoryValidInternal(const UEdGraphPin* InPin, const FName& InPinCategory)
 {
 	if (InPinCategory == UEdGraphSchema_K2::PC_Float ||
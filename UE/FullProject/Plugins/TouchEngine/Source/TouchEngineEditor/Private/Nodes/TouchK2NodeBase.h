@@ -18,6 +18,8 @@
 #include "K2Node.h"
 #include "TouchK2NodeBase.generated.h"
 
+class UK2Node_CallFunction;
+
 /**
  * Base Touch K2 blueprint node
  */
@@ -80,12 +82,20 @@ protected:
 		static const FName OutputFrameLastUpdated;
 		/** Prefix parameter */
 		static const FName Prefix; // Internal, part of Getter/Setter functions
+		/** Handle parameter */
+		static const FName Handle; // Internal, part of Getter/Setter functions
 		/** The default parameters of every UTouchBlueprintFunctionLibrary function. Currently all the values of FFunctionParametersNames */
 		static const TArray<FName> DefaultParameters;
 	};
 
 	UEdGraphPin* CreateTouchComponentPin(const FText& Tooltip);
 
+	/**
+	 * Connects the Handle parameter of the given UTouchBlueprintFunctionLibrary call to a variable kept across calls, so the variable is only looked up by name on the first call.
+	 * Persistent variables are only available in the event graph, in other graphs the handle is local to each call.
+	 */
+	void ConnectVariableHandle(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UK2Node_CallFunction* CallFunction);
+
 private:
 
 	/**
@@ -103,6 +103,7 @@ void UTouchOutputK2Node::ExpandNode(FKismetCompilerContext& CompilerContext, UEd
 	CallFunction->AllocateDefaultPins();
 	CallFunction->FindPinChecked(FPinNames::Prefix)->DefaultValue = "o/";
 	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFunction, this);
+	ConnectVariableHandle(CompilerContext, SourceGraph, CallFunction);
 
 	ValidateLegacyVariableNames(FPinNames::OutputName, CompilerContext, "o/");
 
@@ -92,6 +92,7 @@ void UTouchParameterGetK2Node::ExpandNode(FKismetCompilerContext& CompilerContex
 	CallFunction->AllocateDefaultPins();
 	CallFunction->FindPinChecked(FPinNames::Prefix)->DefaultValue = "p/";
 	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFunction, this);
+	ConnectVariableHandle(CompilerContext, SourceGraph, CallFunction);
 
 	ValidateLegacyVariableNames(FPinNames::ParameterName, CompilerContext, "p/");
 
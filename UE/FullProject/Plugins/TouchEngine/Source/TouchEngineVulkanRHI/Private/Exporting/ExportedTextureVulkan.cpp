@@ -306,9 +306,8 @@ namespace UE::TouchEngine::Vulkan
 		}
 
 		const FIntPoint Resolution = GetResolution_RenderThread();
-		const void* NullPointer = nullptr;
 		TouchObject<TEVulkanTexture> TouchRepresentation = TouchObject<TEVulkanTexture>::make_take(TEVulkanTextureCreate(VulkanTextureData->VulkanSharedHandle, VulkanTextureData->MemoryHandleFlags, VulkanFormat, Resolution.X, Resolution.Y, TETextureOriginTopLeft, Mapping, nullptr, nullptr));
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEVulkanTextureCreate(textureHandle: '%p' [UE: '%s'], handleType: '%d', format: '%d', width: '%d', height: '%d', origin: '%s', map: '%s', callback: '%p', info: '%p') [Thread: '%s']  =>  Returned '%p'"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEVulkanTextureCreate(textureHandle: '%p' [UE: '%s'], handleType: '%d', format: '%d', width: '%d', height: '%d', origin: '%s', map: '%s', callback: '%p', info: '%p') [Thread: '%s']  =>  Returned '%p'"),
 			VulkanTextureData->VulkanSharedHandle,
 			*DebugName,
 			VulkanTextureData->MemoryHandleFlags,
@@ -317,8 +316,8 @@ namespace UE::TouchEngine::Vulkan
 			Resolution.Y,
 			TEXT("TETextureOriginTopLeft"),
 			*FString::Printf(TEXT("[r: %d, g: %d, b: %d, a: %d]"), Mapping.r, Mapping.g, Mapping.b, Mapping.a),
-			NullPointer,
-			NullPointer,
+			static_cast<const void*>(nullptr),
+			static_cast<const void*>(nullptr),
 			*GetCurrentThreadStr(),
 			TouchRepresentation.get()
 		)
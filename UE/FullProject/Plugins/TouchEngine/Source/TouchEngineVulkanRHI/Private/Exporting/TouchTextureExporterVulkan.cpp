@@ -58,7 +58,7 @@ namespace UE::TouchEngine::Vulkan
 		const TSharedRef<FExportedTextureVulkan> VulkanTexture = StaticCastSharedRef<FExportedTextureVulkan>(Texture);
 		check(VulkanTexture->SignalSemaphoreData.IsSet());
 		
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceAddTextureTransfer(instance: '%p', texture: '%p' ['%s'], semaphore: '%p' ['%s'], value: '%lld') [Thread: '%s', Frame: '%lld', Parameter: '%s']"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEInstanceAddTextureTransfer(instance: '%p', texture: '%p' ['%s'], semaphore: '%p' ['%s'], value: '%lld') [Thread: '%s', Frame: '%lld', Parameter: '%s']"),
 			Params.Instance.get(),
 			Texture->GetTouchRepresentation_RenderThread().get(),
 			*Texture->DebugName,
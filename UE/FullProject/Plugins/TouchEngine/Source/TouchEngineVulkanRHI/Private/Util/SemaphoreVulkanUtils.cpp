@@ -133,22 +133,21 @@ namespace UE::TouchEngine::Vulkan
 			[](HANDLE semaphore, TEObjectEvent event, void* info)
 			{
 				const TmpData* DName = static_cast<TmpData*>(info);
-				const uint64 Value = GetCompletedSemaphoreValue(DName->VulkanSemaphore.Get(),FString());
-				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEVulkanSemaphoreCallback(semaphoreHandle: '%p' [TE: '%p', UE: '%s'], event: '%s', info: '%p') [Thread: '%s', CurrentValue: '%lld']"),
+				UE_LOG_TE_CALL(Log, TEXT("  TEVulkanSemaphoreCallback(semaphoreHandle: '%p' [TE: '%p', UE: '%s'], event: '%s', info: '%p') [Thread: '%s', CurrentValue: '%lld']"),
 					semaphore,
 					DName->TouchSemaphore,
 					*DName->DebugName,
 					*TEObjectEventToString(event),
 					info,
 					*UE::TouchEngine::GetCurrentThreadStr(),
-					Value
+					GetCompletedSemaphoreValue(DName->VulkanSemaphore.Get(), FString())
 				);
 				if (event == TEObjectEventRelease)
 				{
 					delete DName;
 				}
 			}, DName);
-		UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEVulkanSemaphoreCreate(type: '%d', handle: '%p', handleType: '%d', callback: '%s', info: '%p') [Thread: '%s']  =>  Returned TE: '%p' [UE: '%s']"),
+		UE_LOG_TE_CALL(Log, TEXT("  TEVulkanSemaphoreCreate(type: '%d', handle: '%p', handleType: '%d', callback: '%s', info: '%p') [Thread: '%s']  =>  Returned TE: '%p' [UE: '%s']"),
 			SemaphoreTypeCreateInfo.semaphoreType,
 			Result.ExportedHandle,
 			static_cast<VkExternalSemaphoreHandleTypeFlagBits>(ExportSemInfo.handleTypes),